@@ -17,6 +17,12 @@
  * Authors: Victor Isachi <victor.isachi@unibo.it>
  *
  * CU BFM VIP to check FractalSync networks
+ *
+ * sync blocks the CU until the wake; split_sync arrives, overlaps independent work with the barrier and then waits for
+ * the wake latched by the split-phase endpoint (fractal_sync_sp) of the interface; multi_sync keeps several distinct
+ * barriers in flight, up to the outstanding barriers of the endpoints.
+ * A CU that waits longer than WATCHDOG cycles for a wake (or for a free line of its endpoint) gives up: the
+ * synchronization is counted as an error, recorded as hung and the CU moves on to the next one.
  */
 
 import fractal_dv_pkg::*;
@@ -39,6 +45,10 @@ class cu_bfm #(
 
   int unsigned detected_errors;
   time         transaction_times[$];
+  bit          hung; // The current synchronization has timed out
+
+  sync_trace   trace = null;
+  int unsigned cu_id;
 
   function new(string instance_name, 
                virtual fractal_sync_if.mst_port #(.AGGR_WIDTH(FSYNC_TREE_AGGR_WIDTH), .LVL_WIDTH(FSYNC_TREE_LVL_WIDTH), .ID_WIDTH(FSYNC_TREE_ID_WIDTH)) vif_master_h_tree,
@@ -52,9 +62,15 @@ class cu_bfm #(
     this.vif_master_v_nbr  = vif_master_v_nbr;
   endfunction: new
 
+  function automatic void set_trace(sync_trace trace, int unsigned cu_id);
+    this.trace = trace;
+    this.cu_id = cu_id;
+  endfunction: set_trace
+
   task automatic init();
     detected_errors   = 0;
     transaction_times = {};
+    hung              = 1'b0;
     vif_master_h_tree.sync   = 1'b0;
     vif_master_h_tree.aggr   = '0;
     vif_master_h_tree.id_req = '0;
@@ -67,12 +83,35 @@ class cu_bfm #(
     vif_master_v_nbr.sync    = 1'b0;
     vif_master_v_nbr.aggr    = '0;
     vif_master_v_nbr.id_req  = '0;
+    vif_master_h_tree.wait_req = 1'b0;
+    vif_master_h_tree.lvl_wait = '0;
+    vif_master_h_tree.id_wait  = '0;
+    vif_master_v_tree.wait_req = 1'b0;
+    vif_master_v_tree.lvl_wait = '0;
+    vif_master_v_tree.id_wait  = '0;
+    vif_master_h_nbr.wait_req  = 1'b0;
+    vif_master_h_nbr.lvl_wait  = '0;
+    vif_master_h_nbr.id_wait   = '0;
+    vif_master_v_nbr.wait_req  = 1'b0;
+    vif_master_v_nbr.lvl_wait  = '0;
+    vif_master_v_nbr.id_wait   = '0;
   endtask: init
   
-  task automatic sync_req(sync_transaction fsync, int unsigned comp_cycles, int unsigned max_rand_cycles, const ref logic clk);
-    int unsigned rand_cycles = $urandom_range(0, max_rand_cycles);
+  // hold_wait: blocking synchronization, the wait for the barrier is held from the request (and until the next one) so
+  // that the split-phase endpoint frees its line with the wake
+  task automatic sync_req(sync_transaction fsync, int unsigned comp_cycles, int unsigned max_rand_cycles, const ref logic clk, input bit hold_wait = 1'b0);
+    int unsigned rand_cycles  = $urandom_range(0, max_rand_cycles);
+    int unsigned ready_cycles = 0;
     repeat (comp_cycles + rand_cycles) @(negedge clk);
     @(negedge clk);
+    while (!sync_ready(fsync)) begin
+      if (++ready_cycles > WATCHDOG) begin
+        timeout("free split-phase line");
+        return;
+      end
+      @(negedge clk);
+    end
+    if (hold_wait) drive_wait(fsync);
     if (fsync.sync_level == 1) begin
       case (fsync.sync_barrier_id)
         2'b00: begin
@@ -117,11 +156,16 @@ class cu_bfm #(
     vif_master_v_nbr.sync = 1'b0;
   endtask: sync_req
 
-  task automatic sync_rsp(ref sync_transaction fsync_rsp, const ref logic clk);
-    bit detected_single_wake = 0;
-    do
+  task automatic sync_rsp(ref sync_transaction fsync_rsp, const ref logic clk, input int unsigned watchdog_cycles = WATCHDOG);
+    bit          detected_single_wake = 0;
+    int unsigned wake_cycles          = 0;
+    do begin
       @(posedge clk);
-    while (!vif_master_h_tree.wake && !vif_master_v_tree.wake && !vif_master_h_nbr.wake && !vif_master_v_nbr.wake);
+      if (++wake_cycles > watchdog_cycles) begin
+        timeout("wake");
+        return;
+      end
+    end while (!vif_master_h_tree.wake && !vif_master_v_tree.wake && !vif_master_h_nbr.wake && !vif_master_v_nbr.wake);
     fsync_rsp.transaction_time = $time;
     if (vif_master_h_tree.wake) begin
       if (detected_single_wake == 1'b0) detected_single_wake = 1'b1;
@@ -143,31 +187,165 @@ class cu_bfm #(
   endtask: sync_rsp
 
   task automatic sync(input sync_transaction fsync_req, ref sync_transaction fsync_rsp, input int unsigned comp_cycles, input int unsigned max_rand_cycles, const ref logic clk);
+    bit mismatch;
+    hung = 1'b0;
     fork
       begin
         if (fractal_dv_pkg::VERBOSE > 0) begin
           $display("\nBFM instance [%s]: synchronization request", instance_name);
           fsync_req.print();
         end
-        sync_req(fsync_req, comp_cycles, max_rand_cycles, clk);
+        sync_req(fsync_req, comp_cycles, max_rand_cycles, clk, 1'b1);
       end begin
-        sync_rsp(fsync_rsp, clk);
+        sync_rsp(fsync_rsp, clk, comp_cycles+max_rand_cycles+1+WATCHDOG);
         if (fractal_dv_pkg::VERBOSE > 0) begin
           $display("\nBFM instance [%s]: synchronization response", instance_name);
           fsync_rsp.print();
         end
       end
     join
+    if (hung) begin
+      transaction_times.push_back(0);
+      if (trace != null) trace.write(cu_id, fsync_req, fsync_req.transaction_time, 0, sync_trace::HUNG);
+      return;
+    end
     transaction_times.push_back(fsync_rsp.transaction_time-fsync_req.transaction_time);
     if (fractal_dv_pkg::VERBOSE > 1) begin
       $display ("Synchronization transaction required %0tns (%0tns - %0tns)", transaction_times[transaction_times.size()-1], fsync_req.transaction_time, fsync_rsp.transaction_time);
     end
-    if ((fsync_req.sync_level != fsync_rsp.sync_level) || (fsync_req.sync_barrier_id != fsync_rsp.sync_barrier_id)) begin
+    mismatch = (fsync_req.sync_level != fsync_rsp.sync_level) || (fsync_req.sync_barrier_id != fsync_rsp.sync_barrier_id);
+    if (trace != null) trace.write(cu_id, fsync_req, fsync_req.transaction_time, fsync_rsp.transaction_time, mismatch ? sync_trace::ERROR : 0);
+    if (mismatch) begin
       $error("[ERROR] Detected synchronization error: req and rsp do not match");
       detected_errors++;
     end
   endtask: sync
 
+  // Wait signals of the interface fsync_req is sent through (the other interfaces stop waiting)
+  function automatic void drive_wait(sync_transaction fsync_req);
+    clear_wait();
+    if (fsync_req.sync_level == 1) begin
+      case (fsync_req.sync_barrier_id)
+        2'b00: begin vif_master_h_tree.lvl_wait = 0; vif_master_h_tree.id_wait = fsync_req.sync_barrier_id; vif_master_h_tree.wait_req = 1'b1; end
+        2'b01: begin vif_master_v_tree.lvl_wait = 0; vif_master_v_tree.id_wait = fsync_req.sync_barrier_id; vif_master_v_tree.wait_req = 1'b1; end
+        2'b10: begin vif_master_h_nbr.lvl_wait  = 1; vif_master_h_nbr.id_wait  = fsync_req.sync_barrier_id; vif_master_h_nbr.wait_req  = 1'b1; end
+        2'b11: begin vif_master_v_nbr.lvl_wait  = 1; vif_master_v_nbr.id_wait  = fsync_req.sync_barrier_id; vif_master_v_nbr.wait_req  = 1'b1; end
+        default: $fatal("Detected synchronization wait at level 1 with invalid barrier ID!!!");
+      endcase
+    end else if (fsync_req.sync_barrier_id[0] == 1'b0) begin
+      vif_master_h_tree.lvl_wait = fsync_req.sync_level-1;
+      vif_master_h_tree.id_wait  = fsync_req.sync_barrier_id;
+      vif_master_h_tree.wait_req = 1'b1;
+    end else begin
+      vif_master_v_tree.lvl_wait = fsync_req.sync_level-1;
+      vif_master_v_tree.id_wait  = fsync_req.sync_barrier_id;
+      vif_master_v_tree.wait_req = 1'b1;
+    end
+  endfunction: drive_wait
+
+  function automatic void clear_wait();
+    vif_master_h_tree.wait_req = 1'b0;
+    vif_master_v_tree.wait_req = 1'b0;
+    vif_master_h_nbr.wait_req  = 1'b0;
+    vif_master_v_nbr.wait_req  = 1'b0;
+  endfunction: clear_wait
+
+  // The outstanding-barrier table of the interface fsync is sent through can accept an arrive
+  function automatic bit sync_ready(sync_transaction fsync);
+    if (fsync.sync_level == 1) begin
+      case (fsync.sync_barrier_id)
+        2'b00:   return vif_master_h_tree.sync_ready;
+        2'b01:   return vif_master_v_tree.sync_ready;
+        2'b10:   return vif_master_h_nbr.sync_ready;
+        default: return vif_master_v_nbr.sync_ready;
+      endcase
+    end
+    return fsync.sync_barrier_id[0] ? vif_master_v_tree.sync_ready : vif_master_h_tree.sync_ready;
+  endfunction: sync_ready
+
+  // Wait (from a negedge) for the wake of the barrier of fsync_req on the interface it was sent through: the wake may
+  // have been latched while the CU was computing or arrive while waiting
+  task automatic sync_wait(input sync_transaction fsync_req, ref sync_transaction fsync_rsp, const ref logic clk);
+    bit          done_error;
+    int unsigned wake_cycles = 0;
+    if (hung) return;
+    drive_wait(fsync_req);
+    do begin
+      @(posedge clk);
+      if (++wake_cycles > WATCHDOG) begin
+        @(negedge clk);
+        clear_wait();
+        timeout("wake");
+        return;
+      end
+    end while (!(vif_master_h_tree.wait_req && vif_master_h_tree.done) && !(vif_master_v_tree.wait_req && vif_master_v_tree.done) &&
+               !(vif_master_h_nbr.wait_req && vif_master_h_nbr.done)   && !(vif_master_v_nbr.wait_req && vif_master_v_nbr.done));
+    fsync_rsp.transaction_time = $time;
+    fsync_rsp.set(fsync_req.sync_level, 0, fsync_req.sync_barrier_id);
+    done_error = vif_master_h_tree.done_error | vif_master_v_tree.done_error | vif_master_h_nbr.done_error | vif_master_v_nbr.done_error;
+    @(negedge clk);
+    clear_wait();
+    if (done_error) begin
+      $error("[ERROR] Detected synchronization error: wake with error");
+      detected_errors++;
+    end
+  endtask: sync_wait
+
+  // Split-phase synchronization: arrive, work_cycles of independent work overlapped with the barrier, wait
+  task automatic split_sync(input sync_transaction fsync_req, ref sync_transaction fsync_rsp, input int unsigned comp_cycles, input int unsigned work_cycles, input int unsigned max_rand_cycles, const ref logic clk);
+    if (fractal_dv_pkg::VERBOSE > 0) begin
+      $display("\nBFM instance [%s]: synchronization arrive", instance_name);
+      fsync_req.print();
+    end
+    hung = 1'b0;
+    sync_req(fsync_req, comp_cycles, max_rand_cycles, clk);
+    repeat (work_cycles) @(negedge clk);
+    sync_wait(fsync_req, fsync_rsp, clk);
+    if (hung) begin
+      transaction_times.push_back(0);
+      if (trace != null) trace.write(cu_id, fsync_req, fsync_req.transaction_time, 0, sync_trace::HUNG);
+      return;
+    end
+    transaction_times.push_back(fsync_rsp.transaction_time-fsync_req.transaction_time);
+    if (fractal_dv_pkg::VERBOSE > 1) begin
+      $display ("Synchronization transaction required %0tns (%0tns - %0tns)", transaction_times[transaction_times.size()-1], fsync_req.transaction_time, fsync_rsp.transaction_time);
+    end
+    if (trace != null) trace.write(cu_id, fsync_req, fsync_req.transaction_time, fsync_rsp.transaction_time, 0);
+  endtask: split_sync
+
+  // Pipelined split-phase synchronizations: arrive at every barrier (distinct barriers, in flight together also on the
+  // same interface), work_cycles of independent work, then wait for each barrier in order
+  task automatic multi_sync(input sync_transaction fsync_reqs[$], ref sync_transaction fsync_rsps[$], input int unsigned comp_cycles, input int unsigned work_cycles, input int unsigned max_rand_cycles, const ref logic clk);
+    hung = 1'b0;
+    foreach (fsync_reqs[k]) begin
+      if (hung) break;
+      if (fractal_dv_pkg::VERBOSE > 0) begin
+        $display("\nBFM instance [%s]: synchronization arrive", instance_name);
+        fsync_reqs[k].print();
+      end
+      sync_req(fsync_reqs[k], k ? 0 : comp_cycles, k ? 0 : max_rand_cycles, clk);
+    end
+    repeat (work_cycles) @(negedge clk);
+    foreach (fsync_reqs[k]) begin
+      sync_wait(fsync_reqs[k], fsync_rsps[k], clk);
+      if (hung) begin
+        transaction_times.push_back(0);
+        if (trace != null) trace.write(cu_id, fsync_reqs[k], fsync_reqs[k].transaction_time, 0, sync_trace::HUNG);
+        continue;
+      end
+      transaction_times.push_back(fsync_rsps[k].transaction_time-fsync_reqs[k].transaction_time);
+      if (trace != null) trace.write(cu_id, fsync_reqs[k], fsync_reqs[k].transaction_time, fsync_rsps[k].transaction_time, 0);
+    end
+  endtask: multi_sync
+
+  // A synchronization has waited longer than WATCHDOG cycles for what: one error per synchronization
+  function automatic void timeout(string what);
+    if (hung) return;
+    $error("[ERROR] BFM instance [%s]: synchronization timeout, no %s in %0d cycles", instance_name, what, WATCHDOG);
+    detected_errors++;
+    hung = 1'b1;
+  endfunction: timeout
+
   function automatic int unsigned get_errors();
     return this.detected_errors;
   endfunction: get_errors
@@ -22,8 +22,11 @@
 package fractal_dv_pkg;
   
   localparam int unsigned VERBOSE = 0;
+
+  localparam int unsigned WATCHDOG = 100000; // Cycles a CU waits for a wake or a free split-phase line before it hangs
   
   `include "sync_transaction.sv"
+  `include "sync_trace.sv"
   `include "cu_bfm.sv"
 
 endpackage: fractal_dv_pkg
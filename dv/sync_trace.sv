@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Solderpad Hardware License, Version 0.51 
+ * (the "License"); you may not use this file except in compliance 
+ * with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: SHL-0.51
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization transaction trace: same binary format as sw/model/fractal_sync_trace.hpp
+ *
+ * Little-endian 32-bit words. Header: magic "FSTR", version, n_cu_y << 16 | n_cu_x, clock period (ns).
+ * One record per transaction, in wake order:
+ *   word 0: flags << 24 | level << 16 | CU (row-major index)
+ *   word 1: aggregate (without the level bit)
+ *   word 2: barrier id
+ *   word 3: issue cycle (rising edge sampling the request)
+ *   word 4: wake cycle (rising edge sampling the wake, 0 if the CU hung)
+ */
+
+import fractal_dv_pkg::*;
+
+class sync_trace;
+
+  localparam bit[31:0]    MAGIC   = 32'h52545346; // "FSTR"
+  localparam bit[31:0]    VERSION = 1;
+  localparam int unsigned ERROR   = 'h1;          // wake did not match the request
+  localparam int unsigned HUNG    = 'h2;          // no wake before the end of the simulation
+
+  int          fd;
+  int unsigned n_cu_x;
+  int unsigned n_cu_y;
+  int unsigned clk_period;
+
+  function new();
+    this.fd = 0;
+  endfunction: new
+
+  function automatic void write_word(bit[31:0] word);
+    $fwrite(this.fd, "%c%c%c%c", word[7:0], word[15:8], word[23:16], word[31:24]);
+  endfunction: write_word
+
+  function automatic bit read_word(output bit[31:0] word);
+    for (int i = 0; i < 4; i++) begin
+      int c = $fgetc(this.fd);
+      if (c < 0) return 1'b0;
+      word[8*i +: 8] = c[7:0];
+    end
+    return 1'b1;
+  endfunction: read_word
+
+  function automatic void open_write(string path, int unsigned n_cu_x, int unsigned n_cu_y, int unsigned clk_period);
+    this.fd = $fopen(path, "wb");
+    if (this.fd == 0) $fatal("Cannot write trace %s", path);
+    this.n_cu_x     = n_cu_x;
+    this.n_cu_y     = n_cu_y;
+    this.clk_period = clk_period;
+    write_word(MAGIC);
+    write_word(VERSION);
+    write_word((n_cu_y << 16) | n_cu_x);
+    write_word(clk_period);
+  endfunction: open_write
+
+  function automatic void open_read(string path);
+    bit[31:0] magic, version, size, period;
+    this.fd = $fopen(path, "rb");
+    if (this.fd == 0) $fatal("Cannot read trace %s", path);
+    if (!read_word(magic) || !read_word(version) || !read_word(size) || !read_word(period) || (magic != MAGIC) || (version != VERSION))
+      $fatal("Not a FractalSync trace (or unsupported version): %s", path);
+    this.n_cu_x     = size[15:0];
+    this.n_cu_y     = size[31:16];
+    this.clk_period = period;
+  endfunction: open_read
+
+  function automatic void write(int unsigned cu, sync_transaction fsync_req, time issue_time, time wake_time, int unsigned flags);
+    write_word((flags << 24) | (fsync_req.sync_level << 16) | cu);
+    write_word(fsync_req.sync_aggregate);
+    write_word(fsync_req.sync_barrier_id);
+    write_word(issue_time/this.clk_period);
+    write_word(wake_time/this.clk_period);
+  endfunction: write
+
+  function automatic bit read(output int unsigned cu, output sync_transaction fsync_req, output int unsigned issue, output int unsigned wake, output int unsigned flags);
+    bit[31:0] w[5];
+    if (!read_word(w[0])) return 1'b0;
+    for (int i = 1; i < 5; i++) if (!read_word(w[i])) $fatal("Truncated trace");
+    cu        = w[0][15:0];
+    flags     = w[0][31:24];
+    fsync_req = new();
+    fsync_req.set(w[0][23:16], w[1], w[2]);
+    issue     = w[3];
+    wake      = w[4];
+    return 1'b1;
+  endfunction: read
+
+  function automatic void close();
+    if (this.fd != 0) $fclose(this.fd);
+    this.fd = 0;
+  endfunction: close
+
+endclass: sync_trace
@@ -41,6 +41,16 @@ module tb_bfm
   parameter int unsigned MAX_COMP_CYCLES = 0;
   parameter int unsigned MAX_RAND_CYCLES = 0;
 
+  parameter int unsigned CLK_PERIOD = 10;
+
+  parameter bit          SPLIT_PHASE   = 1'b0; // Split-phase endpoints on the CU interfaces (+SPLIT_PHASE, +PIPELINE)
+  parameter int unsigned N_SP_BARRIERS = 4;    // Outstanding barriers of the split-phase endpoints
+
+  parameter bit          FLOW_CTRL  = 1'b0; // DUT credit-based flow control
+  parameter int unsigned FIFO_DEPTH = 0;    // DUT FIFO depth (0: sized on the link ratios)
+
+  parameter int ARBITER_TYPE = -1; // DUT arbiter type (fractal_sync_pkg::arb_e) of every node (-1: default types of the tree)
+
   // Testbench localparams - DO NOT CHANGE
   localparam int unsigned N_CU  = N_CU_Y*N_CU_X;
   localparam int unsigned N_LVL = $clog2(N_CU);
@@ -73,8 +83,14 @@ module tb_bfm
   sync_transaction sync_rsp[N_CU];
 
   int unsigned detected_errors;
+  int unsigned sp_errors = 0;
   time         sync_time;
 
+  int unsigned pipeline_work;
+
+  sync_trace   trace;      // +TRACE_OUT=<file>: record the transactions, +TRACE_IN=<file>: replay a trace
+  string       trace_path;
+
   ht_cu_fsync_req_t  ht_cu_fsync_req[N_CU][1]; // Single link CU-FSync interface
   ht_cu_fsync_rsp_t  ht_cu_fsync_rsp[N_CU][1]; // Single link CU-FSync interface
   vt_cu_fsync_req_t  vt_cu_fsync_req[N_CU][1]; // Single link CU-FSync interface
@@ -88,6 +104,27 @@ module tb_bfm
   v_root_fsync_req_t v_root_fsync_req[1][1]; // Single node, single link root node out interface
   v_root_fsync_rsp_t v_root_fsync_rsp[1][1]; // Single node, single link root node out interface
 
+  ht_cu_fsync_req_t     ht_cu_arrive[N_CU];   // CU side of the split-phase endpoints
+  ht_cu_fsync_rsp_t     ht_cu_wake[N_CU];
+  logic                 ht_cu_wait[N_CU];
+  ht_cu_fsync_rsp_sig_t ht_cu_wait_sig[N_CU];
+  ht_cu_fsync_rsp_t     ht_cu_done[N_CU];
+  vt_cu_fsync_req_t     vt_cu_arrive[N_CU];
+  vt_cu_fsync_rsp_t     vt_cu_wake[N_CU];
+  logic                 vt_cu_wait[N_CU];
+  vt_cu_fsync_rsp_sig_t vt_cu_wait_sig[N_CU];
+  vt_cu_fsync_rsp_t     vt_cu_done[N_CU];
+  hn_cu_fsync_req_t     hn_cu_arrive[N_CU];
+  hn_cu_fsync_rsp_t     hn_cu_wake[N_CU];
+  logic                 hn_cu_wait[N_CU];
+  hn_cu_fsync_rsp_sig_t hn_cu_wait_sig[N_CU];
+  hn_cu_fsync_rsp_t     hn_cu_done[N_CU];
+  vn_cu_fsync_req_t     vn_cu_arrive[N_CU];
+  vn_cu_fsync_rsp_t     vn_cu_wake[N_CU];
+  logic                 vn_cu_wait[N_CU];
+  vn_cu_fsync_rsp_sig_t vn_cu_wait_sig[N_CU];
+  vn_cu_fsync_rsp_t     vn_cu_done[N_CU];
+
   // CU-FractalSync network interfaces
   fractal_sync_if #(.AGGR_WIDTH(CU_AGGR_W),  .LVL_WIDTH(CU_LVL_W),  .ID_WIDTH(CU_ID_W))  if_cu_h_tree[N_CU]();
   fractal_sync_if #(.AGGR_WIDTH(CU_AGGR_W),  .LVL_WIDTH(CU_LVL_W),  .ID_WIDTH(CU_ID_W))  if_cu_v_tree[N_CU]();
@@ -96,14 +133,138 @@ module tb_bfm
 
   // Interface - Req/Rsp conversion
   for (genvar i = 0; i < N_CU; i++) begin
-    `FSYNC_ASSIGN_I2S_REQ(if_cu_h_tree[i],       ht_cu_fsync_req[i][0])
-    `FSYNC_ASSIGN_S2I_RSP(ht_cu_fsync_rsp[i][0], if_cu_h_tree[i])
-    `FSYNC_ASSIGN_I2S_REQ(if_cu_v_tree[i],       vt_cu_fsync_req[i][0])
-    `FSYNC_ASSIGN_S2I_RSP(vt_cu_fsync_rsp[i][0], if_cu_v_tree[i])
-    `FSYNC_ASSIGN_I2S_REQ(if_cu_h_nbr[i],        hn_cu_fsync_req[i])
-    `FSYNC_ASSIGN_S2I_RSP(hn_cu_fsync_rsp[i],    if_cu_h_nbr[i])
-    `FSYNC_ASSIGN_I2S_REQ(if_cu_v_nbr[i],        vn_cu_fsync_req[i])
-    `FSYNC_ASSIGN_S2I_RSP(vn_cu_fsync_rsp[i],    if_cu_v_nbr[i])
+    `FSYNC_ASSIGN_I2S_REQ(if_cu_h_tree[i],  ht_cu_arrive[i])
+    `FSYNC_ASSIGN_I2S_WAIT(if_cu_h_tree[i], ht_cu_wait[i], ht_cu_wait_sig[i])
+    `FSYNC_ASSIGN_S2I_RSP(ht_cu_wake[i],    if_cu_h_tree[i])
+    `FSYNC_ASSIGN_S2I_DONE(ht_cu_done[i],   if_cu_h_tree[i])
+    `FSYNC_ASSIGN_I2S_REQ(if_cu_v_tree[i],  vt_cu_arrive[i])
+    `FSYNC_ASSIGN_I2S_WAIT(if_cu_v_tree[i], vt_cu_wait[i], vt_cu_wait_sig[i])
+    `FSYNC_ASSIGN_S2I_RSP(vt_cu_wake[i],    if_cu_v_tree[i])
+    `FSYNC_ASSIGN_S2I_DONE(vt_cu_done[i],   if_cu_v_tree[i])
+    `FSYNC_ASSIGN_I2S_REQ(if_cu_h_nbr[i],   hn_cu_arrive[i])
+    `FSYNC_ASSIGN_I2S_WAIT(if_cu_h_nbr[i],  hn_cu_wait[i], hn_cu_wait_sig[i])
+    `FSYNC_ASSIGN_S2I_RSP(hn_cu_wake[i],    if_cu_h_nbr[i])
+    `FSYNC_ASSIGN_S2I_DONE(hn_cu_done[i],   if_cu_h_nbr[i])
+    `FSYNC_ASSIGN_I2S_REQ(if_cu_v_nbr[i],   vn_cu_arrive[i])
+    `FSYNC_ASSIGN_I2S_WAIT(if_cu_v_nbr[i],  vn_cu_wait[i], vn_cu_wait_sig[i])
+    `FSYNC_ASSIGN_S2I_RSP(vn_cu_wake[i],    if_cu_v_nbr[i])
+    `FSYNC_ASSIGN_S2I_DONE(vn_cu_done[i],   if_cu_v_nbr[i])
+  end
+
+  // Split-phase endpoints: outstanding barriers of every CU interface, wakes latched until the CUs wait for them.
+  // Rejected arrives and dropped wakes would leave a CU waiting for a wake that never comes: they are errors
+  if (SPLIT_PHASE) begin: gen_sp
+    for (genvar i = 0; i < N_CU; i++) begin: gen_cu_sp
+      logic[3:0] reject, overflow; // h-tree, v-tree, h-nbr, v-nbr endpoints
+
+      fractal_sync_sp #(
+        .N_BARRIERS      ( N_SP_BARRIERS         ),
+        .LVL_OFFSET      ( 0                     ),
+        .fsync_req_t     ( ht_cu_fsync_req_t     ),
+        .fsync_rsp_t     ( ht_cu_fsync_rsp_t     ),
+        .fsync_rsp_sig_t ( ht_cu_fsync_rsp_sig_t )
+      ) i_ht_sp (
+        .clk_i      ( clk                        ),
+        .rst_ni     ( rstn                       ),
+        .arrive_i   ( ht_cu_arrive[i]            ),
+        .ready_o    ( if_cu_h_tree[i].sync_ready ),
+        .reject_o   ( reject[0]                  ),
+        .wait_i     ( ht_cu_wait[i]              ),
+        .wait_sig_i ( ht_cu_wait_sig[i]          ),
+        .done_o     ( ht_cu_done[i]              ),
+        .rsp_o      ( ht_cu_wake[i]              ),
+        .overflow_o ( overflow[0]                ),
+        .req_o      ( ht_cu_fsync_req[i][0]      ),
+        .rsp_i      ( ht_cu_fsync_rsp[i][0]      )
+      );
+      fractal_sync_sp #(
+        .N_BARRIERS      ( N_SP_BARRIERS         ),
+        .LVL_OFFSET      ( 0                     ),
+        .fsync_req_t     ( vt_cu_fsync_req_t     ),
+        .fsync_rsp_t     ( vt_cu_fsync_rsp_t     ),
+        .fsync_rsp_sig_t ( vt_cu_fsync_rsp_sig_t )
+      ) i_vt_sp (
+        .clk_i      ( clk                        ),
+        .rst_ni     ( rstn                       ),
+        .arrive_i   ( vt_cu_arrive[i]            ),
+        .ready_o    ( if_cu_v_tree[i].sync_ready ),
+        .reject_o   ( reject[1]                  ),
+        .wait_i     ( vt_cu_wait[i]              ),
+        .wait_sig_i ( vt_cu_wait_sig[i]          ),
+        .done_o     ( vt_cu_done[i]              ),
+        .rsp_o      ( vt_cu_wake[i]              ),
+        .overflow_o ( overflow[1]                ),
+        .req_o      ( vt_cu_fsync_req[i][0]      ),
+        .rsp_i      ( vt_cu_fsync_rsp[i][0]      )
+      );
+      fractal_sync_sp #(
+        .N_BARRIERS      ( N_SP_BARRIERS         ),
+        .LVL_OFFSET      ( 1                     ),
+        .fsync_req_t     ( hn_cu_fsync_req_t     ),
+        .fsync_rsp_t     ( hn_cu_fsync_rsp_t     ),
+        .fsync_rsp_sig_t ( hn_cu_fsync_rsp_sig_t )
+      ) i_hn_sp (
+        .clk_i      ( clk                       ),
+        .rst_ni     ( rstn                      ),
+        .arrive_i   ( hn_cu_arrive[i]           ),
+        .ready_o    ( if_cu_h_nbr[i].sync_ready ),
+        .reject_o   ( reject[2]                 ),
+        .wait_i     ( hn_cu_wait[i]             ),
+        .wait_sig_i ( hn_cu_wait_sig[i]         ),
+        .done_o     ( hn_cu_done[i]             ),
+        .rsp_o      ( hn_cu_wake[i]             ),
+        .overflow_o ( overflow[2]               ),
+        .req_o      ( hn_cu_fsync_req[i]        ),
+        .rsp_i      ( hn_cu_fsync_rsp[i]        )
+      );
+      fractal_sync_sp #(
+        .N_BARRIERS      ( N_SP_BARRIERS         ),
+        .LVL_OFFSET      ( 1                     ),
+        .fsync_req_t     ( vn_cu_fsync_req_t     ),
+        .fsync_rsp_t     ( vn_cu_fsync_rsp_t     ),
+        .fsync_rsp_sig_t ( vn_cu_fsync_rsp_sig_t )
+      ) i_vn_sp (
+        .clk_i      ( clk                       ),
+        .rst_ni     ( rstn                      ),
+        .arrive_i   ( vn_cu_arrive[i]           ),
+        .ready_o    ( if_cu_v_nbr[i].sync_ready ),
+        .reject_o   ( reject[3]                 ),
+        .wait_i     ( vn_cu_wait[i]             ),
+        .wait_sig_i ( vn_cu_wait_sig[i]         ),
+        .done_o     ( vn_cu_done[i]             ),
+        .rsp_o      ( vn_cu_wake[i]             ),
+        .overflow_o ( overflow[3]               ),
+        .req_o      ( vn_cu_fsync_req[i]        ),
+        .rsp_i      ( vn_cu_fsync_rsp[i]        )
+      );
+
+      always @(posedge clk) begin
+        if (rstn && ((|reject) || (|overflow))) begin
+          $error("[ERROR] Split-phase endpoints of CU %0d: rejected arrive (%b), dropped wake (%b)", i, reject, overflow);
+          sp_errors++;
+        end
+      end
+    end
+  end else begin: gen_no_sp
+    // Blocking synchronizations only: CU interfaces straight to the network
+    for (genvar i = 0; i < N_CU; i++) begin: gen_cu
+      assign ht_cu_fsync_req[i][0]      = ht_cu_arrive[i];
+      assign ht_cu_wake[i]              = ht_cu_fsync_rsp[i][0];
+      assign ht_cu_done[i]              = '{wake: 1'b0, sig: '0, error: 1'b0, credit: 1'b1};
+      assign if_cu_h_tree[i].sync_ready = 1'b1;
+      assign vt_cu_fsync_req[i][0]      = vt_cu_arrive[i];
+      assign vt_cu_wake[i]              = vt_cu_fsync_rsp[i][0];
+      assign vt_cu_done[i]              = '{wake: 1'b0, sig: '0, error: 1'b0, credit: 1'b1};
+      assign if_cu_v_tree[i].sync_ready = 1'b1;
+      assign hn_cu_fsync_req[i]         = hn_cu_arrive[i];
+      assign hn_cu_wake[i]              = hn_cu_fsync_rsp[i];
+      assign hn_cu_done[i]              = '{wake: 1'b0, sig: '0, error: 1'b0, credit: 1'b1};
+      assign if_cu_h_nbr[i].sync_ready  = 1'b1;
+      assign vn_cu_fsync_req[i]         = vn_cu_arrive[i];
+      assign vn_cu_wake[i]              = vn_cu_fsync_rsp[i];
+      assign vn_cu_done[i]              = '{wake: 1'b0, sig: '0, error: 1'b0, credit: 1'b1};
+      assign if_cu_v_nbr[i].sync_ready  = 1'b1;
+    end
   end
 
   // Hardwired synchronization tree root signals
@@ -111,10 +272,12 @@ module tb_bfm
   assign h_root_fsync_rsp[0][0].sig.lvl = '0;
   assign h_root_fsync_rsp[0][0].sig.id  = '0;
   assign h_root_fsync_rsp[0][0].error   = 1'b0;
+  assign h_root_fsync_rsp[0][0].credit  = 1'b1;
   assign v_root_fsync_rsp[0][0].wake    = 1'b0;
   assign v_root_fsync_rsp[0][0].sig.lvl = '0;
   assign v_root_fsync_rsp[0][0].sig.id  = '0;
   assign v_root_fsync_rsp[0][0].error   = 1'b0;
+  assign v_root_fsync_rsp[0][0].credit  = 1'b1;
 
   // BFMs of CUs
   cu_bfm #(.FSYNC_TREE_AGGR_WIDTH(CU_AGGR_W), .FSYNC_TREE_LVL_WIDTH(CU_LVL_W), .FSYNC_TREE_ID_WIDTH(CU_ID_W),
@@ -150,25 +313,102 @@ module tb_bfm
   endfunction: get_sync_time
 
   function automatic void get_errors();
-    detected_errors = 0;
+    detected_errors = sp_errors;
     for (int i = 0; i < N_CU; i++) detected_errors += cu_bfms[i].get_errors();
   endfunction: get_errors
 
+  // +SPLIT_PHASE=<work cycles>: split-phase synchronizations, with the given independent work between arrive and wait
   task automatic run_test();
+    int unsigned work_cycles;
+    bit          split = $value$plusargs("SPLIT_PHASE=%d", work_cycles);
     fork begin
       for (int i = 0; i < N_CU; i++) begin
         fork
           automatic int j = i;
-          cu_bfms[j].sync(sync_req[j], sync_rsp[j], comp_cycles[j], max_rand_cycles[j], clk);
+          if (split) cu_bfms[j].split_sync(sync_req[j], sync_rsp[j], comp_cycles[j], work_cycles, max_rand_cycles[j], clk);
+          else       cu_bfms[j].sync(sync_req[j], sync_rsp[j], comp_cycles[j], max_rand_cycles[j], clk);
         join_none
       end
       wait fork;
     end join
   endtask: run_test
   
+  // +PIPELINE=<work cycles>: every CU keeps a neighbor, a row and a column barrier in flight together (the neighbor and
+  // the row barriers on the same h-tree interface), then waits for them in order
+  task automatic pipeline_test(int unsigned work_cycles);
+    sync_transaction reqs[N_CU][$];
+    sync_transaction rsps[N_CU][$];
+    for (int t = 0; t < 3; t++) begin
+      if (t == 0) nbr_h_sync();
+      if (t == 1) row_sync();
+      if (t == 2) col_sync();
+      for (int i = 0; i < N_CU; i++) begin
+        reqs[i].push_back(sync_req[i]);
+        rsps[i].push_back(sync_rsp[i]);
+      end
+    end
+    fork begin
+      for (int i = 0; i < N_CU; i++) begin
+        fork
+          automatic int j = i;
+          cu_bfms[j].multi_sync(reqs[j], rsps[j], comp_cycles[j], work_cycles, max_rand_cycles[j], clk);
+        join_none
+      end
+      wait fork;
+    end join
+  endtask: pipeline_test
+
+  // Replay the transactions of a trace: each CU issues its requests in order, keeping the recorded skew of its first
+  // request and the recorded computation gaps between the wake of a request and the issue of the next one. Requests
+  // recorded without a wake (hung CU) are issued, so that their barriers see the same arrivals, but not waited for
+  task automatic replay_test(sync_trace trace);
+    sync_transaction replay_req[N_CU][$];
+    int unsigned     replay_comp[N_CU][$];
+    bit              replay_hung[N_CU][$];
+    int unsigned     prev_wake[N_CU];
+    int unsigned     min_issue = '1;
+    sync_transaction fsync_req;
+    int unsigned     cu, issue, wake, flags;
+    int unsigned     n_records = 0;
+
+    if ((trace.n_cu_x != N_CU_X) || (trace.n_cu_y != N_CU_Y)) $fatal("Trace recorded on a %0dx%0d mesh", trace.n_cu_x, trace.n_cu_y);
+    if (trace.clk_period != CLK_PERIOD) $warning("Trace clock period %0dns, replayed at %0dns", trace.clk_period, CLK_PERIOD);
+    while (trace.read(cu, fsync_req, issue, wake, flags)) begin
+      if (cu >= N_CU) $fatal("Trace transaction of CU %0d not valid for the DUT", cu);
+      fsync_req.set_uid();
+      if (replay_req[cu].size() == 0) replay_comp[cu].push_back(issue);
+      else                            replay_comp[cu].push_back((issue > prev_wake[cu]+1) ? issue-prev_wake[cu]-1 : 0);
+      replay_req[cu].push_back(fsync_req);
+      replay_hung[cu].push_back((flags & sync_trace::HUNG) != 0);
+      prev_wake[cu] = wake;
+      if (issue < min_issue) min_issue = issue;
+      n_records++;
+    end
+    for (int i = 0; i < N_CU; i++)
+      if (replay_comp[i].size() > 0) replay_comp[i][0] -= min_issue;
+    $display("\n  --> STARTED REPLAY: %0d transactions", n_records);
+
+    fork begin
+      for (int i = 0; i < N_CU; i++) begin
+        fork
+          automatic int j = i;
+          for (int k = 0; k < replay_req[j].size(); k++) begin
+            if (replay_hung[j][k]) begin
+              cu_bfms[j].sync_req(replay_req[j][k], replay_comp[j][k], 0, clk);
+              break;
+            end
+            sync_rsp[j] = new();
+            cu_bfms[j].sync(replay_req[j][k], sync_rsp[j], replay_comp[j][k], 0, clk);
+          end
+        join_none
+      end
+      wait fork;
+    end join
+  endtask: replay_test
+
   // Clock
   always begin
-    #5 clk = ~clk;
+    #(CLK_PERIOD/2) clk = ~clk;
   end
 
   // Reset and clock init
@@ -184,7 +424,12 @@ module tb_bfm
 
   // DUT
   if ((N_CU_Y == 2) && (N_CU_X == 2)) begin: gen_dut_2x2
-    fractal_sync_2x2 i_sync_network_dut (
+    fractal_sync_2x2 #(
+      .ARBITER_TYPE_1D ( (ARBITER_TYPE < 0) ? fractal_sync_2x2_pkg::ARBITER_TYPE_1D : fractal_sync_pkg::arb_e'(ARBITER_TYPE) ),
+      .ARBITER_TYPE_2D ( (ARBITER_TYPE < 0) ? fractal_sync_2x2_pkg::ARBITER_TYPE_2D : fractal_sync_pkg::arb_e'(ARBITER_TYPE) ),
+      .FLOW_CTRL       ( FLOW_CTRL  ),
+      .FIFO_DEPTH      ( FIFO_DEPTH )
+    ) i_sync_network_dut (
       .clk_i             ( clk              ),
       .rst_ni            ( rstn             ),
       .h_1d_fsync_req_i  ( ht_cu_fsync_req  ),
@@ -201,7 +446,12 @@ module tb_bfm
       .v_2d_fsync_rsp_i  ( v_root_fsync_rsp )
     );
   end else if ((N_CU_Y == 4) && (N_CU_X == 4)) begin: gen_dut_4x4
-    fractal_sync_4x4 i_sync_network_dut (
+    fractal_sync_4x4 #(
+      .ARBITER_TYPE_1D ( (ARBITER_TYPE < 0) ? fractal_sync_4x4_pkg::ARBITER_TYPE_1D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .ARBITER_TYPE_2D ( (ARBITER_TYPE < 0) ? fractal_sync_4x4_pkg::ARBITER_TYPE_2D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .FLOW_CTRL       ( FLOW_CTRL  ),
+      .FIFO_DEPTH      ( FIFO_DEPTH )
+    ) i_sync_network_dut (
       .clk_i             ( clk              ),
       .rst_ni            ( rstn             ),
       .h_1d_fsync_req_i  ( ht_cu_fsync_req  ),
@@ -218,7 +468,12 @@ module tb_bfm
       .v_2d_fsync_rsp_i  ( v_root_fsync_rsp )
     );
   end else if ((N_CU_Y == 8) && (N_CU_X == 8)) begin: gen_dut_8x8
-    fractal_sync_8x8 i_sync_network_dut (
+    fractal_sync_8x8 #(
+      .ARBITER_TYPE_1D ( (ARBITER_TYPE < 0) ? fractal_sync_8x8_pkg::ARBITER_TYPE_1D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .ARBITER_TYPE_2D ( (ARBITER_TYPE < 0) ? fractal_sync_8x8_pkg::ARBITER_TYPE_2D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .FLOW_CTRL       ( FLOW_CTRL  ),
+      .FIFO_DEPTH      ( FIFO_DEPTH )
+    ) i_sync_network_dut (
       .clk_i             ( clk              ),
       .rst_ni            ( rstn             ),
       .h_1d_fsync_req_i  ( ht_cu_fsync_req  ),
@@ -235,7 +490,12 @@ module tb_bfm
       .v_2d_fsync_rsp_i  ( v_root_fsync_rsp )
     );
   end else if ((N_CU_Y == 16) && (N_CU_X == 16)) begin: gen_dut_16x16
-    fractal_sync_16x16 i_sync_network_dut (
+    fractal_sync_16x16 #(
+      .ARBITER_TYPE_1D ( (ARBITER_TYPE < 0) ? fractal_sync_16x16_pkg::ARBITER_TYPE_1D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .ARBITER_TYPE_2D ( (ARBITER_TYPE < 0) ? fractal_sync_16x16_pkg::ARBITER_TYPE_2D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .FLOW_CTRL       ( FLOW_CTRL  ),
+      .FIFO_DEPTH      ( FIFO_DEPTH )
+    ) i_sync_network_dut (
       .clk_i             ( clk              ),
       .rst_ni            ( rstn             ),
       .h_1d_fsync_req_i  ( ht_cu_fsync_req  ),
@@ -252,7 +512,56 @@ module tb_bfm
       .v_2d_fsync_rsp_i  ( v_root_fsync_rsp )
     );
   end else if ((N_CU_Y == 32) && (N_CU_X == 32)) begin: gen_dut_32x32
-    fractal_sync_32x32 i_sync_network_dut (
+    fractal_sync_32x32 #(
+      .ARBITER_TYPE_1D ( (ARBITER_TYPE < 0) ? fractal_sync_32x32_pkg::ARBITER_TYPE_1D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .ARBITER_TYPE_2D ( (ARBITER_TYPE < 0) ? fractal_sync_32x32_pkg::ARBITER_TYPE_2D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .FLOW_CTRL       ( FLOW_CTRL  ),
+      .FIFO_DEPTH      ( FIFO_DEPTH )
+    ) i_sync_network_dut (
+      .clk_i             ( clk              ),
+      .rst_ni            ( rstn             ),
+      .h_1d_fsync_req_i  ( ht_cu_fsync_req  ),
+      .h_1d_fsync_rsp_o  ( ht_cu_fsync_rsp  ),
+      .v_1d_fsync_req_i  ( vt_cu_fsync_req  ),
+      .v_1d_fsync_rsp_o  ( vt_cu_fsync_rsp  ),
+      .h_nbr_fsycn_req_i ( hn_cu_fsync_req  ),
+      .h_nbr_fsycn_rsp_o ( hn_cu_fsync_rsp  ),
+      .v_nbr_fsycn_req_i ( vn_cu_fsync_req  ),
+      .v_nbr_fsycn_rsp_o ( vn_cu_fsync_rsp  ),
+      .h_2d_fsync_req_o  ( h_root_fsync_req ),
+      .h_2d_fsync_rsp_i  ( h_root_fsync_rsp ),
+      .v_2d_fsync_req_o  ( v_root_fsync_req ),
+      .v_2d_fsync_rsp_i  ( v_root_fsync_rsp )
+    );
+  end else if ((N_CU_Y == 64) && (N_CU_X == 64)) begin: gen_dut_64x64
+    fractal_sync_64x64 #(
+      .ARBITER_TYPE_1D ( (ARBITER_TYPE < 0) ? fractal_sync_64x64_pkg::ARBITER_TYPE_1D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .ARBITER_TYPE_2D ( (ARBITER_TYPE < 0) ? fractal_sync_64x64_pkg::ARBITER_TYPE_2D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .FLOW_CTRL       ( FLOW_CTRL  ),
+      .FIFO_DEPTH      ( FIFO_DEPTH )
+    ) i_sync_network_dut (
+      .clk_i             ( clk              ),
+      .rst_ni            ( rstn             ),
+      .h_1d_fsync_req_i  ( ht_cu_fsync_req  ),
+      .h_1d_fsync_rsp_o  ( ht_cu_fsync_rsp  ),
+      .v_1d_fsync_req_i  ( vt_cu_fsync_req  ),
+      .v_1d_fsync_rsp_o  ( vt_cu_fsync_rsp  ),
+      .h_nbr_fsycn_req_i ( hn_cu_fsync_req  ),
+      .h_nbr_fsycn_rsp_o ( hn_cu_fsync_rsp  ),
+      .v_nbr_fsycn_req_i ( vn_cu_fsync_req  ),
+      .v_nbr_fsycn_rsp_o ( vn_cu_fsync_rsp  ),
+      .h_2d_fsync_req_o  ( h_root_fsync_req ),
+      .h_2d_fsync_rsp_i  ( h_root_fsync_rsp ),
+      .v_2d_fsync_req_o  ( v_root_fsync_req ),
+      .v_2d_fsync_rsp_i  ( v_root_fsync_rsp )
+    );
+  end else if ((N_CU_Y == 128) && (N_CU_X == 128)) begin: gen_dut_128x128
+    fractal_sync_128x128 #(
+      .ARBITER_TYPE_1D ( (ARBITER_TYPE < 0) ? fractal_sync_128x128_pkg::ARBITER_TYPE_1D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .ARBITER_TYPE_2D ( (ARBITER_TYPE < 0) ? fractal_sync_128x128_pkg::ARBITER_TYPE_2D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .FLOW_CTRL       ( FLOW_CTRL  ),
+      .FIFO_DEPTH      ( FIFO_DEPTH )
+    ) i_sync_network_dut (
       .clk_i             ( clk              ),
       .rst_ni            ( rstn             ),
       .h_1d_fsync_req_i  ( ht_cu_fsync_req  ),
@@ -422,10 +731,22 @@ module tb_bfm
   
   // Run test
   initial begin    
+    if (!SPLIT_PHASE && ($test$plusargs("SPLIT_PHASE") || $test$plusargs("PIPELINE")))
+      $fatal("+SPLIT_PHASE and +PIPELINE need the split-phase endpoints: -GSPLIT_PHASE=1");
+
     // Wait for reset
     repeat(10) @(negedge clk);
 
-    for (int t = 0; t < N_TESTS; t++) begin
+    trace = new();
+    if ($value$plusargs("TRACE_IN=%s", trace_path)) begin
+      trace.open_read(trace_path);
+      replay_test(trace);
+    end else if ($value$plusargs("TRACE_OUT=%s", trace_path)) begin
+      trace.open_write(trace_path, N_CU_X, N_CU_Y, CLK_PERIOD);
+      for (int i = 0; i < N_CU; i++) cu_bfms[i].set_trace(trace, i);
+    end
+
+    for (int t = 0; t < N_TESTS && !$test$plusargs("TRACE_IN"); t++) begin
       // Generate synchronization requests
       //same_rand_sync();
       //distinct_2x2_sync();
@@ -448,7 +769,14 @@ module tb_bfm
       get_sync_time(t);
       $display("\n  <-- ENDED TEST: synchronization time %0tns", sync_time);
     end
+    if ($value$plusargs("PIPELINE=%d", pipeline_work) && !$test$plusargs("TRACE_IN")) begin
+      $display("\n  --> STARTED TEST: %s", "pipeline");
+      set_req_timing();
+      pipeline_test(pipeline_work);
+      $display("\n  <-- ENDED TEST: pipeline");
+    end
     get_errors();
+    trace.close();
 
     repeat(4) @(negedge clk);
     
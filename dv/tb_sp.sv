@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Solderpad Hardware License, Version 0.51
+ * (the "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: SHL-0.51
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * TB for the FractalSync split-phase endpoint (same sequence as sw/tests/fractal_sync_model_sp_test.cpp): a full
+ * table rejects arrives (reject_o) and drops wakes without a pending line (overflow_o), every latched wake is consumed
+ * once by its wait, and an arrive at a barrier with a stale woken line reuses the line instead of letting the stale
+ * wake satisfy the next wait
+ */
+
+module tb_sp
+  import fractal_sync_pkg::*;
+#(
+)(
+);
+
+  `include "../hw/include/fractal_sync/typedef.svh"
+
+  // Testbench parameters
+  parameter int unsigned N_BARRIERS = 4;
+
+  parameter int unsigned CLK_PERIOD = 10;
+
+  // Testbench localparams - DO NOT CHANGE
+  localparam int unsigned AGGR_W = 4;
+  localparam int unsigned LVL_W  = 2;
+  localparam int unsigned ID_W   = 3;
+
+  // Testbench type definitions
+  `FSYNC_TYPEDEF_ALL(sp_fsync, logic[AGGR_W-1:0], logic[LVL_W-1:0], logic[ID_W-1:0])
+
+  // Testbench internal signals
+  logic clk, rstn;
+
+  sp_fsync_req_t     arrive;
+  logic              ready;
+  logic              reject;
+  logic              wait_req;
+  sp_fsync_rsp_sig_t wait_sig;
+  sp_fsync_rsp_t     done;
+  sp_fsync_rsp_t     wake;
+  logic              overflow;
+  sp_fsync_req_t     net_req;
+  sp_fsync_rsp_t     net_rsp;
+
+  int unsigned detected_errors = 0;
+
+  // DUT
+  fractal_sync_sp #(
+    .N_BARRIERS      ( N_BARRIERS         ),
+    .LVL_OFFSET      ( 0                  ),
+    .fsync_req_t     ( sp_fsync_req_t     ),
+    .fsync_rsp_t     ( sp_fsync_rsp_t     ),
+    .fsync_rsp_sig_t ( sp_fsync_rsp_sig_t )
+  ) i_sp_dut (
+    .clk_i      ( clk      ),
+    .rst_ni     ( rstn     ),
+    .arrive_i   ( arrive   ),
+    .ready_o    ( ready    ),
+    .reject_o   ( reject   ),
+    .wait_i     ( wait_req ),
+    .wait_sig_i ( wait_sig ),
+    .done_o     ( done     ),
+    .rsp_o      ( wake     ),
+    .overflow_o ( overflow ),
+    .req_o      ( net_req  ),
+    .rsp_i      ( net_rsp  )
+  );
+
+  // Clock
+  always begin
+    #(CLK_PERIOD/2) clk = ~clk;
+  end
+
+  // Testbench subroutines
+  // One cycle of the endpoint, driven from the negedge: optional arrive at (a_lvl, a_id), wake of (w_lvl, w_id) from the
+  // network and wait for (q_lvl, q_id); the combinational outputs are settled when the task returns
+  task automatic cycle(bit a, int unsigned a_lvl, int unsigned a_id, bit w, int unsigned w_lvl, int unsigned w_id, bit q, int unsigned q_lvl, int unsigned q_id);
+    @(negedge clk);
+    arrive.sync     = a;
+    arrive.sig.aggr = a ? (1 << a_lvl) : '0;
+    arrive.sig.id   = a_id;
+    arrive.credit   = 1'b1;
+    net_rsp.wake    = w;
+    net_rsp.sig.lvl = w_lvl;
+    net_rsp.sig.id  = w_id;
+    net_rsp.error   = 1'b0;
+    net_rsp.credit  = 1'b1;
+    wait_req        = q;
+    wait_sig.lvl    = q_lvl;
+    wait_sig.id     = q_id;
+    #1;
+  endtask: cycle
+
+  task automatic idle();
+    cycle(0, 0, 0, 0, 0, 0, 0, 0, 0);
+  endtask: idle
+
+  function automatic void check(bit cond, string what);
+    if (!cond) begin
+      $error("[ERROR] %s", what);
+      detected_errors++;
+    end
+  endfunction: check
+
+  // Run test
+  initial begin
+    clk = 1'b0;
+    rstn = 1'b0;
+    idle();
+    repeat(4) @(negedge clk);
+    rstn = 1'b1;
+    repeat(4) idle();
+
+    $display("\n  --> STARTED TEST: %s", "full table");
+    // Fill the table with pending barriers: the next arrive is rejected
+    for (int unsigned b = 0; b < N_BARRIERS; b++) begin
+      check(ready, "table full before N_BARRIERS arrives");
+      cycle(1, 2, b, 0, 0, 0, 0, 0, 0);
+      check(!reject && net_req.sync, "arrive with free lines rejected");
+    end
+    cycle(1, 2, N_BARRIERS, 0, 0, 0, 0, 0, 0);
+    check(!ready, "full table ready");
+    check(reject && !net_req.sync, "arrive with a full table accepted");
+    cycle(1, 2, 0, 0, 0, 0, 0, 0, 0);
+    check(reject && !net_req.sync, "arrive at a pending barrier accepted");
+
+    // Wake every pending barrier, then a barrier without a pending line: no free line, the wake is dropped and reported
+    for (int unsigned b = 0; b < N_BARRIERS; b++) begin
+      cycle(0, 0, 0, 1, 2, b, 0, 0, 0);
+      check(!overflow, "wake of a pending barrier dropped");
+    end
+    cycle(0, 0, 0, 1, 2, N_BARRIERS, 0, 0, 0);
+    check(overflow, "wake dropped by a full table not reported");
+
+    // Every latched wake satisfies one wait, in any order, and frees its line
+    for (int b = N_BARRIERS-1; b >= 0; b--) begin
+      cycle(0, 0, 0, 0, 0, 0, 1, 2, b);
+      check(done.wake, "latched wake not consumed by its wait");
+      cycle(0, 0, 0, 0, 0, 0, 1, 2, b);
+      check(!done.wake, "latched wake consumed twice");
+    end
+    idle();
+    check(ready, "lines not freed by the waits");
+    $display("\n  <-- ENDED TEST: full table");
+
+    $display("\n  --> STARTED TEST: %s", "stale wake");
+    // Stale wake: woken but never waited for, then the CU arrives again at the same barrier
+    cycle(1, 3, 1, 0, 0, 0, 0, 0, 0);
+    cycle(0, 0, 0, 1, 3, 1, 0, 0, 0);
+    cycle(1, 3, 1, 0, 0, 0, 0, 0, 0);
+    check(!reject && net_req.sync, "arrive at a barrier with a stale wake rejected");
+    // The reused line leaves N_BARRIERS-1 free lines
+    for (int unsigned b = 0; b < N_BARRIERS-1; b++) begin
+      cycle(1, 2, b, 0, 0, 0, 0, 0, 0);
+      check(!reject, "stale woken line not reused");
+    end
+    cycle(0, 0, 0, 0, 0, 0, 1, 3, 1);
+    check(!ready, "more free lines than expected");
+    check(!done.wake, "stale wake satisfied the wait of the new arrive");
+    cycle(0, 0, 0, 1, 3, 1, 1, 3, 1);
+    check(done.wake, "wake of the new arrive not consumed");
+    $display("\n  <-- ENDED TEST: stale wake");
+
+    repeat(4) idle();
+
+    $info("Test finished with %0d errors: %s", detected_errors, detected_errors ? "[FAIL]" : "[PASS]");
+
+    $stop;
+  end
+
+endmodule: tb_sp
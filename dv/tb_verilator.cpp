@@ -0,0 +1,280 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Verilator testbench: tb_bfm tests on the Verilated tb_verilator top (-std=c++20)
+ * The C++ model can be run in lockstep and its CU responses compared against the RTL every cycle.
+ * TB_FLOW_CTRL, TB_FIFO_DEPTH and TB_ARBITER_TYPE must match the -GFLOW_CTRL, -GFIFO_DEPTH and -GARBITER_TYPE of the
+ * Verilated top (model configuration).
+ * TB_SPLIT_PHASE and TB_SP_BARRIERS must match -GSPLIT_PHASE and -GN_SP_BARRIERS: as cu_bfm in tb_bfm, every CU holds
+ * the wait for the barrier of its last request, and the split-phase endpoints of the top are compared every cycle
+ * against model endpoints (ready_o, done_o, reject_o/overflow_o through sp_error_o).
+ *
+ * Usage: Vtb_verilator [MIN_COMP_CYCLES] [MAX_COMP_CYCLES] [MAX_RAND_CYCLES] [SEED] [LOCKSTEP] [STREAM_ITERATIONS]
+ */
+
+#include "Vtb_verilator.h"
+#include "verilated.h"
+
+#include "fractal_sync_bfm.hpp"
+#include "fractal_sync_model.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <vector>
+
+#ifndef TB_FLOW_CTRL
+#define TB_FLOW_CTRL (0)
+#endif
+#ifndef TB_FIFO_DEPTH
+#define TB_FIFO_DEPTH (0)
+#endif
+#ifndef TB_ARBITER_TYPE
+#define TB_ARBITER_TYPE (-1)
+#endif
+#ifndef TB_SPLIT_PHASE
+#define TB_SPLIT_PHASE (0)
+#endif
+#ifndef TB_SP_BARRIERS
+#define TB_SP_BARRIERS (4)
+#endif
+
+using namespace fractal_sync::model;
+
+/* Same interface as the C++ model for bfm_t */
+class vl_tree{
+public:
+  vl_tree(VerilatedContext &ctx, const unsigned int n_cu, const bool lockstep)
+    : top_(&ctx), n_cu_(n_cu), req_(4*n_cu, req_t{false, 0, 0, true}), rsp_(4*n_cu), wait_(4*n_cu), sp_(TB_SPLIT_PHASE ? 4*n_cu : 0) {
+    for (auto &sp : sp_) sp.init(TB_SP_BARRIERS);
+    if (lockstep){
+      unsigned int n_cu_x = 1;
+      while (n_cu_x*n_cu_x < n_cu) n_cu_x++;
+      config_t cfg   = preset(n_cu_x);
+      cfg.flow_ctrl  = TB_FLOW_CTRL;
+      cfg.fifo_depth = TB_FIFO_DEPTH;
+      if (TB_ARBITER_TYPE >= 0){
+        for (auto &arb : cfg.arbiter_type_1d) arb = static_cast<arb_e>(TB_ARBITER_TYPE);
+        for (auto &arb : cfg.arbiter_type_2d) arb = static_cast<arb_e>(TB_ARBITER_TYPE);
+      }
+      model_.emplace_back(cfg);
+    }
+    // Same reset as tb_bfm: 10 cycles
+    top_.clk_i  = 0;
+    top_.rst_ni = 0;
+    for (unsigned int i = 0; i < 10; i++){
+      drive();
+      top_.clk_i = 0;
+      top_.eval();
+      top_.clk_i = 1;
+      top_.eval();
+    }
+    top_.rst_ni = 1;
+  }
+
+  ~vl_tree(){ top_.final(); }
+
+  req_t &req(const unsigned int cu, const iface_e iface){ return req_[4*cu + static_cast<unsigned int>(iface)]; }
+  const rsp_t &rsp(const unsigned int cu, const iface_e iface) const { return rsp_[4*cu + static_cast<unsigned int>(iface)]; }
+
+  void eval(){
+    hold_wait();
+    drive();
+    top_.clk_i = 0;
+    top_.eval();
+    sample();
+    check_sp();
+    if (model_.empty()) return;
+
+    for (unsigned int cu = 0; cu < n_cu_; cu++)
+      for (unsigned int i = 0; i < 4; i++) model_[0].req(cu, static_cast<iface_e>(i)) = req(cu, static_cast<iface_e>(i));
+    model_[0].eval();
+    for (unsigned int cu = 0; cu < n_cu_; cu++){
+      for (unsigned int i = 0; i < 4; i++){
+        const rsp_t &r = rsp(cu, static_cast<iface_e>(i));
+        const rsp_t &m = model_[0].rsp(cu, static_cast<iface_e>(i));
+        if (r.wake == m.wake && (!r.wake || (r.lvl == m.lvl && r.id == m.id && r.error == m.error))) continue;
+        std::printf("[ERROR] Model mismatch at cycle %llu (CU %u, interface %u): RTL wake=%u lvl=%u id=%u, model wake=%u lvl=%u id=%u\n",
+                    static_cast<unsigned long long>(cycle_), cu, i, r.wake, r.lvl, r.id, m.wake, m.lvl, m.id);
+        mismatches_++;
+      }
+    }
+  }
+
+  void tick(){
+    top_.clk_i = 1;
+    top_.eval();
+    for (auto &sp : sp_) sp.commit();
+    if (!model_.empty()) model_[0].tick();
+    cycle_++;
+  }
+
+  unsigned int mismatches() const { return mismatches_; }
+
+private:
+  struct wait_t{
+    bool         wait;
+    unsigned int lvl;
+    unsigned int id;
+  };
+
+  /* Level of the wake of a request: highest aggregate bit (level-1) on the trees, 1 on the neighbor interfaces */
+  static unsigned int barrier_lvl(const req_t &r, const iface_e iface){
+    unsigned int lvl = 0;
+    while (r.aggr >> (lvl+1)) lvl++;
+    return (iface == iface_e::h_tree || iface == iface_e::v_tree) ? lvl : lvl+1;
+  }
+
+  /* Same as cu_bfm drive_wait: the wait for the barrier of a request is held until the next one (the other interfaces
+   * of the CU stop waiting) */
+  void hold_wait(){
+    for (unsigned int cu = 0; cu < n_cu_; cu++)
+      for (unsigned int i = 0; i < 4; i++){
+        const req_t &r = req(cu, static_cast<iface_e>(i));
+        if (!r.sync) continue;
+        for (unsigned int j = 0; j < 4; j++) wait_[4*cu + j].wait = false;
+        wait_[4*cu + i] = wait_t{true, barrier_lvl(r, static_cast<iface_e>(i)), r.id};
+      }
+  }
+
+  /* Split-phase endpoints of the top against the model endpoints, fed with the same arrives, wakes and waits */
+  void check_sp(){
+    for (unsigned int cu = 0; cu < n_cu_; cu++){
+      const bool ready[4] = {top_.h_tree_ready_o[cu] != 0, top_.v_tree_ready_o[cu] != 0, top_.h_nbr_ready_o[cu] != 0, top_.v_nbr_ready_o[cu] != 0};
+      const bool done[4]  = {top_.h_tree_done_o[cu] != 0, top_.v_tree_done_o[cu] != 0, top_.h_nbr_done_o[cu] != 0, top_.v_nbr_done_o[cu] != 0};
+      bool       sp_error = false;
+      for (unsigned int i = 0; i < 4; i++){
+        const req_t  &r = req(cu, static_cast<iface_e>(i));
+        const wait_t &w = wait_[4*cu + i];
+        if (sp_.empty()){
+          if (!ready[i] || done[i]){
+            std::printf("[ERROR] Split-phase output without endpoints at cycle %llu (CU %u, interface %u): ready=%u done=%u\n",
+                        static_cast<unsigned long long>(cycle_), cu, i, ready[i], done[i]);
+            mismatches_++;
+          }
+          continue;
+        }
+        split_phase &sp = sp_[4*cu + i];
+        const bool   m_ready = sp.ready();
+        if (r.sync) sp.arrive(barrier_lvl(r, static_cast<iface_e>(i)), r.id);
+        const bool m_done = sp.eval(rsp(cu, static_cast<iface_e>(i)), w.wait, w.lvl, w.id);
+        sp_error |= (r.sync && !sp.accepted()) || sp.overflow();
+        if (ready[i] == m_ready && done[i] == m_done) continue;
+        std::printf("[ERROR] Split-phase mismatch at cycle %llu (CU %u, interface %u): RTL ready=%u done=%u, model ready=%u done=%u\n",
+                    static_cast<unsigned long long>(cycle_), cu, i, ready[i], done[i], m_ready, m_done);
+        mismatches_++;
+      }
+      if ((top_.sp_error_o[cu] != 0) != sp_error){
+        std::printf("[ERROR] Split-phase error mismatch at cycle %llu (CU %u): RTL %u, model %u\n",
+                    static_cast<unsigned long long>(cycle_), cu, top_.sp_error_o[cu], sp_error);
+        mismatches_++;
+      }
+      if (sp_error){
+        std::printf("[ERROR] Split-phase endpoint of CU %u rejected an arrive or dropped a wake at cycle %llu\n",
+                    cu, static_cast<unsigned long long>(cycle_));
+        mismatches_++;
+      }
+    }
+  }
+
+  void drive(){
+    for (unsigned int i = 0; i < n_cu_; i++){
+      const req_t &ht = req(i, iface_e::h_tree);
+      const req_t &vt = req(i, iface_e::v_tree);
+      const req_t &hn = req(i, iface_e::h_nbr);
+      const req_t &vn = req(i, iface_e::v_nbr);
+      top_.h_tree_sync_i[i] = ht.sync; top_.h_tree_aggr_i[i] = ht.aggr; top_.h_tree_id_i[i] = ht.id;
+      top_.v_tree_sync_i[i] = vt.sync; top_.v_tree_aggr_i[i] = vt.aggr; top_.v_tree_id_i[i] = vt.id;
+      top_.h_nbr_sync_i[i]  = hn.sync; top_.h_nbr_aggr_i[i]  = hn.aggr; top_.h_nbr_id_i[i]  = hn.id;
+      top_.v_nbr_sync_i[i]  = vn.sync; top_.v_nbr_aggr_i[i]  = vn.aggr; top_.v_nbr_id_i[i]  = vn.id;
+      const wait_t &htw = wait_[4*i + static_cast<unsigned int>(iface_e::h_tree)];
+      const wait_t &vtw = wait_[4*i + static_cast<unsigned int>(iface_e::v_tree)];
+      const wait_t &hnw = wait_[4*i + static_cast<unsigned int>(iface_e::h_nbr)];
+      const wait_t &vnw = wait_[4*i + static_cast<unsigned int>(iface_e::v_nbr)];
+      top_.h_tree_wait_i[i] = htw.wait; top_.h_tree_lvl_wait_i[i] = htw.lvl; top_.h_tree_id_wait_i[i] = htw.id;
+      top_.v_tree_wait_i[i] = vtw.wait; top_.v_tree_lvl_wait_i[i] = vtw.lvl; top_.v_tree_id_wait_i[i] = vtw.id;
+      top_.h_nbr_wait_i[i]  = hnw.wait; top_.h_nbr_lvl_wait_i[i]  = hnw.lvl; top_.h_nbr_id_wait_i[i]  = hnw.id;
+      top_.v_nbr_wait_i[i]  = vnw.wait; top_.v_nbr_lvl_wait_i[i]  = vnw.lvl; top_.v_nbr_id_wait_i[i]  = vnw.id;
+    }
+  }
+
+  void sample(){
+    for (unsigned int i = 0; i < n_cu_; i++){
+      rsp_out(i, iface_e::h_tree) = rsp_t{top_.h_tree_wake_o[i] != 0, top_.h_tree_lvl_o[i], top_.h_tree_id_o[i], top_.h_tree_error_o[i] != 0, false};
+      rsp_out(i, iface_e::v_tree) = rsp_t{top_.v_tree_wake_o[i] != 0, top_.v_tree_lvl_o[i], top_.v_tree_id_o[i], top_.v_tree_error_o[i] != 0, false};
+      rsp_out(i, iface_e::h_nbr)  = rsp_t{top_.h_nbr_wake_o[i]  != 0, top_.h_nbr_lvl_o[i],  top_.h_nbr_id_o[i],  top_.h_nbr_error_o[i]  != 0, false};
+      rsp_out(i, iface_e::v_nbr)  = rsp_t{top_.v_nbr_wake_o[i]  != 0, top_.v_nbr_lvl_o[i],  top_.v_nbr_id_o[i],  top_.v_nbr_error_o[i]  != 0, false};
+    }
+  }
+
+  rsp_t &rsp_out(const unsigned int cu, const iface_e iface){ return rsp_[4*cu + static_cast<unsigned int>(iface)]; }
+
+  Vtb_verilator        top_;
+  unsigned int         n_cu_;
+  std::vector<req_t>   req_;
+  std::vector<rsp_t>   rsp_;
+  std::vector<wait_t>  wait_;
+  std::vector<split_phase> sp_; // Model endpoints (TB_SPLIT_PHASE)
+  std::deque<network>  model_; // deque: the model is not relocatable
+  unsigned long long   cycle_      = 0;
+  unsigned int         mismatches_ = 0;
+};
+
+int main(int argc, char *argv[]){
+  VerilatedContext ctx;
+  ctx.commandArgs(argc, argv);
+
+  const unsigned int min_comp = (argc > 1) ? std::atoi(argv[1]) : 0;
+  const unsigned int max_comp = (argc > 2) ? std::atoi(argv[2]) : min_comp;
+  const unsigned int max_rand = (argc > 3) ? std::atoi(argv[3]) : 0;
+  const unsigned int seed     = (argc > 4) ? std::atoi(argv[4]) : 1;
+  const bool         lockstep = (argc > 5) ? std::atoi(argv[5]) != 0 : false;
+  const unsigned int n_stream = (argc > 6) ? std::atoi(argv[6]) : 0;
+
+  try {
+    const unsigned int n_cu_x = TB_N_CU_X;
+    vl_tree            dut(ctx, n_cu_x*n_cu_x, lockstep);
+    bfm_t<vl_tree>     bfm(dut, n_cu_x*n_cu_x, min_comp, max_comp, max_rand, seed);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int t = 0; t < n_bfm_tests; t++){
+      std::printf("\n  --> STARTED TEST: %s\n", bfm_test_name(t));
+      const auto latency = bfm.run(bfm_test(t, n_cu_x));
+      std::printf("\n  <-- ENDED TEST: synchronization time %lluns\n", static_cast<unsigned long long>(*std::max_element(latency.begin(), latency.end())));
+      if (bfm.hung()) break;
+    }
+    for (unsigned int t = 0; n_stream && !bfm.hung() && t < n_bfm_tests; t++){
+      const stream_t res = bfm.stream(bfm_test(t, n_cu_x), n_stream, n_stream/4);
+      std::printf("\n  <-> STREAM %s: %llu barriers in %llu cycles, steady state %.4f rounds/cycle (%.4f barriers/cycle)\n", bfm_test_name(t),
+                  static_cast<unsigned long long>(res.wakes), static_cast<unsigned long long>(res.cycles), res.rounds_per_cycle(),
+                  res.rounds_per_cycle()*bfm_test_groups(t, n_cu_x));
+    }
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const unsigned int errors = bfm.errors() + dut.mismatches();
+    std::printf("\nTest finished with %u errors: %s\n", errors, errors ? "[FAIL]" : "[PASS]");
+    std::printf("Simulated %llu cycles in %.3fs (%.0f cycles/s)\n", static_cast<unsigned long long>(bfm.cycles()), wall, wall > 0 ? bfm.cycles()/wall : 0.0);
+    return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+  } catch (const std::exception &e){
+    std::fprintf(stderr, "%s\n", e.what());
+    return EXIT_FAILURE;
+  }
+}
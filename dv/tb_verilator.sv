@@ -0,0 +1,497 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Solderpad Hardware License, Version 0.51 
+ * (the "License"); you may not use this file except in compliance 
+ * with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: SHL-0.51
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Verilator top for FractalSync networks: same DUT connection as tb_bfm, CU interfaces as flat ports
+ * The CU BFM and the tests are in C++ (dv/tb_verilator.cpp)
+ *
+ * Parameters:
+ *  N_CU_X     - Number of CUs in a row of the (square) mesh
+ *  FLOW_CTRL  - DUT credit-based flow control
+ *  FIFO_DEPTH - DUT FIFO depth (0: sized on the link ratios)
+ *  ARBITER_TYPE - DUT arbiter type (fractal_sync_pkg::arb_e) of every node (-1: default types of the tree)
+ *  SPLIT_PHASE   - Split-phase endpoints (fractal_sync_sp) between the CU interfaces and the DUT, as in tb_bfm
+ *  N_SP_BARRIERS - Outstanding barriers of the split-phase endpoints
+ *
+ * Interface signals (one element per CU, same layout as fractal_sync_if):
+ *  > *_sync_i     - Synchronization request
+ *  > *_aggr_i     - Aggregate of the synch. req.
+ *  > *_id_i       - Id of the synch. req.
+ *  < *_ready_o    - The split-phase endpoint can accept a request (always set without SPLIT_PHASE)
+ *  < *_wake_o     - Synchronization response
+ *  < *_lvl_o      - Level of the synch. rsp.
+ *  < *_id_o       - Id of the synch. rsp.
+ *  < *_error_o    - Error of the synch. rsp.
+ *  > *_wait_i     - Wait for the barrier of *_lvl_wait_i and *_id_wait_i
+ *  > *_lvl_wait_i - Level of the barrier waited for
+ *  > *_id_wait_i  - Id of the barrier waited for
+ *  < *_done_o     - Wait satisfied (never set without SPLIT_PHASE)
+ *  < sp_error_o   - An endpoint of the CU has rejected a request or dropped a wake
+ */
+
+module tb_verilator
+  import fractal_sync_pkg::*;
+#(
+  parameter  int unsigned N_CU_X     = 4,
+  parameter  bit          FLOW_CTRL  = 1'b0,
+  parameter  int unsigned FIFO_DEPTH = 0,
+  parameter  int          ARBITER_TYPE = -1,
+  parameter  bit          SPLIT_PHASE   = 1'b0,
+  parameter  int unsigned N_SP_BARRIERS = 4,
+  localparam int unsigned N_CU       = N_CU_X*N_CU_X,
+  localparam int unsigned N_LVL      = $clog2(N_CU),
+  localparam int unsigned ROOT_AGGR_W = 1,
+  localparam int unsigned CU_AGGR_W  = ROOT_AGGR_W+N_LVL,
+  localparam int unsigned CU_LVL_W   = $clog2(CU_AGGR_W-1),
+  localparam int unsigned CU_ID_W    = N_LVL-1 >= 2 ? N_LVL-1 : 2,
+  localparam int unsigned ROOT_LVL_W = CU_LVL_W,
+  localparam int unsigned ROOT_ID_W  = CU_ID_W,
+  localparam int unsigned NBR_AGGR_W = 1,
+  localparam int unsigned NBR_LVL_W  = 1,
+  localparam int unsigned NBR_ID_W   = 2
+)(
+  input  logic                 clk_i,
+  input  logic                 rst_ni,
+
+  input  logic                 h_tree_sync_i[N_CU],
+  input  logic[CU_AGGR_W-1:0]  h_tree_aggr_i[N_CU],
+  input  logic[CU_ID_W-1:0]    h_tree_id_i[N_CU],
+  output logic                 h_tree_wake_o[N_CU],
+  output logic[CU_LVL_W-1:0]   h_tree_lvl_o[N_CU],
+  output logic[CU_ID_W-1:0]    h_tree_id_o[N_CU],
+  output logic                 h_tree_error_o[N_CU],
+  output logic                 h_tree_ready_o[N_CU],
+  input  logic                 h_tree_wait_i[N_CU],
+  input  logic[CU_LVL_W-1:0]   h_tree_lvl_wait_i[N_CU],
+  input  logic[CU_ID_W-1:0]    h_tree_id_wait_i[N_CU],
+  output logic                 h_tree_done_o[N_CU],
+
+  input  logic                 v_tree_sync_i[N_CU],
+  input  logic[CU_AGGR_W-1:0]  v_tree_aggr_i[N_CU],
+  input  logic[CU_ID_W-1:0]    v_tree_id_i[N_CU],
+  output logic                 v_tree_wake_o[N_CU],
+  output logic[CU_LVL_W-1:0]   v_tree_lvl_o[N_CU],
+  output logic[CU_ID_W-1:0]    v_tree_id_o[N_CU],
+  output logic                 v_tree_error_o[N_CU],
+  output logic                 v_tree_ready_o[N_CU],
+  input  logic                 v_tree_wait_i[N_CU],
+  input  logic[CU_LVL_W-1:0]   v_tree_lvl_wait_i[N_CU],
+  input  logic[CU_ID_W-1:0]    v_tree_id_wait_i[N_CU],
+  output logic                 v_tree_done_o[N_CU],
+
+  input  logic                 h_nbr_sync_i[N_CU],
+  input  logic[NBR_AGGR_W-1:0] h_nbr_aggr_i[N_CU],
+  input  logic[NBR_ID_W-1:0]   h_nbr_id_i[N_CU],
+  output logic                 h_nbr_wake_o[N_CU],
+  output logic[NBR_LVL_W-1:0]  h_nbr_lvl_o[N_CU],
+  output logic[NBR_ID_W-1:0]   h_nbr_id_o[N_CU],
+  output logic                 h_nbr_error_o[N_CU],
+  output logic                 h_nbr_ready_o[N_CU],
+  input  logic                 h_nbr_wait_i[N_CU],
+  input  logic[NBR_LVL_W-1:0]  h_nbr_lvl_wait_i[N_CU],
+  input  logic[NBR_ID_W-1:0]   h_nbr_id_wait_i[N_CU],
+  output logic                 h_nbr_done_o[N_CU],
+
+  input  logic                 v_nbr_sync_i[N_CU],
+  input  logic[NBR_AGGR_W-1:0] v_nbr_aggr_i[N_CU],
+  input  logic[NBR_ID_W-1:0]   v_nbr_id_i[N_CU],
+  output logic                 v_nbr_wake_o[N_CU],
+  output logic[NBR_LVL_W-1:0]  v_nbr_lvl_o[N_CU],
+  output logic[NBR_ID_W-1:0]   v_nbr_id_o[N_CU],
+  output logic                 v_nbr_error_o[N_CU],
+  output logic                 v_nbr_ready_o[N_CU],
+  input  logic                 v_nbr_wait_i[N_CU],
+  input  logic[NBR_LVL_W-1:0]  v_nbr_lvl_wait_i[N_CU],
+  input  logic[NBR_ID_W-1:0]   v_nbr_id_wait_i[N_CU],
+  output logic                 v_nbr_done_o[N_CU],
+
+  output logic                 sp_error_o[N_CU]
+);
+
+  `include "fractal_sync/typedef.svh"
+
+  // Testbench type definitions
+  `FSYNC_TYPEDEF_ALL(ht_cu_fsync,  logic[CU_AGGR_W-1:0],   logic[CU_LVL_W-1:0],   logic[CU_ID_W-1:0])
+  `FSYNC_TYPEDEF_ALL(vt_cu_fsync,  logic[CU_AGGR_W-1:0],   logic[CU_LVL_W-1:0],   logic[CU_ID_W-1:0])
+  `FSYNC_TYPEDEF_ALL(hn_cu_fsync,  logic[NBR_AGGR_W-1:0],  logic[NBR_LVL_W-1:0],  logic[NBR_ID_W-1:0])
+  `FSYNC_TYPEDEF_ALL(vn_cu_fsync,  logic[NBR_AGGR_W-1:0],  logic[NBR_LVL_W-1:0],  logic[NBR_ID_W-1:0])
+  `FSYNC_TYPEDEF_ALL(h_root_fsync, logic[ROOT_AGGR_W-1:0], logic[ROOT_LVL_W-1:0], logic[ROOT_ID_W-1:0])
+  `FSYNC_TYPEDEF_ALL(v_root_fsync, logic[ROOT_AGGR_W-1:0], logic[ROOT_LVL_W-1:0], logic[ROOT_ID_W-1:0])
+
+  // Testbench internal signals
+  ht_cu_fsync_req_t  ht_cu_fsync_req[N_CU][1]; // Single link CU-FSync interface
+  ht_cu_fsync_rsp_t  ht_cu_fsync_rsp[N_CU][1]; // Single link CU-FSync interface
+  vt_cu_fsync_req_t  vt_cu_fsync_req[N_CU][1]; // Single link CU-FSync interface
+  vt_cu_fsync_rsp_t  vt_cu_fsync_rsp[N_CU][1]; // Single link CU-FSync interface
+  hn_cu_fsync_req_t  hn_cu_fsync_req[N_CU];
+  hn_cu_fsync_rsp_t  hn_cu_fsync_rsp[N_CU];
+  vn_cu_fsync_req_t  vn_cu_fsync_req[N_CU];
+  vn_cu_fsync_rsp_t  vn_cu_fsync_rsp[N_CU];
+  h_root_fsync_req_t h_root_fsync_req[1][1]; // Single node, single link root node out interface
+  h_root_fsync_rsp_t h_root_fsync_rsp[1][1]; // Single node, single link root node out interface
+  v_root_fsync_req_t v_root_fsync_req[1][1]; // Single node, single link root node out interface
+  v_root_fsync_rsp_t v_root_fsync_rsp[1][1]; // Single node, single link root node out interface
+
+  ht_cu_fsync_req_t     ht_cu_arrive[N_CU];   // CU side of the split-phase endpoints
+  ht_cu_fsync_rsp_t     ht_cu_wake[N_CU];
+  ht_cu_fsync_rsp_sig_t ht_cu_wait_sig[N_CU];
+  ht_cu_fsync_rsp_t     ht_cu_done[N_CU];
+  vt_cu_fsync_req_t     vt_cu_arrive[N_CU];
+  vt_cu_fsync_rsp_t     vt_cu_wake[N_CU];
+  vt_cu_fsync_rsp_sig_t vt_cu_wait_sig[N_CU];
+  vt_cu_fsync_rsp_t     vt_cu_done[N_CU];
+  hn_cu_fsync_req_t     hn_cu_arrive[N_CU];
+  hn_cu_fsync_rsp_t     hn_cu_wake[N_CU];
+  hn_cu_fsync_rsp_sig_t hn_cu_wait_sig[N_CU];
+  hn_cu_fsync_rsp_t     hn_cu_done[N_CU];
+  vn_cu_fsync_req_t     vn_cu_arrive[N_CU];
+  vn_cu_fsync_rsp_t     vn_cu_wake[N_CU];
+  vn_cu_fsync_rsp_sig_t vn_cu_wait_sig[N_CU];
+  vn_cu_fsync_rsp_t     vn_cu_done[N_CU];
+
+  // Flat ports - Req/Rsp conversion
+  for (genvar i = 0; i < N_CU; i++) begin: gen_cu_ports
+    assign ht_cu_arrive[i].sync          = h_tree_sync_i[i];
+    assign ht_cu_arrive[i].sig.aggr      = h_tree_aggr_i[i];
+    assign ht_cu_arrive[i].sig.id        = h_tree_id_i[i];
+    assign ht_cu_arrive[i].credit        = 1'b1;
+    assign h_tree_wake_o[i]              = ht_cu_wake[i].wake;
+    assign h_tree_lvl_o[i]               = ht_cu_wake[i].sig.lvl;
+    assign h_tree_id_o[i]                = ht_cu_wake[i].sig.id;
+    assign h_tree_error_o[i]             = ht_cu_wake[i].error;
+    assign ht_cu_wait_sig[i].lvl         = h_tree_lvl_wait_i[i];
+    assign ht_cu_wait_sig[i].id          = h_tree_id_wait_i[i];
+    assign h_tree_done_o[i]              = ht_cu_done[i].wake;
+
+    assign vt_cu_arrive[i].sync          = v_tree_sync_i[i];
+    assign vt_cu_arrive[i].sig.aggr      = v_tree_aggr_i[i];
+    assign vt_cu_arrive[i].sig.id        = v_tree_id_i[i];
+    assign vt_cu_arrive[i].credit        = 1'b1;
+    assign v_tree_wake_o[i]              = vt_cu_wake[i].wake;
+    assign v_tree_lvl_o[i]               = vt_cu_wake[i].sig.lvl;
+    assign v_tree_id_o[i]                = vt_cu_wake[i].sig.id;
+    assign v_tree_error_o[i]             = vt_cu_wake[i].error;
+    assign vt_cu_wait_sig[i].lvl         = v_tree_lvl_wait_i[i];
+    assign vt_cu_wait_sig[i].id          = v_tree_id_wait_i[i];
+    assign v_tree_done_o[i]              = vt_cu_done[i].wake;
+
+    assign hn_cu_arrive[i].sync          = h_nbr_sync_i[i];
+    assign hn_cu_arrive[i].sig.aggr      = h_nbr_aggr_i[i];
+    assign hn_cu_arrive[i].sig.id        = h_nbr_id_i[i];
+    assign hn_cu_arrive[i].credit        = 1'b1;
+    assign h_nbr_wake_o[i]               = hn_cu_wake[i].wake;
+    assign h_nbr_lvl_o[i]                = hn_cu_wake[i].sig.lvl;
+    assign h_nbr_id_o[i]                 = hn_cu_wake[i].sig.id;
+    assign h_nbr_error_o[i]              = hn_cu_wake[i].error;
+    assign hn_cu_wait_sig[i].lvl         = h_nbr_lvl_wait_i[i];
+    assign hn_cu_wait_sig[i].id          = h_nbr_id_wait_i[i];
+    assign h_nbr_done_o[i]               = hn_cu_done[i].wake;
+
+    assign vn_cu_arrive[i].sync          = v_nbr_sync_i[i];
+    assign vn_cu_arrive[i].sig.aggr      = v_nbr_aggr_i[i];
+    assign vn_cu_arrive[i].sig.id        = v_nbr_id_i[i];
+    assign vn_cu_arrive[i].credit        = 1'b1;
+    assign v_nbr_wake_o[i]               = vn_cu_wake[i].wake;
+    assign v_nbr_lvl_o[i]                = vn_cu_wake[i].sig.lvl;
+    assign v_nbr_id_o[i]                 = vn_cu_wake[i].sig.id;
+    assign v_nbr_error_o[i]              = vn_cu_wake[i].error;
+    assign vn_cu_wait_sig[i].lvl         = v_nbr_lvl_wait_i[i];
+    assign vn_cu_wait_sig[i].id          = v_nbr_id_wait_i[i];
+    assign v_nbr_done_o[i]               = vn_cu_done[i].wake;
+  end
+
+  // Split-phase endpoints, as in tb_bfm: wakes latched until the CUs wait for them
+  if (SPLIT_PHASE) begin: gen_sp
+    for (genvar i = 0; i < N_CU; i++) begin: gen_cu_sp
+      logic[3:0] reject, overflow; // h-tree, v-tree, h-nbr, v-nbr endpoints
+
+      fractal_sync_sp #(
+        .N_BARRIERS      ( N_SP_BARRIERS         ),
+        .LVL_OFFSET      ( 0                     ),
+        .fsync_req_t     ( ht_cu_fsync_req_t     ),
+        .fsync_rsp_t     ( ht_cu_fsync_rsp_t     ),
+        .fsync_rsp_sig_t ( ht_cu_fsync_rsp_sig_t )
+      ) i_ht_sp (
+        .clk_i      ( clk_i                 ),
+        .rst_ni     ( rst_ni                ),
+        .arrive_i   ( ht_cu_arrive[i]       ),
+        .ready_o    ( h_tree_ready_o[i]     ),
+        .reject_o   ( reject[0]             ),
+        .wait_i     ( h_tree_wait_i[i]      ),
+        .wait_sig_i ( ht_cu_wait_sig[i]     ),
+        .done_o     ( ht_cu_done[i]         ),
+        .rsp_o      ( ht_cu_wake[i]         ),
+        .overflow_o ( overflow[0]           ),
+        .req_o      ( ht_cu_fsync_req[i][0] ),
+        .rsp_i      ( ht_cu_fsync_rsp[i][0] )
+      );
+      fractal_sync_sp #(
+        .N_BARRIERS      ( N_SP_BARRIERS         ),
+        .LVL_OFFSET      ( 0                     ),
+        .fsync_req_t     ( vt_cu_fsync_req_t     ),
+        .fsync_rsp_t     ( vt_cu_fsync_rsp_t     ),
+        .fsync_rsp_sig_t ( vt_cu_fsync_rsp_sig_t )
+      ) i_vt_sp (
+        .clk_i      ( clk_i                 ),
+        .rst_ni     ( rst_ni                ),
+        .arrive_i   ( vt_cu_arrive[i]       ),
+        .ready_o    ( v_tree_ready_o[i]     ),
+        .reject_o   ( reject[1]             ),
+        .wait_i     ( v_tree_wait_i[i]      ),
+        .wait_sig_i ( vt_cu_wait_sig[i]     ),
+        .done_o     ( vt_cu_done[i]         ),
+        .rsp_o      ( vt_cu_wake[i]         ),
+        .overflow_o ( overflow[1]           ),
+        .req_o      ( vt_cu_fsync_req[i][0] ),
+        .rsp_i      ( vt_cu_fsync_rsp[i][0] )
+      );
+      fractal_sync_sp #(
+        .N_BARRIERS      ( N_SP_BARRIERS         ),
+        .LVL_OFFSET      ( 1                     ),
+        .fsync_req_t     ( hn_cu_fsync_req_t     ),
+        .fsync_rsp_t     ( hn_cu_fsync_rsp_t     ),
+        .fsync_rsp_sig_t ( hn_cu_fsync_rsp_sig_t )
+      ) i_hn_sp (
+        .clk_i      ( clk_i              ),
+        .rst_ni     ( rst_ni             ),
+        .arrive_i   ( hn_cu_arrive[i]    ),
+        .ready_o    ( h_nbr_ready_o[i]   ),
+        .reject_o   ( reject[2]          ),
+        .wait_i     ( h_nbr_wait_i[i]    ),
+        .wait_sig_i ( hn_cu_wait_sig[i]  ),
+        .done_o     ( hn_cu_done[i]      ),
+        .rsp_o      ( hn_cu_wake[i]      ),
+        .overflow_o ( overflow[2]        ),
+        .req_o      ( hn_cu_fsync_req[i] ),
+        .rsp_i      ( hn_cu_fsync_rsp[i] )
+      );
+      fractal_sync_sp #(
+        .N_BARRIERS      ( N_SP_BARRIERS         ),
+        .LVL_OFFSET      ( 1                     ),
+        .fsync_req_t     ( vn_cu_fsync_req_t     ),
+        .fsync_rsp_t     ( vn_cu_fsync_rsp_t     ),
+        .fsync_rsp_sig_t ( vn_cu_fsync_rsp_sig_t )
+      ) i_vn_sp (
+        .clk_i      ( clk_i              ),
+        .rst_ni     ( rst_ni             ),
+        .arrive_i   ( vn_cu_arrive[i]    ),
+        .ready_o    ( v_nbr_ready_o[i]   ),
+        .reject_o   ( reject[3]          ),
+        .wait_i     ( v_nbr_wait_i[i]    ),
+        .wait_sig_i ( vn_cu_wait_sig[i]  ),
+        .done_o     ( vn_cu_done[i]      ),
+        .rsp_o      ( vn_cu_wake[i]      ),
+        .overflow_o ( overflow[3]        ),
+        .req_o      ( vn_cu_fsync_req[i] ),
+        .rsp_i      ( vn_cu_fsync_rsp[i] )
+      );
+
+      assign sp_error_o[i] = (|reject) | (|overflow);
+    end
+  end else begin: gen_no_sp
+    // Blocking synchronizations only: CU interfaces straight to the network
+    for (genvar i = 0; i < N_CU; i++) begin: gen_cu
+      assign ht_cu_fsync_req[i][0] = ht_cu_arrive[i];
+      assign ht_cu_wake[i]         = ht_cu_fsync_rsp[i][0];
+      assign ht_cu_done[i]         = '{wake: 1'b0, sig: '0, error: 1'b0, credit: 1'b1};
+      assign h_tree_ready_o[i]     = 1'b1;
+      assign vt_cu_fsync_req[i][0] = vt_cu_arrive[i];
+      assign vt_cu_wake[i]         = vt_cu_fsync_rsp[i][0];
+      assign vt_cu_done[i]         = '{wake: 1'b0, sig: '0, error: 1'b0, credit: 1'b1};
+      assign v_tree_ready_o[i]     = 1'b1;
+      assign hn_cu_fsync_req[i]    = hn_cu_arrive[i];
+      assign hn_cu_wake[i]         = hn_cu_fsync_rsp[i];
+      assign hn_cu_done[i]         = '{wake: 1'b0, sig: '0, error: 1'b0, credit: 1'b1};
+      assign h_nbr_ready_o[i]      = 1'b1;
+      assign vn_cu_fsync_req[i]    = vn_cu_arrive[i];
+      assign vn_cu_wake[i]         = vn_cu_fsync_rsp[i];
+      assign vn_cu_done[i]         = '{wake: 1'b0, sig: '0, error: 1'b0, credit: 1'b1};
+      assign v_nbr_ready_o[i]      = 1'b1;
+      assign sp_error_o[i]         = 1'b0;
+    end
+  end
+
+  // Hardwired synchronization tree root signals
+  assign h_root_fsync_rsp[0][0].wake    = 1'b0;
+  assign h_root_fsync_rsp[0][0].sig.lvl = '0;
+  assign h_root_fsync_rsp[0][0].sig.id  = '0;
+  assign h_root_fsync_rsp[0][0].error   = 1'b0;
+  assign h_root_fsync_rsp[0][0].credit  = 1'b1;
+  assign v_root_fsync_rsp[0][0].wake    = 1'b0;
+  assign v_root_fsync_rsp[0][0].sig.lvl = '0;
+  assign v_root_fsync_rsp[0][0].sig.id  = '0;
+  assign v_root_fsync_rsp[0][0].error   = 1'b0;
+  assign v_root_fsync_rsp[0][0].credit  = 1'b1;
+
+  // DUT
+  if (N_CU_X == 2) begin: gen_dut_2x2
+    fractal_sync_2x2 #(
+      .ARBITER_TYPE_1D ( (ARBITER_TYPE < 0) ? fractal_sync_2x2_pkg::ARBITER_TYPE_1D : fractal_sync_pkg::arb_e'(ARBITER_TYPE) ),
+      .ARBITER_TYPE_2D ( (ARBITER_TYPE < 0) ? fractal_sync_2x2_pkg::ARBITER_TYPE_2D : fractal_sync_pkg::arb_e'(ARBITER_TYPE) ),
+      .FLOW_CTRL       ( FLOW_CTRL  ),
+      .FIFO_DEPTH      ( FIFO_DEPTH )
+    ) i_sync_network_dut (
+      .clk_i             ( clk_i            ),
+      .rst_ni            ( rst_ni           ),
+      .h_1d_fsync_req_i  ( ht_cu_fsync_req  ),
+      .h_1d_fsync_rsp_o  ( ht_cu_fsync_rsp  ),
+      .v_1d_fsync_req_i  ( vt_cu_fsync_req  ),
+      .v_1d_fsync_rsp_o  ( vt_cu_fsync_rsp  ),
+      .h_nbr_fsycn_req_i ( hn_cu_fsync_req  ),
+      .h_nbr_fsycn_rsp_o ( hn_cu_fsync_rsp  ),
+      .v_nbr_fsycn_req_i ( vn_cu_fsync_req  ),
+      .v_nbr_fsycn_rsp_o ( vn_cu_fsync_rsp  ),
+      .h_2d_fsync_req_o  ( h_root_fsync_req ),
+      .h_2d_fsync_rsp_i  ( h_root_fsync_rsp ),
+      .v_2d_fsync_req_o  ( v_root_fsync_req ),
+      .v_2d_fsync_rsp_i  ( v_root_fsync_rsp )
+    );
+  end else if (N_CU_X == 4) begin: gen_dut_4x4
+    fractal_sync_4x4 #(
+      .ARBITER_TYPE_1D ( (ARBITER_TYPE < 0) ? fractal_sync_4x4_pkg::ARBITER_TYPE_1D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .ARBITER_TYPE_2D ( (ARBITER_TYPE < 0) ? fractal_sync_4x4_pkg::ARBITER_TYPE_2D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .FLOW_CTRL       ( FLOW_CTRL  ),
+      .FIFO_DEPTH      ( FIFO_DEPTH )
+    ) i_sync_network_dut (
+      .clk_i             ( clk_i            ),
+      .rst_ni            ( rst_ni           ),
+      .h_1d_fsync_req_i  ( ht_cu_fsync_req  ),
+      .h_1d_fsync_rsp_o  ( ht_cu_fsync_rsp  ),
+      .v_1d_fsync_req_i  ( vt_cu_fsync_req  ),
+      .v_1d_fsync_rsp_o  ( vt_cu_fsync_rsp  ),
+      .h_nbr_fsycn_req_i ( hn_cu_fsync_req  ),
+      .h_nbr_fsycn_rsp_o ( hn_cu_fsync_rsp  ),
+      .v_nbr_fsycn_req_i ( vn_cu_fsync_req  ),
+      .v_nbr_fsycn_rsp_o ( vn_cu_fsync_rsp  ),
+      .h_2d_fsync_req_o  ( h_root_fsync_req ),
+      .h_2d_fsync_rsp_i  ( h_root_fsync_rsp ),
+      .v_2d_fsync_req_o  ( v_root_fsync_req ),
+      .v_2d_fsync_rsp_i  ( v_root_fsync_rsp )
+    );
+  end else if (N_CU_X == 8) begin: gen_dut_8x8
+    fractal_sync_8x8 #(
+      .ARBITER_TYPE_1D ( (ARBITER_TYPE < 0) ? fractal_sync_8x8_pkg::ARBITER_TYPE_1D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .ARBITER_TYPE_2D ( (ARBITER_TYPE < 0) ? fractal_sync_8x8_pkg::ARBITER_TYPE_2D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .FLOW_CTRL       ( FLOW_CTRL  ),
+      .FIFO_DEPTH      ( FIFO_DEPTH )
+    ) i_sync_network_dut (
+      .clk_i             ( clk_i            ),
+      .rst_ni            ( rst_ni           ),
+      .h_1d_fsync_req_i  ( ht_cu_fsync_req  ),
+      .h_1d_fsync_rsp_o  ( ht_cu_fsync_rsp  ),
+      .v_1d_fsync_req_i  ( vt_cu_fsync_req  ),
+      .v_1d_fsync_rsp_o  ( vt_cu_fsync_rsp  ),
+      .h_nbr_fsycn_req_i ( hn_cu_fsync_req  ),
+      .h_nbr_fsycn_rsp_o ( hn_cu_fsync_rsp  ),
+      .v_nbr_fsycn_req_i ( vn_cu_fsync_req  ),
+      .v_nbr_fsycn_rsp_o ( vn_cu_fsync_rsp  ),
+      .h_2d_fsync_req_o  ( h_root_fsync_req ),
+      .h_2d_fsync_rsp_i  ( h_root_fsync_rsp ),
+      .v_2d_fsync_req_o  ( v_root_fsync_req ),
+      .v_2d_fsync_rsp_i  ( v_root_fsync_rsp )
+    );
+  end else if (N_CU_X == 16) begin: gen_dut_16x16
+    fractal_sync_16x16 #(
+      .ARBITER_TYPE_1D ( (ARBITER_TYPE < 0) ? fractal_sync_16x16_pkg::ARBITER_TYPE_1D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .ARBITER_TYPE_2D ( (ARBITER_TYPE < 0) ? fractal_sync_16x16_pkg::ARBITER_TYPE_2D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .FLOW_CTRL       ( FLOW_CTRL  ),
+      .FIFO_DEPTH      ( FIFO_DEPTH )
+    ) i_sync_network_dut (
+      .clk_i             ( clk_i            ),
+      .rst_ni            ( rst_ni           ),
+      .h_1d_fsync_req_i  ( ht_cu_fsync_req  ),
+      .h_1d_fsync_rsp_o  ( ht_cu_fsync_rsp  ),
+      .v_1d_fsync_req_i  ( vt_cu_fsync_req  ),
+      .v_1d_fsync_rsp_o  ( vt_cu_fsync_rsp  ),
+      .h_nbr_fsycn_req_i ( hn_cu_fsync_req  ),
+      .h_nbr_fsycn_rsp_o ( hn_cu_fsync_rsp  ),
+      .v_nbr_fsycn_req_i ( vn_cu_fsync_req  ),
+      .v_nbr_fsycn_rsp_o ( vn_cu_fsync_rsp  ),
+      .h_2d_fsync_req_o  ( h_root_fsync_req ),
+      .h_2d_fsync_rsp_i  ( h_root_fsync_rsp ),
+      .v_2d_fsync_req_o  ( v_root_fsync_req ),
+      .v_2d_fsync_rsp_i  ( v_root_fsync_rsp )
+    );
+  end else if (N_CU_X == 32) begin: gen_dut_32x32
+    fractal_sync_32x32 #(
+      .ARBITER_TYPE_1D ( (ARBITER_TYPE < 0) ? fractal_sync_32x32_pkg::ARBITER_TYPE_1D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .ARBITER_TYPE_2D ( (ARBITER_TYPE < 0) ? fractal_sync_32x32_pkg::ARBITER_TYPE_2D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .FLOW_CTRL       ( FLOW_CTRL  ),
+      .FIFO_DEPTH      ( FIFO_DEPTH )
+    ) i_sync_network_dut (
+      .clk_i             ( clk_i            ),
+      .rst_ni            ( rst_ni           ),
+      .h_1d_fsync_req_i  ( ht_cu_fsync_req  ),
+      .h_1d_fsync_rsp_o  ( ht_cu_fsync_rsp  ),
+      .v_1d_fsync_req_i  ( vt_cu_fsync_req  ),
+      .v_1d_fsync_rsp_o  ( vt_cu_fsync_rsp  ),
+      .h_nbr_fsycn_req_i ( hn_cu_fsync_req  ),
+      .h_nbr_fsycn_rsp_o ( hn_cu_fsync_rsp  ),
+      .v_nbr_fsycn_req_i ( vn_cu_fsync_req  ),
+      .v_nbr_fsycn_rsp_o ( vn_cu_fsync_rsp  ),
+      .h_2d_fsync_req_o  ( h_root_fsync_req ),
+      .h_2d_fsync_rsp_i  ( h_root_fsync_rsp ),
+      .v_2d_fsync_req_o  ( v_root_fsync_req ),
+      .v_2d_fsync_rsp_i  ( v_root_fsync_rsp )
+    );
+  end else if (N_CU_X == 64) begin: gen_dut_64x64
+    fractal_sync_64x64 #(
+      .ARBITER_TYPE_1D ( (ARBITER_TYPE < 0) ? fractal_sync_64x64_pkg::ARBITER_TYPE_1D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .ARBITER_TYPE_2D ( (ARBITER_TYPE < 0) ? fractal_sync_64x64_pkg::ARBITER_TYPE_2D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .FLOW_CTRL       ( FLOW_CTRL  ),
+      .FIFO_DEPTH      ( FIFO_DEPTH )
+    ) i_sync_network_dut (
+      .clk_i             ( clk_i            ),
+      .rst_ni            ( rst_ni           ),
+      .h_1d_fsync_req_i  ( ht_cu_fsync_req  ),
+      .h_1d_fsync_rsp_o  ( ht_cu_fsync_rsp  ),
+      .v_1d_fsync_req_i  ( vt_cu_fsync_req  ),
+      .v_1d_fsync_rsp_o  ( vt_cu_fsync_rsp  ),
+      .h_nbr_fsycn_req_i ( hn_cu_fsync_req  ),
+      .h_nbr_fsycn_rsp_o ( hn_cu_fsync_rsp  ),
+      .v_nbr_fsycn_req_i ( vn_cu_fsync_req  ),
+      .v_nbr_fsycn_rsp_o ( vn_cu_fsync_rsp  ),
+      .h_2d_fsync_req_o  ( h_root_fsync_req ),
+      .h_2d_fsync_rsp_i  ( h_root_fsync_rsp ),
+      .v_2d_fsync_req_o  ( v_root_fsync_req ),
+      .v_2d_fsync_rsp_i  ( v_root_fsync_rsp )
+    );
+  end else if (N_CU_X == 128) begin: gen_dut_128x128
+    fractal_sync_128x128 #(
+      .ARBITER_TYPE_1D ( (ARBITER_TYPE < 0) ? fractal_sync_128x128_pkg::ARBITER_TYPE_1D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .ARBITER_TYPE_2D ( (ARBITER_TYPE < 0) ? fractal_sync_128x128_pkg::ARBITER_TYPE_2D : '{default: fractal_sync_pkg::arb_e'(ARBITER_TYPE)} ),
+      .FLOW_CTRL       ( FLOW_CTRL  ),
+      .FIFO_DEPTH      ( FIFO_DEPTH )
+    ) i_sync_network_dut (
+      .clk_i             ( clk_i            ),
+      .rst_ni            ( rst_ni           ),
+      .h_1d_fsync_req_i  ( ht_cu_fsync_req  ),
+      .h_1d_fsync_rsp_o  ( ht_cu_fsync_rsp  ),
+      .v_1d_fsync_req_i  ( vt_cu_fsync_req  ),
+      .v_1d_fsync_rsp_o  ( vt_cu_fsync_rsp  ),
+      .h_nbr_fsycn_req_i ( hn_cu_fsync_req  ),
+      .h_nbr_fsycn_rsp_o ( hn_cu_fsync_rsp  ),
+      .v_nbr_fsycn_req_i ( vn_cu_fsync_req  ),
+      .v_nbr_fsycn_rsp_o ( vn_cu_fsync_rsp  ),
+      .h_2d_fsync_req_o  ( h_root_fsync_req ),
+      .h_2d_fsync_rsp_i  ( h_root_fsync_rsp ),
+      .v_2d_fsync_req_o  ( v_root_fsync_req ),
+      .v_2d_fsync_rsp_i  ( v_root_fsync_rsp )
+    );
+  end else $fatal("Detected unsupported synchronization network configuration!!!");
+
+endmodule: tb_verilator
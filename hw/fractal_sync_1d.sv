@@ -21,10 +21,10 @@
  *
  * Parameters:
  *  NODE_TYPE            - Node type of control core (horizontal, vertical, 2D, root)
- *  RF_TYPE              - Remote RF type (Directly Mapped or CAM)
- *  ARBITER_TYPE         - Arbiter type (Fully Associative or Directly Mapped wrap-around/alternating order)
+ *  RF_TYPE              - Remote RF type (Directly Mapped, CAM or hashed Set-Associative)
+ *  ARBITER_TYPE         - Arbiter type (Fully Associative, Directly Mapped wrap-around/alternating order or Parallel-Prefix)
  *  N_LOCAL_REGS         - Number of register in the local RF
- *  N_REMOTE_LINES       - Number of CAM lines in a CAM-based remote RF
+ *  N_REMOTE_LINES       - Number of lines in a CAM-based or set-associative remote RF
  *  AGGREGATE_WIDTH      - Width of the aggr field
  *  ID_WIDTH             - Width of the id field
  *  LVL_OFFSET           - Level offset from first node of the syncrhonization tree: 0 for nodes at level 1, 1 for nodes at level 2, ...
@@ -38,6 +38,7 @@
  *  REMOTE_FIFO_COMB_OUT - 1: Output remote FIFO with fall-through; 0: sequential remote FIFO
  *  IN_PORTS             - Number of RX (input) ports
  *  OUT_PORTS            - Number of TX (output) ports
+ *  FLOW_CTRL            - 1: Credit-based flow control on every link (full FIFOs stall the sender); 0: none
  *
  * Interface signals:
  *  > req_in_i  - Synchronization request (input)
@@ -66,7 +67,8 @@ module fractal_sync_1d
   parameter bit                           LOCAL_FIFO_COMB_OUT  = 1'b1,
   parameter bit                           REMOTE_FIFO_COMB_OUT = 1'b1,
   parameter int unsigned                  IN_PORTS             = 2,
-  parameter int unsigned                  OUT_PORTS            = IN_PORTS/2
+  parameter int unsigned                  OUT_PORTS            = IN_PORTS/2,
+  parameter bit                           FLOW_CTRL            = 1'b0
 )(
   input  logic           clk_i,
   input  logic           rst_ni,
@@ -111,10 +113,13 @@ module fractal_sync_1d
   logic           empty_rx[IN_PORTS];
   fsync_req_out_t req_rx[IN_PORTS];
   logic           pop_rx[IN_PORTS];
+  logic           credit_rx[IN_PORTS];
 
   logic           pop_req_arb[REQ_ARB_PORTS];
   logic           empty_req_arb[REQ_ARB_PORTS];
   fsync_req_out_t req_arb[REQ_ARB_PORTS];
+  fsync_req_out_t req_out[OUT_PORTS];
+  logic           ready_req_out[OUT_PORTS];
 
   fsync_rsp_t sampled_rsp_out[OUT_PORTS];
   logic       check_tx[OUT_PORTS];
@@ -130,6 +135,7 @@ module fractal_sync_1d
   logic       ws_empty_tx[OUT_PORTS];
   fsync_rsp_t ws_rsp_tx[OUT_PORTS];
   logic       ws_pop_tx[OUT_PORTS];
+  logic       credit_tx[OUT_PORTS];
 
   logic       en_pop_rsp_arb[RSP_ARB_PORTS];
   logic       en_empty_rsp_arb[RSP_ARB_PORTS];
@@ -139,14 +145,19 @@ module fractal_sync_1d
   logic       ws_empty_rsp_arb[RSP_ARB_PORTS];
   fsync_rsp_t ws_rsp_arb_in[RSP_ARB_PORTS];
   fsync_rsp_t ws_rsp_arb_out[WS_IN_PORTS];
+  logic       ready_rsp_in[IN_PORTS];
+  logic       en_ready_rsp_arb[EN_IN_PORTS];
+  logic       ws_ready_rsp_arb[WS_IN_PORTS];
 
   logic           remote_empty[IN_PORTS];
   fsync_req_out_t remote_req[IN_PORTS];
   logic           remote_pop[IN_PORTS];
+  logic           remote_push[IN_PORTS];
 
   logic       local_empty[IN_PORTS];
   fsync_rsp_t local_rsp[IN_PORTS];
   logic       local_pop[IN_PORTS];
+  logic       local_push[IN_PORTS];
   logic[1:0]  local_pop_q[IN_PORTS];
   logic[1:0]  local_pop_d[IN_PORTS];
 
@@ -162,19 +173,23 @@ module fractal_sync_1d
       .fsync_req_out_t ( fsync_req_out_t      ),
       .COMB_IN         ( /*DO NOT OVERWRITE*/ ),
       .FIFO_DEPTH      ( FIFO_DEPTH           ),
-      .FIFO_COMB_OUT   ( RX_FIFO_COMB_OUT     )
+      .FIFO_COMB_OUT   ( RX_FIFO_COMB_OUT     ),
+      .FLOW_CTRL       ( FLOW_CTRL            )
     ) i_rx (
-      .clk_i                                  ,
-      .rst_ni                                 ,
-      .req_i             ( req_in_i[i]       ),
-      .sampled_req_o     ( sampled_req_in[i] ),
-      .check_propagate_o ( check_rx[i]       ),
-      .local_o           ( local_rx[i]       ),
-      .root_o            ( root_rx[i]        ),
-      .error_overflow_o  ( overflow_rx[i]    ),
-      .empty_o           ( empty_rx[i]       ),
-      .req_o             ( req_rx[i]         ),
-      .pop_i             ( pop_rx[i]         )
+      .clk_i                                               ,
+      .rst_ni                                              ,
+      .req_i             ( req_in_i[i]                    ),
+      .sampled_req_o     ( sampled_req_in[i]              ),
+      .check_propagate_o ( check_rx[i]                    ),
+      .local_o           ( local_rx[i]                    ),
+      .root_o            ( root_rx[i]                     ),
+      .error_overflow_o  ( overflow_rx[i]                 ),
+      .empty_o           ( empty_rx[i]                    ),
+      .req_o             ( req_rx[i]                      ),
+      .pop_i             ( pop_rx[i]                      ),
+      .cc_push_i         ( local_push[i] | remote_push[i] ),
+      .cc_pop_i          ( {remote_pop[i], local_pop[i]}  ),
+      .credit_o          ( credit_rx[i]                   )
     );
   end
 
@@ -201,9 +216,27 @@ module fractal_sync_1d
     .pop_o     ( pop_req_arb   ),
     .empty_i   ( empty_req_arb ),
     .element_i ( req_arb       ),
-    .element_o ( req_out_o     )
+    .element_o ( req_out       ),
+    .ready_i   ( ready_req_out )
   );
 
+  for (genvar i = 0; i < OUT_PORTS; i++) begin: gen_req_out
+    assign req_out_o[i].sync   = req_out[i].sync;
+    assign req_out_o[i].sig    = req_out[i].sig;
+    assign req_out_o[i].credit = credit_tx[i];
+
+    fractal_sync_credit #(
+      .FLOW_CTRL   ( FLOW_CTRL  ),
+      .MAX_CREDITS ( FIFO_DEPTH )
+    ) i_credit (
+      .clk_i                           ,
+      .rst_ni                          ,
+      .credit_i ( rsp_out_i[i].credit ),
+      .send_i   ( req_out[i].sync     ),
+      .ready_o  ( ready_req_out[i]    )
+    );
+  end
+
 /*******************************************************/
 /**                   RX Arbiter End                  **/
 /*******************************************************/
@@ -217,7 +250,8 @@ module fractal_sync_1d
       .fsync_rsp_t   ( fsync_rsp_t          ),
       .COMB_IN       ( /*DO NOT OVERWRITE*/ ),
       .FIFO_DEPTH    ( FIFO_DEPTH           ),
-      .FIFO_COMB_OUT ( TX_FIFO_COMB_OUT     )
+      .FIFO_COMB_OUT ( TX_FIFO_COMB_OUT     ),
+      .FLOW_CTRL     ( FLOW_CTRL            )
     ) i_tx (
       .clk_i                                     ,
       .rst_ni                                    ,
@@ -233,7 +267,8 @@ module fractal_sync_1d
       .en_pop_i            ( en_pop_tx[i]       ),
       .ws_empty_o          ( ws_empty_tx[i]     ),
       .ws_rsp_o            ( ws_rsp_tx[i]       ),
-      .ws_pop_i            ( ws_pop_tx[i]       )
+      .ws_pop_i            ( ws_pop_tx[i]       ),
+      .credit_o            ( credit_tx[i]       )
     );
   end
 
@@ -254,8 +289,29 @@ module fractal_sync_1d
   end
 
   for (genvar i = 0; i < IN_PORTS/2; i++) begin
-    assign rsp_in_o[2*i]   = en_rsp_arb_out[i];
-    assign rsp_in_o[2*i+1] = ws_rsp_arb_out[i];
+    assign rsp_in_o[2*i].wake     = en_rsp_arb_out[i].wake;
+    assign rsp_in_o[2*i].sig      = en_rsp_arb_out[i].sig;
+    assign rsp_in_o[2*i].error    = en_rsp_arb_out[i].error;
+    assign rsp_in_o[2*i].credit   = credit_rx[2*i];
+    assign rsp_in_o[2*i+1].wake   = ws_rsp_arb_out[i].wake;
+    assign rsp_in_o[2*i+1].sig    = ws_rsp_arb_out[i].sig;
+    assign rsp_in_o[2*i+1].error  = ws_rsp_arb_out[i].error;
+    assign rsp_in_o[2*i+1].credit = credit_rx[2*i+1];
+    assign en_ready_rsp_arb[i]    = ready_rsp_in[2*i];
+    assign ws_ready_rsp_arb[i]    = ready_rsp_in[2*i+1];
+  end
+
+  for (genvar i = 0; i < IN_PORTS; i++) begin: gen_rsp_in
+    fractal_sync_credit #(
+      .FLOW_CTRL   ( FLOW_CTRL  ),
+      .MAX_CREDITS ( FIFO_DEPTH )
+    ) i_credit (
+      .clk_i                          ,
+      .rst_ni                         ,
+      .credit_i ( req_in_i[i].credit ),
+      .send_i   ( rsp_in_o[i].wake   ),
+      .ready_o  ( ready_rsp_in[i]    )
+    );
   end
 
   fractal_sync_arbiter #(
@@ -269,7 +325,8 @@ module fractal_sync_1d
     .pop_o     ( en_pop_rsp_arb   ),
     .empty_i   ( en_empty_rsp_arb ),
     .element_i ( en_rsp_arb_in    ),
-    .element_o ( en_rsp_arb_out   )
+    .element_o ( en_rsp_arb_out   ),
+    .ready_i   ( en_ready_rsp_arb )
   );
 
   fractal_sync_arbiter #(
@@ -283,7 +340,8 @@ module fractal_sync_1d
     .pop_o     ( ws_pop_rsp_arb   ),
     .empty_i   ( ws_empty_rsp_arb ),
     .element_i ( ws_rsp_arb_in    ),
-    .element_o ( ws_rsp_arb_out   )
+    .element_o ( ws_rsp_arb_out   ),
+    .ready_i   ( ws_ready_rsp_arb )
   );
 
 /*******************************************************/
@@ -345,9 +403,11 @@ module fractal_sync_1d
     .local_empty_o       ( local_empty     ),
     .local_rsp_o         ( local_rsp       ),
     .local_pop_i         ( local_pop       ),
+    .local_push_o        ( local_push      ),
     .remote_empty_o      ( remote_empty    ),
     .remote_req_o        ( remote_req      ),
     .remote_pop_i        ( remote_pop      ),
+    .remote_push_o       ( remote_push     ),
     .detected_error_o    (                 )
   );
 
@@ -21,10 +21,10 @@
  *
  * Parameters:
  *  NODE_TYPE            - Node type of control core (horizontal, vertical, 2D, root)
- *  RF_TYPE              - Remote RF type (Directly Mapped or CAM)
- *  ARBITER_TYPE         - Arbiter type (Fully Associative or Directly Mapped wrap-around/alternating order)
+ *  RF_TYPE              - Remote RF type (Directly Mapped, CAM or hashed Set-Associative)
+ *  ARBITER_TYPE         - Arbiter type (Fully Associative, Directly Mapped wrap-around/alternating order or Parallel-Prefix)
  *  N_LOCAL_REGS         - Number of register in the local RF
- *  N_REMOTE_LINES       - Number of CAM lines in a CAM-based remote RF
+ *  N_REMOTE_LINES       - Number of lines in a CAM-based or set-associative remote RF
  *  AGGREGATE_WIDTH      - Width of the aggr field
  *  ID_WIDTH             - Width of the id field
  *  LVL_OFFSET           - Level offset from first node of the syncrhonization tree: 0 for nodes at level 1, 1 for nodes at level 2, ...
@@ -38,6 +38,7 @@
  *  REMOTE_FIFO_COMB_OUT - 1: Output remote FIFO with fall-through; 0: sequential remote FIFO
  *  IN_PORTS             - Number of RX (input) ports
  *  OUT_PORTS            - Number of TX (output) ports
+ *  FLOW_CTRL            - 1: Credit-based flow control on every link (full FIFOs stall the sender); 0: none
  *
  * Interface signals:
  *  > req_in_i  - Synchronization request (input)
@@ -70,7 +71,8 @@ module fractal_sync_2d
   localparam int unsigned                 IN_V_PORTS           = IN_PORTS/2,
   parameter int unsigned                  OUT_PORTS            = IN_PORTS/2,
   localparam int unsigned                 OUT_H_PORTS          = OUT_PORTS/2,
-  localparam int unsigned                 OUT_V_PORTS          = OUT_PORTS/2
+  localparam int unsigned                 OUT_V_PORTS          = OUT_PORTS/2,
+  parameter bit                           FLOW_CTRL            = 1'b0
 )(
   input  logic           clk_i,
   input  logic           rst_ni,
@@ -123,6 +125,7 @@ module fractal_sync_2d
   logic           h_empty_rx[IN_H_PORTS];
   fsync_req_out_t h_req_rx[IN_H_PORTS];
   logic           h_pop_rx[IN_H_PORTS];
+  logic           h_credit_rx[IN_H_PORTS];
 
   fsync_req_in_t  v_sampled_req_in[IN_V_PORTS];
   logic           v_check_rx[IN_V_PORTS];
@@ -133,14 +136,19 @@ module fractal_sync_2d
   logic           v_empty_rx[IN_V_PORTS];
   fsync_req_out_t v_req_rx[IN_V_PORTS];
   logic           v_pop_rx[IN_V_PORTS];
+  logic           v_credit_rx[IN_V_PORTS];
 
   logic           h_pop_req_arb[H_REQ_ARB_PORTS];
   logic           h_empty_req_arb[H_REQ_ARB_PORTS];
   fsync_req_out_t h_req_arb[H_REQ_ARB_PORTS];
+  fsync_req_out_t h_req_out[OUT_H_PORTS];
+  logic           h_ready_req_out[OUT_H_PORTS];
 
   logic           v_pop_req_arb[V_REQ_ARB_PORTS];
   logic           v_empty_req_arb[V_REQ_ARB_PORTS];
   fsync_req_out_t v_req_arb[V_REQ_ARB_PORTS];
+  fsync_req_out_t v_req_out[OUT_V_PORTS];
+  logic           v_ready_req_out[OUT_V_PORTS];
 
   fsync_rsp_t h_sampled_rsp_out[OUT_H_PORTS];
   logic       h_check_tx[OUT_H_PORTS];
@@ -164,6 +172,7 @@ module fractal_sync_2d
   logic       h_ws_empty_tx[OUT_H_PORTS];
   fsync_rsp_t h_ws_rsp_tx[OUT_H_PORTS];
   logic       h_ws_pop_tx[OUT_H_PORTS];
+  logic       h_credit_tx[OUT_H_PORTS];
 
   logic       v_en_empty_tx[OUT_V_PORTS];
   fsync_rsp_t v_en_rsp_tx[OUT_V_PORTS];
@@ -171,6 +180,7 @@ module fractal_sync_2d
   logic       v_ws_empty_tx[OUT_V_PORTS];
   fsync_rsp_t v_ws_rsp_tx[OUT_V_PORTS];
   logic       v_ws_pop_tx[OUT_V_PORTS];
+  logic       v_credit_tx[OUT_V_PORTS];
 
   logic       h_en_pop_rsp_arb[H_RSP_ARB_PORTS];
   logic       h_en_empty_rsp_arb[H_RSP_ARB_PORTS];
@@ -180,6 +190,9 @@ module fractal_sync_2d
   logic       h_ws_empty_rsp_arb[H_RSP_ARB_PORTS];
   fsync_rsp_t h_ws_rsp_arb_in[H_RSP_ARB_PORTS];
   fsync_rsp_t h_ws_rsp_arb_out[H_WS_IN_PORTS];
+  logic       h_ready_rsp_in[IN_H_PORTS];
+  logic       h_en_ready_rsp_arb[H_EN_IN_PORTS];
+  logic       h_ws_ready_rsp_arb[H_WS_IN_PORTS];
 
   logic       v_en_pop_rsp_arb[V_RSP_ARB_PORTS];
   logic       v_en_empty_rsp_arb[V_RSP_ARB_PORTS];
@@ -189,6 +202,9 @@ module fractal_sync_2d
   logic       v_ws_empty_rsp_arb[V_RSP_ARB_PORTS];
   fsync_rsp_t v_ws_rsp_arb_in[V_RSP_ARB_PORTS];
   fsync_rsp_t v_ws_rsp_arb_out[V_WS_IN_PORTS];
+  logic       v_ready_rsp_in[IN_V_PORTS];
+  logic       v_en_ready_rsp_arb[V_EN_IN_PORTS];
+  logic       v_ws_ready_rsp_arb[V_WS_IN_PORTS];
 
   fsync_req_in_t sampled_req_in[IN_PORTS];
   logic          check_rx[IN_PORTS];
@@ -205,10 +221,12 @@ module fractal_sync_2d
   logic           remote_empty[IN_PORTS];
   fsync_req_out_t remote_req[IN_PORTS];
   logic           remote_pop[IN_PORTS];
+  logic           remote_push[IN_PORTS];
 
   logic       local_empty[IN_PORTS];
   fsync_rsp_t local_rsp[IN_PORTS];
   logic       local_pop[IN_PORTS];
+  logic       local_push[IN_PORTS];
   logic[1:0]  local_pop_q[IN_PORTS];
   logic[1:0]  local_pop_d[IN_PORTS];
 
@@ -224,19 +242,23 @@ module fractal_sync_2d
       .fsync_req_out_t ( fsync_req_out_t      ),
       .COMB_IN         ( /*DO NOT OVERWRITE*/ ),
       .FIFO_DEPTH      ( FIFO_DEPTH           ),
-      .FIFO_COMB_OUT   ( RX_FIFO_COMB_OUT     )
+      .FIFO_COMB_OUT   ( RX_FIFO_COMB_OUT     ),
+      .FLOW_CTRL       ( FLOW_CTRL            )
     ) i_h_rx (
-      .clk_i                                    ,
-      .rst_ni                                   ,
-      .req_i             ( h_req_in_i[i]       ),
-      .sampled_req_o     ( h_sampled_req_in[i] ),
-      .check_propagate_o ( h_check_rx[i]       ),
-      .local_o           ( h_local_rx[i]       ),
-      .root_o            ( h_root_rx[i]        ),
-      .error_overflow_o  ( h_overflow_rx[i]    ),
-      .empty_o           ( h_empty_rx[i]       ),
-      .req_o             ( h_req_rx[i]         ),
-      .pop_i             ( h_pop_rx[i]         )
+      .clk_i                                                   ,
+      .rst_ni                                                  ,
+      .req_i             ( h_req_in_i[i]                      ),
+      .sampled_req_o     ( h_sampled_req_in[i]                ),
+      .check_propagate_o ( h_check_rx[i]                      ),
+      .local_o           ( h_local_rx[i]                      ),
+      .root_o            ( h_root_rx[i]                       ),
+      .error_overflow_o  ( h_overflow_rx[i]                   ),
+      .empty_o           ( h_empty_rx[i]                      ),
+      .req_o             ( h_req_rx[i]                        ),
+      .pop_i             ( h_pop_rx[i]                        ),
+      .cc_push_i         ( local_push[2*i] | remote_push[2*i] ),
+      .cc_pop_i          ( {remote_pop[2*i], local_pop[2*i]}  ),
+      .credit_o          ( h_credit_rx[i]                     )
     );
   end
 
@@ -246,19 +268,23 @@ module fractal_sync_2d
       .fsync_req_out_t ( fsync_req_out_t      ),
       .COMB_IN         ( /*DO NOT OVERWRITE*/ ),
       .FIFO_DEPTH      ( FIFO_DEPTH           ),
-      .FIFO_COMB_OUT   ( RX_FIFO_COMB_OUT     )
+      .FIFO_COMB_OUT   ( RX_FIFO_COMB_OUT     ),
+      .FLOW_CTRL       ( FLOW_CTRL            )
     ) i_v_rx (
-      .clk_i                                    ,
-      .rst_ni                                   ,
-      .req_i             ( v_req_in_i[i]       ),
-      .sampled_req_o     ( v_sampled_req_in[i] ),
-      .check_propagate_o ( v_check_rx[i]       ),
-      .local_o           ( v_local_rx[i]       ),
-      .root_o            ( v_root_rx[i]        ),
-      .error_overflow_o  ( v_overflow_rx[i]    ),
-      .empty_o           ( v_empty_rx[i]       ),
-      .req_o             ( v_req_rx[i]         ),
-      .pop_i             ( v_pop_rx[i]         )
+      .clk_i                                                       ,
+      .rst_ni                                                      ,
+      .req_i             ( v_req_in_i[i]                          ),
+      .sampled_req_o     ( v_sampled_req_in[i]                    ),
+      .check_propagate_o ( v_check_rx[i]                          ),
+      .local_o           ( v_local_rx[i]                          ),
+      .root_o            ( v_root_rx[i]                           ),
+      .error_overflow_o  ( v_overflow_rx[i]                       ),
+      .empty_o           ( v_empty_rx[i]                          ),
+      .req_o             ( v_req_rx[i]                            ),
+      .pop_i             ( v_pop_rx[i]                            ),
+      .cc_push_i         ( local_push[2*i+1] | remote_push[2*i+1] ),
+      .cc_pop_i          ( {remote_pop[2*i+1], local_pop[2*i+1]}  ),
+      .credit_o          ( v_credit_rx[i]                         )
     );
   end
   
@@ -285,9 +311,27 @@ module fractal_sync_2d
     .pop_o     ( h_pop_req_arb   ),
     .empty_i   ( h_empty_req_arb ),
     .element_i ( h_req_arb       ),
-    .element_o ( h_req_out_o     )
+    .element_o ( h_req_out       ),
+    .ready_i   ( h_ready_req_out )
   );
 
+  for (genvar i = 0; i < OUT_H_PORTS; i++) begin: gen_h_req_out
+    assign h_req_out_o[i].sync   = h_req_out[i].sync;
+    assign h_req_out_o[i].sig    = h_req_out[i].sig;
+    assign h_req_out_o[i].credit = h_credit_tx[i];
+
+    fractal_sync_credit #(
+      .FLOW_CTRL   ( FLOW_CTRL  ),
+      .MAX_CREDITS ( FIFO_DEPTH )
+    ) i_credit (
+      .clk_i                              ,
+      .rst_ni                             ,
+      .credit_i ( h_rsp_out_i[i].credit ),
+      .send_i   ( h_req_out[i].sync     ),
+      .ready_o  ( h_ready_req_out[i]    )
+    );
+  end
+
   for (genvar i = 0; i < IN_V_PORTS; i++) begin
     assign v_pop_rx[i]                   = v_pop_req_arb[i+IN_V_PORTS];
     assign v_empty_req_arb[i+IN_V_PORTS] = v_empty_rx[i];
@@ -305,9 +349,27 @@ module fractal_sync_2d
     .pop_o     ( v_pop_req_arb   ),
     .empty_i   ( v_empty_req_arb ),
     .element_i ( v_req_arb       ),
-    .element_o ( v_req_out_o     )
+    .element_o ( v_req_out       ),
+    .ready_i   ( v_ready_req_out )
   );
 
+  for (genvar i = 0; i < OUT_V_PORTS; i++) begin: gen_v_req_out
+    assign v_req_out_o[i].sync   = v_req_out[i].sync;
+    assign v_req_out_o[i].sig    = v_req_out[i].sig;
+    assign v_req_out_o[i].credit = v_credit_tx[i];
+
+    fractal_sync_credit #(
+      .FLOW_CTRL   ( FLOW_CTRL  ),
+      .MAX_CREDITS ( FIFO_DEPTH )
+    ) i_credit (
+      .clk_i                              ,
+      .rst_ni                             ,
+      .credit_i ( v_rsp_out_i[i].credit ),
+      .send_i   ( v_req_out[i].sync     ),
+      .ready_o  ( v_ready_req_out[i]    )
+    );
+  end
+
 /*******************************************************/
 /**                   RX Arbiter End                  **/
 /*******************************************************/
@@ -321,7 +383,8 @@ module fractal_sync_2d
       .fsync_rsp_t   ( fsync_rsp_t          ),
       .COMB_IN       ( /*DO NOT OVERWRITE*/ ),
       .FIFO_DEPTH    ( FIFO_DEPTH           ),
-      .FIFO_COMB_OUT ( TX_FIFO_COMB_OUT     )
+      .FIFO_COMB_OUT ( TX_FIFO_COMB_OUT     ),
+      .FLOW_CTRL     ( FLOW_CTRL            )
     ) i_h_tx (
       .clk_i                                       ,
       .rst_ni                                      ,
@@ -337,7 +400,8 @@ module fractal_sync_2d
       .en_pop_i            ( h_en_pop_tx[i]       ),
       .ws_empty_o          ( h_ws_empty_tx[i]     ),
       .ws_rsp_o            ( h_ws_rsp_tx[i]       ),
-      .ws_pop_i            ( h_ws_pop_tx[i]       )
+      .ws_pop_i            ( h_ws_pop_tx[i]       ),
+      .credit_o            ( h_credit_tx[i]       )
     );
   end
 
@@ -348,7 +412,8 @@ module fractal_sync_2d
       .fsync_rsp_t   ( fsync_rsp_t          ),
       .COMB_IN       ( /*DO NOT OVERWRITE*/ ),
       .FIFO_DEPTH    ( FIFO_DEPTH           ),
-      .FIFO_COMB_OUT ( TX_FIFO_COMB_OUT     )
+      .FIFO_COMB_OUT ( TX_FIFO_COMB_OUT     ),
+      .FLOW_CTRL     ( FLOW_CTRL            )
     ) i_v_tx (
       .clk_i                                       ,
       .rst_ni                                      ,
@@ -364,7 +429,8 @@ module fractal_sync_2d
       .en_pop_i            ( v_en_pop_tx[i]       ),
       .ws_empty_o          ( v_ws_empty_tx[i]     ),
       .ws_rsp_o            ( v_ws_rsp_tx[i]       ),
-      .ws_pop_i            ( v_ws_pop_tx[i]       )
+      .ws_pop_i            ( v_ws_pop_tx[i]       ),
+      .credit_o            ( v_credit_tx[i]       )
     );
   end
 
@@ -385,8 +451,29 @@ module fractal_sync_2d
   end
 
   for (genvar i = 0; i < IN_H_PORTS/2; i++) begin
-    assign h_rsp_in_o[2*i]   = h_en_rsp_arb_out[i];
-    assign h_rsp_in_o[2*i+1] = h_ws_rsp_arb_out[i];
+    assign h_rsp_in_o[2*i].wake     = h_en_rsp_arb_out[i].wake;
+    assign h_rsp_in_o[2*i].sig      = h_en_rsp_arb_out[i].sig;
+    assign h_rsp_in_o[2*i].error    = h_en_rsp_arb_out[i].error;
+    assign h_rsp_in_o[2*i].credit   = h_credit_rx[2*i];
+    assign h_rsp_in_o[2*i+1].wake   = h_ws_rsp_arb_out[i].wake;
+    assign h_rsp_in_o[2*i+1].sig    = h_ws_rsp_arb_out[i].sig;
+    assign h_rsp_in_o[2*i+1].error  = h_ws_rsp_arb_out[i].error;
+    assign h_rsp_in_o[2*i+1].credit = h_credit_rx[2*i+1];
+    assign h_en_ready_rsp_arb[i]    = h_ready_rsp_in[2*i];
+    assign h_ws_ready_rsp_arb[i]    = h_ready_rsp_in[2*i+1];
+  end
+
+  for (genvar i = 0; i < IN_H_PORTS; i++) begin: gen_h_rsp_in
+    fractal_sync_credit #(
+      .FLOW_CTRL   ( FLOW_CTRL  ),
+      .MAX_CREDITS ( FIFO_DEPTH )
+    ) i_credit (
+      .clk_i                            ,
+      .rst_ni                           ,
+      .credit_i ( h_req_in_i[i].credit ),
+      .send_i   ( h_rsp_in_o[i].wake   ),
+      .ready_o  ( h_ready_rsp_in[i]    )
+    );
   end
 
   fractal_sync_arbiter #(
@@ -400,7 +487,8 @@ module fractal_sync_2d
     .pop_o     ( h_en_pop_rsp_arb   ),
     .empty_i   ( h_en_empty_rsp_arb ),
     .element_i ( h_en_rsp_arb_in    ),
-    .element_o ( h_en_rsp_arb_out   )
+    .element_o ( h_en_rsp_arb_out   ),
+    .ready_i   ( h_en_ready_rsp_arb )
   );
 
   fractal_sync_arbiter #(
@@ -414,7 +502,8 @@ module fractal_sync_2d
     .pop_o     ( h_ws_pop_rsp_arb   ),
     .empty_i   ( h_ws_empty_rsp_arb ),
     .element_i ( h_ws_rsp_arb_in    ),
-    .element_o ( h_ws_rsp_arb_out   )
+    .element_o ( h_ws_rsp_arb_out   ),
+    .ready_i   ( h_ws_ready_rsp_arb )
   );
 
   for (genvar i = 0; i < OUT_V_PORTS; i++) begin
@@ -428,8 +517,29 @@ module fractal_sync_2d
   end
 
   for (genvar i = 0; i < IN_V_PORTS/2; i++) begin
-    assign v_rsp_in_o[2*i]   = v_en_rsp_arb_out[i];
-    assign v_rsp_in_o[2*i+1] = v_ws_rsp_arb_out[i];
+    assign v_rsp_in_o[2*i].wake     = v_en_rsp_arb_out[i].wake;
+    assign v_rsp_in_o[2*i].sig      = v_en_rsp_arb_out[i].sig;
+    assign v_rsp_in_o[2*i].error    = v_en_rsp_arb_out[i].error;
+    assign v_rsp_in_o[2*i].credit   = v_credit_rx[2*i];
+    assign v_rsp_in_o[2*i+1].wake   = v_ws_rsp_arb_out[i].wake;
+    assign v_rsp_in_o[2*i+1].sig    = v_ws_rsp_arb_out[i].sig;
+    assign v_rsp_in_o[2*i+1].error  = v_ws_rsp_arb_out[i].error;
+    assign v_rsp_in_o[2*i+1].credit = v_credit_rx[2*i+1];
+    assign v_en_ready_rsp_arb[i]    = v_ready_rsp_in[2*i];
+    assign v_ws_ready_rsp_arb[i]    = v_ready_rsp_in[2*i+1];
+  end
+
+  for (genvar i = 0; i < IN_V_PORTS; i++) begin: gen_v_rsp_in
+    fractal_sync_credit #(
+      .FLOW_CTRL   ( FLOW_CTRL  ),
+      .MAX_CREDITS ( FIFO_DEPTH )
+    ) i_credit (
+      .clk_i                            ,
+      .rst_ni                           ,
+      .credit_i ( v_req_in_i[i].credit ),
+      .send_i   ( v_rsp_in_o[i].wake   ),
+      .ready_o  ( v_ready_rsp_in[i]    )
+    );
   end
 
   fractal_sync_arbiter #(
@@ -443,7 +553,8 @@ module fractal_sync_2d
     .pop_o     ( v_en_pop_rsp_arb   ),
     .empty_i   ( v_en_empty_rsp_arb ),
     .element_i ( v_en_rsp_arb_in    ),
-    .element_o ( v_en_rsp_arb_out   )
+    .element_o ( v_en_rsp_arb_out   ),
+    .ready_i   ( v_en_ready_rsp_arb )
   );
 
   fractal_sync_arbiter #(
@@ -457,7 +568,8 @@ module fractal_sync_2d
     .pop_o     ( v_ws_pop_rsp_arb   ),
     .empty_i   ( v_ws_empty_rsp_arb ),
     .element_i ( v_ws_rsp_arb_in    ),
-    .element_o ( v_ws_rsp_arb_out   )
+    .element_o ( v_ws_rsp_arb_out   ),
+    .ready_i   ( v_ws_ready_rsp_arb )
   );
 
 /*******************************************************/
@@ -565,9 +677,11 @@ module fractal_sync_2d
     .local_empty_o       ( local_empty     ),
     .local_rsp_o         ( local_rsp       ),
     .local_pop_i         ( local_pop       ),
+    .local_push_o        ( local_push      ),
     .remote_empty_o      ( remote_empty    ),
     .remote_req_o        ( remote_req      ),
     .remote_pop_i        ( remote_pop      ),
+    .remote_push_o       ( remote_push     ),
     .detected_error_o    (                 )
   );
 
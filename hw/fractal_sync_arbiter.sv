@@ -29,6 +29,7 @@
  *  > empty_i   - Indicates empty input FIFO
  *  > element_i - Input element
  *  < element_o - Output element
+ *  > ready_i   - Indicates that the output can accept an element (no grant otherwise)
  */
 
 module fractal_sync_arbiter_fa
@@ -45,7 +46,8 @@ module fractal_sync_arbiter_fa
   input  logic     empty_i[IN_PORTS],
   input  arbiter_t element_i[IN_PORTS],
 
-  output arbiter_t element_o[OUT_PORTS]
+  output arbiter_t element_o[OUT_PORTS],
+  input  logic     ready_i[OUT_PORTS]
 );
 
 /*******************************************************/
@@ -106,6 +108,7 @@ module fractal_sync_arbiter_fa
     sel_idx     = '{default: '0};
     clear_mask  = 1'b0;
     for (int unsigned i = 0; i < OUT_PORTS; i++) begin
+      if (!ready_i[i]) continue;
       for (int unsigned j = 0; j < IN_PORTS; j++) begin
         if (pending_req[j] & c_mask[j]) begin
           pending_req[j] = 1'b0;
@@ -151,6 +154,201 @@ module fractal_sync_arbiter_fa
 
 endmodule: fractal_sync_arbiter_fa
 
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Solderpad Hardware License, Version 0.51 
+ * (the "License"); you may not use this file except in compliance 
+ * with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: SHL-0.51
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization parallel-prefix arbiter: same grants as the fully-associative arbiter with log-depth logic
+ * Asynchronous valid low reset
+ *
+ * The k-th ready output is granted the k-th pending input, masked inputs first (round-robin), in index order: the rank
+ * of every input and output is a prefix count (Kogge-Stone scan), so that no grant depends on the grants of the lower
+ * outputs.
+ *
+ * Parameters:
+ *  IN_PORTS  - Number of input ports
+ *  OUT_PORTS - Number of output ports
+ *  arbiter_t - Arbiter element type
+ *
+ * Interface signals:
+ *  < pop_o     - Pop input element
+ *  > empty_i   - Indicates empty input FIFO
+ *  > element_i - Input element
+ *  < element_o - Output element
+ *  > ready_i   - Indicates that the output can accept an element (no grant otherwise)
+ */
+
+module fractal_sync_arbiter_pp
+  import fractal_sync_pkg::*;
+#(
+  parameter int unsigned IN_PORTS  = 1,
+  parameter int unsigned OUT_PORTS = 1,
+  parameter type         arbiter_t = logic
+)(
+  input  logic     clk_i,
+  input  logic     rst_ni,
+
+  output logic     pop_o[IN_PORTS],
+  input  logic     empty_i[IN_PORTS],
+  input  arbiter_t element_i[IN_PORTS],
+
+  output arbiter_t element_o[OUT_PORTS],
+  input  logic     ready_i[OUT_PORTS]
+);
+
+/*******************************************************/
+/**                Assertions Beginning               **/
+/*******************************************************/
+
+`ifndef SYNTHESIS
+  initial FRACTAL_SYNC_ARBITER_IN_PORTS: assert (IN_PORTS > 0) else $fatal("IN_PORTS must be > 0");
+  initial FRACTAL_SYNC_ARBITER_OUT_PORTS: assert (OUT_PORTS > 0) else $fatal("OUT_PORTS must be > 0");
+`endif /* SYNTHESIS */
+
+/*******************************************************/
+/**                   Assertions End                  **/
+/*******************************************************/
+/**        Parameters and Definitions Beginning       **/
+/*******************************************************/
+
+  localparam int unsigned IN_LVLS  = $clog2(IN_PORTS);
+  localparam int unsigned OUT_LVLS = $clog2(OUT_PORTS);
+  localparam int unsigned CNT_W    = $clog2(((IN_PORTS > OUT_PORTS) ? IN_PORTS : OUT_PORTS) + 1);
+
+/*******************************************************/
+/**           Parameters and Definitions End          **/
+/*******************************************************/
+/**             Internal Signals Beginning            **/
+/*******************************************************/
+
+  logic            req_arb[IN_PORTS];
+  logic            gnt_arb[IN_PORTS];
+
+  logic            c_mask[IN_PORTS];
+  logic            n_mask[IN_PORTS];
+  logic            clear_mask;
+
+  logic[CNT_W-1:0] masked_cnt[IN_LVLS+1][IN_PORTS];
+  logic[CNT_W-1:0] unmasked_cnt[IN_LVLS+1][IN_PORTS];
+  logic[CNT_W-1:0] ready_cnt[OUT_LVLS+1][OUT_PORTS];
+
+  logic[CNT_W-1:0] n_masked;
+  logic[CNT_W-1:0] n_ready;
+  logic[CNT_W-1:0] in_rank[IN_PORTS];
+  logic[CNT_W-1:0] out_rank[OUT_PORTS];
+
+  logic            sel[OUT_PORTS][IN_PORTS];
+
+/*******************************************************/
+/**                Internal Signals End               **/
+/*******************************************************/
+/**            Hardwired Signals Beginning            **/
+/*******************************************************/
+
+  for (genvar i = 0; i < IN_PORTS; i++) begin: gen_req_pop
+    assign req_arb[i] = ~empty_i[i];
+    assign pop_o[i]   = gnt_arb[i];
+  end
+
+/*******************************************************/
+/**               Hardwired Signals End               **/
+/*******************************************************/
+/**               Prefix Counts Beginning             **/
+/*******************************************************/
+
+  for (genvar j = 0; j < IN_PORTS; j++) begin: gen_in_cnt
+    assign masked_cnt[0][j]   = CNT_W'(req_arb[j] &  c_mask[j]);
+    assign unmasked_cnt[0][j] = CNT_W'(req_arb[j] & ~c_mask[j]);
+  end
+
+  for (genvar l = 0; l < IN_LVLS; l++) begin: gen_in_scan
+    for (genvar j = 0; j < IN_PORTS; j++) begin: gen_in_scan_node
+      if (j >= 2**l) begin: gen_sum
+        assign masked_cnt[l+1][j]   = masked_cnt[l][j]   + masked_cnt[l][j-2**l];
+        assign unmasked_cnt[l+1][j] = unmasked_cnt[l][j] + unmasked_cnt[l][j-2**l];
+      end else begin: gen_pass
+        assign masked_cnt[l+1][j]   = masked_cnt[l][j];
+        assign unmasked_cnt[l+1][j] = unmasked_cnt[l][j];
+      end
+    end
+  end
+
+  for (genvar i = 0; i < OUT_PORTS; i++) begin: gen_out_cnt
+    assign ready_cnt[0][i] = CNT_W'(ready_i[i]);
+  end
+
+  for (genvar l = 0; l < OUT_LVLS; l++) begin: gen_out_scan
+    for (genvar i = 0; i < OUT_PORTS; i++) begin: gen_out_scan_node
+      if (i >= 2**l) begin: gen_sum
+        assign ready_cnt[l+1][i] = ready_cnt[l][i] + ready_cnt[l][i-2**l];
+      end else begin: gen_pass
+        assign ready_cnt[l+1][i] = ready_cnt[l][i];
+      end
+    end
+  end
+
+  assign n_masked   = masked_cnt[IN_LVLS][IN_PORTS-1];
+  assign n_ready    = ready_cnt[OUT_LVLS][OUT_PORTS-1];
+  assign clear_mask = n_ready > n_masked;
+
+/*******************************************************/
+/**                  Prefix Counts End                **/
+/*******************************************************/
+/**                 Arbiter Beginning                 **/
+/*******************************************************/
+
+  // Rank among the pending inputs (masked ones first) and among the ready outputs
+  for (genvar j = 0; j < IN_PORTS; j++) begin: gen_in_rank
+    assign in_rank[j] = c_mask[j] ? masked_cnt[IN_LVLS][j] - 1 : n_masked + unmasked_cnt[IN_LVLS][j] - 1;
+    assign gnt_arb[j] = req_arb[j] & (in_rank[j] < n_ready);
+  end
+
+  for (genvar i = 0; i < OUT_PORTS; i++) begin: gen_out_rank
+    assign out_rank[i] = ready_cnt[OUT_LVLS][i] - 1;
+    for (genvar j = 0; j < IN_PORTS; j++) begin: gen_sel
+      assign sel[i][j] = ready_i[i] & gnt_arb[j] & (in_rank[j] == out_rank[i]);
+    end
+  end
+
+  always_comb begin: next_mask_logic
+    for (int unsigned i = 0; i < IN_PORTS; i++)
+      n_mask[i] = (c_mask[i] & clear_mask & gnt_arb[i]) | (~gnt_arb[i] & (c_mask[i] | clear_mask));
+  end
+
+  always_ff @(posedge clk_i, negedge rst_ni) begin: current_mask_logic
+    if (!rst_ni) c_mask <= '{default: 1'b1};
+    else         c_mask <= n_mask;
+  end
+
+  // One-hot AND-OR output multiplexers
+  always_comb begin: out_el_logic
+    for (int unsigned i = 0; i < OUT_PORTS; i++) begin
+      element_o[i] = '0;
+      for (int unsigned j = 0; j < IN_PORTS; j++)
+        element_o[i] |= element_i[j] & {$bits(arbiter_t){sel[i][j]}};
+    end
+  end
+
+/*******************************************************/
+/**                    Arbiter End                    **/
+/*******************************************************/
+
+endmodule: fractal_sync_arbiter_pp
+
 /*
  * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
  *
@@ -176,13 +374,14 @@ endmodule: fractal_sync_arbiter_fa
  *  IN_PORTS     - Number of input ports
  *  OUT_PORTS    - Number of output ports
  *  arbiter_t    - Arbiter element type
- *  ARBITER_TYPE - Arbiter type (Fully Associative or Directly Mapped wrap-around/alternating order)
+ *  ARBITER_TYPE - Arbiter type (Fully Associative, Directly Mapped wrap-around/alternating order or Parallel-Prefix)
  *
  * Interface signals:
  *  < pop_o     - Pop input element
  *  > empty_i   - Indicates empty input FIFO
  *  > element_i - Input element
  *  < element_o - Output element
+ *  > ready_i   - Indicates that the output can accept an element (no grant otherwise)
  */
 
 module fractal_sync_arbiter
@@ -200,7 +399,8 @@ module fractal_sync_arbiter
   input  logic     empty_i[IN_PORTS],
   input  arbiter_t element_i[IN_PORTS],
 
-  output arbiter_t element_o[OUT_PORTS]
+  output arbiter_t element_o[OUT_PORTS],
+  input  logic     ready_i[OUT_PORTS]
 );
 
 /*******************************************************/
@@ -237,6 +437,12 @@ module fractal_sync_arbiter
       .OUT_PORTS ( OUT_PORTS ),
       .arbiter_t ( arbiter_t )
     ) i_fractal_sync_arbiter (.*);
+  end else if (ARBITER_TYPE == fractal_sync_pkg::PP_ARB) begin: gen_pp_arbiter
+    fractal_sync_arbiter_pp #(
+      .IN_PORTS  ( IN_PORTS  ),
+      .OUT_PORTS ( OUT_PORTS ),
+      .arbiter_t ( arbiter_t )
+    ) i_fractal_sync_arbiter (.*);
   end else if (ARBITER_TYPE == fractal_sync_pkg::DM_WA_ARB) begin: gen_dm_wa_arbiter
     for (genvar i = 0; i < OUT_PORTS; i++) begin: gen_port_arbiters
       localparam int unsigned INPUT_PORTS  = (i <  N_LEFTOVER_ARB) ? N_LEFTOVER_PORTS : N_LEFTOVERN_PORTS;
@@ -245,8 +451,10 @@ module fractal_sync_arbiter
       logic     empty_in[INPUT_PORTS];
       arbiter_t element_in[INPUT_PORTS];
       arbiter_t element_out[OUTPUT_PORTS];
+      logic     ready_out[OUTPUT_PORTS];
 
       assign element_o[i] = element_out[0]; // Single output port
+      assign ready_out[0] = ready_i[i];
 
       fractal_sync_arbiter_fa #(
         .IN_PORTS  ( INPUT_PORTS  ),
@@ -258,7 +466,8 @@ module fractal_sync_arbiter
         .pop_o     ( pop_out     ),
         .empty_i   ( empty_in    ),
         .element_i ( element_in  ),
-        .element_o ( element_out )
+        .element_o ( element_out ),
+        .ready_i   ( ready_out   )
       );
     end
 
@@ -278,8 +487,10 @@ module fractal_sync_arbiter
       logic     empty_in[INPUT_PORTS];
       arbiter_t element_in[INPUT_PORTS];
       arbiter_t element_out[OUTPUT_PORTS];
+      logic     ready_out[OUTPUT_PORTS];
 
       assign element_o[i] = element_out[0]; // Single output port
+      assign ready_out[0] = ready_i[i];
 
       fractal_sync_arbiter_fa #(
         .IN_PORTS  ( INPUT_PORTS  ),
@@ -291,7 +502,8 @@ module fractal_sync_arbiter
         .pop_o     ( pop_out     ),
         .empty_i   ( empty_in    ),
         .element_i ( element_in  ),
-        .element_o ( element_out )
+        .element_o ( element_out ),
+        .ready_i   ( ready_out   )
       );
     end
 
@@ -21,9 +21,9 @@
  *
  * Parameters:
  *  NODE_TYPE            - Node type of control core (horizontal, vertical, 2D, root)
- *  RF_TYPE              - Remote RF type (Directly Mapped or CAM)
+ *  RF_TYPE              - Remote RF type (Directly Mapped, CAM or hashed Set-Associative)
  *  N_LOCAL_REGS         - Number of register in teh local RF
- *  N_REMOTE_LINES       - Number of CAM lines in a CAM-based remote RF
+ *  N_REMOTE_LINES       - Number of lines in a CAM-based or set-associative remote RF
  *  AGGREGATE_WIDTH      - Width of the aggr field
  *  ID_WIDTH             - Width of the id field
  *  LVL_OFFSET           - Level offset from first node of the syncrhonization tree: 0 for nodes at level 1, 1 for nodes at level 2, ...
@@ -51,9 +51,11 @@
  *  > local_empty_o       - Indicates that local FIFO (associated with local RF) is empty
  *  > local_rsp_o         - Local synchronization response (input) FIFO
  *  > local_pop_i         - Pop synch. rsp.
+ *  < local_push_o        - Indicates that a synch. rsp. is pushed in the local FIFO (flow control)
  *  > remote_empty_o      - Indicates that remote FIFO (associated with remote RF) is empty
  *  > remote_req_o        - Remote synch. req. (output) FIFO
  *  > remote_pop_i        - Pop synch. req.
+ *  < remote_push_o       - Indicates that a synch. req. is pushed in the remote FIFO (flow control)
  *  > detected_error_o    - Detected error associated with RX/TX transaction
  */
 
@@ -108,10 +110,12 @@ module fractal_sync_cc
   output logic           local_empty_o[N_FIFOS],
   output fsync_rsp_in_t  local_rsp_o[N_FIFOS],
   input  logic           local_pop_i[N_FIFOS],
+  output logic           local_push_o[N_FIFOS],
 
   output logic           remote_empty_o[N_FIFOS],
   output fsync_req_out_t remote_req_o[N_FIFOS],
   input  logic           remote_pop_i[N_FIFOS],
+  output logic           remote_push_o[N_FIFOS],
 
   output logic           detected_error_o[N_PORTS]
 );
@@ -122,7 +126,7 @@ module fractal_sync_cc
 
 `ifndef SYNTHESIS
   initial FRACTAL_SYNC_CC_LOCAL_REGS: assert (N_LOCAL_REGS > 0) else $fatal("N_LOCAL_REGS must be > 0");
-  initial FRACTAL_SYNC_CC_REMOTE_LINES: assert (RF_TYPE == fractal_sync_pkg::CAM_RF -> N_REMOTE_LINES > 0) else $fatal("N_REMOTE_LINES must be > 0 for CAM Remote Register File");
+  initial FRACTAL_SYNC_CC_REMOTE_LINES: assert (RF_TYPE != fractal_sync_pkg::DM_RF -> N_REMOTE_LINES > 0) else $fatal("N_REMOTE_LINES must be > 0 for CAM and SA Remote Register Files");
   initial FRACTAL_SYNC_CC_AGGR_W: assert (AGGREGATE_WIDTH > 0) else $fatal("AGGREGATE_WIDTH must be > 0");
   initial FRACTAL_SYNC_CC_ID_W: assert (ID_WIDTH > 0) else $fatal("ID_WIDTH must be > 0");
   initial FRACTAL_SYNC_CC_AGGR: assert ($bits(req_i[0].sig.aggr) == $bits(remote_req_o[0].sig.aggr)+1) else $fatal("Input req. aggregate with must be 1 more than output");
@@ -290,6 +294,7 @@ module fractal_sync_cc
     assign remote_req[i].sync     = req_i[i].sync;
     assign remote_req[i].sig.aggr = req_i[i].sig.aggr >> 1;
     assign remote_req[i].sig.id   = req_i[i].sig.id;
+    assign remote_req[i].credit   = 1'b0;
   end
 
   for (genvar i = 0; i < N_RX_PORTS; i++) begin: gen_rsp
@@ -297,6 +302,7 @@ module fractal_sync_cc
     assign local_rsp[i].sig.lvl = level[i];
     assign local_rsp[i].sig.id  = req_i[i].sig.id;
     assign local_rsp[i].error   = rf_error[i];
+    assign local_rsp[i].credit  = 1'b0;
   end
 
 /*******************************************************/
@@ -701,6 +707,11 @@ module fractal_sync_cc
 /**                  FIFOs Beginning                  **/
 /*******************************************************/
 
+  for (genvar i = 0; i < N_FIFOS; i++) begin: gen_fifo_push
+    assign local_push_o[i]  = push_local[i];
+    assign remote_push_o[i] = push_remote[i];
+  end
+
   for (genvar i = 0; i < N_FIFOS; i++) begin: gen_local_fifos
     fractal_sync_fifo #(
       .FIFO_DEPTH ( FIFO_DEPTH          ),
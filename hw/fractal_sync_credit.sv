@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Solderpad Hardware License, Version 0.51 
+ * (the "License"); you may not use this file except in compliance 
+ * with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: SHL-0.51
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization credit counter (sender side of a flow-controlled link)
+ * Asynchronous valid low reset
+ *
+ * The receiver (fractal_sync_rx/fractal_sync_tx) hands out one credit per free FIFO slot, one credit per cycle,
+ * through the credit bit of the reverse channel; the sender may only transmit while it holds a credit.
+ * The counter saturates at MAX_CREDITS: a deeper receiver (or a CU, which returns a credit every cycle) is then
+ * used with MAX_CREDITS slots. Without flow control the link is always ready and the credits are ignored.
+ *
+ * Parameters:
+ *  FLOW_CTRL   - 1: Credit-based flow control; 0: always ready
+ *  MAX_CREDITS - Maximum number of credits held by the sender
+ *
+ * Interface signals:
+ *  > credit_i - Credit returned by the receiver
+ *  > send_i   - Transaction sent through the link (consumes a credit)
+ *  < ready_o  - Indicates that a transaction can be sent
+ */
+
+module fractal_sync_credit
+  import fractal_sync_pkg::*;
+#(
+  parameter bit          FLOW_CTRL   = 1'b0,
+  parameter int unsigned MAX_CREDITS = 1
+)(
+  input  logic clk_i,
+  input  logic rst_ni,
+
+  input  logic credit_i,
+  input  logic send_i,
+  output logic ready_o
+);
+
+/*******************************************************/
+/**                Assertions Beginning               **/
+/*******************************************************/
+
+`ifndef SYNTHESIS
+  initial FRACTAL_SYNC_CREDIT_MAX_CREDITS: assert (MAX_CREDITS > 0) else $fatal("MAX_CREDITS must be > 0");
+`endif /* SYNTHESIS */
+
+/*******************************************************/
+/**                   Assertions End                  **/
+/*******************************************************/
+/**        Parameters and Definitions Beginning       **/
+/*******************************************************/
+
+  localparam int unsigned CNT_WIDTH = $clog2(MAX_CREDITS+1);
+
+/*******************************************************/
+/**           Parameters and Definitions End          **/
+/*******************************************************/
+/**              Credit Counter Beginning             **/
+/*******************************************************/
+
+  if (FLOW_CTRL) begin: gen_credit_cnt
+    logic[CNT_WIDTH-1:0] c_credits, n_credits;
+
+    always_ff @(posedge clk_i, negedge rst_ni) begin: credit_reg
+      if (!rst_ni) c_credits <= '0;
+      else         c_credits <= n_credits;
+    end
+
+    always_comb begin: next_credit_logic
+      n_credits = c_credits;
+      if (send_i)                              n_credits = n_credits - 1;
+      if (credit_i && n_credits < MAX_CREDITS) n_credits = n_credits + 1;
+    end
+
+    assign ready_o = (c_credits > 0) ? 1'b1 : 1'b0;
+  end else begin: gen_no_credit_cnt
+    assign ready_o = 1'b1;
+  end
+
+/*******************************************************/
+/**                 Credit Counter End                **/
+/*******************************************************/
+
+endmodule: fractal_sync_credit
@@ -20,7 +20,7 @@
  * Asynchronous valid low reset
  *
  * Parameters:
- *  FIFO_DEPTH - Maximum number of elements that can be present in the FIFO
+ *  FIFO_DEPTH - Maximum number of elements that can be present in the FIFO (storage rounded up to a power of 2)
  *  fifo_t     - FIFO element type
  *  COMB_OUT   - Combinational output based on input (fall-through)
  *
@@ -66,7 +66,8 @@ module fractal_sync_fifo
 /*******************************************************/
 
   localparam int unsigned ADDR_WIDTH = $clog2(FIFO_DEPTH);
-  localparam int unsigned PTR_WIDTH  = (ADDR_WIDTH == 0) ? 1 : ADDR_WIDTH-1;
+  localparam int unsigned PTR_WIDTH  = (ADDR_WIDTH == 0) ? 1 : ADDR_WIDTH;
+  localparam int unsigned N_ENTRIES  = 2**ADDR_WIDTH;
 
 /*******************************************************/
 /**           Parameters and Definitions End          **/
@@ -81,7 +82,7 @@ module fractal_sync_fifo
   logic[PTR_WIDTH-1:0] w_ptr;
   logic[PTR_WIDTH-1:0] r_ptr;
 
-  fifo_t fifo[FIFO_DEPTH];
+  fifo_t fifo[N_ENTRIES];
 
   logic empty_fifo;
 
@@ -31,6 +31,12 @@
  *  lvl (level)        - Indicates the level of origin of synchronization response
  *  id_rsp             - Indicated the id of the barrier of the synchronization response
  *  error              - Indicates error
+ *  sync_ready         - Indicates that a synchronization request can be issued (outstanding barriers, see fractal_sync_sp)
+ *  wait_req           - Indicates wait for a barrier previously arrived at with sync (split-phase, see fractal_sync_sp)
+ *  lvl_wait           - Indicates the level of the barrier waited for
+ *  id_wait            - Indicates the id of the barrier waited for
+ *  done               - Indicates that the wait is satisfied (the wake of the barrier is consumed)
+ *  done_error         - Indicates error of the consumed wake
  */
 
 interface fractal_sync_if
@@ -50,6 +56,13 @@ interface fractal_sync_if
   logic[ID_WIDTH-1:0]   id_rsp;
   logic                 error;
 
+  logic                 sync_ready;
+  logic                 wait_req;
+  logic[LVL_WIDTH-1:0]  lvl_wait;
+  logic[ID_WIDTH-1:0]   id_wait;
+  logic                 done;
+  logic                 done_error;
+
   modport mst_port (
     output sync,
     output aggr,
@@ -57,7 +70,13 @@ interface fractal_sync_if
     input  wake,
     input  lvl,
     input  id_rsp,
-    input  error
+    input  error,
+    input  sync_ready,
+    output wait_req,
+    output lvl_wait,
+    output id_wait,
+    input  done,
+    input  done_error
   );
 
   modport slv_port (
@@ -67,7 +86,13 @@ interface fractal_sync_if
     output wake,
     output lvl,
     output id_rsp,
-    output error
+    output error,
+    output sync_ready,
+    input  wait_req,
+    input  lvl_wait,
+    input  id_wait,
+    output done,
+    output done_error
   );
 
 endinterface: fractal_sync_if
\ No newline at end of file
@@ -173,7 +173,8 @@ endmodule: fractal_sync_mp_rf
  *  > idx_i       - Register index
  *  > idx_valid_i - Indicates that the selected index is valid
  *  < present_o   - Indicates whether register at selected index is present (asynchronous)
- *  < sd_o        - Source/destination ports of the synchronization transaction stored: sticky, will remember all ports
+ *  < sd_o        - Source/destination ports of the synchronization transaction stored: remembers all ports until the
+ *                  register is cleared (a stale port would misroute the wakes of the next barrier on the register)
  */
 
 module fractal_sync_mp_rf_br #(
@@ -271,7 +272,7 @@ module fractal_sync_mp_rf_br #(
         if ((check_i[j] | set_i[j]) && (reg_idx[j] == i)) sd_mask[i] = sd_i[j];
       end
     end
-    assign sd_reg_d[i] = sd_reg_q[i] | sd_mask[i];
+    assign sd_reg_d[i] = (check_reg[i] & reg_q[i]) ? '0 : sd_reg_q[i] | sd_mask[i];
   end
 
   always_comb begin: reg_d_logic
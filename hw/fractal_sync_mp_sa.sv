@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Solderpad Hardware License, Version 0.51
+ * (the "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: SHL-0.51
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization multi-port hashed set-associative RF with back-routing registers: synch. check; asynch. present
+ * Asynchronous valid low reset
+ *
+ * The set of a signature is the XOR of its low and next index-wide bit slices, and the rest of the signature is the tag
+ * stored in the ways of the set: each port compares its tag against the N_WAYS lines of its set only. Signatures that
+ * find their set full spill over to N_SPILL_LINES fully associative CAM lines; when both are full they are dropped, as
+ * in a full CAM.
+ *
+ * Parameters:
+ *  N_LINES       - Number of set-associative lines in the register file (N_LINES/N_WAYS must be a power of 2)
+ *  N_WAYS        - Number of ways of a set (clipped to N_LINES; raised so that there are at most half as many sets as signatures)
+ *  N_SPILL_LINES - Number of spill CAM lines
+ *  SIG_WIDTH     - Width of the signature
+ *  N_PORTS       - Number of ports
+ *
+ * Interface signals:
+ *  > check_i     - Check (synchronous) the signature (function of level and barrier id) and update RF accordingly (present AND valid => clear; NOT(present) AND valid => set)
+ *  > set_i       - Set (synchronous) the signature (valid => set); set_i has lower priority than check_i
+ *  > sd_i        - Source/destination ports of the synchronization transaction to be stored for back-routing
+ *  > sig_i       - Signature
+ *  > sig_valid_i - Indicates that the signature is valid
+ *  < present_o   - Indicates whether signature is present (asynchronous)
+ *  < sd_o        - Source/destination ports of the synchronization transaction stored: sticky, will remember all ports
+ */
+
+module fractal_sync_mp_sa_br
+  import fractal_sync_pkg::*;
+#(
+  parameter int unsigned  N_LINES       = 2,
+  parameter int unsigned  N_WAYS        = 2,
+  parameter int unsigned  N_SPILL_LINES = 2,
+  parameter int unsigned  SIG_WIDTH     = 1,
+  localparam int unsigned SD_WIDTH      = fractal_sync_pkg::SD_WIDTH,
+  parameter int unsigned  N_PORTS       = 2
+)(
+  input  logic                clk_i,
+  input  logic                rst_ni,
+
+  input  logic                check_i[N_PORTS],
+  input  logic                set_i[N_PORTS],
+  input  logic[SD_WIDTH-1:0]  sd_i[N_PORTS],
+  input  logic[SIG_WIDTH-1:0] sig_i[N_PORTS],
+  input  logic                sig_valid_i[N_PORTS],
+  output logic                present_o[N_PORTS],
+  output logic[SD_WIDTH-1:0]  sd_o[N_PORTS]
+);
+
+/*******************************************************/
+/**                Assertions Beginning               **/
+/*******************************************************/
+
+`ifndef SYNTHESIS
+  initial FRACTAL_SYNC_MP_SA_WAYS: assert (N_LINES > 0 && N_WAYS > 0) else $fatal("N_LINES and N_WAYS must be > 0");
+  initial FRACTAL_SYNC_MP_SA_SETS: assert (N_SETS*N_SET_WAYS == N_LINES && 2**IDX_BITS == N_SETS) else $fatal("N_LINES/N_WAYS must be a power of 2");
+  initial FRACTAL_SYNC_MP_SA_LINES: assert (N_LINES+N_SPILL_LINES >= N_PORTS/2) else $fatal("N_LINES+N_SPILL_LINES must be >= N_PORTS/2");
+`endif /* SYNTHESIS */
+
+/*******************************************************/
+/**                   Assertions End                  **/
+/*******************************************************/
+/**        Parameters and Definitions Beginning       **/
+/*******************************************************/
+
+  localparam int unsigned N_MIN_WAYS  = (N_WAYS < N_LINES) ? N_WAYS : N_LINES;
+  localparam int unsigned N_MAX_SETS  = 2**(SIG_WIDTH-1);
+  localparam int unsigned N_SETS      = (N_LINES/N_MIN_WAYS < N_MAX_SETS) ? N_LINES/N_MIN_WAYS : N_MAX_SETS;
+  localparam int unsigned N_SET_WAYS  = N_LINES/N_SETS;
+  localparam int unsigned IDX_BITS    = $clog2(N_SETS);
+  localparam int unsigned IDX_WIDTH   = (IDX_BITS > 0) ? IDX_BITS : 1;
+  localparam int unsigned TAG_WIDTH   = SIG_WIDTH-IDX_BITS;
+  localparam int unsigned SPILL_LINES = (N_SPILL_LINES > 0) ? N_SPILL_LINES : 1;
+
+/*******************************************************/
+/**           Parameters and Definitions End          **/
+/*******************************************************/
+/**             Internal Signals Beginning            **/
+/*******************************************************/
+
+  logic[IDX_WIDTH-1:0] set_idx[N_PORTS];
+  logic[TAG_WIDTH-1:0] tag[N_PORTS];
+
+  logic                way_valid_d[N_SETS][N_SET_WAYS];
+  logic                way_valid_q[N_SETS][N_SET_WAYS];
+  logic[TAG_WIDTH-1:0] way_tag_d[N_SETS][N_SET_WAYS];
+  logic[TAG_WIDTH-1:0] way_tag_q[N_SETS][N_SET_WAYS];
+  logic[SD_WIDTH-1:0]  way_sd_d[N_SETS][N_SET_WAYS];
+  logic[SD_WIDTH-1:0]  way_sd_q[N_SETS][N_SET_WAYS];
+
+  logic                spill_valid_d[SPILL_LINES];
+  logic                spill_valid_q[SPILL_LINES];
+  logic[SIG_WIDTH-1:0] spill_sig_d[SPILL_LINES];
+  logic[SIG_WIDTH-1:0] spill_sig_q[SPILL_LINES];
+  logic[SD_WIDTH-1:0]  spill_sd_d[SPILL_LINES];
+  logic[SD_WIDTH-1:0]  spill_sd_q[SPILL_LINES];
+
+  logic way_hit[N_PORTS][N_SET_WAYS];
+  logic spill_hit[N_PORTS][SPILL_LINES];
+
+  logic store[N_PORTS];
+
+/*******************************************************/
+/**                Internal Signals End               **/
+/*******************************************************/
+/**                 Set Index Beginning               **/
+/*******************************************************/
+
+  for (genvar i = 0; i < N_PORTS; i++) begin: gen_set_idx_tag
+    if (IDX_BITS == 0) begin: gen_single_set
+      assign set_idx[i] = '0;
+    end else begin: gen_hashed_set
+      for (genvar b = 0; b < IDX_BITS; b++) begin: gen_idx_bit
+        if (b+IDX_BITS < SIG_WIDTH) assign set_idx[i][b] = sig_i[i][b] ^ sig_i[i][b+IDX_BITS];
+        else                        assign set_idx[i][b] = sig_i[i][b];
+      end
+    end
+    assign tag[i] = sig_i[i][SIG_WIDTH-1:IDX_BITS];
+  end
+
+/*******************************************************/
+/**                    Set Index End                  **/
+/*******************************************************/
+/**                  Look-up Beginning                **/
+/*******************************************************/
+
+  for (genvar i = 0; i < N_PORTS; i++) begin: gen_hit
+    for (genvar w = 0; w < N_SET_WAYS; w++) begin: gen_way_hit
+      assign way_hit[i][w] = way_valid_q[set_idx[i]][w] & (way_tag_q[set_idx[i]][w] == tag[i]) & sig_valid_i[i];
+    end
+    for (genvar l = 0; l < SPILL_LINES; l++) begin: gen_spill_hit
+      assign spill_hit[i][l] = (N_SPILL_LINES > 0) & spill_valid_q[l] & (spill_sig_q[l] == sig_i[i]) & sig_valid_i[i];
+    end
+  end
+
+  always_comb begin: present_sd_logic
+    present_o = '{default: 1'b0};
+    sd_o      = '{default: '0};
+    for (int unsigned i = 0; i < N_PORTS; i++) begin
+      for (int unsigned w = 0; w < N_SET_WAYS; w++) begin
+        if (way_hit[i][w]) begin present_o[i] = 1'b1; sd_o[i] = way_sd_q[set_idx[i]][w]; end
+      end
+      for (int unsigned l = 0; l < SPILL_LINES; l++) begin
+        if (spill_hit[i][l]) begin present_o[i] = 1'b1; sd_o[i] = spill_sd_q[l]; end
+      end
+    end
+  end
+
+/*******************************************************/
+/**                     Look-up End                   **/
+/*******************************************************/
+/**                   Update Beginning                **/
+/*******************************************************/
+
+  // Hit lines are freed (check) or updated (set), missing signatures are stored in a free way of their set first, then
+  // in a free spill line: lines freed in the same cycle can be written again
+  always_comb begin: free_update_store_logic
+    way_valid_d   = way_valid_q;
+    way_tag_d     = way_tag_q;
+    way_sd_d      = way_sd_q;
+    spill_valid_d = spill_valid_q;
+    spill_sig_d   = spill_sig_q;
+    spill_sd_d    = spill_sd_q;
+    for (int unsigned i = 0; i < N_PORTS; i++) begin
+      store[i] = (check_i[i] | set_i[i]) & sig_valid_i[i];
+      for (int unsigned w = 0; w < N_SET_WAYS; w++) begin
+        if (way_hit[i][w]) begin
+          store[i] = 1'b0;
+          if      (check_i[i]) begin way_valid_d[set_idx[i]][w] = 1'b0; way_sd_d[set_idx[i]][w] = '0;                                 end
+          else if (set_i[i])   begin                                    way_sd_d[set_idx[i]][w] = way_sd_q[set_idx[i]][w] | sd_i[i]; end
+        end
+      end
+      for (int unsigned l = 0; l < SPILL_LINES; l++) begin
+        if (spill_hit[i][l]) begin
+          store[i] = 1'b0;
+          if      (check_i[i]) begin spill_valid_d[l] = 1'b0; spill_sd_d[l] = '0;                   end
+          else if (set_i[i])   begin                          spill_sd_d[l] = spill_sd_q[l] | sd_i[i]; end
+        end
+      end
+    end
+    for (int unsigned i = 0; i < N_PORTS; i++) begin
+      for (int unsigned w = 0; w < N_SET_WAYS; w++) begin
+        if (store[i] & ~way_valid_d[set_idx[i]][w]) begin
+          way_valid_d[set_idx[i]][w] = 1'b1;
+          way_tag_d[set_idx[i]][w]   = tag[i];
+          way_sd_d[set_idx[i]][w]    = sd_i[i];
+          store[i]                   = 1'b0;
+        end
+      end
+      for (int unsigned l = 0; l < N_SPILL_LINES; l++) begin
+        if (store[i] & ~spill_valid_d[l]) begin
+          spill_valid_d[l] = 1'b1;
+          spill_sig_d[l]   = sig_i[i];
+          spill_sd_d[l]    = sd_i[i];
+          store[i]         = 1'b0;
+        end
+      end
+    end
+  end
+
+  always_ff @(posedge clk_i, negedge rst_ni) begin: way_regs
+    if (!rst_ni) begin
+      way_valid_q <= '{default: '{default: 1'b0}};
+      way_tag_q   <= '{default: '{default: '0}};
+      way_sd_q    <= '{default: '{default: '0}};
+    end else begin
+      way_valid_q <= way_valid_d;
+      way_tag_q   <= way_tag_d;
+      way_sd_q    <= way_sd_d;
+    end
+  end
+
+  always_ff @(posedge clk_i, negedge rst_ni) begin: spill_regs
+    if (!rst_ni) begin
+      spill_valid_q <= '{default: 1'b0};
+      spill_sig_q   <= '{default: '0};
+      spill_sd_q    <= '{default: '0};
+    end else begin
+      spill_valid_q <= spill_valid_d;
+      spill_sig_q   <= spill_sig_d;
+      spill_sd_q    <= spill_sd_d;
+    end
+  end
+
+/*******************************************************/
+/**                      Update End                   **/
+/*******************************************************/
+
+endmodule: fractal_sync_mp_sa_br
@@ -73,11 +73,12 @@ module fractal_sync_neighbor
 
   for (genvar i = 0; i < N_PORTS; i++) begin: gen_sync_req_rsp
     assign sync_req[i]      = req_i[i].sync;
-    assign id_d[i]          = sync_req[i] ? req_i[i].sig.id : '0;
+    assign id_d[i]          = sync_req[i] ? req_i[i].sig.id : id_q[i];
     assign rsp_o[i].wake    = wake;
     assign rsp_o[i].sig.lvl = 1'b1;
     assign rsp_o[i].sig.id  = (wake & same_id) ? id[0] : '0;
     assign rsp_o[i].error   = (wake & same_id) ? 1'b0  : 1'b1;
+    assign rsp_o[i].credit  = 1'b0;
   end
 
   assign clear_sync_req = &sync_present_q;
@@ -37,16 +37,24 @@ package fractal_sync_pkg;
     RF2D = 1
   } rf_dim_e;
 
-  typedef enum logic {
+  // Remote RF types: CAM, Directly Mapped, hashed Set-Associative with spill CAM lines
+  typedef enum logic[1:0] {
     CAM_RF = 0,
-    DM_RF  = 1
+    DM_RF  = 1,
+    SA_RF  = 2
   } remote_rf_e;
 
-  // Arbiter types: Fully Associative, Directly Mapped wrap-around order, Directly Mapped alternating order
+  // Ways of a set and spill lines of the set-associative remote RF
+  localparam int unsigned SA_RF_WAYS        = 2;
+  localparam int unsigned SA_RF_SPILL_LINES = 2;
+
+  // Arbiter types: Fully Associative, Directly Mapped wrap-around order, Directly Mapped alternating order, Parallel-Prefix
+  // (same grants as Fully Associative)
   typedef enum logic[1:0] {
     FA_ARB     = 0,
     DM_WA_ARB  = 1,
-    DM_ALT_ARB = 2
+    DM_ALT_ARB = 2,
+    PP_ARB     = 3
   } arb_e;
 
   typedef enum logic[2:0] {
@@ -20,11 +20,13 @@
  * Asynchronous valid low reset
  *
  * Parameters:
- *  RF_TYPE     - Register file type (Directly Mapped or CAM)
- *  LEVEL_WIDTH - Width needed to represent the possible levels
- *  ID_WIDTH    - Width needed to represent the possible barrier ids
- *  N_CAM_LINES - Number of CAM lines (used if RF is CAM-based)
- *  N_PORTS     - Number of ports
+ *  RF_TYPE       - Register file type (Directly Mapped, CAM or hashed Set-Associative)
+ *  LEVEL_WIDTH   - Width needed to represent the possible levels
+ *  ID_WIDTH      - Width needed to represent the possible barrier ids
+ *  N_CAM_LINES   - Number of CAM lines (used if RF is CAM-based) or of set-associative lines (used if RF is SA)
+ *  N_SA_WAYS     - Number of ways of a set (used if RF is SA)
+ *  N_SPILL_LINES - Number of spill CAM lines for full sets (used if RF is SA)
+ *  N_PORTS       - Number of ports
  *
  * Interface signals:
  *  > level_i   - Level of synchronization requests/responses
@@ -42,12 +44,14 @@
 module fractal_sync_1d_remote_rf 
   import fractal_sync_pkg::*; 
 #(
-  parameter fractal_sync_pkg::remote_rf_e RF_TYPE     = fractal_sync_pkg::CAM_RF,
-  parameter int unsigned                  LEVEL_WIDTH = 1,
-  parameter int unsigned                  ID_WIDTH    = 1,
-  parameter int unsigned                  N_CAM_LINES = 1,
-  localparam int unsigned                 SD_WIDTH    = fractal_sync_pkg::SD_WIDTH,
-  parameter int unsigned                  N_PORTS     = 2
+  parameter fractal_sync_pkg::remote_rf_e RF_TYPE       = fractal_sync_pkg::CAM_RF,
+  parameter int unsigned                  LEVEL_WIDTH   = 1,
+  parameter int unsigned                  ID_WIDTH      = 1,
+  parameter int unsigned                  N_CAM_LINES   = 1,
+  parameter int unsigned                  N_SA_WAYS     = fractal_sync_pkg::SA_RF_WAYS,
+  parameter int unsigned                  N_SPILL_LINES = fractal_sync_pkg::SA_RF_SPILL_LINES,
+  localparam int unsigned                 SD_WIDTH      = fractal_sync_pkg::SD_WIDTH,
+  parameter int unsigned                  N_PORTS       = 2
 )(
   input  logic                  clk_i,
   input  logic                  rst_ni,
@@ -236,6 +240,24 @@ module fractal_sync_1d_remote_rf
       .present_o   ( present_o ),
       .sd_o        ( sd_o      )
     );
+  end else if (RF_TYPE == fractal_sync_pkg::SA_RF) begin: gen_sa_rf
+    fractal_sync_mp_sa_br #(
+      .N_LINES       ( N_CAM_LINES   ),
+      .N_WAYS        ( N_SA_WAYS     ),
+      .N_SPILL_LINES ( N_SPILL_LINES ),
+      .SIG_WIDTH     ( SIG_WIDTH     ),
+      .N_PORTS       ( N_PORTS       )
+    ) i_sa_rf (
+      .clk_i                    ,
+      .rst_ni                   ,
+      .check_i     ( check_rf  ),
+      .set_i       ( set_rf    ),
+      .sd_i        ( sd_rf     ),
+      .sig_i       ( local_sig ),
+      .sig_valid_i ( valid_sig ),
+      .present_o   ( present_o ),
+      .sd_o        ( sd_o      )
+    );
   end
 `ifndef SYNTHESIS
   else $fatal("Unsupported Remote Register File Type");
@@ -269,11 +291,13 @@ endmodule: fractal_sync_1d_remote_rf
  * Asynchronous valid low reset
  *
  * Parameters:
- *  RF_TYPE     - Register file type (Directly Mapped or CAM)
- *  LEVEL_WIDTH - Width needed to represent the possible levels
- *  ID_WIDTH    - Width needed to represent the possible barrier ids
- *  N_CAM_LINES - Number of CAM lines (used if RF is CAM-based)
- *  N_PORTS     - Number of ports
+ *  RF_TYPE       - Register file type (Directly Mapped, CAM or hashed Set-Associative)
+ *  LEVEL_WIDTH   - Width needed to represent the possible levels
+ *  ID_WIDTH      - Width needed to represent the possible barrier ids
+ *  N_CAM_LINES   - Number of CAM lines (used if RF is CAM-based) or of set-associative lines (used if RF is SA)
+ *  N_SA_WAYS     - Number of ways of a set (used if RF is SA)
+ *  N_SPILL_LINES - Number of spill CAM lines for full sets (used if RF is SA)
+ *  N_PORTS       - Number of ports
  *
  * Interface signals:
  *  > level_i   - Level of synchronization requests/responses
@@ -289,13 +313,15 @@ endmodule: fractal_sync_1d_remote_rf
  */
 
 module fractal_sync_2d_remote_rf #(
-  parameter fractal_sync_pkg::remote_rf_e RF_TYPE     = fractal_sync_pkg::CAM_RF,
-  parameter int unsigned                  LEVEL_WIDTH = 1,
-  parameter int unsigned                  ID_WIDTH    = 1,
-  parameter int unsigned                  N_CAM_LINES = 2,
-  localparam int unsigned                 SD_WIDTH    = fractal_sync_pkg::SD_WIDTH,
-  parameter int unsigned                  N_H_PORTS   = 2,
-  parameter int unsigned                  N_V_PORTS   = 2
+  parameter fractal_sync_pkg::remote_rf_e RF_TYPE       = fractal_sync_pkg::CAM_RF,
+  parameter int unsigned                  LEVEL_WIDTH   = 1,
+  parameter int unsigned                  ID_WIDTH      = 1,
+  parameter int unsigned                  N_CAM_LINES   = 2,
+  parameter int unsigned                  N_SA_WAYS     = fractal_sync_pkg::SA_RF_WAYS,
+  parameter int unsigned                  N_SPILL_LINES = fractal_sync_pkg::SA_RF_SPILL_LINES,
+  localparam int unsigned                 SD_WIDTH      = fractal_sync_pkg::SD_WIDTH,
+  parameter int unsigned                  N_H_PORTS     = 2,
+  parameter int unsigned                  N_V_PORTS     = 2
 )(
   input  logic                  clk_i,
   input  logic                  rst_ni,
@@ -347,11 +373,13 @@ module fractal_sync_2d_remote_rf #(
 /*******************************************************/
 
   fractal_sync_1d_remote_rf #(
-    .RF_TYPE     ( RF_TYPE       ),
-    .LEVEL_WIDTH ( LEVEL_WIDTH   ),
-    .ID_WIDTH    ( ID_WIDTH      ),
-    .N_CAM_LINES ( N_H_CAM_LINES ),
-    .N_PORTS     ( N_H_PORTS     )
+    .RF_TYPE       ( RF_TYPE       ),
+    .LEVEL_WIDTH   ( LEVEL_WIDTH   ),
+    .ID_WIDTH      ( ID_WIDTH      ),
+    .N_CAM_LINES   ( N_H_CAM_LINES ),
+    .N_SA_WAYS     ( N_SA_WAYS     ),
+    .N_SPILL_LINES ( N_SPILL_LINES ),
+    .N_PORTS       ( N_H_PORTS     )
   ) i_rf_h (
     .clk_i                    ,
     .rst_ni                   ,
@@ -374,11 +402,13 @@ module fractal_sync_2d_remote_rf #(
 /*******************************************************/
 
   fractal_sync_1d_remote_rf #(
-    .RF_TYPE     ( RF_TYPE       ),
-    .LEVEL_WIDTH ( LEVEL_WIDTH   ),
-    .ID_WIDTH    ( ID_WIDTH      ),
-    .N_CAM_LINES ( N_V_CAM_LINES ),
-    .N_PORTS     ( N_V_PORTS     )
+    .RF_TYPE       ( RF_TYPE       ),
+    .LEVEL_WIDTH   ( LEVEL_WIDTH   ),
+    .ID_WIDTH      ( ID_WIDTH      ),
+    .N_CAM_LINES   ( N_V_CAM_LINES ),
+    .N_SA_WAYS     ( N_SA_WAYS     ),
+    .N_SPILL_LINES ( N_SPILL_LINES ),
+    .N_PORTS       ( N_V_PORTS     )
   ) i_rf_v (
     .clk_i                    ,
     .rst_ni                   ,
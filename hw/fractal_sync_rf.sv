@@ -20,12 +20,12 @@
  * Asynchronous valid low reset
  *
  * Parameters:
- *  REMOTE_RF_TYPE - Remote register file type (Directly Mapped or CAM)
+ *  REMOTE_RF_TYPE - Remote register file type (Directly Mapped, CAM or hashed Set-Associative)
  *  EN_REMOTE_RF   - Enable/disable remote RF (for root node)
  *  N_LOCAL_REGS   - Number of registers in the local RF
  *  LEVEL_WIDTH    - Width needed to represent the possible levels
  *  ID_WIDTH       - Width needed to represent the possible barrier ids
- *  N_REMOTE_LINES - Number of CAM lines in a CAM-based remote RF
+ *  N_REMOTE_LINES - Number of lines in a CAM-based or set-associative remote RF
  *  N_PORTS        - Number of ports
  *
  * Interface signals:
@@ -181,12 +181,12 @@ endmodule: fractal_sync_1d_rf
  * Asynchronous valid low reset
  *
  * Parameters:
- *  REMOTE_RF_TYPE - Remote register file type (Directly Mapped or CAM)
+ *  REMOTE_RF_TYPE - Remote register file type (Directly Mapped, CAM or hashed Set-Associative)
  *  EN_REMOTE_RF   - Enable/disable remote RF (for root node)
  *  N_LOCAL_REGS   - Number of registers in the local RF
  *  LEVEL_WIDTH    - Width needed to represent the possible number of levels
  *  ID_WIDTH       - Width needed to represent the possible barrier ids
- *  N_REMOTE_LINES - Number of CAM lines in a CAM-based remote RF
+ *  N_REMOTE_LINES - Number of lines in a CAM-based or set-associative remote RF
  *  N_PORTS        - Number of ports
  *
   * Interface signals:
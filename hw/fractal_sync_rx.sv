@@ -25,6 +25,7 @@
  *  COMB_IN         - 1: Combinational datapath, 0: sample input
  *  FIFO_DEPTH      - Depth of the request FIFO
  *  FIFO_COMB_OUT   - 1: Output FIFO with fall-through; 0: sequential FIFO
+ *  FLOW_CTRL       - 1: Credit-based flow control (credits cover the request FIFO and the CC FIFOs of the port); 0: none
  *
  * Interface signals:
  *  > req_i             - Synchronization request
@@ -36,6 +37,9 @@
  *  < empty_o           - Indicates empty fifo
  *  < req_o             - Synchronization request propagated directly (without involvement of the control-core)
  *  > pop_i             - Pop current synchronization request
+ *  > cc_push_i         - Indicates that the (local) synch. req. has been stored in a CC (local/remote) FIFO
+ *  > cc_pop_i          - Pop of the CC FIFOs of the port ({remote, local})
+ *  < credit_o          - Credit returned to the sender (one free slot)
  */
 
 module fractal_sync_rx 
@@ -45,7 +49,8 @@ module fractal_sync_rx
   parameter type         fsync_req_out_t = logic,
   parameter bit          COMB_IN         = 1'b0,
   parameter int unsigned FIFO_DEPTH      = 1,
-  parameter bit          FIFO_COMB_OUT   = 1'b1
+  parameter bit          FIFO_COMB_OUT   = 1'b1,
+  parameter bit          FLOW_CTRL       = 1'b0
 )(
   // Request interface - in
   input  logic           clk_i,
@@ -60,7 +65,11 @@ module fractal_sync_rx
   // FIFO interface - out
   output logic           empty_o,
   output fsync_req_out_t req_o,
-  input  logic           pop_i
+  input  logic           pop_i,
+  // Flow control
+  input  logic           cc_push_i,
+  input  logic[1:0]      cc_pop_i,
+  output logic           credit_o
 );
 
 /*******************************************************/
@@ -75,6 +84,14 @@ module fractal_sync_rx
 /*******************************************************/
 /**                   Assertions End                  **/
 /*******************************************************/
+/**        Parameters and Definitions Beginning       **/
+/*******************************************************/
+
+  localparam int unsigned CREDIT_WIDTH = $clog2(FIFO_DEPTH+1);
+
+/*******************************************************/
+/**           Parameters and Definitions End          **/
+/*******************************************************/
 /**             Internal Signals Beginning            **/
 /*******************************************************/
   
@@ -119,6 +136,7 @@ module fractal_sync_rx
   assign sampled_out_req.sync     = sampled_req_o.sync;
   assign sampled_out_req.sig.aggr = sampled_req_o.sig.aggr >> 1;
   assign sampled_out_req.sig.id   = sampled_req_o.sig.id;
+  assign sampled_out_req.credit   = 1'b0;
 
   assign push = sampled_sync & propagate;
 
@@ -130,6 +148,28 @@ module fractal_sync_rx
 /*******************************************************/
 /**                    RX Logic End                   **/
 /*******************************************************/
+/**               Flow Control Beginning              **/
+/*******************************************************/
+
+  // A credit is held by every request stored in a FIFO of the port: requests that are not stored (e.g. first
+  // arrival of a barrier) give their credit back immediately. One credit per cycle is returned to the sender.
+  if (FLOW_CTRL) begin: gen_credit
+    logic[CREDIT_WIDTH-1:0] c_owed, n_owed;
+
+    always_ff @(posedge clk_i, negedge rst_ni) begin: owed_reg
+      if (!rst_ni) c_owed <= FIFO_DEPTH;
+      else         c_owed <= n_owed;
+    end
+
+    assign credit_o = (c_owed > 0) ? 1'b1 : 1'b0;
+    assign n_owed   = c_owed - credit_o + (sampled_sync & ~push & ~cc_push_i) + pop_i + cc_pop_i[0] + cc_pop_i[1];
+  end else begin: gen_no_credit
+    assign credit_o = 1'b0;
+  end
+
+/*******************************************************/
+/**                  Flow Control End                 **/
+/*******************************************************/
 /**                 REQ FIFO Beginning                **/
 /*******************************************************/
 
@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Solderpad Hardware License, Version 0.51
+ * (the "License"); you may not use this file except in compliance
+ * with the License. You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: SHL-0.51
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization split-phase (arrive/wait) CU endpoint with outstanding-barrier table
+ * Asynchronous valid low reset
+ *
+ * Sits between a CU and its port of the network and tracks up to N_BARRIERS barriers (level and id) per interface,
+ * so that a CU can have several distinct barriers in flight and receive their wakes out of order. An arrive (sync)
+ * allocates a pending line and is forwarded to the network; the wake of the network, a single-cycle pulse, marks the
+ * pending line of its barrier as woken until the CU consumes it with a wait for the same barrier. A wait is satisfied
+ * by a woken line or, bypassing the table, by the wake of the same cycle: a CU that waits right after arriving sees
+ * the same latency as a blocking synchronization. A wait polls when asserted for a single cycle and blocks when held
+ * until done.
+ * An arrive at a barrier that is still pending would be counted by the nodes as another participant: it is rejected
+ * (not forwarded), as are arrives with a full table (the CU should arrive only when ready_o). An arrive at a barrier
+ * with a woken line reuses the line: the CU has not waited for that wake (e.g. a blocking CU woken through rsp_o) and
+ * arrives again, so the stale wake is discarded instead of satisfying the next wait. Wakes without a pending line are
+ * latched in a free line and dropped (overflow_o) when the table is full. The raw wakes are still forwarded (rsp_o)
+ * for blocking CUs.
+ *
+ * Parameters:
+ *  N_BARRIERS      - Number of outstanding barriers (arrived at and not yet waited for)
+ *  LVL_OFFSET      - Level of the wake of a request with aggr = 1: 0 for the tree ports, 1 for the neighbor ports
+ *  fsync_req_t     - Synchronization request type
+ *  fsync_rsp_t     - Synchronization response type
+ *  fsync_rsp_sig_t - Synchronization response signature type (level and id)
+ *
+ * Interface signals:
+ *  > arrive_i   - Arrive (synchronization request of the CU)
+ *  < ready_o    - Indicates that the table can accept an arrive
+ *  < reject_o   - Indicates that the arrive has been rejected (barrier already pending or full table)
+ *  > wait_i     - Wait for the barrier of wait_sig_i: the woken line is consumed when done
+ *  > wait_sig_i - Level and id of the barrier waited for
+ *  < done_o     - Wait satisfied (wake), with the barrier and the error of the wake (asynchronous)
+ *  < rsp_o      - Raw synchronization response of the network
+ *  < overflow_o - Indicates that a wake has been dropped (full table)
+ *  < req_o      - Synchronization request to the network
+ *  > rsp_i      - Synchronization response of the network
+ */
+
+module fractal_sync_sp
+  import fractal_sync_pkg::*;
+#(
+  parameter int unsigned N_BARRIERS      = 2,
+  parameter int unsigned LVL_OFFSET      = 0,
+  parameter type         fsync_req_t     = logic,
+  parameter type         fsync_rsp_t     = logic,
+  parameter type         fsync_rsp_sig_t = logic
+)(
+  input  logic           clk_i,
+  input  logic           rst_ni,
+
+  input  fsync_req_t     arrive_i,
+  output logic           ready_o,
+  output logic           reject_o,
+  input  logic           wait_i,
+  input  fsync_rsp_sig_t wait_sig_i,
+  output fsync_rsp_t     done_o,
+  output fsync_rsp_t     rsp_o,
+  output logic           overflow_o,
+
+  output fsync_req_t     req_o,
+  input  fsync_rsp_t     rsp_i
+);
+
+/*******************************************************/
+/**                Assertions Beginning               **/
+/*******************************************************/
+
+`ifndef SYNTHESIS
+  initial FRACTAL_SYNC_SP_BARRIERS: assert (N_BARRIERS > 0) else $fatal("N_BARRIERS must be > 0");
+`endif /* SYNTHESIS */
+
+/*******************************************************/
+/**                   Assertions End                  **/
+/*******************************************************/
+/**             Internal Signals Beginning            **/
+/*******************************************************/
+
+  logic           c_valid[N_BARRIERS];
+  logic           n_valid[N_BARRIERS];
+  logic           c_woken[N_BARRIERS];
+  logic           n_woken[N_BARRIERS];
+  fsync_rsp_sig_t c_sig[N_BARRIERS];
+  fsync_rsp_sig_t n_sig[N_BARRIERS];
+  logic           c_error[N_BARRIERS];
+  logic           n_error[N_BARRIERS];
+
+  fsync_rsp_sig_t arrive_sig;
+  logic           bypass;
+  logic           wake_used;
+  logic           store;
+  logic           accept;
+  logic           alloc;
+
+/*******************************************************/
+/**                Internal Signals End               **/
+/*******************************************************/
+/**            Hardwired Signals Beginning            **/
+/*******************************************************/
+
+  assign rsp_o = rsp_i;
+
+  always_comb begin: req_logic
+    req_o      = arrive_i;
+    req_o.sync = arrive_i.sync & accept;
+  end
+
+  assign reject_o = arrive_i.sync & ~accept;
+
+  always_comb begin: ready_logic
+    ready_o = 1'b0;
+    for (int unsigned i = 0; i < N_BARRIERS; i++) ready_o |= ~c_valid[i];
+  end
+
+  assign bypass = rsp_i.wake & (rsp_i.sig == wait_sig_i);
+
+/*******************************************************/
+/**               Hardwired Signals End               **/
+/*******************************************************/
+/**              Level Encoder Beginning              **/
+/*******************************************************/
+
+  always_comb begin: arrive_lvl_enc
+    arrive_sig.lvl = '0;
+    for (int j = $bits(arrive_i.sig.aggr)-1; j >= 0; j--) begin
+      if (arrive_i.sig.aggr[j] == 1'b1) begin
+        arrive_sig.lvl = j+LVL_OFFSET;
+        break;
+      end
+    end
+  end
+  assign arrive_sig.id = arrive_i.sig.id;
+
+/*******************************************************/
+/**                 Level Encoder End                 **/
+/*******************************************************/
+/**                   Table Beginning                 **/
+/*******************************************************/
+
+  // Wait first (a woken line, or a pending line woken in the same cycle), then the wake marks the pending line of its
+  // barrier (or a free line), then the arrive takes over the stale woken line of its barrier or allocates a pending
+  // line: lines freed in the same cycle can be reused
+  always_comb begin: table_logic
+    n_valid       = c_valid;
+    n_woken       = c_woken;
+    n_sig         = c_sig;
+    n_error       = c_error;
+    done_o        = '0;
+    done_o.sig    = wait_sig_i;
+    done_o.credit = 1'b1;
+    wake_used     = 1'b0;
+    for (int unsigned i = 0; i < N_BARRIERS; i++) begin
+      if (wait_i & ~done_o.wake & c_valid[i] & (c_sig[i] == wait_sig_i) & (c_woken[i] | bypass)) begin
+        done_o.wake  = 1'b1;
+        done_o.error = c_woken[i] ? c_error[i] : rsp_i.error;
+        wake_used    = ~c_woken[i];
+        n_valid[i]   = 1'b0;
+        n_woken[i]   = 1'b0;
+      end
+    end
+    if (wait_i & ~done_o.wake & bypass) begin
+      done_o.wake  = 1'b1;
+      done_o.error = rsp_i.error;
+      wake_used    = 1'b1;
+    end
+
+    store = rsp_i.wake & ~wake_used;
+    for (int unsigned i = 0; i < N_BARRIERS; i++) begin
+      if (store & c_valid[i] & ~c_woken[i] & (c_sig[i] == rsp_i.sig)) begin
+        n_woken[i] = 1'b1;
+        n_error[i] = rsp_i.error;
+        store      = 1'b0;
+      end
+    end
+    for (int unsigned i = 0; i < N_BARRIERS; i++) begin
+      if (store & ~n_valid[i]) begin
+        n_valid[i] = 1'b1;
+        n_woken[i] = 1'b1;
+        n_sig[i]   = rsp_i.sig;
+        n_error[i] = rsp_i.error;
+        store      = 1'b0;
+      end
+    end
+
+    accept = arrive_i.sync;
+    for (int unsigned i = 0; i < N_BARRIERS; i++) begin
+      if (n_valid[i] & ~n_woken[i] & (n_sig[i] == arrive_sig)) accept = 1'b0;
+    end
+    alloc = accept;
+    for (int unsigned i = 0; i < N_BARRIERS; i++) begin
+      if (alloc & n_valid[i] & n_woken[i] & (n_sig[i] == arrive_sig)) begin
+        n_woken[i] = 1'b0;
+        n_error[i] = 1'b0;
+        alloc      = 1'b0;
+      end
+    end
+    for (int unsigned i = 0; i < N_BARRIERS; i++) begin
+      if (alloc & ~n_valid[i]) begin
+        n_valid[i] = 1'b1;
+        n_woken[i] = 1'b0;
+        n_sig[i]   = arrive_sig;
+        n_error[i] = 1'b0;
+        alloc      = 1'b0;
+      end
+    end
+    if (alloc) accept = 1'b0;
+  end
+
+  assign overflow_o = store;
+
+  always_ff @(posedge clk_i, negedge rst_ni) begin: table_regs
+    if (!rst_ni) begin
+      c_valid <= '{default: 1'b0};
+      c_woken <= '{default: 1'b0};
+      c_sig   <= '{default: '0};
+      c_error <= '{default: 1'b0};
+    end else begin
+      c_valid <= n_valid;
+      c_woken <= n_woken;
+      c_sig   <= n_sig;
+      c_error <= n_error;
+    end
+  end
+
+/*******************************************************/
+/**                     Table End                     **/
+/*******************************************************/
+
+endmodule: fractal_sync_sp
@@ -24,6 +24,7 @@
  *  COMB_IN       - 1: Combinational datapath, 0: sample input
  *  FIFO_DEPTH    - Depth of the request FIFO
  *  FIFO_COMB_OUT - 1: Output FIFO with fall-through; 0: sequential FIFO
+ *  FLOW_CTRL     - 1: Credit-based flow control (a credit covers a slot of both FIFOs); 0: none
  *
  * Interface signals:
  *  > rsp_i             - Synchronization response
@@ -34,6 +35,7 @@
  *  < empty_o           - Indicates empty fifo
  *  < rsp_o             - Synchronization response
  *  > pop_i             - Pop current synchronization request
+ *  < credit_o          - Credit returned to the sender (one free slot)
  */
 
 module fractal_sync_tx 
@@ -42,7 +44,8 @@ module fractal_sync_tx
   parameter type         fsync_rsp_t   = logic,
   parameter bit          COMB_IN       = 1'b0,
   parameter int unsigned FIFO_DEPTH    = 1,
-  parameter bit          FIFO_COMB_OUT = 1'b1
+  parameter bit          FIFO_COMB_OUT = 1'b1,
+  parameter bit          FLOW_CTRL     = 1'b0
 )(
   // Response interface - in
   input  logic       clk_i,
@@ -61,7 +64,9 @@ module fractal_sync_tx
   input  logic       en_pop_i,
   output logic       ws_empty_o,
   output fsync_rsp_t ws_rsp_o,
-  input  logic       ws_pop_i
+  input  logic       ws_pop_i,
+  // Flow control
+  output logic       credit_o
 );
 
 /*******************************************************/
@@ -75,6 +80,14 @@ module fractal_sync_tx
 /*******************************************************/
 /**                   Assertions End                  **/
 /*******************************************************/
+/**        Parameters and Definitions Beginning       **/
+/*******************************************************/
+
+  localparam int unsigned CREDIT_WIDTH = $clog2(FIFO_DEPTH+1);
+
+/*******************************************************/
+/**           Parameters and Definitions End          **/
+/*******************************************************/
 /**             Internal Signals Beginning            **/
 /*******************************************************/
   
@@ -124,6 +137,43 @@ module fractal_sync_tx
 /*******************************************************/
 /**                    TX Logic End                   **/
 /*******************************************************/
+/**               Flow Control Beginning              **/
+/*******************************************************/
+
+  // A response may be pushed in both FIFOs: the credits follow the occupancy of the fuller FIFO. Responses that
+  // are not stored give their credit back immediately. One credit per cycle is returned to the sender.
+  if (FLOW_CTRL) begin: gen_credit
+    logic[CREDIT_WIDTH-1:0] c_owed, n_owed;
+    logic[CREDIT_WIDTH-1:0] c_en_cnt, n_en_cnt;
+    logic[CREDIT_WIDTH-1:0] c_ws_cnt, n_ws_cnt;
+    logic[CREDIT_WIDTH-1:0] c_max_cnt, n_max_cnt;
+
+    always_ff @(posedge clk_i, negedge rst_ni) begin: credit_reg
+      if (!rst_ni) begin
+        c_owed   <= FIFO_DEPTH;
+        c_en_cnt <= '0;
+        c_ws_cnt <= '0;
+      end else begin
+        c_owed   <= n_owed;
+        c_en_cnt <= n_en_cnt;
+        c_ws_cnt <= n_ws_cnt;
+      end
+    end
+
+    assign n_en_cnt  = c_en_cnt + en_push - en_pop_i;
+    assign n_ws_cnt  = c_ws_cnt + ws_push - ws_pop_i;
+    assign c_max_cnt = (c_en_cnt > c_ws_cnt) ? c_en_cnt : c_ws_cnt;
+    assign n_max_cnt = (n_en_cnt > n_ws_cnt) ? n_en_cnt : n_ws_cnt;
+
+    assign credit_o = (c_owed > 0) ? 1'b1 : 1'b0;
+    assign n_owed   = c_owed - credit_o + sampled_wake + c_max_cnt - n_max_cnt;
+  end else begin: gen_no_credit
+    assign credit_o = 1'b0;
+  end
+
+/*******************************************************/
+/**                  Flow Control End                 **/
+/*******************************************************/
 /**                RSP FIFOs Beginning                **/
 /*******************************************************/
 
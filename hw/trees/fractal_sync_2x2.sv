@@ -21,18 +21,18 @@
  *
  * Parameters:
  *  TOP_NODE_TYPE       - Top node type (2D or root)
- *  RF_TYPE_1D          - Remote RF type (DM or CAM) of 1D nodes
- *  ARBITER_TYPE_1D     - Arbiter type (FA, DM_WA or DM_ALT) of 1D nodes
+ *  RF_TYPE_1D          - Remote RF type (DM, CAM or SA) of 1D nodes
+ *  ARBITER_TYPE_1D     - Arbiter type (FA, DM_WA, DM_ALT or PP) of 1D nodes
  *  N_LOCAL_REGS_1D     - Local RF size of 1D nodes
- *  N_REMOTE_LINES_1D   - Remote RF size of CAM-based 1D nodes
+ *  N_REMOTE_LINES_1D   - Remote RF size of CAM-based and SA 1D nodes
  *  RX_FIFO_COMB_1D     - Output RX FIFO fall-through/sequential of 1D nodes
  *  TX_FIFO_COMB_1D     - Output TX FIFO with fall-through/sequential of 1D nodes
  *  LOCAL_FIFO_COMB_1D  - Output local FIFO with fall-through/sequential of 1D nodes
  *  REMOTE_FIFO_COMB_1D - Output remote FIFO with fall-through/sequential of 1D nodes
- *  RF_TYPE_2D          - Remote RF type (DM or CAM) of 2D node
- *  ARBITER_TYPE_2D     - Arbiter type (FA, DM_WA or DM_ALT) of 2D node
+ *  RF_TYPE_2D          - Remote RF type (DM, CAM or SA) of 2D node
+ *  ARBITER_TYPE_2D     - Arbiter type (FA, DM_WA, DM_ALT or PP) of 2D node
  *  N_LOCAL_REGS_2D     - Local RF size of 2D node
- *  N_REMOTE_LINES_2D   - Remote RF size of CAM-based 2D node (will be ignored for root node)
+ *  N_REMOTE_LINES_2D   - Remote RF size of CAM-based and SA 2D node (will be ignored for root node)
  *  RX_FIFO_COMB_2D     - Output RX FIFO with fall-through/sequential of 2D node
  *  TX_FIFO_COMB_2D     - Output TX FIFO with fall-through/sequential of 2D node
  *  LOCAL_FIFO_COMB_2D  - Output local FIFO with fall-through/sequential of 2D node
@@ -41,6 +41,8 @@
  *  N_LINKS_ITL         - Number of output links of the 1D network links and input links of the 2D network links (1D node-2D node)
  *  N_LINKS_OUT         - Number of output links of the 2D network links (2D node-Out)
  *  N_PIPELINE_STAGES   - Number of pipeline stages at each level: index 0 refers to level 1, index 1 refers to level 2, ...
+ *  FLOW_CTRL           - Credit-based flow control on the node-to-node links (1) or none (0)
+ *  FIFO_DEPTH          - Depth of the node FIFOs: 0 sizes them on the worst-case ratio of the input and output links
  *  AGGREGATE_WIDTH     - Width of the aggr field (CU-1D interface)
  *  ID_WIDTH            - Width of the id field (CU-1D interface)
  *  LVL_OFFSET          - Level offset of 1D nodes (CU-1D interface)
@@ -99,6 +101,9 @@ package fractal_sync_2x2_pkg;
 
   localparam int unsigned                  N_PIPELINE_STAGES[N_LEVELS] = '{0, 0};
 
+  localparam bit                           FLOW_CTRL                   = 0;
+  localparam int unsigned                  FIFO_DEPTH                  = 0;
+
   localparam int unsigned                  N_1D_H_PORTS                = 4;
   localparam int unsigned                  N_1D_V_PORTS                = 4;
   localparam int unsigned                  N_NBR_H_PORTS               = 4;
@@ -147,6 +152,8 @@ module fractal_sync_2x2_core
   parameter int unsigned                  N_LINKS_ITL                                       = fractal_sync_2x2_pkg::N_LINKS_ITL,
   parameter int unsigned                  N_LINKS_OUT                                       = fractal_sync_2x2_pkg::N_LINKS_OUT,
   parameter int unsigned                  N_PIPELINE_STAGES[fractal_sync_2x2_pkg::N_LEVELS] = fractal_sync_2x2_pkg::N_PIPELINE_STAGES,
+  parameter bit                           FLOW_CTRL                                         = fractal_sync_2x2_pkg::FLOW_CTRL,
+  parameter int unsigned                  FIFO_DEPTH                                        = fractal_sync_2x2_pkg::FIFO_DEPTH,
   parameter int unsigned                  AGGREGATE_WIDTH                                   = fractal_sync_2x2_pkg::IN_AGGR_WIDTH,
   parameter int unsigned                  ID_WIDTH                                          = fractal_sync_2x2_pkg::ID_WIDTH,
   parameter int unsigned                  LVL_OFFSET                                        = fractal_sync_2x2_pkg::IN_LVL_OFFSET,
@@ -208,8 +215,8 @@ module fractal_sync_2x2_core
 
   `FSYNC_TYPEDEF_REQ_ALL(fsync_itl, logic[ITL_AGGR_WIDTH-1:0], logic[ITL_ID_WIDTH-1:0])
 
-  localparam int unsigned FIFO_DEPTH_1D = (N_LINKS_ITL/N_LINKS_IN  > 0) ? N_LINKS_ITL/N_LINKS_IN  : 1;
-  localparam int unsigned FIFO_DEPTH_2D = (N_LINKS_OUT/N_LINKS_ITL > 0) ? N_LINKS_OUT/N_LINKS_ITL : 1;
+  localparam int unsigned FIFO_DEPTH_1D = (FIFO_DEPTH > 0) ? FIFO_DEPTH : (N_LINKS_ITL/N_LINKS_IN  > 0) ? N_LINKS_ITL/N_LINKS_IN  : 1;
+  localparam int unsigned FIFO_DEPTH_2D = (FIFO_DEPTH > 0) ? FIFO_DEPTH : (N_LINKS_OUT/N_LINKS_ITL > 0) ? N_LINKS_OUT/N_LINKS_ITL : 1;
 
   localparam int unsigned N_1D_NODE_IN_PORTS  = N_LINKS_IN*2;
   localparam int unsigned N_1D_NODE_OUT_PORTS = N_LINKS_ITL;
@@ -401,7 +408,8 @@ module fractal_sync_2x2_core
       .LOCAL_FIFO_COMB_OUT  ( LOCAL_FIFO_COMB_1D         ),
       .REMOTE_FIFO_COMB_OUT ( REMOTE_FIFO_COMB_1D        ),
       .IN_PORTS             ( N_1D_NODE_IN_PORTS         ),
-      .OUT_PORTS            ( N_1D_NODE_OUT_PORTS        )
+      .OUT_PORTS            ( N_1D_NODE_OUT_PORTS        ),
+      .FLOW_CTRL            ( FLOW_CTRL                  )
     ) i_h_1d_node (
       .clk_i                                ,
       .rst_ni                               ,
@@ -437,7 +445,8 @@ module fractal_sync_2x2_core
       .LOCAL_FIFO_COMB_OUT  ( LOCAL_FIFO_COMB_1D         ),
       .REMOTE_FIFO_COMB_OUT ( REMOTE_FIFO_COMB_1D        ),
       .IN_PORTS             ( N_1D_NODE_IN_PORTS         ),
-      .OUT_PORTS            ( N_1D_NODE_OUT_PORTS        )
+      .OUT_PORTS            ( N_1D_NODE_OUT_PORTS        ),
+      .FLOW_CTRL            ( FLOW_CTRL                  )
     ) i_v_1d_node (
       .clk_i                                ,
       .rst_ni                               ,
@@ -510,7 +519,8 @@ module fractal_sync_2x2_core
     .LOCAL_FIFO_COMB_OUT  ( LOCAL_FIFO_COMB_2D  ),
     .REMOTE_FIFO_COMB_OUT ( REMOTE_FIFO_COMB_2D ),
     .IN_PORTS             ( N_2D_NODE_IN_PORTS  ),
-    .OUT_PORTS            ( N_2D_NODE_OUT_PORTS )
+    .OUT_PORTS            ( N_2D_NODE_OUT_PORTS ),
+    .FLOW_CTRL            ( FLOW_CTRL           )
   ) i_top_node (
     .clk_i                             ,
     .rst_ni                            ,
@@ -554,6 +564,8 @@ module fractal_sync_2x2
   parameter int unsigned                  N_LINKS_ITL                                       = fractal_sync_2x2_pkg::N_LINKS_ITL,
   parameter int unsigned                  N_LINKS_OUT                                       = fractal_sync_2x2_pkg::N_LINKS_OUT,
   parameter int unsigned                  N_PIPELINE_STAGES[fractal_sync_2x2_pkg::N_LEVELS] = fractal_sync_2x2_pkg::N_PIPELINE_STAGES,
+  parameter bit                           FLOW_CTRL                                         = fractal_sync_2x2_pkg::FLOW_CTRL,
+  parameter int unsigned                  FIFO_DEPTH                                        = fractal_sync_2x2_pkg::FIFO_DEPTH,
   parameter int unsigned                  AGGREGATE_WIDTH                                   = fractal_sync_2x2_pkg::IN_AGGR_WIDTH,
   parameter int unsigned                  ID_WIDTH                                          = fractal_sync_2x2_pkg::ID_WIDTH,
   parameter int unsigned                  LVL_OFFSET                                        = fractal_sync_2x2_pkg::IN_LVL_OFFSET,
@@ -597,6 +609,7 @@ module fractal_sync_2x2
     assign h_nbr_fsycn_rsp_o[i].sig.lvl = '0;
     assign h_nbr_fsycn_rsp_o[i].sig.id  = '0;
     assign h_nbr_fsycn_rsp_o[i].error   = 1'b0;
+    assign h_nbr_fsycn_rsp_o[i].credit  = 1'b0;
   end
 
   for (genvar i = 0; i < N_NBR_V_PORTS; i++) begin: gen_v_nbr_net
@@ -604,6 +617,7 @@ module fractal_sync_2x2
     assign v_nbr_fsycn_rsp_o[i].sig.lvl = '0;
     assign v_nbr_fsycn_rsp_o[i].sig.id  = '0;
     assign v_nbr_fsycn_rsp_o[i].error   = 1'b0;
+    assign v_nbr_fsycn_rsp_o[i].credit  = 1'b0;
   end
 
 /*******************************************************/
@@ -612,7 +626,37 @@ module fractal_sync_2x2
 /**      H-Tree Synchronization Network Beginning     **/
 /*******************************************************/
 
-  fractal_sync_2x2_core i_fractal_sync_2x2_core (.*);
+  fractal_sync_2x2_core #(
+    .TOP_NODE_TYPE       ( TOP_NODE_TYPE       ),
+    .RF_TYPE_1D          ( RF_TYPE_1D          ),
+    .ARBITER_TYPE_1D     ( ARBITER_TYPE_1D     ),
+    .N_LOCAL_REGS_1D     ( N_LOCAL_REGS_1D     ),
+    .N_REMOTE_LINES_1D   ( N_REMOTE_LINES_1D   ),
+    .RX_FIFO_COMB_1D     ( RX_FIFO_COMB_1D     ),
+    .TX_FIFO_COMB_1D     ( TX_FIFO_COMB_1D     ),
+    .LOCAL_FIFO_COMB_1D  ( LOCAL_FIFO_COMB_1D  ),
+    .REMOTE_FIFO_COMB_1D ( REMOTE_FIFO_COMB_1D ),
+    .RF_TYPE_2D          ( RF_TYPE_2D          ),
+    .ARBITER_TYPE_2D     ( ARBITER_TYPE_2D     ),
+    .N_LOCAL_REGS_2D     ( N_LOCAL_REGS_2D     ),
+    .N_REMOTE_LINES_2D   ( N_REMOTE_LINES_2D   ),
+    .RX_FIFO_COMB_2D     ( RX_FIFO_COMB_2D     ),
+    .TX_FIFO_COMB_2D     ( TX_FIFO_COMB_2D     ),
+    .LOCAL_FIFO_COMB_2D  ( LOCAL_FIFO_COMB_2D  ),
+    .REMOTE_FIFO_COMB_2D ( REMOTE_FIFO_COMB_2D ),
+    .N_LINKS_IN          ( N_LINKS_IN          ),
+    .N_LINKS_ITL         ( N_LINKS_ITL         ),
+    .N_LINKS_OUT         ( N_LINKS_OUT         ),
+    .N_PIPELINE_STAGES   ( N_PIPELINE_STAGES   ),
+    .FLOW_CTRL           ( FLOW_CTRL           ),
+    .FIFO_DEPTH          ( FIFO_DEPTH          ),
+    .AGGREGATE_WIDTH     ( AGGREGATE_WIDTH     ),
+    .ID_WIDTH            ( ID_WIDTH            ),
+    .LVL_OFFSET          ( LVL_OFFSET          ),
+    .fsync_in_req_t      ( fsync_in_req_t      ),
+    .fsync_out_req_t     ( fsync_out_req_t     ),
+    .fsync_rsp_t         ( fsync_rsp_t         )
+  ) i_fractal_sync_2x2_core (.*);
 
 /*******************************************************/
 /**         H-Tree Synchronization Network End        **/
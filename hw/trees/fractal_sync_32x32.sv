@@ -21,18 +21,18 @@
  *
  * Parameters:
  *  TOP_NODE_TYPE       - Top node type (2D or root)
- *  RF_TYPE_1D          - Remote RF type (DM or CAM) of 1D nodes at various levels: index 0 refers to level 1, index 1 refers to level 3, ...
- *  ARBITER_TYPE_1D     - Arbiter type (FA, DM_WA or DM_ALT) of 1D nodes at various levels: index 0 refers to level 1, index 1 refers to level 3, ...
+ *  RF_TYPE_1D          - Remote RF type (DM, CAM or SA) of 1D nodes at various levels: index 0 refers to level 1, index 1 refers to level 3, ...
+ *  ARBITER_TYPE_1D     - Arbiter type (FA, DM_WA, DM_ALT or PP) of 1D nodes at various levels: index 0 refers to level 1, index 1 refers to level 3, ...
  *  N_LOCAL_REGS_1D     - Local RF size of 1D nodes at various levels: index 0 refers to level 1, index 1 refers to level 3, ...
- *  N_REMOTE_LINES_1D   - Remote RF size of CAM-based 1D nodes at various levels: index 0 refers to level 1, index 1 refers to level 3, ...
+ *  N_REMOTE_LINES_1D   - Remote RF size of CAM-based and SA 1D nodes at various levels: index 0 refers to level 1, index 1 refers to level 3, ...
  *  RX_FIFO_COMB_1D     - Output RX FIFO fall-through/sequential of 1D nodes at various levels: index 0 refers to level 1, index 1 refers to level 3, ...
  *  TX_FIFO_COMB_1D     - Output TX FIFO with fall-through/sequential of 1D nodes at various levels: index 0 refers to level 1, index 1 refers to level 3, ...
  *  LOCAL_FIFO_COMB_1D  - Output local FIFO with fall-through/sequential of 1D nodes at various levels: index 0 refers to level 1, index 1 refers to level 3, ...
  *  REMOTE_FIFO_COMB_1D - Output remote FIFO with fall-through/sequential of 1D nodes at various levels: index 0 refers to level 1, index 1 refers to level 3, ...
- *  RF_TYPE_2D          - Remote RF type (DM or CAM) of 2D nodes at various levels: index 0 refers to level 2, index 1 refers to level 4, ...
- *  ARBITER_TYPE_2D     - Arbiter type (FA, DM_WA or DM_ALT) of 2D nodes at various levels: index 0 refers to level 2, index 1 refers to level 4, ...
+ *  RF_TYPE_2D          - Remote RF type (DM, CAM or SA) of 2D nodes at various levels: index 0 refers to level 2, index 1 refers to level 4, ...
+ *  ARBITER_TYPE_2D     - Arbiter type (FA, DM_WA, DM_ALT or PP) of 2D nodes at various levels: index 0 refers to level 2, index 1 refers to level 4, ...
  *  N_LOCAL_REGS_2D     - Local RF size of 2D nodes at various levels: index 0 refers to level 2, index 1 refers to level 4, ...
- *  N_REMOTE_LINES_2D   - Remote RF size of CAM-based 2D nodes (will be ignored for root node) at various levels: index 0 refers to level 2, index 1 refers to level 4, ...
+ *  N_REMOTE_LINES_2D   - Remote RF size of CAM-based and SA 2D nodes (will be ignored for root node) at various levels: index 0 refers to level 2, index 1 refers to level 4, ...
  *  RX_FIFO_COMB_2D     - Output RX FIFO with fall-through/sequential of 2D nodes at various levels: index 0 refers to level 2, index 1 refers to level 4, ...
  *  TX_FIFO_COMB_2D     - Output TX FIFO with fall-through/sequential of 2D nodes at various levels: index 0 refers to level 2, index 1 refers to level 4, ...
  *  LOCAL_FIFO_COMB_2D  - Output local FIFO with fall-through/sequential of 2D nodes at various levels: index 0 refers to level 2, index 1 refers to level 4, ...
@@ -41,6 +41,8 @@
  *  N_LINKS_ITL         - Number of network links at the intermediate (internal) levels: index 0 refers to level 2, index 1 refers to level 3, ...
  *  N_LINKS_OUT         - Number of output links of the 2D network links (2D node-Out)
  *  N_PIPELINE_STAGES   - Number of pipeline stages at each level: index 0 refers to level 1, index 1 refers to level 2, ...
+ *  FLOW_CTRL           - Credit-based flow control on the node-to-node links (1) or none (0)
+ *  FIFO_DEPTH          - Depth of the node FIFOs: 0 sizes them on the worst-case ratio of the input and output links
  *  AGGREGATE_WIDTH     - Width of the aggr field (CU-1D interface)
  *  ID_WIDTH            - Width of the id field (CU-1D interface)
  *  LVL_OFFSET          - Level offset of 1D nodes (CU-1D interface)
@@ -117,6 +119,9 @@ package fractal_sync_32x32_pkg;
 
   localparam int unsigned                  N_PIPELINE_STAGES[N_LEVELS]          = '{0, 0, 0, 0, 1, 1, 3, 3, 7, 7};
 
+  localparam bit                           FLOW_CTRL                            = 0;
+  localparam int unsigned                  FIFO_DEPTH                           = 0;
+
   localparam int unsigned                  N_1D_H_PORTS                         = 1024;
   localparam int unsigned                  N_1D_V_PORTS                         = 1024;
   localparam int unsigned                  N_NBR_H_PORTS                        = 1024;
@@ -165,6 +170,8 @@ module fractal_sync_32x32_core
   parameter int unsigned                  N_LINKS_ITL[fractal_sync_32x32_pkg::N_ITL_LEVELS]            = fractal_sync_32x32_pkg::N_LINKS_ITL,
   parameter int unsigned                  N_LINKS_OUT                                                  = fractal_sync_32x32_pkg::N_LINKS_OUT,
   parameter int unsigned                  N_PIPELINE_STAGES[fractal_sync_32x32_pkg::N_LEVELS]          = fractal_sync_32x32_pkg::N_PIPELINE_STAGES,
+  parameter bit                           FLOW_CTRL                                                  = fractal_sync_32x32_pkg::FLOW_CTRL,
+  parameter int unsigned                  FIFO_DEPTH                                                 = fractal_sync_32x32_pkg::FIFO_DEPTH,
   parameter int unsigned                  AGGREGATE_WIDTH                                              = fractal_sync_32x32_pkg::IN_AGGR_WIDTH,
   parameter int unsigned                  ID_WIDTH                                                     = fractal_sync_32x32_pkg::ID_WIDTH,
   parameter int unsigned                  LVL_OFFSET                                                   = fractal_sync_32x32_pkg::IN_LVL_OFFSET,
@@ -380,6 +387,8 @@ module fractal_sync_32x32_core
       .N_LINKS_ITL         ( LEAF_N_LINKS_ITL          ),
       .N_LINKS_OUT         ( LEAF_N_LINKS_OUT          ),
       .N_PIPELINE_STAGES   ( LEAF_N_PIPELINE_STAGES    ),
+      .FLOW_CTRL           ( FLOW_CTRL                 ),
+      .FIFO_DEPTH          ( FIFO_DEPTH                ),
       .AGGREGATE_WIDTH     ( LEAF_AGGREGATE_WIDTH      ),
       .ID_WIDTH            ( LEAF_ID_WIDTH             ),
       .LVL_OFFSET          ( LEAF_LVL_OFFSET           ),
@@ -428,6 +437,8 @@ module fractal_sync_32x32_core
     .N_LINKS_ITL         ( ROOT_N_LINKS_ITL         ),
     .N_LINKS_OUT         ( ROOT_N_LINKS_OUT         ),
     .N_PIPELINE_STAGES   ( ROOT_N_PIPELINE_STAGES   ),
+    .FLOW_CTRL           ( FLOW_CTRL                ),
+    .FIFO_DEPTH          ( FIFO_DEPTH               ),
     .AGGREGATE_WIDTH     ( ROOT_AGGREGATE_WIDTH     ),
     .ID_WIDTH            ( ROOT_ID_WIDTH            ),
     .LVL_OFFSET          ( ROOT_LVL_OFFSET          ),
@@ -477,6 +488,8 @@ module fractal_sync_32x32
   parameter int unsigned                  N_LINKS_ITL[fractal_sync_32x32_pkg::N_ITL_LEVELS]            = fractal_sync_32x32_pkg::N_LINKS_ITL,
   parameter int unsigned                  N_LINKS_OUT                                                  = fractal_sync_32x32_pkg::N_LINKS_OUT,
   parameter int unsigned                  N_PIPELINE_STAGES[fractal_sync_32x32_pkg::N_LEVELS]          = fractal_sync_32x32_pkg::N_PIPELINE_STAGES,
+  parameter bit                           FLOW_CTRL                                                  = fractal_sync_32x32_pkg::FLOW_CTRL,
+  parameter int unsigned                  FIFO_DEPTH                                                 = fractal_sync_32x32_pkg::FIFO_DEPTH,
   parameter int unsigned                  AGGREGATE_WIDTH                                              = fractal_sync_32x32_pkg::IN_AGGR_WIDTH,
   parameter int unsigned                  ID_WIDTH                                                     = fractal_sync_32x32_pkg::ID_WIDTH,
   parameter int unsigned                  LVL_OFFSET                                                   = fractal_sync_32x32_pkg::IN_LVL_OFFSET,
@@ -534,6 +547,7 @@ module fractal_sync_32x32
       assign h_nbr_fsycn_rsp_o[i].sig.lvl = '0;
       assign h_nbr_fsycn_rsp_o[i].sig.id  = '0;
       assign h_nbr_fsycn_rsp_o[i].error   = 1'b0;
+      assign h_nbr_fsycn_rsp_o[i].credit  = 1'b0;
     end else if (h_nbr_col_idx%2) begin: gen_nbr_node
       fsync_nbr_req_t h_nbr_req[N_NBR_PORTS];
       fsync_nbr_rsp_t h_nbr_rsp[N_NBR_PORTS];
@@ -561,6 +575,7 @@ module fractal_sync_32x32
       assign v_nbr_fsycn_rsp_o[i].sig.lvl = '0;
       assign v_nbr_fsycn_rsp_o[i].sig.id  = '0;
       assign v_nbr_fsycn_rsp_o[i].error   = 1'b0;
+      assign v_nbr_fsycn_rsp_o[i].credit  = 1'b0;
     end else if (v_nbr_row_idx%2) begin: gen_nbr_node
       fsync_nbr_req_t v_nbr_req[N_NBR_PORTS];
       fsync_nbr_rsp_t v_nbr_rsp[N_NBR_PORTS];
@@ -587,7 +602,37 @@ module fractal_sync_32x32
 /**      H-Tree Synchronization Network Beginning     **/
 /*******************************************************/
 
-  fractal_sync_32x32_core i_fractal_sync_32x32_core (.*);
+  fractal_sync_32x32_core #(
+    .TOP_NODE_TYPE       ( TOP_NODE_TYPE       ),
+    .RF_TYPE_1D          ( RF_TYPE_1D          ),
+    .ARBITER_TYPE_1D     ( ARBITER_TYPE_1D     ),
+    .N_LOCAL_REGS_1D     ( N_LOCAL_REGS_1D     ),
+    .N_REMOTE_LINES_1D   ( N_REMOTE_LINES_1D   ),
+    .RX_FIFO_COMB_1D     ( RX_FIFO_COMB_1D     ),
+    .TX_FIFO_COMB_1D     ( TX_FIFO_COMB_1D     ),
+    .LOCAL_FIFO_COMB_1D  ( LOCAL_FIFO_COMB_1D  ),
+    .REMOTE_FIFO_COMB_1D ( REMOTE_FIFO_COMB_1D ),
+    .RF_TYPE_2D          ( RF_TYPE_2D          ),
+    .ARBITER_TYPE_2D     ( ARBITER_TYPE_2D     ),
+    .N_LOCAL_REGS_2D     ( N_LOCAL_REGS_2D     ),
+    .N_REMOTE_LINES_2D   ( N_REMOTE_LINES_2D   ),
+    .RX_FIFO_COMB_2D     ( RX_FIFO_COMB_2D     ),
+    .TX_FIFO_COMB_2D     ( TX_FIFO_COMB_2D     ),
+    .LOCAL_FIFO_COMB_2D  ( LOCAL_FIFO_COMB_2D  ),
+    .REMOTE_FIFO_COMB_2D ( REMOTE_FIFO_COMB_2D ),
+    .N_LINKS_IN          ( N_LINKS_IN          ),
+    .N_LINKS_ITL         ( N_LINKS_ITL         ),
+    .N_LINKS_OUT         ( N_LINKS_OUT         ),
+    .N_PIPELINE_STAGES   ( N_PIPELINE_STAGES   ),
+    .FLOW_CTRL           ( FLOW_CTRL           ),
+    .FIFO_DEPTH          ( FIFO_DEPTH          ),
+    .AGGREGATE_WIDTH     ( AGGREGATE_WIDTH     ),
+    .ID_WIDTH            ( ID_WIDTH            ),
+    .LVL_OFFSET          ( LVL_OFFSET          ),
+    .fsync_in_req_t      ( fsync_in_req_t      ),
+    .fsync_out_req_t     ( fsync_out_req_t     ),
+    .fsync_rsp_t         ( fsync_rsp_t         )
+  ) i_fractal_sync_32x32_core (.*);
 
 /*******************************************************/
 /**         H-Tree Synchronization Network End        **/
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization host barrier: the FractalSync trees over threads (C11 atomics, pthreads)
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <limits.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+#include "fractal_sync_host.h"
+
+static unsigned int fsync_host_n_cpus(void){
+  long n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  return (n_cpus > 0) ? (unsigned int)n_cpus : 1;
+}
+
+static fsync_host_slot_t *fsync_host_alloc_slots(const unsigned int n_slots){
+  size_t             size  = (size_t)n_slots*sizeof(fsync_host_slot_t);
+  fsync_host_slot_t *slots = aligned_alloc(FSYNC_HOST_CACHE_LINE, size);
+  if (slots != NULL) memset(slots, 0, size);
+  return slots;
+}
+
+/*
+ * Node of the tree reached at level lvl by the CU in (y_pos, x_pos) through channel ch (h: 0, v: 1), as wired in
+ * hw/trees: the h trees pair the CUs of a row first, the v trees the CUs of a column, 2D nodes join both
+ */
+static unsigned int fsync_host_node(const fsync_topology_t *topo, const unsigned int lvl, const unsigned int ch, const unsigned int y_pos, const unsigned int x_pos){
+  const unsigned int k = (lvl-1)/2;
+  if (!(lvl & 1)) return (y_pos >> (k+1))*(topo->n_cu_x >> (k+1)) + (x_pos >> (k+1));
+  if (ch == 0)    return (y_pos >> k)*(topo->n_cu_x >> (k+1)) + (x_pos >> (k+1));
+  else            return (y_pos >> (k+1))*(topo->n_cu_x >> k) + (x_pos >> k);
+}
+
+bool fsync_host_init(fsync_host_t *host, const fsync_topology_t *topo){
+  memset(host, 0, sizeof(*host));
+  host->topo = topo;
+  host->spin = (topo->n_cu <= fsync_host_n_cpus()) ? 1 << 12 : 0;
+
+  for (unsigned int l = 0; l < topo->n_lvl; l++){
+    fsync_host_level_t *level = &host->levels[l];
+    /* Every node of level l+1 forwards the barriers of levels l+1 to n_lvl */
+    level->n_nodes = topo->n_cu >> (l+1);
+    level->n_slots = 0;
+    for (unsigned int b = l; b < topo->n_lvl; b++){
+      level->reg_offset[b] = level->n_slots;
+      level->n_slots      += topo->n_dir_regs[b];
+    }
+    level->n_slots = (level->n_slots + FSYNC_HOST_SLOTS_PER_LINE-1)/FSYNC_HOST_SLOTS_PER_LINE*FSYNC_HOST_SLOTS_PER_LINE;
+    for (unsigned int ch = 0; ch < 2; ch++){
+      level->slots[ch] = fsync_host_alloc_slots(level->n_nodes*level->n_slots);
+      if (level->slots[ch] == NULL){
+        fsync_host_free(host);
+        return false;
+      }
+    }
+  }
+
+  for (unsigned int ch = 0; ch < 2; ch++){
+    host->nbr[ch] = fsync_host_alloc_slots(topo->n_cu/2*FSYNC_HOST_SLOTS_PER_LINE);
+    if (host->nbr[ch] == NULL){
+      fsync_host_free(host);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void fsync_host_free(fsync_host_t *host){
+  for (unsigned int l = 0; l < __FSYNC_MAX_N_LVL__; l++){
+    for (unsigned int ch = 0; ch < 2; ch++){
+      free(host->levels[l].slots[ch]);
+      host->levels[l].slots[ch] = NULL;
+    }
+  }
+  for (unsigned int ch = 0; ch < 2; ch++){
+    free(host->nbr[ch]);
+    host->nbr[ch] = NULL;
+  }
+}
+
+static void fsync_host_wait(const fsync_host_t *host, fsync_host_slot_t *slot, const unsigned int epoch){
+  for (unsigned int i = 0; i < host->spin; i++)
+    if (atomic_load_explicit(&slot->epoch, memory_order_acquire) != epoch) return;
+
+  while (atomic_load(&slot->epoch) == epoch){
+#ifdef __linux__
+    atomic_store(&slot->sleepers, 1);
+    syscall(SYS_futex, (unsigned int *)&slot->epoch, FUTEX_WAIT_PRIVATE, epoch, NULL, NULL, 0);
+#else
+    sched_yield();
+#endif
+  }
+}
+
+/* Wake response: reset the slot for the next barrier before releasing its waiter */
+static void fsync_host_wake(fsync_host_slot_t *slot){
+  atomic_store_explicit(&slot->count, 0, memory_order_relaxed);
+  atomic_fetch_add(&slot->epoch, 1);
+#ifdef __linux__
+  if (atomic_exchange(&slot->sleepers, 0))
+    syscall(SYS_futex, (unsigned int *)&slot->epoch, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+#endif
+}
+
+bool fsync_host_sync(fsync_host_t *host, const fsync_cu_t *cu){
+  const fsync_topology_t *topo = host->topo;
+  const unsigned int      aggr = cu->fsync_req.fs_req_aggr;
+  const unsigned int      id   = cu->fsync_req.fs_req_id;
+  const unsigned int      ch   = id & 1;
+  unsigned int            lvl  = 0;
+  while (aggr >> lvl) lvl++;
+
+  if (lvl == 0 || lvl > topo->n_lvl || cu->y_pos >= topo->n_cu_y || cu->x_pos >= topo->n_cu_x) return false;
+
+  /* Dedicated neighbor link: node between positions 2k-1 and 2k of the row (h) or column (v) */
+  if (lvl == 1 && id >= 2){
+    const unsigned int pos  = ch ? cu->y_pos : cu->x_pos;
+    const unsigned int line = ch ? cu->x_pos : cu->y_pos;
+    const unsigned int link = (pos+1) >> 1;
+    if (id > 3 || link == 0 || link >= topo->n_cu_x/2) return false;
+
+    fsync_host_slot_t *slot  = &host->nbr[ch][(line*(topo->n_cu_x/2) + link)*FSYNC_HOST_SLOTS_PER_LINE];
+    unsigned int       epoch = atomic_load(&slot->epoch);
+    if (atomic_fetch_add(&slot->count, 1) == 0) fsync_host_wait(host, slot, epoch);
+    else                                        fsync_host_wake(slot);
+    return true;
+  }
+
+  const unsigned int reg = id >> 1;
+  if (reg >= topo->n_dir_regs[lvl-1]) return false;
+
+  /* Climb while winning (second arrival), aggregating at the levels selected by the aggregate */
+  fsync_host_slot_t *won[__FSYNC_MAX_N_LVL__];
+  unsigned int       n_won = 0;
+  for (unsigned int l = 1; l <= lvl; l++){
+    if (!((aggr >> (l-1)) & 1)) continue;
+    fsync_host_level_t *level = &host->levels[l-1];
+    fsync_host_slot_t  *slot  = &level->slots[ch][fsync_host_node(topo, l, ch, cu->y_pos, cu->x_pos)*level->n_slots + level->reg_offset[lvl-1] + reg];
+    unsigned int        epoch = atomic_load(&slot->epoch);
+    if (atomic_fetch_add(&slot->count, 1) == 0){
+      fsync_host_wait(host, slot, epoch);
+      break;
+    }
+    won[n_won++] = slot;
+  }
+
+  /* Propagate the wake down the won slots */
+  while (n_won > 0) fsync_host_wake(won[--n_won]);
+  return true;
+}
+
+bool fsync_host_pin(const fsync_topology_t *topo, const fsync_cu_t *cu){
+#ifdef __linux__
+  cpu_set_t allowed;
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return false;
+  const unsigned int n_allowed = CPU_COUNT(&allowed);
+  if (n_allowed == 0) return false;
+
+  /* Row-major CU index over the CPUs the process may run on */
+  unsigned int target = ((cu->y_pos << topo->x_shift) + cu->x_pos) % n_allowed;
+  for (unsigned int cpu = 0; cpu < CPU_SETSIZE; cpu++){
+    if (!CPU_ISSET(cpu, &allowed)) continue;
+    if (target-- == 0){
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(cpu, &set);
+      return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    }
+  }
+  return false;
+#else
+  (void)topo; (void)cu;
+  return false;
+#endif
+}
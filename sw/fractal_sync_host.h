@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization host barrier header: the FractalSync trees over threads (C11 atomics, pthreads)
+ *
+ * Each thread plays a CU of the mesh and issues the requests of the generator (fsync_gen_reqs, fsync_alloc_teams,
+ * fsync_gen_nbr_reqs) unchanged. A request climbs the tree of its direction (id[0]: h/v) and is combined at every level
+ * whose aggregate bit is set, exactly like the remote RFs of the 1D/2D nodes; the barrier level (aggregate MSB) plays
+ * the local RF register id[ID_WIDTH-1:1]. Every combining point is a two-party slot: the first thread waits on it, the
+ * second one climbs on. The last thread to reach the barrier node wakes the waiters down the same path, as the wake
+ * responses of the trees. Ids 2/3 at level 1 use the dedicated neighbor links. Nodes never share a cache line, so
+ * threads only contend with their sibling subtree at each level (instead of all on one counter as pthread_barrier).
+ */
+
+#ifndef FSYNC_HOST_H
+#define FSYNC_HOST_H
+
+#include <stdatomic.h>
+#include "fractal_sync_req_gen.h"
+
+#define FSYNC_HOST_CACHE_LINE     (64)
+#define FSYNC_HOST_SLOTS_PER_LINE (FSYNC_HOST_CACHE_LINE/sizeof(fsync_host_slot_t))
+
+/* Combining point of a node: one per (barrier level, register) */
+typedef struct fsync_host_slot{
+  atomic_uint count;    /* Arrivals of the current barrier (0 or 1) */
+  atomic_uint epoch;    /* Incremented on wake */
+  atomic_uint sleepers; /* The waiting thread is blocked in the kernel */
+  unsigned int pad;
+} fsync_host_slot_t;
+
+typedef struct fsync_host_level{
+  unsigned int       n_nodes;                         /* Nodes of the level (per direction) */
+  unsigned int       n_slots;                         /* Slots of a node, padded to a cache line */
+  unsigned int       reg_offset[__FSYNC_MAX_N_LVL__]; /* Slot of register 0 of each barrier level (index 0 refers to level 1) */
+  fsync_host_slot_t *slots[2];                        /* Slots of the h and v nodes: [node*n_slots + slot] */
+} fsync_host_level_t;
+
+typedef struct fsync_host{
+  const fsync_topology_t *topo;
+  fsync_host_level_t      levels[__FSYNC_MAX_N_LVL__];
+  fsync_host_slot_t      *nbr[2];                    /* Neighbor links (h, v): [(line*(n_cu_x/2) + link)*FSYNC_HOST_SLOTS_PER_LINE] */
+  unsigned int            spin;                      /* Polling iterations before blocking in the kernel (0 when CUs outnumber the CPUs) */
+} fsync_host_t;
+
+/**
+ * @brief allocate the barrier nodes of a topology
+ * @param host host barrier
+ * @param topo topology descriptor (must outlive the host barrier)
+ * @return true if the host barrier has been initialized properly, false otherwise (e.g. out of memory)
+ */
+bool fsync_host_init(fsync_host_t *host, const fsync_topology_t *topo);
+
+/**
+ * @brief release the memory of the barrier nodes
+ * @param host host barrier
+ * @return no return value
+ */
+void fsync_host_free(fsync_host_t *host);
+
+/**
+ * @brief issue the FractalSync request of a CU and wait for its wake (blocking)
+ * @param host host barrier
+ * @param cu CU position and request, as set by the generator
+ * @return true on wake, false on an error response (request not valid for the topology, e.g. id out of range or missing neighbor link)
+ */
+bool fsync_host_sync(fsync_host_t *host, const fsync_cu_t *cu);
+
+/**
+ * @brief pin the calling thread to a CPU, CUs are laid out row-major over the online CPUs
+ * @param topo topology descriptor
+ * @param cu CU played by the calling thread
+ * @return true if the thread has been pinned, false otherwise (e.g. affinity not supported)
+ */
+bool fsync_host_pin(const fsync_topology_t *topo, const fsync_cu_t *cu);
+
+#endif /*FSYNC_HOST_H*/
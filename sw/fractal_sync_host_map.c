@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization host mapping: placement of the CU threads of the host barrier on the CPUs
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include "fractal_sync_host_map.h"
+
+#define FSYNC_HOST_MAP_MAX_CPUS (4096)
+
+/* Nominal cache-line transfer (or context switch, for CUs sharing a CPU) costs in ns */
+static const double fsync_host_default_cost[n_fs_doms] = {1000.0, 10.0, 20.0, 40.0, 80.0, 120.0, 200.0};
+
+static const char *fsync_host_dom_names[n_fs_doms] = {"cpu", "smt", "l2", "l3", "numa", "package", "system"};
+
+typedef struct fsync_host_cpu{
+  unsigned int cpu;
+  unsigned int dom_id[n_fs_doms];
+} fsync_host_cpu_t;
+
+const char *fsync_host_dom_name(const fsync_host_dom dom){
+  return (dom < n_fs_doms) ? fsync_host_dom_names[dom] : "unknown";
+}
+
+static bool fsync_host_read_uint(const char *path, unsigned int *value){
+  FILE *file = fopen(path, "r");
+  if (file == NULL) return false;
+  int  read_value;
+  bool read = fscanf(file, "%d", &read_value) == 1;
+  fclose(file);
+  /* Unknown ids (e.g. physical_package_id -1) belong to a single domain */
+  if (read) *value = (read_value < 0) ? 0 : (unsigned int)read_value;
+  return read;
+}
+
+static bool fsync_host_read_str(const char *path, char *str, const size_t size){
+  FILE *file = fopen(path, "r");
+  if (file == NULL) return false;
+  bool read = fgets(str, size, file) != NULL;
+  fclose(file);
+  if (read) str[strcspn(str, "\n")] = '\0';
+  return read;
+}
+
+/* Parse a CPU list ("0-3,8,10-11") into a flag array, return the number of CPUs */
+static unsigned int fsync_host_parse_list(const char *list, bool *cpus){
+  unsigned int n_cpus = 0;
+  const char  *pos    = list;
+  while (*pos){
+    char         *end;
+    unsigned long first = strtoul(pos, &end, 10), last = first;
+    if (end == pos) break;
+    if (*end == '-') last = strtoul(end+1, &end, 10);
+    for (unsigned long cpu = first; cpu <= last && cpu < FSYNC_HOST_MAP_MAX_CPUS; cpu++){
+      n_cpus += !cpus[cpu];
+      cpus[cpu] = true;
+    }
+    pos = (*end == ',') ? end+1 : end;
+  }
+  return n_cpus;
+}
+
+/* Sharing domains are named after their first CPU (lists are sorted), NUMA nodes and packages after their id */
+static bool fsync_host_read_cpu(const char *sysfs, fsync_host_cpu_t *cpu){
+  char path[512];
+  char list[1024];
+
+  cpu->dom_id[cpu_fs_dom] = cpu->cpu;
+  snprintf(path, sizeof(path), "%s/cpu/cpu%u/topology/thread_siblings_list", sysfs, cpu->cpu);
+  if (fsync_host_read_str(path, list, sizeof(list))) cpu->dom_id[smt_fs_dom] = strtoul(list, NULL, 10);
+  else                                               cpu->dom_id[smt_fs_dom] = cpu->cpu;
+
+  /* Without cache information a level shares nothing beyond the inner one */
+  cpu->dom_id[l2_fs_dom] = cpu->dom_id[smt_fs_dom];
+  cpu->dom_id[l3_fs_dom] = cpu->dom_id[smt_fs_dom];
+  for (unsigned int index = 0; ; index++){
+    unsigned int level;
+    char         type[32];
+    snprintf(path, sizeof(path), "%s/cpu/cpu%u/cache/index%u/level", sysfs, cpu->cpu, index);
+    if (!fsync_host_read_uint(path, &level)) break;
+    snprintf(path, sizeof(path), "%s/cpu/cpu%u/cache/index%u/type", sysfs, cpu->cpu, index);
+    if (fsync_host_read_str(path, type, sizeof(type)) && !strcmp(type, "Instruction")) continue;
+    if (level != 2 && level != 3) continue;
+    snprintf(path, sizeof(path), "%s/cpu/cpu%u/cache/index%u/shared_cpu_list", sysfs, cpu->cpu, index);
+    if (fsync_host_read_str(path, list, sizeof(list))) cpu->dom_id[(level == 2) ? l2_fs_dom : l3_fs_dom] = strtoul(list, NULL, 10);
+  }
+  if (cpu->dom_id[l3_fs_dom] == cpu->dom_id[smt_fs_dom]) cpu->dom_id[l3_fs_dom] = cpu->dom_id[l2_fs_dom];
+
+  cpu->dom_id[numa_fs_dom] = 0;
+  snprintf(path, sizeof(path), "%s/cpu/cpu%u", sysfs, cpu->cpu);
+  DIR *dir = opendir(path);
+  if (dir == NULL) return false;
+  for (struct dirent *entry = readdir(dir); entry != NULL; entry = readdir(dir)){
+    unsigned int node;
+    if (sscanf(entry->d_name, "node%u", &node) == 1) cpu->dom_id[numa_fs_dom] = node;
+  }
+  closedir(dir);
+
+  cpu->dom_id[package_fs_dom] = 0;
+  snprintf(path, sizeof(path), "%s/cpu/cpu%u/topology/physical_package_id", sysfs, cpu->cpu);
+  fsync_host_read_uint(path, &cpu->dom_id[package_fs_dom]);
+  cpu->dom_id[system_fs_dom] = 0;
+  return true;
+}
+
+/* Outermost domains first: CPUs sharing inner domains are adjacent */
+static int fsync_host_cmp_cpu(const void *a, const void *b){
+  const fsync_host_cpu_t *cpu_a = a;
+  const fsync_host_cpu_t *cpu_b = b;
+  for (int dom = system_fs_dom; dom >= cpu_fs_dom; dom--)
+    if (cpu_a->dom_id[dom] != cpu_b->dom_id[dom]) return (cpu_a->dom_id[dom] < cpu_b->dom_id[dom]) ? -1 : 1;
+  return 0;
+}
+
+/* Rank of a CU along the h trees: bit 2i is x[i], bit 2i+1 is y[i] */
+static unsigned int fsync_host_tree_rank(const unsigned int y_pos, const unsigned int x_pos){
+  unsigned int rank = 0;
+  for (unsigned int b = 0; b < __FSYNC_MAX_N_LVL__/2; b++)
+    rank |= (((x_pos >> b) & 1) << (2*b)) | (((y_pos >> b) & 1) << (2*b+1));
+  return rank;
+}
+
+/* Innermost domain shared by the CPUs of two CUs */
+static fsync_host_dom fsync_host_span(const fsync_host_map_t *map, const unsigned int cu1, const unsigned int cu2){
+  fsync_host_dom dom = cpu_fs_dom;
+  while (dom < system_fs_dom && map->dom_id[cu1][dom] != map->dom_id[cu2][dom]) dom++;
+  return dom;
+}
+
+bool fsync_host_map_init(fsync_host_map_t *map, const fsync_topology_t *topo, const fsync_host_order order, const char *sysfs, const double *dom_cost){
+  char path[512];
+  char list[4096];
+  bool online[FSYNC_HOST_MAP_MAX_CPUS] = {false};
+
+  memset(map, 0, sizeof(*map));
+  for (unsigned int dom = 0; dom < n_fs_doms; dom++) map->dom_cost[dom] = (dom_cost != NULL) ? dom_cost[dom] : fsync_host_default_cost[dom];
+
+  snprintf(path, sizeof(path), "%s/cpu/online", (sysfs != NULL) ? sysfs : "/sys/devices/system");
+  if (!fsync_host_read_str(path, list, sizeof(list)) || fsync_host_parse_list(list, online) == 0) return false;
+
+  fsync_host_cpu_t *cpus = malloc(FSYNC_HOST_MAP_MAX_CPUS*sizeof(fsync_host_cpu_t));
+  if (cpus == NULL) return false;
+
+  /* On the running system only the CPUs of the affinity mask are usable */
+  cpu_set_t allowed;
+  bool      use_mask = (sysfs == NULL) && (sched_getaffinity(0, sizeof(allowed), &allowed) == 0);
+  for (unsigned int cpu = 0; cpu < FSYNC_HOST_MAP_MAX_CPUS; cpu++){
+    if (!online[cpu] || (use_mask && (cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &allowed)))) continue;
+    cpus[map->n_cpus].cpu = cpu;
+    if (!fsync_host_read_cpu((sysfs != NULL) ? sysfs : "/sys/devices/system", &cpus[map->n_cpus])){
+      free(cpus);
+      return false;
+    }
+    map->n_cpus++;
+  }
+  if (map->n_cpus == 0){
+    free(cpus);
+    return false;
+  }
+  if (order == tree_fs_map) qsort(cpus, map->n_cpus, sizeof(fsync_host_cpu_t), fsync_host_cmp_cpu);
+
+  /* More CUs than CPUs: consecutive ranks share a CPU, so the leaves of the trees do */
+  for (unsigned int y = 0; y < topo->n_cu_y; y++){
+    for (unsigned int x = 0; x < topo->n_cu_x; x++){
+      unsigned int cu   = (y << topo->x_shift) + x;
+      unsigned int rank = (order == tree_fs_map) ? fsync_host_tree_rank(y, x) : cu;
+      unsigned int slot = (topo->n_cu > map->n_cpus) ? (unsigned int)((unsigned long)rank*map->n_cpus/topo->n_cu) : rank;
+      map->cpu[cu] = cpus[slot].cpu;
+      memcpy(map->dom_id[cu], cpus[slot].dom_id, sizeof(map->dom_id[cu]));
+    }
+  }
+  free(cpus);
+
+  /* Nodes of the trees: the CUs of a node are the CUs of the same node index (see fsync_host_node) */
+  for (unsigned int l = 1; l <= topo->n_lvl; l++){
+    const unsigned int k = (l-1)/2;
+    for (unsigned int ch = 0; ch < 2; ch++){
+      const unsigned int size_x  = (l & 1) ? ((ch == 0) ? 2u << k : 1u << k) : 2u << k;
+      const unsigned int size_y  = (l & 1) ? ((ch == 0) ? 1u << k : 2u << k) : 2u << k;
+      double             cost    = 0.0;
+      unsigned int       n_nodes = 0;
+      map->lvl_dom[l-1][ch] = cpu_fs_dom;
+      for (unsigned int y0 = 0; y0 < topo->n_cu_y; y0 += size_y){
+        for (unsigned int x0 = 0; x0 < topo->n_cu_x; x0 += size_x){
+          fsync_host_dom     dom   = cpu_fs_dom;
+          const unsigned int first = (y0 << topo->x_shift) + x0;
+          for (unsigned int y = y0; y < y0+size_y; y++){
+            for (unsigned int x = x0; x < x0+size_x; x++){
+              fsync_host_dom span = fsync_host_span(map, first, (y << topo->x_shift) + x);
+              if (span > dom) dom = span;
+            }
+          }
+          if (dom > map->lvl_dom[l-1][ch]) map->lvl_dom[l-1][ch] = dom;
+          cost += map->dom_cost[dom];
+          n_nodes++;
+        }
+      }
+      map->lvl_cost[l-1][ch] = cost/n_nodes;
+    }
+  }
+
+  return true;
+}
+
+double fsync_host_map_req_cost(const fsync_host_map_t *map, const fsync_topology_t *topo, const fsync_cu_t *cu){
+  const unsigned int aggr = cu->fsync_req.fs_req_aggr;
+  const unsigned int id   = cu->fsync_req.fs_req_id;
+  const unsigned int ch   = id & 1;
+  unsigned int       lvl  = 0;
+  while (aggr >> lvl) lvl++;
+  if (lvl == 0 || lvl > topo->n_lvl) return 0.0;
+
+  /* Neighbor link: only the two CPUs of the link */
+  if (lvl == 1 && id >= 2){
+    unsigned int pos = ch ? cu->y_pos : cu->x_pos;
+    unsigned int nbr = (pos & 1) ? pos+1 : pos-1;
+    if (pos == 0 || nbr >= topo->n_cu_x) return 0.0;
+    unsigned int cu1 = (cu->y_pos << topo->x_shift) + cu->x_pos;
+    unsigned int cu2 = ch ? (nbr << topo->x_shift) + cu->x_pos : (cu->y_pos << topo->x_shift) + nbr;
+    return 2*map->dom_cost[fsync_host_span(map, cu1, cu2)];
+  }
+
+  double cost = 0.0;
+  for (unsigned int l = 1; l <= lvl; l++)
+    if ((aggr >> (l-1)) & 1) cost += 2*map->lvl_cost[l-1][ch];
+  return cost;
+}
+
+bool fsync_host_map_pin(const fsync_host_map_t *map, const fsync_topology_t *topo, const fsync_cu_t *cu){
+  if (cu->y_pos >= topo->n_cu_y || cu->x_pos >= topo->n_cu_x) return false;
+  const unsigned int cpu = map->cpu[(cu->y_pos << topo->x_shift) + cu->x_pos];
+  if (cpu >= CPU_SETSIZE) return false;
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization host mapping header: placement of the CU threads of the host barrier on the CPUs
+ *
+ * The CPU topology (SMT siblings, L2 and L3 sharing, NUMA nodes, packages) is read from the Linux sysfs. In tree order
+ * the CUs are ranked along the h trees (x and y bits interleaved, x first: every h subtree and every 2D node covers a
+ * contiguous range of ranks) and the CPUs are sorted by package, NUMA node, L3, L2 and core, so that the lower levels
+ * of the trees land on the innermost shared-cache domains. Each node of the trees is then charged the nominal
+ * cache-line transfer cost of the widest domain spanned by the CPUs of its CUs.
+ */
+
+#ifndef FSYNC_HOST_MAP_H
+#define FSYNC_HOST_MAP_H
+
+#include "fractal_sync_req_gen.h"
+
+/* Sharing domains of two CPUs, innermost first */
+typedef enum {cpu_fs_dom, smt_fs_dom, l2_fs_dom, l3_fs_dom, numa_fs_dom, package_fs_dom, system_fs_dom, n_fs_doms} fsync_host_dom;
+typedef enum {row_fs_map, tree_fs_map} fsync_host_order;
+
+typedef struct fsync_host_map{
+  unsigned int   n_cpus;                                 /* CPUs the process may run on */
+  unsigned int   cpu[__FSYNC_MAX_N_CU__];                /* CPU of each CU (row-major CU index) */
+  unsigned int   dom_id[__FSYNC_MAX_N_CU__][n_fs_doms];  /* Domains of the CPU of each CU */
+  double         dom_cost[n_fs_doms];                    /* Cost of a synchronization across each domain (ns) */
+  fsync_host_dom lvl_dom[__FSYNC_MAX_N_LVL__][2];        /* Widest domain spanned by a node of each level (h, v): index 0 refers to level 1 */
+  double         lvl_cost[__FSYNC_MAX_N_LVL__][2];       /* Mean cost of the nodes of each level (h, v) in ns */
+} fsync_host_map_t;
+
+/**
+ * @brief read the CPU topology and assign a CPU to every CU of the mesh
+ * @param map host mapping
+ * @param topo topology descriptor
+ * @param order row_fs_map for the row-major layout of fsync_host_pin, tree_fs_map for the cache-topology-aware layout
+ * @param sysfs root of the CPU and NUMA node directories, NULL for /sys/devices/system
+ * @param dom_cost cost of a synchronization across each domain in ns, NULL for nominal values of current servers
+ * @return true if the mapping has been computed properly, false otherwise (e.g. CPU topology not readable)
+ */
+bool fsync_host_map_init(fsync_host_map_t *map, const fsync_topology_t *topo, const fsync_host_order order, const char *sysfs, const double *dom_cost);
+
+/**
+ * @brief expected cost of a barrier: the request climbs to its barrier node and the wake goes back down
+ * @param map host mapping
+ * @param topo topology descriptor
+ * @param cu CU position and request, as set by the generator
+ * @return sum of the level costs along the path of the request in ns (0 for no request)
+ */
+double fsync_host_map_req_cost(const fsync_host_map_t *map, const fsync_topology_t *topo, const fsync_cu_t *cu);
+
+/**
+ * @brief name of a sharing domain
+ * @param dom sharing domain
+ * @return name of the domain
+ */
+const char *fsync_host_dom_name(const fsync_host_dom dom);
+
+/**
+ * @brief pin the calling thread to the CPU of its CU
+ * @param map host mapping
+ * @param topo topology descriptor
+ * @param cu CU played by the calling thread
+ * @return true if the thread has been pinned, false otherwise (e.g. affinity not supported)
+ */
+bool fsync_host_map_pin(const fsync_host_map_t *map, const fsync_topology_t *topo, const fsync_cu_t *cu);
+
+#endif /*FSYNC_HOST_MAP_H*/
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization request cache: memoizes the generator output per CU membership set
+ */
+
+#include <string.h>
+#include "fractal_sync_req_cache.h"
+
+static inline uint64_t fsync_mix(uint64_t value){
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebULL;
+  value ^= value >> 31;
+  return value;
+}
+
+static inline uint64_t fsync_members_key(const uint64_t *members, const unsigned int n_words){
+  if (n_words == 1) return members[0];
+  uint64_t key = 0;
+  for (unsigned int w = 0; w < n_words; w++)
+    key = fsync_mix(key ^ (members[w] + 0x9e3779b97f4a7c15ULL*(w+1)));
+  return key;
+}
+
+static inline const uint64_t *fsync_entry_members(const fsync_req_cache_t *cache, const unsigned int entry){
+  return &cache->members[entry*cache->n_words];
+}
+
+static inline fsync_req_t *fsync_entry_reqs(const fsync_req_cache_t *cache, const unsigned int entry){
+  return &cache->reqs[entry*cache->max_cus];
+}
+
+static int fsync_req_cache_find(const fsync_req_cache_t *cache, const uint64_t key, const uint64_t *members, const fsync_dir dir){
+  unsigned int index = (unsigned int)fsync_mix(key);
+  for (unsigned int p = 0; p < __FSYNC_REQ_CACHE_PROBES__ && p < cache->n_entries; p++){
+    unsigned int entry = (index + p) & (cache->n_entries-1);
+    const fsync_req_cache_entry_t *e = &cache->entries[entry];
+    if (!e->valid || e->key != key || e->dir != dir) continue;
+    if (cache->members != NULL && memcmp(fsync_entry_members(cache, entry), members, cache->n_words*sizeof(uint64_t))) continue;
+    return (int)entry;
+  }
+  return -1;
+}
+
+static unsigned int fsync_req_cache_victim(const fsync_req_cache_t *cache, const uint64_t key){
+  unsigned int index  = (unsigned int)fsync_mix(key);
+  unsigned int victim = index & (cache->n_entries-1);
+  for (unsigned int p = 0; p < __FSYNC_REQ_CACHE_PROBES__ && p < cache->n_entries; p++){
+    unsigned int entry = (index + p) & (cache->n_entries-1);
+    if (!cache->entries[entry].valid) return entry;
+    if (cache->stamp - cache->entries[entry].stamp > cache->stamp - cache->entries[victim].stamp) victim = entry;
+  }
+  return victim;
+}
+
+size_t fsync_req_cache_size(const fsync_topology_t *topo, const unsigned int n_entries, const unsigned int max_cus){
+  unsigned int n_words = __FSYNC_MEMBERS_WORDS__(topo->n_cu);
+  size_t       size    = (size_t)n_entries*sizeof(fsync_req_cache_entry_t);
+  if (n_words > 1) size += (size_t)n_entries*n_words*sizeof(uint64_t);
+  size += (size_t)n_entries*max_cus*sizeof(fsync_req_t);
+  return size;
+}
+
+bool fsync_req_cache_init(fsync_req_cache_t *cache, const fsync_topology_t *topo, const unsigned int n_entries, const unsigned int max_cus, void *mem, const size_t mem_size){
+  if (cache == NULL || topo == NULL || mem == NULL) return false;
+  if (n_entries == 0 || (n_entries & (n_entries-1)) || max_cus < 2) return false;
+  if (mem_size < fsync_req_cache_size(topo, n_entries, max_cus)) return false;
+
+  cache->topo      = topo;
+  cache->n_entries = n_entries;
+  cache->max_cus   = max_cus;
+  cache->n_words   = __FSYNC_MEMBERS_WORDS__(topo->n_cu);
+  /* Entries and membership bitmaps first: both require 64-bit alignment */
+  cache->entries   = (fsync_req_cache_entry_t*)mem;
+  cache->members   = (cache->n_words > 1) ? (uint64_t*)(cache->entries + n_entries) : NULL;
+  cache->reqs      = (cache->n_words > 1) ? (fsync_req_t*)(cache->members + n_entries*cache->n_words) :
+                                            (fsync_req_t*)(cache->entries + n_entries);
+  fsync_req_cache_flush(cache);
+
+  return true;
+}
+
+void fsync_req_cache_flush(fsync_req_cache_t *cache){
+  for (unsigned int i = 0; i < cache->n_entries; i++) cache->entries[i].valid = false;
+  cache->stamp    = 0;
+  cache->hits     = 0;
+  cache->misses   = 0;
+  cache->bypasses = 0;
+}
+
+const fsync_req_t *fsync_req_cache_lookup(fsync_req_cache_t *cache, const uint64_t *members, const fsync_dir default_dir){
+  int entry = fsync_req_cache_find(cache, fsync_members_key(members, cache->n_words), members, default_dir);
+  if (entry < 0){
+    cache->misses++;
+    return NULL;
+  }
+  cache->hits++;
+  cache->entries[entry].stamp = ++cache->stamp;
+  return fsync_entry_reqs(cache, (unsigned int)entry);
+}
+
+bool fsync_req_cache_gen_reqs(fsync_req_cache_t *cache, fsync_cu_t *cus, const unsigned int num_cus, const fsync_dir default_dir){
+  const fsync_topology_t *topo = cache->topo;
+
+  if (num_cus < 2 || num_cus > cache->max_cus){
+    cache->bypasses++;
+    return fsync_gen_reqs_fast(topo, cus, num_cus, default_dir);
+  }
+
+  uint64_t members[__FSYNC_MEMBERS_WORDS__(__FSYNC_MAX_N_CU__)];
+  for (unsigned int w = 0; w < cache->n_words; w++) members[w] = 0;
+  for (unsigned int i = 0; i < num_cus; i++){
+    unsigned int pos = (cus[i].y_pos << topo->x_shift) + cus[i].x_pos;
+    /* CUs outside of the mesh or repeated CUs are left to the generator */
+    if (cus[i].x_pos >= topo->n_cu_x || cus[i].y_pos >= topo->n_cu_y || (members[pos >> 6] >> (pos & 63)) & 1){
+      cache->bypasses++;
+      return fsync_gen_reqs_fast(topo, cus, num_cus, default_dir);
+    }
+    members[pos >> 6] |= 1ULL << (pos & 63);
+  }
+
+  /* Requests are stored by rank of the CU position in the membership bitmap */
+  unsigned int rank_base[__FSYNC_MEMBERS_WORDS__(__FSYNC_MAX_N_CU__)];
+  for (unsigned int w = 0, rank = 0; w < cache->n_words; w++){
+    rank_base[w] = rank;
+    rank        += __builtin_popcountll(members[w]);
+  }
+
+  uint64_t key   = fsync_members_key(members, cache->n_words);
+  int      entry = fsync_req_cache_find(cache, key, members, default_dir);
+  if (entry >= 0){
+    cache->hits++;
+    cache->entries[entry].stamp = ++cache->stamp;
+    const fsync_req_t *reqs = fsync_entry_reqs(cache, (unsigned int)entry);
+    for (unsigned int i = 0; i < num_cus; i++){
+      unsigned int pos = (cus[i].y_pos << topo->x_shift) + cus[i].x_pos;
+      cus[i].fsync_req = reqs[rank_base[pos >> 6] + __builtin_popcountll(members[pos >> 6] & ((1ULL << (pos & 63)) - 1))];
+    }
+    return cache->entries[entry].generated;
+  }
+
+  cache->misses++;
+  bool generated_reqs = fsync_gen_reqs_fast(topo, cus, num_cus, default_dir);
+
+  unsigned int victim = fsync_req_cache_victim(cache, key);
+  fsync_req_cache_entry_t *e = &cache->entries[victim];
+  e->key       = key;
+  e->num_cus   = num_cus;
+  e->stamp     = ++cache->stamp;
+  e->dir       = default_dir;
+  e->valid     = true;
+  e->generated = generated_reqs;
+  if (cache->members != NULL) memcpy(&cache->members[victim*cache->n_words], members, cache->n_words*sizeof(uint64_t));
+  fsync_req_t *reqs = fsync_entry_reqs(cache, victim);
+  for (unsigned int i = 0; i < num_cus; i++){
+    unsigned int pos = (cus[i].y_pos << topo->x_shift) + cus[i].x_pos;
+    reqs[rank_base[pos >> 6] + __builtin_popcountll(members[pos >> 6] & ((1ULL << (pos & 63)) - 1))] = cus[i].fsync_req;
+  }
+
+  return generated_reqs;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization request cache header
+ */
+
+#ifndef FSYNC_REQ_CACHE_H
+#define FSYNC_REQ_CACHE_H
+
+#include <stdint.h>
+#include "fractal_sync_req_gen.h"
+
+/* Number of entries probed on lookup/insertion (bounded linear probing) */
+#define __FSYNC_REQ_CACHE_PROBES__   (4)
+/* Number of 64-bit words of a CU membership bitmap */
+#define __FSYNC_MEMBERS_WORDS__(n_cu) (((n_cu)+63)/64)
+
+typedef struct fsync_req_cache_entry{
+  uint64_t     key;       /* Membership bitmap (meshes up to 64 CUs) or membership fingerprint */
+  unsigned int num_cus;
+  unsigned int stamp;     /* Last use, for replacement */
+  fsync_dir    dir;
+  bool         valid;
+  bool         generated; /* Return value of the generator */
+} fsync_req_cache_entry_t;
+
+typedef struct fsync_req_cache{
+  const fsync_topology_t  *topo;
+  fsync_req_cache_entry_t *entries;
+  uint64_t                *members;  /* Full membership bitmap of each entry, NULL if the key is the bitmap itself */
+  fsync_req_t             *reqs;     /* max_cus requests per entry, ordered by CU position (y_pos*n_cu_x + x_pos) */
+  unsigned int             n_entries;
+  unsigned int             max_cus;
+  unsigned int             n_words;
+  unsigned int             stamp;
+  unsigned long            hits;
+  unsigned long            misses;
+  unsigned long            bypasses; /* Groups that cannot be cached (too large, repeated CUs) */
+} fsync_req_cache_t;
+
+/**
+ * @brief size of the memory required by a request cache
+ * @param topo topology descriptor
+ * @param n_entries number of cached groups (power of two)
+ * @param max_cus largest cached group, larger groups bypass the cache
+ * @return memory size in bytes
+ */
+size_t fsync_req_cache_size(const fsync_topology_t *topo, const unsigned int n_entries, const unsigned int max_cus);
+
+/**
+ * @brief initialize an empty request cache over caller-owned memory
+ * @param cache request cache
+ * @param topo topology descriptor (must outlive the cache)
+ * @param n_entries number of cached groups (power of two)
+ * @param max_cus largest cached group, larger groups bypass the cache
+ * @param mem memory of at least fsync_req_cache_size(topo, n_entries, max_cus) bytes, aligned for 64-bit access
+ * @param mem_size size of the memory in bytes
+ * @return true if the cache has been initialized properly, false otherwise
+ */
+bool fsync_req_cache_init(fsync_req_cache_t *cache, const fsync_topology_t *topo, const unsigned int n_entries, const unsigned int max_cus, void *mem, const size_t mem_size);
+
+/**
+ * @brief invalidate all entries and clear the hit/miss counters
+ * @param cache request cache
+ * @return no return value
+ */
+void fsync_req_cache_flush(fsync_req_cache_t *cache);
+
+/**
+ * @brief look up a group by membership bitmap
+ * @param cache request cache
+ * @param members membership bitmap, bit (y_pos*n_cu_x + x_pos) set for every CU of the group (__FSYNC_MEMBERS_WORDS__(n_cu) words)
+ * @param default_dir default barrier direction when the barrier can be reached both horizontaly and vertically (i.e. synchronization at 2D node)
+ * @return requests of the group ordered by CU position, NULL on a miss
+ */
+const fsync_req_t *fsync_req_cache_lookup(fsync_req_cache_t *cache, const uint64_t *members, const fsync_dir default_dir);
+
+/**
+ * @brief same as fsync_gen_reqs, but served from the cache when the group has already been generated
+ * @param cache request cache
+ * @param cus array of CUs
+ * @param num_cus size of the array of CUs
+ * @param default_dir default barrier direction when the barrier can be reached both horizontaly and vertically (i.e. synchronization at 2D node)
+ * @return true if synchronization requests have been generated properly, false otherwise (e.g. degenerate array of CUs)
+ */
+bool fsync_req_cache_gen_reqs(fsync_req_cache_t *cache, fsync_cu_t *cus, const unsigned int num_cus, const fsync_dir default_dir);
+
+#endif /*FSYNC_REQ_CACHE_H*/
@@ -35,20 +35,92 @@ static inline unsigned int fsync_update_pos(unsigned int *pos, const unsigned in
   return threshold/2;
 }
 
-bool fsync_partition_h_cus(fsync_cu_t **cus, const unsigned int num_cus, const unsigned int threshold, fsync_cu_t **l_cus, unsigned int *num_l_cus, fsync_cu_t **h_cus, unsigned int *num_h_cus){
+static inline void fsync_swap_cus(fsync_cu_t **cus, const unsigned int i, const unsigned int j){
+  fsync_cu_t *temp = cus[i];
+  cus[i] = cus[j];
+  cus[j] = temp;
+}
+
+static inline unsigned int fsync_log2(unsigned int value){
+  unsigned int log = 0;
+  while (value >>= 1) log++;
+  return log;
+}
+
+bool fsync_topology_init(fsync_topology_t *topo, const unsigned int n_cu_x, const unsigned int n_cu_y, const unsigned int *n_local_regs, const unsigned int *n_links){
+  if (topo == NULL) return false;
+  if (n_cu_x < 2 || n_cu_x != n_cu_y || (n_cu_x & (n_cu_x-1))) return false;
+  if (n_cu_x > __FSYNC_MAX_N_CU_X__) return false;
+
+  topo->n_cu_x     = n_cu_x;
+  topo->n_cu_y     = n_cu_y;
+  topo->n_cu       = n_cu_x*n_cu_y;
+  topo->x_shift    = fsync_log2(n_cu_x);
+  topo->n_lvl      = 2*topo->x_shift;
+  topo->n_2d_lvl   = topo->x_shift;
+  topo->root_th    = n_cu_x/2;
+  topo->aggr_width = topo->n_lvl+1;
+  topo->id_width   = topo->n_lvl-1;
+  topo->lvl_width  = fsync_log2(topo->n_lvl-1)+1;
+
+  for (unsigned int l = 0; l < topo->n_lvl; l++){
+    bool node_2d = (l & 1);
+    /* Default sizes follow hw/trees: 1D local RFs grow as 4^i, 2D local RFs as 2*4^i, links double every other level */
+    topo->n_local_regs[l] = (n_local_regs != NULL) ? n_local_regs[l] : (node_2d ? 2u : 1u) << (2*(l/2));
+    topo->n_links[l]      = (n_links      != NULL) ? n_links[l]      : 1u << (l/2);
+    if (topo->n_local_regs[l] < (node_2d ? 2 : 1) || topo->n_links[l] < 1) return false;
+    topo->n_dir_regs[l]   = node_2d ? topo->n_local_regs[l]/2 : topo->n_local_regs[l];
+  }
+  for (unsigned int l = topo->n_lvl; l < __FSYNC_MAX_N_LVL__; l++){
+    topo->n_local_regs[l] = 0;
+    topo->n_dir_regs[l]   = 0;
+    topo->n_links[l]      = 0;
+  }
+
+  topo->n_2d_nodes = 0;
+  for (unsigned int b = 0; b < __FSYNC_MAX_N_2D_LVL__; b++){
+    topo->occ_offset[b] = topo->n_2d_nodes;
+    if (b < topo->n_2d_lvl) topo->n_2d_nodes += 1 << (2*(topo->x_shift-(b+1)));
+  }
+
+  return true;
+}
+
+bool fsync_active_h_cus(fsync_cu_t **cus, const unsigned int num_cus, const unsigned int threshold){
+  bool l_cus = false;
+  bool h_cus = false;
   for (unsigned int i = 0; i < num_cus; i++){
-    if (cus[i]->x_pos < threshold) l_cus[(*num_l_cus)++] = cus[i];
-    else                           h_cus[(*num_h_cus)++] = cus[i];                          
+    if (cus[i]->x_pos < threshold) l_cus = true;
+    else                           h_cus = true;
+    if (l_cus && h_cus) return true;
   }
-  return (*num_l_cus > 0) && (*num_h_cus > 0);
+  return false;
 }
 
-bool fsync_partition_v_cus(fsync_cu_t **cus, const unsigned int num_cus, const unsigned int threshold, fsync_cu_t **l_cus, unsigned int *num_l_cus, fsync_cu_t **h_cus, unsigned int *num_h_cus){
+bool fsync_active_v_cus(fsync_cu_t **cus, const unsigned int num_cus, const unsigned int threshold){
+  bool l_cus = false;
+  bool h_cus = false;
   for (unsigned int i = 0; i < num_cus; i++){
-    if (cus[i]->y_pos < threshold) l_cus[(*num_l_cus)++] = cus[i];
-    else                           h_cus[(*num_h_cus)++] = cus[i];
+    if (cus[i]->y_pos < threshold) l_cus = true;
+    else                           h_cus = true;
+    if (l_cus && h_cus) return true;
   }
-  return (*num_l_cus > 0) && (*num_h_cus > 0);
+  return false;
+}
+
+/* In-place partition: low CUs are moved to cus[0:num_l_cus-1], high CUs to cus[num_l_cus:num_cus-1] */
+bool fsync_partition_h_cus(fsync_cu_t **cus, const unsigned int num_cus, const unsigned int threshold, unsigned int *num_l_cus){
+  *num_l_cus = 0;
+  for (unsigned int i = 0; i < num_cus; i++)
+    if (cus[i]->x_pos < threshold) fsync_swap_cus(cus, i, (*num_l_cus)++);
+  return (*num_l_cus > 0) && (*num_l_cus < num_cus);
+}
+
+bool fsync_partition_v_cus(fsync_cu_t **cus, const unsigned int num_cus, const unsigned int threshold, unsigned int *num_l_cus){
+  *num_l_cus = 0;
+  for (unsigned int i = 0; i < num_cus; i++)
+    if (cus[i]->y_pos < threshold) fsync_swap_cus(cus, i, (*num_l_cus)++);
+  return (*num_l_cus > 0) && (*num_l_cus < num_cus);
 }
 
 unsigned int fsync_update_h_poss(fsync_cu_t **cus, const unsigned int num_cus, const unsigned int threshold){
@@ -77,76 +149,43 @@ void fsync_update_cus_req(fsync_cu_t **cus, const unsigned int num_cus, const fs
 bool fsync_partition_subtree(fsync_cu_t **cus, const unsigned int num_cus, const fsync_dir dir, const unsigned int threshold, const fsync_node node){
   if (threshold < 1) return false;
 
+  unsigned int num_l_cus;
+  bool         l_subtree_active;
+  bool         h_subtree_active;
+
   if (node == hv_fs_node){
-    fsync_cu_t **h_l_cus = malloc(num_cus*sizeof(fsync_cu_t*));
-    fsync_cu_t **h_h_cus = malloc(num_cus*sizeof(fsync_cu_t*));
-    fsync_cu_t **v_l_cus = malloc(num_cus*sizeof(fsync_cu_t*));
-    fsync_cu_t **v_h_cus = malloc(num_cus*sizeof(fsync_cu_t*));
-    if (h_l_cus == NULL || h_h_cus == NULL || v_l_cus == NULL || v_h_cus == NULL) return false;
-    unsigned int num_h_l_cus = 0;
-    unsigned int num_h_h_cus = 0;
-    unsigned int num_v_l_cus = 0;
-    unsigned int num_v_h_cus = 0;
-
-    bool h_node_active = fsync_partition_h_cus(cus, num_cus, threshold, h_l_cus, &num_h_l_cus, h_h_cus, &num_h_h_cus);
-    bool v_node_active = fsync_partition_v_cus(cus, num_cus, threshold, v_l_cus, &num_v_l_cus, v_h_cus, &num_v_h_cus);
+    bool h_node_active = fsync_active_h_cus(cus, num_cus, threshold);
+    bool v_node_active = fsync_active_v_cus(cus, num_cus, threshold);
     bool node_active = h_node_active && v_node_active;
 
-    bool l_subtree_active;
-    bool h_subtree_active;
-    if (node_active || (!h_node_active && !v_node_active)){
-      if (dir == h_fs_dir){
-        fsync_update_cus_req(v_l_cus, num_v_l_cus, dir, node, node_active);
-        fsync_update_cus_req(v_h_cus, num_v_h_cus, dir, node, node_active);
-        fsync_update_v_poss(v_h_cus, num_v_h_cus, threshold);
-        l_subtree_active = fsync_partition_subtree(v_l_cus, num_v_l_cus, h_fs_dir, threshold, h_fs_node);
-        h_subtree_active = fsync_partition_subtree(v_h_cus, num_v_h_cus, h_fs_dir, threshold, h_fs_node);
-      }else{
-        fsync_update_cus_req(h_l_cus, num_h_l_cus, dir, node, node_active);
-        fsync_update_cus_req(h_h_cus, num_h_h_cus, dir, node, node_active);
-        fsync_update_h_poss(h_h_cus, num_h_h_cus, threshold);
-        l_subtree_active = fsync_partition_subtree(h_l_cus, num_h_l_cus, v_fs_dir, threshold, v_fs_node);
-        h_subtree_active = fsync_partition_subtree(h_h_cus, num_h_h_cus, v_fs_dir, threshold, v_fs_node);
-      }
-    }else if(h_node_active){
-      fsync_update_cus_req(v_l_cus, num_v_l_cus, dir, node, node_active);
-      fsync_update_cus_req(v_h_cus, num_v_h_cus, dir, node, node_active);
-      fsync_update_v_poss(v_h_cus, num_v_h_cus, threshold);
-      l_subtree_active = fsync_partition_subtree(v_l_cus, num_v_l_cus, h_fs_dir, threshold, h_fs_node);
-      h_subtree_active = fsync_partition_subtree(v_h_cus, num_v_h_cus, h_fs_dir, threshold, h_fs_node);
+    fsync_dir subtree_dir;
+    if (node_active || (!h_node_active && !v_node_active)) subtree_dir = dir;
+    else if (h_node_active)                                 subtree_dir = h_fs_dir;
+    else                                                    subtree_dir = v_fs_dir;
+
+    fsync_update_cus_req(cus, num_cus, dir, node, node_active);
+    if (subtree_dir == h_fs_dir){
+      fsync_partition_v_cus(cus, num_cus, threshold, &num_l_cus);
+      fsync_update_v_poss(&cus[num_l_cus], num_cus-num_l_cus, threshold);
+      l_subtree_active = fsync_partition_subtree(cus, num_l_cus, h_fs_dir, threshold, h_fs_node);
+      h_subtree_active = fsync_partition_subtree(&cus[num_l_cus], num_cus-num_l_cus, h_fs_dir, threshold, h_fs_node);
     }else{
-      fsync_update_cus_req(h_l_cus, num_h_l_cus, dir, node, node_active);
-      fsync_update_cus_req(h_h_cus, num_h_h_cus, dir, node, node_active);
-      fsync_update_h_poss(h_h_cus, num_h_h_cus, threshold);
-      l_subtree_active = fsync_partition_subtree(h_l_cus, num_h_l_cus, v_fs_dir, threshold, v_fs_node);
-      h_subtree_active = fsync_partition_subtree(h_h_cus, num_h_h_cus, v_fs_dir, threshold, v_fs_node);
+      fsync_partition_h_cus(cus, num_cus, threshold, &num_l_cus);
+      fsync_update_h_poss(&cus[num_l_cus], num_cus-num_l_cus, threshold);
+      l_subtree_active = fsync_partition_subtree(cus, num_l_cus, v_fs_dir, threshold, v_fs_node);
+      h_subtree_active = fsync_partition_subtree(&cus[num_l_cus], num_cus-num_l_cus, v_fs_dir, threshold, v_fs_node);
     }
-    
-    free(h_l_cus);
-    free(h_h_cus);
-    free(v_l_cus);
-    free(v_h_cus);
 
     return node_active || l_subtree_active || h_subtree_active;
   }else{
-    fsync_cu_t **l_cus = malloc(num_cus*sizeof(fsync_cu_t*));
-    fsync_cu_t **h_cus = malloc(num_cus*sizeof(fsync_cu_t*));
-    if (l_cus == NULL || h_cus == NULL) return false;
-    unsigned int num_l_cus = 0;
-    unsigned int num_h_cus = 0;
-
-    bool node_active = (dir == h_fs_dir) ? fsync_partition_h_cus(cus, num_cus, threshold, l_cus, &num_l_cus, h_cus, &num_h_cus) :
-                                           fsync_partition_v_cus(cus, num_cus, threshold, l_cus, &num_l_cus, h_cus, &num_h_cus);
-    fsync_update_cus_req(l_cus, num_l_cus, dir, node, node_active);
-    fsync_update_cus_req(h_cus, num_h_cus, dir, node, node_active);
-    unsigned int subtree_threshold = (dir == h_fs_dir) ? fsync_update_h_poss(h_cus, num_h_cus, threshold) :
-                                                         fsync_update_v_poss(h_cus, num_h_cus, threshold);
-
-    bool l_subtree_active = fsync_partition_subtree(l_cus, num_l_cus, dir, subtree_threshold, hv_fs_node);
-    bool h_subtree_active = fsync_partition_subtree(h_cus, num_h_cus, dir, subtree_threshold, hv_fs_node);
+    bool node_active = (dir == h_fs_dir) ? fsync_partition_h_cus(cus, num_cus, threshold, &num_l_cus) :
+                                           fsync_partition_v_cus(cus, num_cus, threshold, &num_l_cus);
+    fsync_update_cus_req(cus, num_cus, dir, node, node_active);
+    unsigned int subtree_threshold = (dir == h_fs_dir) ? fsync_update_h_poss(&cus[num_l_cus], num_cus-num_l_cus, threshold) :
+                                                         fsync_update_v_poss(&cus[num_l_cus], num_cus-num_l_cus, threshold);
 
-    free (l_cus);
-    free (h_cus);
+    l_subtree_active = fsync_partition_subtree(cus, num_l_cus, dir, subtree_threshold, hv_fs_node);
+    h_subtree_active = fsync_partition_subtree(&cus[num_l_cus], num_cus-num_l_cus, dir, subtree_threshold, hv_fs_node);
 
     return node_active || l_subtree_active || h_subtree_active;
   }
@@ -160,91 +199,100 @@ void fsync_init_reqs(fsync_cu_t *cus, const unsigned int num_cus){
   }
 }
 
-bool fsync_gen_reqs(fsync_cu_t *cus, const unsigned int num_cus, const fsync_dir default_dir){
-  fsync_init_reqs(cus, num_cus);
-  
-  if (num_cus < 2) return false;
+static bool fsync_gen_pair_reqs(const fsync_topology_t *topo, fsync_cu_t *cus, const fsync_dir default_dir){
+  unsigned int x_dist = abs_diff(cus[0].x_pos, cus[1].x_pos);
+  unsigned int y_dist = abs_diff(cus[0].y_pos, cus[1].y_pos);
+  unsigned int dist   = x_dist + y_dist;
+  fsync_dir    dir;
 
-  if (num_cus == 2){
-    unsigned int x_dist = abs_diff(cus[0].x_pos, cus[1].x_pos);
-    unsigned int y_dist = abs_diff(cus[0].y_pos, cus[1].y_pos);
-    unsigned int dist   = x_dist + y_dist;
-    fsync_dir    dir;
+  if (dist == 0) return false;
 
-    if (dist == 0) return false;
+  if (x_dist > y_dist){
+    dir = h_fs_dir;
+    cus[0].fsync_req.req_node = h_fs_node; cus[1].fsync_req.req_node = h_fs_node;
+  }else if(x_dist == y_dist){
+    dir = default_dir;
+    cus[0].fsync_req.req_node = hv_fs_node; cus[1].fsync_req.req_node = hv_fs_node; 
+  }else{
+    dir = v_fs_dir;
+    cus[0].fsync_req.req_node = v_fs_node; cus[1].fsync_req.req_node = v_fs_node; 
+  }
 
-    if (x_dist > y_dist){
-      dir = h_fs_dir;
-      cus[0].fsync_req.req_node = h_fs_node; cus[1].fsync_req.req_node = h_fs_node;
-    }else if(x_dist == y_dist){
-      dir = default_dir;
-      cus[0].fsync_req.req_node = hv_fs_node; cus[1].fsync_req.req_node = hv_fs_node; 
+  if (dist == 1){
+    cus[0].fsync_req.fs_req_aggr = 0b1; cus[1].fsync_req.fs_req_aggr = 0b1;
+    if (dir == h_fs_dir){
+      if (fsync_nbr_node(cus[0].x_pos, cus[1].x_pos)){
+        cus[0].fsync_req.fs_req_id = 2; cus[1].fsync_req.fs_req_id = 2;  
+      }else{
+        cus[0].fsync_req.fs_req_id = 0; cus[1].fsync_req.fs_req_id = 0;
+      }
     }else{
-      dir = v_fs_dir;
-      cus[0].fsync_req.req_node = v_fs_node; cus[1].fsync_req.req_node = v_fs_node; 
+      if (fsync_nbr_node(cus[0].y_pos, cus[1].y_pos)){
+        cus[0].fsync_req.fs_req_id = 3; cus[1].fsync_req.fs_req_id = 3;
+      }else{
+        cus[0].fsync_req.fs_req_id = 1; cus[1].fsync_req.fs_req_id = 1;
+      }
+    }
+  }else{
+    unsigned int hops = topo->n_lvl;
+    unsigned int x_th = topo->root_th;
+    unsigned int y_th = topo->root_th;
+    unsigned int x_p0 = cus[0].x_pos;
+    unsigned int x_p1 = cus[1].x_pos;
+    unsigned int y_p0 = cus[0].y_pos;
+    unsigned int y_p1 = cus[1].y_pos;
+    bool done = false;
+    while (!done){
+      if (fsync_same_subtree(x_p0, x_p1, x_th) && x_th > 0){
+        fsync_update_pos(&x_p0, x_th);
+        x_th = fsync_update_pos(&x_p1, x_th);
+        --hops;
+      } else done = true;
+      if (fsync_same_subtree(y_p0, y_p1, y_th) && y_th >0){
+        fsync_update_pos(&y_p0, y_th);
+        y_th = fsync_update_pos(&y_p1, y_th);
+        --hops;
+      } else done = true;
     }
 
-    if (dist == 1){
-      cus[0].fsync_req.fs_req_aggr = 0b1; cus[1].fsync_req.fs_req_aggr = 0b1;
+    if (hops > 1){
+      unsigned int aggregate = 0b1 << (hops-1);
+      cus[0].fsync_req.fs_req_aggr = aggregate; cus[1].fsync_req.fs_req_aggr = aggregate;
       if (dir == h_fs_dir){
-        if (fsync_nbr_node(cus[0].x_pos, cus[1].x_pos)){
-          cus[0].fsync_req.fs_req_id = 2; cus[1].fsync_req.fs_req_id = 2;  
-        }else{
-          cus[0].fsync_req.fs_req_id = 0; cus[1].fsync_req.fs_req_id = 0;
-        }
+        cus[0].fsync_req.fs_req_id = 0;         cus[1].fsync_req.fs_req_id = 0;
+        cus[0].fsync_req.req_node  = h_fs_node; cus[1].fsync_req.req_node  = h_fs_node;
       }else{
-        if (fsync_nbr_node(cus[0].y_pos, cus[1].y_pos)){
-          cus[0].fsync_req.fs_req_id = 3; cus[1].fsync_req.fs_req_id = 3;
-        }else{
-          cus[0].fsync_req.fs_req_id = 1; cus[1].fsync_req.fs_req_id = 1;
-        }
-      }
-    }else{
-      unsigned int hops = __FSYNC_N_LVL__;
-      unsigned int x_th = __FSYNC_N_CU_X__/2;
-      unsigned int y_th = __FSYNC_N_CU_Y__/2;
-      unsigned int x_p0 = cus[0].x_pos;
-      unsigned int x_p1 = cus[1].x_pos;
-      unsigned int y_p0 = cus[0].y_pos;
-      unsigned int y_p1 = cus[1].y_pos;
-      bool done = false;
-      while (!done){
-        if (fsync_same_subtree(x_p0, x_p1, x_th) && x_th > 0){
-          fsync_update_pos(&x_p0, x_th);
-          x_th = fsync_update_pos(&x_p1, x_th);
-          --hops;
-        } else done = true;
-        if (fsync_same_subtree(y_p0, y_p1, y_th) && y_th >0){
-          fsync_update_pos(&y_p0, y_th);
-          y_th = fsync_update_pos(&y_p1, y_th);
-          --hops;
-        } else done = true;
+        cus[0].fsync_req.fs_req_id = 1;         cus[1].fsync_req.fs_req_id = 1;
+        cus[0].fsync_req.req_node  = v_fs_node; cus[1].fsync_req.req_node  = v_fs_node;
       }
-
-      if (hops > 1){
-        unsigned int aggregate = 0b1 << (hops-1);
-        cus[0].fsync_req.fs_req_aggr = aggregate; cus[1].fsync_req.fs_req_aggr = aggregate;
-        if (dir == h_fs_dir){
-          cus[0].fsync_req.fs_req_id = 0;         cus[1].fsync_req.fs_req_id = 0;
-          cus[0].fsync_req.req_node  = h_fs_node; cus[1].fsync_req.req_node  = h_fs_node;
-        }else{
-          cus[0].fsync_req.fs_req_id = 1;         cus[1].fsync_req.fs_req_id = 1;
-          cus[0].fsync_req.req_node  = v_fs_node; cus[1].fsync_req.req_node  = v_fs_node;
-        }
-      }else return false;
-    }
-    return true;
+    }else return false;
   }
+  return true;
+}
+
+size_t fsync_gen_reqs_workspace_size(const unsigned int num_cus){
+  if (num_cus <= 2) return 0;
+  return num_cus*(sizeof(fsync_cu_t*) + sizeof(fsync_cu_t));
+}
 
-  fsync_cu_t *temp_cus = malloc(num_cus*sizeof(fsync_cu_t));
-  if (temp_cus == NULL) return false;
-  for (unsigned int i = 0; i < num_cus; i++) temp_cus[i] = cus[i];
+bool fsync_gen_reqs_workspace(const fsync_topology_t *topo, fsync_cu_t *cus, const unsigned int num_cus, const fsync_dir default_dir, void *workspace, const size_t workspace_size){
+  fsync_init_reqs(cus, num_cus);
+  
+  if (num_cus < 2) return false;
 
-  fsync_cu_t **cus_ptr = malloc(num_cus*sizeof(fsync_cu_t*));
-  if (cus_ptr == NULL) return false;
-  for (unsigned int i = 0; i < num_cus; i++) cus_ptr[i] = &temp_cus[i];
+  if (num_cus == 2) return fsync_gen_pair_reqs(topo, cus, default_dir);
 
-  bool generated_reqs = fsync_partition_subtree(cus_ptr, num_cus, default_dir, __FSYNC_DEFAULT_TH__, hv_fs_node);
+  if (workspace == NULL || workspace_size < fsync_gen_reqs_workspace_size(num_cus)) return false;
+
+  /* Pointer array first: the workspace is only required to be aligned for fsync_cu_t*, fsync_cu_t copies follow */
+  fsync_cu_t **cus_ptr  = (fsync_cu_t**)workspace;
+  fsync_cu_t  *temp_cus = (fsync_cu_t*)(cus_ptr + num_cus);
+  for (unsigned int i = 0; i < num_cus; i++){
+    temp_cus[i] = cus[i];
+    cus_ptr[i]  = &temp_cus[i];
+  }
+
+  bool generated_reqs = fsync_partition_subtree(cus_ptr, num_cus, default_dir, topo->root_th, hv_fs_node);
 
   for (unsigned int i = 0; i < num_cus; i++){
     cus[i].fsync_req.fs_req_aggr = temp_cus[i].fsync_req.fs_req_aggr;
@@ -252,8 +300,97 @@ bool fsync_gen_reqs(fsync_cu_t *cus, const unsigned int num_cus, const fsync_dir
     cus[i].fsync_req.req_node    = temp_cus[i].fsync_req.req_node;
   }
 
-  free(cus_ptr);
-  free(temp_cus);
+  return generated_reqs;
+}
+
+bool fsync_gen_reqs(const fsync_topology_t *topo, fsync_cu_t *cus, const unsigned int num_cus, const fsync_dir default_dir){
+  size_t workspace_size = fsync_gen_reqs_workspace_size(num_cus);
+  void  *workspace      = NULL;
+  
+  if (workspace_size > 0){
+    workspace = malloc(workspace_size);
+    if (workspace == NULL){
+      fsync_init_reqs(cus, num_cus);
+      return false;
+    }
+  }
+
+  bool generated_reqs = fsync_gen_reqs_workspace(topo, cus, num_cus, default_dir, workspace, workspace_size);
+
+  free(workspace);
+
+  return generated_reqs;
+}
+
+/* Quadrant occupancy masks of a 2D node: quadrant index is {y_bit, x_bit} */
+#define FSYNC_Q_X_L (0x5)
+#define FSYNC_Q_X_H (0xA)
+#define FSYNC_Q_Y_L (0x3)
+#define FSYNC_Q_Y_H (0xC)
+
+static inline bool fsync_h_split(const unsigned char occupancy){
+  return (occupancy & FSYNC_Q_X_L) && (occupancy & FSYNC_Q_X_H);
+}
+
+static inline bool fsync_v_split(const unsigned char occupancy){
+  return (occupancy & FSYNC_Q_Y_L) && (occupancy & FSYNC_Q_Y_H);
+}
+
+bool fsync_gen_reqs_fast(const fsync_topology_t *topo, fsync_cu_t *cus, const unsigned int num_cus, const fsync_dir default_dir){
+  fsync_init_reqs(cus, num_cus);
+  
+  if (num_cus < 2) return false;
+
+  if (num_cus == 2) return fsync_gen_pair_reqs(topo, cus, default_dir);
+
+  /* Quadrant occupancy of every 2D node, stored level by level starting from the leaves (bit 0) */
+  unsigned char occupancy[__FSYNC_MAX_N_2D_NODES__];
+  for (unsigned int i = 0; i < topo->n_2d_nodes; i++) occupancy[i] = 0;
+
+  for (unsigned int i = 0; i < num_cus; i++){
+    unsigned int x = cus[i].x_pos;
+    unsigned int y = cus[i].y_pos;
+    if (x >= topo->n_cu_x || y >= topo->n_cu_y) return false;
+    for (unsigned int b = 0; b < topo->n_2d_lvl; b++){
+      unsigned int node = ((y >> (b+1)) << (topo->x_shift-(b+1))) + (x >> (b+1));
+      occupancy[topo->occ_offset[b] + node] |= 1 << ((((y >> b) & 1) << 1) | ((x >> b) & 1));
+    }
+  }
+
+  bool generated_reqs = false;
+  for (unsigned int i = 0; i < num_cus; i++){
+    unsigned int x    = cus[i].x_pos;
+    unsigned int y    = cus[i].y_pos;
+    unsigned int aggr = 0;
+    unsigned int id   = 0;
+    fsync_node   node = null_fs_node;
+    fsync_dir    dir  = default_dir;
+    for (unsigned int b = topo->n_2d_lvl; b-- > 0;){
+      unsigned char occ = occupancy[topo->occ_offset[b] + ((y >> (b+1)) << (topo->x_shift-(b+1))) + (x >> (b+1))];
+      bool h_active = fsync_h_split(occ);
+      bool v_active = fsync_v_split(occ);
+      bool active   = h_active && v_active;
+      aggr = (aggr << 1) | active;
+      if (active && node == null_fs_node){
+        node = hv_fs_node;
+        id   = (dir == h_fs_dir) ? 0 : 1;
+      }
+      if (h_active != v_active) dir = h_active ? h_fs_dir : v_fs_dir;
+
+      /* 1D node below: horizontal nodes split the CUs of one row half, vertical nodes the ones of one column half */
+      if (dir == h_fs_dir) active = fsync_h_split(occ & (((y >> b) & 1) ? FSYNC_Q_Y_H : FSYNC_Q_Y_L));
+      else                 active = fsync_v_split(occ & (((x >> b) & 1) ? FSYNC_Q_X_H : FSYNC_Q_X_L));
+      aggr = (aggr << 1) | active;
+      if (active && node == null_fs_node){
+        node = (dir == h_fs_dir) ? h_fs_node : v_fs_node;
+        id   = (dir == h_fs_dir) ? 0 : 1;
+      }
+    }
+    cus[i].fsync_req.fs_req_aggr = aggr;
+    cus[i].fsync_req.fs_req_id   = id;
+    cus[i].fsync_req.req_node    = node;
+    generated_reqs |= (node != null_fs_node);
+  }
 
   return generated_reqs;
 }
@@ -25,11 +25,16 @@
 #include <stdlib.h>
 #include <stdbool.h>
 
-#define __FSYNC_N_CU_X__     (4)
-#define __FSYNC_N_CU_Y__     (4)
-#define __FSYNC_N_CU__       (__FSYNC_N_CU_X__*__FSYNC_N_CU_Y__)
-#define __FSYNC_N_LVL__      (4)
-#define __FSYNC_DEFAULT_TH__ (__FSYNC_N_CU_X__/2)
+/* Largest supported tree: bounds the per-level arrays of the topology descriptor */
+#ifndef __FSYNC_MAX_N_LVL__
+#define __FSYNC_MAX_N_LVL__      (10)
+#endif
+#define __FSYNC_MAX_N_CU_X__     (1 << (__FSYNC_MAX_N_LVL__/2))
+#define __FSYNC_MAX_N_CU_Y__     (1 << (__FSYNC_MAX_N_LVL__/2))
+#define __FSYNC_MAX_N_CU__       (__FSYNC_MAX_N_CU_X__*__FSYNC_MAX_N_CU_Y__)
+#define __FSYNC_MAX_N_2D_LVL__   (__FSYNC_MAX_N_LVL__/2)
+/* Number of 2D nodes in the tree: (N_CU-1)/3 for square power-of-two meshes */
+#define __FSYNC_MAX_N_2D_NODES__ ((__FSYNC_MAX_N_CU__-1)/3)
 
 #define abs_diff(x, y) (((x) > (y)) ? ((x) - (y)) : ((y) - (x)))
 
@@ -42,6 +47,24 @@ typedef struct fsync_req{
   fsync_node   req_node;
 } fsync_req_t;
 
+typedef struct fsync_topology{
+  unsigned int n_cu_x;                                 /* Number of CUs in a row of the mesh */
+  unsigned int n_cu_y;                                 /* Number of CUs in a column of the mesh */
+  unsigned int n_cu;                                   /* Number of CUs in the mesh */
+  unsigned int n_lvl;                                  /* Number of tree levels (N_LEVELS) */
+  unsigned int n_2d_lvl;                               /* Number of 2D levels */
+  unsigned int root_th;                                /* Partitioning threshold of the root node */
+  unsigned int x_shift;                                /* log2(n_cu_x) */
+  unsigned int aggr_width;                             /* Width of the CU aggr field (IN_AGGR_WIDTH) */
+  unsigned int id_width;                               /* Width of the CU id field (ID_WIDTH) */
+  unsigned int lvl_width;                              /* Width of the response lvl field (LVL_WIDTH) */
+  unsigned int n_local_regs[__FSYNC_MAX_N_LVL__];      /* Local RF size per level: index 0 refers to level 1, index 1 refers to level 2, ... */
+  unsigned int n_dir_regs[__FSYNC_MAX_N_LVL__];        /* Local registers available to each direction per level (2D nodes split them between h and v) */
+  unsigned int n_links[__FSYNC_MAX_N_LVL__];           /* Number of input links per level: index 0 refers to level 1 (N_LINKS_IN), index 1 refers to level 2, ... */
+  unsigned int occ_offset[__FSYNC_MAX_N_2D_LVL__];     /* Offset of each 2D level in the occupancy table of fsync_gen_reqs_fast (leaves first) */
+  unsigned int n_2d_nodes;                             /* Number of 2D nodes of the tree */
+} fsync_topology_t;
+
 typedef struct fsync_cu{
   unsigned int cu_id;
   unsigned int y_pos;
@@ -49,6 +72,17 @@ typedef struct fsync_cu{
   fsync_req_t  fsync_req;
 } fsync_cu_t;
 
+/**
+ * @brief initialize a topology descriptor for a square power-of-two mesh of CUs
+ * @param topo topology descriptor
+ * @param n_cu_x number of CUs in a row of the mesh
+ * @param n_cu_y number of CUs in a column of the mesh
+ * @param n_local_regs local RF size per level (index 0 refers to level 1), NULL for the sizes of the trees in hw/trees
+ * @param n_links number of input links per level (index 0 refers to level 1), NULL for the link counts of the trees in hw/trees
+ * @return true if the descriptor has been initialized properly, false otherwise (e.g. unsupported mesh)
+ */
+bool fsync_topology_init(fsync_topology_t *topo, const unsigned int n_cu_x, const unsigned int n_cu_y, const unsigned int *n_local_regs, const unsigned int *n_links);
+
 /**
  * @brief initialize array of CUs with default FractalSync request values
  * @param cus array of CUs
@@ -59,11 +93,41 @@ void fsync_init_reqs(fsync_cu_t *cus, const unsigned int num_cus);
 
 /**
  * @brief set the FractalSync request fields (id, aggregate) of the CUs so that they all synchronize at the same barrier
+ * @param topo topology descriptor
  * @param cus array of CUs
  * @param num_cus size of the array of CUs
  * @param default_dir default barrier direction when the barrier can be reached both horizontaly and vertically (i.e. synchronization at 2D node)
  * @return true if synchronization requests have been generated properly, false otherwise (e.g. degenerate array of CUs)
  */
-bool fsync_gen_reqs(fsync_cu_t *cus, const unsigned int num_cus, const fsync_dir default_dir);
+bool fsync_gen_reqs(const fsync_topology_t *topo, fsync_cu_t *cus, const unsigned int num_cus, const fsync_dir default_dir);
+
+/**
+ * @brief size of the workspace required by fsync_gen_reqs_workspace
+ * @param num_cus size of the array of CUs
+ * @return workspace size in bytes (0 if no workspace is required)
+ */
+size_t fsync_gen_reqs_workspace_size(const unsigned int num_cus);
+
+/**
+ * @brief same as fsync_gen_reqs, but uses a caller-owned workspace and performs no heap allocations
+ * @param topo topology descriptor
+ * @param cus array of CUs
+ * @param num_cus size of the array of CUs
+ * @param default_dir default barrier direction when the barrier can be reached both horizontaly and vertically (i.e. synchronization at 2D node)
+ * @param workspace scratch memory of at least fsync_gen_reqs_workspace_size(num_cus) bytes, aligned for pointer access (may be NULL if the required size is 0)
+ * @param workspace_size size of the workspace in bytes
+ * @return true if synchronization requests have been generated properly, false otherwise (e.g. degenerate array of CUs, insufficient workspace)
+ */
+bool fsync_gen_reqs_workspace(const fsync_topology_t *topo, fsync_cu_t *cus, const unsigned int num_cus, const fsync_dir default_dir, void *workspace, const size_t workspace_size);
+
+/**
+ * @brief same as fsync_gen_reqs, but computed in closed form from the CU coordinate bits (non-recursive, no heap allocations)
+ * @param topo topology descriptor
+ * @param cus array of CUs
+ * @param num_cus size of the array of CUs
+ * @param default_dir default barrier direction when the barrier can be reached both horizontaly and vertically (i.e. synchronization at 2D node)
+ * @return true if synchronization requests have been generated properly, false otherwise (e.g. degenerate array of CUs, CU outside of the mesh)
+ */
+bool fsync_gen_reqs_fast(const fsync_topology_t *topo, fsync_cu_t *cus, const unsigned int num_cus, const fsync_dir default_dir);
 
 #endif /*FSYNC_REQ_GEN_H*/
\ No newline at end of file
@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization request (id, aggregate) generator: header-only constexpr C++20 port of fsync_gen_reqs
+ *
+ * A static barrier compiles down to constants:
+ *   constexpr auto row_0 = fsync::barrier_v<fsync::mesh_t<4, 4>, fsync::dir_e::h, fsync::cu_t{0, 0}, fsync::cu_t{0, 1}>;
+ */
+
+#ifndef FSYNC_REQ_GEN_HPP
+#define FSYNC_REQ_GEN_HPP
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+namespace fsync {
+
+enum class dir_e  : unsigned int {h = 0, v = 1};
+enum class node_e : unsigned int {null = 0, h = 1, v = 2, hv = 3};
+
+struct cu_t{
+  unsigned int y_pos;
+  unsigned int x_pos;
+};
+
+/* Same layout as fsync_req_t */
+struct req_t{
+  unsigned int fs_req_aggr;
+  unsigned int fs_req_id;
+  node_e       req_node;
+
+  constexpr bool operator==(const req_t &) const = default;
+};
+
+template <unsigned int N_CU_X, unsigned int N_CU_Y>
+struct mesh_t{
+  static_assert(N_CU_X >= 2 && N_CU_X == N_CU_Y && (N_CU_X & (N_CU_X-1)) == 0, "FractalSync meshes are square powers of two");
+
+  static constexpr unsigned int n_cu_x     = N_CU_X;
+  static constexpr unsigned int n_cu_y     = N_CU_Y;
+  static constexpr unsigned int n_cu       = N_CU_X*N_CU_Y;
+  static constexpr unsigned int n_2d_nodes = (n_cu-1)/3;
+};
+
+namespace detail {
+
+inline constexpr unsigned int q_x_l = 0x5;
+inline constexpr unsigned int q_x_h = 0xA;
+inline constexpr unsigned int q_y_l = 0x3;
+inline constexpr unsigned int q_y_h = 0xC;
+
+constexpr unsigned int log2(unsigned int value){
+  unsigned int log = 0;
+  while (value >>= 1) log++;
+  return log;
+}
+
+constexpr unsigned int abs_diff(const unsigned int x, const unsigned int y){
+  return (x > y) ? (x - y) : (y - x);
+}
+
+constexpr bool h_split(const unsigned int occupancy){
+  return (occupancy & q_x_l) && (occupancy & q_x_h);
+}
+
+constexpr bool v_split(const unsigned int occupancy){
+  return (occupancy & q_y_l) && (occupancy & q_y_h);
+}
+
+constexpr bool nbr_node(const unsigned int pos1, const unsigned int pos2){
+  return (pos1 < pos2) ? pos1 & 1 : pos2 & 1;
+}
+
+constexpr bool same_subtree(const unsigned int pos1, const unsigned int pos2, const unsigned int threshold){
+  return (pos1 < threshold && pos2 < threshold) || (pos1 >= threshold && pos2 >= threshold);
+}
+
+constexpr unsigned int update_pos(unsigned int &pos, const unsigned int threshold){
+  pos = (pos < threshold) ? pos : pos - threshold;
+  return threshold/2;
+}
+
+constexpr bool gen_pair_reqs(const unsigned int n_cu_x, std::span<const cu_t> cus, std::span<req_t> reqs, const dir_e default_dir){
+  const unsigned int x_dist = abs_diff(cus[0].x_pos, cus[1].x_pos);
+  const unsigned int y_dist = abs_diff(cus[0].y_pos, cus[1].y_pos);
+  const unsigned int dist   = x_dist + y_dist;
+  dir_e              dir    = default_dir;
+  node_e             node   = node_e::hv;
+
+  if (dist == 0) return false;
+
+  if      (x_dist > y_dist){ dir = dir_e::h; node = node_e::h; }
+  else if (x_dist < y_dist){ dir = dir_e::v; node = node_e::v; }
+  reqs[0].req_node = node; reqs[1].req_node = node;
+
+  if (dist == 1){
+    const bool         nbr = (dir == dir_e::h) ? nbr_node(cus[0].x_pos, cus[1].x_pos) : nbr_node(cus[0].y_pos, cus[1].y_pos);
+    const unsigned int id  = (nbr ? 2 : 0) + ((dir == dir_e::h) ? 0 : 1);
+    reqs[0].fs_req_aggr = 0b1; reqs[1].fs_req_aggr = 0b1;
+    reqs[0].fs_req_id   = id;  reqs[1].fs_req_id   = id;
+    return true;
+  }
+
+  unsigned int hops = 2*log2(n_cu_x);
+  unsigned int x_th = n_cu_x/2;
+  unsigned int y_th = n_cu_x/2;
+  unsigned int x_p0 = cus[0].x_pos;
+  unsigned int x_p1 = cus[1].x_pos;
+  unsigned int y_p0 = cus[0].y_pos;
+  unsigned int y_p1 = cus[1].y_pos;
+  bool done = false;
+  while (!done){
+    if (same_subtree(x_p0, x_p1, x_th) && x_th > 0){
+      update_pos(x_p0, x_th);
+      x_th = update_pos(x_p1, x_th);
+      --hops;
+    } else done = true;
+    if (same_subtree(y_p0, y_p1, y_th) && y_th > 0){
+      update_pos(y_p0, y_th);
+      y_th = update_pos(y_p1, y_th);
+      --hops;
+    } else done = true;
+  }
+
+  if (hops <= 1) return false;
+
+  node = (dir == dir_e::h) ? node_e::h : node_e::v;
+  for (unsigned int i = 0; i < 2; i++){
+    reqs[i].fs_req_aggr = 0b1u << (hops-1);
+    reqs[i].fs_req_id   = (dir == dir_e::h) ? 0 : 1;
+    reqs[i].req_node    = node;
+  }
+  return true;
+}
+
+/* Closed-form generator (see fsync_gen_reqs_fast): N_2D_NODES bounds the quadrant occupancy table */
+template <unsigned int N_2D_NODES>
+constexpr bool gen_reqs(const unsigned int n_cu_x, const unsigned int n_cu_y, std::span<const cu_t> cus, std::span<req_t> reqs, const dir_e default_dir){
+  for (auto &req : reqs) req = req_t{0, 0, node_e::null};
+
+  if (cus.size() < 2) return false;
+
+  if (cus.size() == 2) return gen_pair_reqs(n_cu_x, cus, reqs, default_dir);
+
+  const unsigned int x_shift  = log2(n_cu_x);
+  const unsigned int n_2d_lvl = x_shift;
+
+  std::array<unsigned int, 32> occ_offset{};
+  for (unsigned int b = 0, offset = 0; b < n_2d_lvl; b++){
+    occ_offset[b] = offset;
+    offset       += 1u << (2*(x_shift-(b+1)));
+  }
+
+  std::array<unsigned char, N_2D_NODES> occupancy{};
+  for (const auto &cu : cus){
+    if (cu.x_pos >= n_cu_x || cu.y_pos >= n_cu_y) return false;
+    for (unsigned int b = 0; b < n_2d_lvl; b++)
+      occupancy[occ_offset[b] + ((cu.y_pos >> (b+1)) << (x_shift-(b+1))) + (cu.x_pos >> (b+1))] |= 1 << ((((cu.y_pos >> b) & 1) << 1) | ((cu.x_pos >> b) & 1));
+  }
+
+  bool generated_reqs = false;
+  for (std::size_t i = 0; i < cus.size(); i++){
+    const unsigned int x    = cus[i].x_pos;
+    const unsigned int y    = cus[i].y_pos;
+    unsigned int       aggr = 0;
+    unsigned int       id   = 0;
+    node_e             node = node_e::null;
+    dir_e              dir  = default_dir;
+    for (unsigned int b = n_2d_lvl; b-- > 0;){
+      const unsigned int occ = occupancy[occ_offset[b] + ((y >> (b+1)) << (x_shift-(b+1))) + (x >> (b+1))];
+      const bool h_active = h_split(occ);
+      const bool v_active = v_split(occ);
+      bool       active   = h_active && v_active;
+      aggr = (aggr << 1) | (active ? 1 : 0);
+      if (active && node == node_e::null){
+        node = node_e::hv;
+        id   = static_cast<unsigned int>(dir);
+      }
+      if (h_active != v_active) dir = h_active ? dir_e::h : dir_e::v;
+
+      if (dir == dir_e::h) active = h_split(occ & (((y >> b) & 1) ? q_y_h : q_y_l));
+      else                 active = v_split(occ & (((x >> b) & 1) ? q_x_h : q_x_l));
+      aggr = (aggr << 1) | (active ? 1 : 0);
+      if (active && node == node_e::null){
+        node = (dir == dir_e::h) ? node_e::h : node_e::v;
+        id   = static_cast<unsigned int>(dir);
+      }
+    }
+    reqs[i]         = req_t{aggr, id, node};
+    generated_reqs |= (node != node_e::null);
+  }
+
+  return generated_reqs;
+}
+
+} // namespace detail
+
+/* Largest mesh handled by the run-time sized interface */
+inline constexpr unsigned int max_n_cu_x = 32;
+
+/**
+ * @brief set the FractalSync requests of the CUs so that they all synchronize at the same barrier (same semantics as fsync_gen_reqs)
+ * @param n_cu_x number of CUs in a row of the mesh (square power of two, up to max_n_cu_x)
+ * @param n_cu_y number of CUs in a column of the mesh
+ * @param cus CU positions
+ * @param reqs generated requests (same size as cus)
+ * @param default_dir default barrier direction when the barrier can be reached both horizontaly and vertically (i.e. synchronization at 2D node)
+ * @return true if synchronization requests have been generated properly, false otherwise (e.g. degenerate array of CUs)
+ */
+constexpr bool gen_reqs(const unsigned int n_cu_x, const unsigned int n_cu_y, std::span<const cu_t> cus, std::span<req_t> reqs, const dir_e default_dir = dir_e::h){
+  if (n_cu_x < 2 || n_cu_x != n_cu_y || (n_cu_x & (n_cu_x-1)) || n_cu_x > max_n_cu_x || reqs.size() != cus.size()) return false;
+  return detail::gen_reqs<(max_n_cu_x*max_n_cu_x-1)/3>(n_cu_x, n_cu_y, cus, reqs, default_dir);
+}
+
+/**
+ * @brief compile-time friendly generator over a fixed mesh
+ * @param cus CU positions
+ * @param default_dir default barrier direction when the barrier can be reached both horizontaly and vertically (i.e. synchronization at 2D node)
+ * @return generated requests (all null if the requests could not be generated)
+ */
+template <typename MESH, std::size_t N>
+constexpr std::array<req_t, N> gen_reqs(const std::array<cu_t, N> &cus, const dir_e default_dir = dir_e::h){
+  std::array<req_t, N> reqs{};
+  detail::gen_reqs<MESH::n_2d_nodes>(MESH::n_cu_x, MESH::n_cu_y, cus, reqs, default_dir);
+  return reqs;
+}
+
+/**
+ * @brief same as gen_reqs over a fixed mesh, also returning whether the requests have been generated properly
+ */
+template <typename MESH, std::size_t N>
+constexpr bool gen_reqs(const std::array<cu_t, N> &cus, std::array<req_t, N> &reqs, const dir_e default_dir = dir_e::h){
+  return detail::gen_reqs<MESH::n_2d_nodes>(MESH::n_cu_x, MESH::n_cu_y, cus, reqs, default_dir);
+}
+
+/* Requests of a static barrier: CUs are given as template arguments */
+template <typename MESH, dir_e DIR, cu_t... CUS>
+inline constexpr std::array<req_t, sizeof...(CUS)> barrier_v = gen_reqs<MESH>(std::array<cu_t, sizeof...(CUS)>{CUS...}, DIR);
+
+} // namespace fsync
+
+#endif /*FSYNC_REQ_GEN_HPP*/
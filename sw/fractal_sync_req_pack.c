@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization packed request encoding
+ */
+
+#include "fractal_sync_req_pack.h"
+
+bool fsync_pack_req(const fsync_topology_t *topo, const fsync_req_t *req, const bool nbr, fsync_req_word_t *word){
+  *word = 0;
+  if (req->req_node == null_fs_node) return true;
+
+  const unsigned int aggr_width = nbr ? __FSYNC_NBR_AGGR_WIDTH__ : topo->aggr_width;
+  const unsigned int id_width   = nbr ? __FSYNC_NBR_ID_WIDTH__   : topo->id_width;
+  if ((req->fs_req_aggr >> aggr_width) || (req->fs_req_id >> id_width) || !req->fs_req_aggr) return false;
+
+  /* Tree requests enter the 1D network of their direction (id[0]), neighbor requests carry their direction in id[0] as well */
+  fsync_port port = nbr ? ((req->fs_req_id & 1) ? v_nbr_fs_port : h_nbr_fs_port) :
+                          ((req->fs_req_id & 1) ? v_fs_port     : h_fs_port);
+
+  *word = ((fsync_req_word_t)port << __FSYNC_REQ_PORT_SHIFT__)   |
+          (1u << (aggr_width+id_width))                          |
+          ((fsync_req_word_t)req->fs_req_aggr << id_width)       |
+          (fsync_req_word_t)req->fs_req_id;
+  return true;
+}
+
+bool fsync_pack_reqs(const fsync_topology_t *topo, const fsync_cu_t *cus, const unsigned int num_cus, fsync_req_word_t *words){
+  bool packed = true;
+  for (unsigned int i = 0; i < num_cus; i++)
+    packed &= fsync_pack_req(topo, &cus[i].fsync_req, cus[i].fsync_req.fs_req_id >= 2, &words[i]);
+  return packed;
+}
+
+bool fsync_pack_team_reqs(const fsync_topology_t *topo, const fsync_team_t *team, fsync_req_word_t *words){
+  bool packed = team->valid;
+  for (unsigned int i = 0; i < team->num_cus; i++)
+    packed &= fsync_pack_req(topo, &team->cus[i].fsync_req, team->nbr, &words[i]);
+  return packed;
+}
+
+bool fsync_gen_reqs_packed(const fsync_topology_t *topo, fsync_cu_t *cus, const unsigned int num_cus, const fsync_dir default_dir, fsync_req_word_t *words){
+  bool generated_reqs = fsync_gen_reqs_fast(topo, cus, num_cus, default_dir);
+  return fsync_pack_reqs(topo, cus, num_cus, words) && generated_reqs;
+}
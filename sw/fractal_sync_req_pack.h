@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization packed request encoding header
+ * A packed request word holds the CU request struct of the target interface (FSYNC_TYPEDEF_REQ_T: {sync, aggr, id},
+ * aggr in the MSBs, id in the LSBs) with the target interface in the topmost bits, so issuing a barrier is a single store.
+ */
+
+#ifndef FSYNC_REQ_PACK_H
+#define FSYNC_REQ_PACK_H
+
+#include <stdint.h>
+#include "fractal_sync_req_gen.h"
+#include "fractal_sync_team_alloc.h"
+
+/* Width of the fields of the neighbor interface (NBR_AGGR_WIDTH, NBR_ID_WIDTH in hw/trees) */
+#define __FSYNC_NBR_AGGR_WIDTH__ (1)
+#define __FSYNC_NBR_ID_WIDTH__   (2)
+
+/* Position of the target interface in the packed request word */
+#define __FSYNC_REQ_PORT_SHIFT__ (30)
+
+#define FSYNC_REQ_WORD_PORT(word) ((fsync_port)((word) >> __FSYNC_REQ_PORT_SHIFT__))
+#define FSYNC_REQ_WORD_REQ(word)  ((word) & ((1u << __FSYNC_REQ_PORT_SHIFT__)-1))
+
+typedef enum {h_fs_port, v_fs_port, h_nbr_fs_port, v_nbr_fs_port} fsync_port;
+
+typedef uint32_t fsync_req_word_t;
+
+/**
+ * @brief pack a FractalSync request in the layout of the request struct of its target interface
+ * @param topo topology descriptor (provides the aggr and id widths of the tree interfaces)
+ * @param req request to pack
+ * @param nbr the request targets the neighbor interfaces
+ * @param word packed request (0 if the CU does not take part in the barrier)
+ * @return true if the request has been packed properly, false otherwise (e.g. aggr or id wider than the interface fields)
+ */
+bool fsync_pack_req(const fsync_topology_t *topo, const fsync_req_t *req, const bool nbr, fsync_req_word_t *word);
+
+/**
+ * @brief pack the requests of an array of CUs as produced by the generators (neighbor requests are the ones with id 2 or 3)
+ * @param topo topology descriptor
+ * @param cus array of CUs
+ * @param num_cus size of the array of CUs
+ * @param words packed requests (one per CU)
+ * @return true if all requests have been packed properly, false otherwise
+ */
+bool fsync_pack_reqs(const fsync_topology_t *topo, const fsync_cu_t *cus, const unsigned int num_cus, fsync_req_word_t *words);
+
+/**
+ * @brief pack the requests of a team allocated by fsync_alloc_teams
+ * @param topo topology descriptor
+ * @param team allocated team
+ * @param words packed requests (one per CU of the team)
+ * @return true if all requests have been packed properly, false otherwise
+ */
+bool fsync_pack_team_reqs(const fsync_topology_t *topo, const fsync_team_t *team, fsync_req_word_t *words);
+
+/**
+ * @brief same as fsync_gen_reqs_fast, also producing the packed request of each CU
+ * @param topo topology descriptor
+ * @param cus array of CUs
+ * @param num_cus size of the array of CUs
+ * @param default_dir default barrier direction when the barrier can be reached both horizontaly and vertically (i.e. synchronization at 2D node)
+ * @param words packed requests (one per CU)
+ * @return true if synchronization requests have been generated and packed properly, false otherwise
+ */
+bool fsync_gen_reqs_packed(const fsync_topology_t *topo, fsync_cu_t *cus, const unsigned int num_cus, const fsync_dir default_dir, fsync_req_word_t *words);
+
+#endif /*FSYNC_REQ_PACK_H*/
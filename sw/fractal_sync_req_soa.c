@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization request (id, aggregate) generator over structure-of-arrays CUs
+ */
+
+#include "fractal_sync_req_soa.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/* Quadrant occupancy masks of a 2D node: quadrant index is {y_bit, x_bit} */
+#define FSYNC_Q_X_L (0x5)
+#define FSYNC_Q_X_H (0xA)
+#define FSYNC_Q_Y_L (0x3)
+#define FSYNC_Q_Y_H (0xC)
+
+typedef struct fsync_soa_reduction{
+  unsigned int pos_or;  /* OR of all coordinates: bounds check */
+  unsigned int diff_or; /* OR of the coordinate differences with the first CU: highest active level */
+} fsync_soa_reduction_t;
+
+static inline unsigned int fsync_soa_msb(unsigned int value){
+  unsigned int msb = 0;
+  while (value >>= 1) msb++;
+  return msb;
+}
+
+static fsync_soa_reduction_t fsync_soa_reduce(const fsync_cus_soa_t *cus){
+  const unsigned int x0     = cus->x_pos[0];
+  const unsigned int y0     = cus->y_pos[0];
+  unsigned int       pos_or = 0;
+  unsigned int       dif_or = 0;
+  unsigned int       i      = 0;
+#if defined(__AVX2__)
+  __m256i v_x0  = _mm256_set1_epi32((int)x0);
+  __m256i v_y0  = _mm256_set1_epi32((int)y0);
+  __m256i v_pos = _mm256_setzero_si256();
+  __m256i v_dif = _mm256_setzero_si256();
+  for (; i + 8 <= cus->num_cus; i += 8){
+    __m256i x = _mm256_loadu_si256((const __m256i*)&cus->x_pos[i]);
+    __m256i y = _mm256_loadu_si256((const __m256i*)&cus->y_pos[i]);
+    v_pos = _mm256_or_si256(v_pos, _mm256_or_si256(x, y));
+    v_dif = _mm256_or_si256(v_dif, _mm256_or_si256(_mm256_xor_si256(x, v_x0), _mm256_xor_si256(y, v_y0)));
+  }
+  __m128i h_pos = _mm_or_si128(_mm256_castsi256_si128(v_pos), _mm256_extracti128_si256(v_pos, 1));
+  __m128i h_dif = _mm_or_si128(_mm256_castsi256_si128(v_dif), _mm256_extracti128_si256(v_dif, 1));
+#elif defined(__SSE2__)
+  __m128i v_x0  = _mm_set1_epi32((int)x0);
+  __m128i v_y0  = _mm_set1_epi32((int)y0);
+  __m128i h_pos = _mm_setzero_si128();
+  __m128i h_dif = _mm_setzero_si128();
+  for (; i + 4 <= cus->num_cus; i += 4){
+    __m128i x = _mm_loadu_si128((const __m128i*)&cus->x_pos[i]);
+    __m128i y = _mm_loadu_si128((const __m128i*)&cus->y_pos[i]);
+    h_pos = _mm_or_si128(h_pos, _mm_or_si128(x, y));
+    h_dif = _mm_or_si128(h_dif, _mm_or_si128(_mm_xor_si128(x, v_x0), _mm_xor_si128(y, v_y0)));
+  }
+#endif
+#if defined(__AVX2__) || defined(__SSE2__)
+  h_pos  = _mm_or_si128(h_pos, _mm_shuffle_epi32(h_pos, _MM_SHUFFLE(1, 0, 3, 2)));
+  h_pos  = _mm_or_si128(h_pos, _mm_shuffle_epi32(h_pos, _MM_SHUFFLE(2, 3, 0, 1)));
+  h_dif  = _mm_or_si128(h_dif, _mm_shuffle_epi32(h_dif, _MM_SHUFFLE(1, 0, 3, 2)));
+  h_dif  = _mm_or_si128(h_dif, _mm_shuffle_epi32(h_dif, _MM_SHUFFLE(2, 3, 0, 1)));
+  pos_or = (unsigned int)_mm_cvtsi128_si32(h_pos);
+  dif_or = (unsigned int)_mm_cvtsi128_si32(h_dif);
+#endif
+  for (; i < cus->num_cus; i++){
+    pos_or |= cus->x_pos[i] | cus->y_pos[i];
+    dif_or |= (cus->x_pos[i] ^ x0) | (cus->y_pos[i] ^ y0);
+  }
+  fsync_soa_reduction_t reduction = {.pos_or = pos_or, .diff_or = dif_or};
+  return reduction;
+}
+
+static inline bool fsync_soa_h_split(const unsigned int occupancy){
+  return (occupancy & FSYNC_Q_X_L) && (occupancy & FSYNC_Q_X_H);
+}
+
+static inline bool fsync_soa_v_split(const unsigned int occupancy){
+  return (occupancy & FSYNC_Q_Y_L) && (occupancy & FSYNC_Q_Y_H);
+}
+
+static void fsync_soa_walk_cu(const fsync_topology_t *topo, const unsigned char *occupancy, const unsigned int top_lvl, fsync_cus_soa_t *cus, const unsigned int i, const fsync_dir default_dir){
+  unsigned int x    = cus->x_pos[i];
+  unsigned int y    = cus->y_pos[i];
+  unsigned int aggr = 0;
+  unsigned int id   = 0;
+  fsync_node   node = null_fs_node;
+  fsync_dir    dir  = default_dir;
+  for (unsigned int b = top_lvl+1; b-- > 0;){
+    unsigned int occ = occupancy[topo->occ_offset[b] + ((y >> (b+1)) << (topo->x_shift-(b+1))) + (x >> (b+1))];
+    bool h_active = fsync_soa_h_split(occ);
+    bool v_active = fsync_soa_v_split(occ);
+    bool active   = h_active && v_active;
+    aggr = (aggr << 1) | active;
+    if (active && node == null_fs_node){
+      node = hv_fs_node;
+      id   = (dir == h_fs_dir) ? 0 : 1;
+    }
+    if (h_active != v_active) dir = h_active ? h_fs_dir : v_fs_dir;
+
+    if (dir == h_fs_dir) active = fsync_soa_h_split(occ & (((y >> b) & 1) ? FSYNC_Q_Y_H : FSYNC_Q_Y_L));
+    else                 active = fsync_soa_v_split(occ & (((x >> b) & 1) ? FSYNC_Q_X_H : FSYNC_Q_X_L));
+    aggr = (aggr << 1) | active;
+    if (active && node == null_fs_node){
+      node = (dir == h_fs_dir) ? h_fs_node : v_fs_node;
+      id   = (dir == h_fs_dir) ? 0 : 1;
+    }
+  }
+  cus->fs_req_aggr[i] = aggr;
+  cus->fs_req_id[i]   = id;
+  cus->req_node[i]    = node;
+}
+
+#if defined(__AVX2__)
+_Static_assert(sizeof(fsync_node) == sizeof(int), "AVX2 path stores fsync_node as 32-bit lanes");
+
+static inline __m256i fsync_soa_nz(const __m256i value){
+  return _mm256_xor_si256(_mm256_cmpeq_epi32(value, _mm256_setzero_si256()), _mm256_set1_epi32(-1));
+}
+
+static inline __m256i fsync_soa_split(const __m256i occ, const __m256i l_mask, const __m256i h_mask){
+  return _mm256_and_si256(fsync_soa_nz(_mm256_and_si256(occ, l_mask)), fsync_soa_nz(_mm256_and_si256(occ, h_mask)));
+}
+
+/* Walk 8 CUs at once: the occupancy table is read with 32-bit gathers at byte offsets (table padded by 3 bytes) */
+static __m256i fsync_soa_walk_cus(const fsync_topology_t *topo, const unsigned char *occupancy, const unsigned int top_lvl, fsync_cus_soa_t *cus, const unsigned int i, const fsync_dir default_dir){
+  const __m256i ones  = _mm256_set1_epi32(1);
+  const __m256i x_l   = _mm256_set1_epi32(FSYNC_Q_X_L);
+  const __m256i x_h   = _mm256_set1_epi32(FSYNC_Q_X_H);
+  const __m256i y_l   = _mm256_set1_epi32(FSYNC_Q_Y_L);
+  const __m256i y_h   = _mm256_set1_epi32(FSYNC_Q_Y_H);
+  const __m256i x     = _mm256_loadu_si256((const __m256i*)&cus->x_pos[i]);
+  const __m256i y     = _mm256_loadu_si256((const __m256i*)&cus->y_pos[i]);
+  __m256i       aggr  = _mm256_setzero_si256();
+  __m256i       id    = _mm256_setzero_si256();
+  __m256i       node  = _mm256_setzero_si256();
+  __m256i       found = _mm256_setzero_si256();
+  __m256i       dir   = _mm256_set1_epi32(default_dir == h_fs_dir ? 0 : 1);
+  for (unsigned int b = top_lvl+1; b-- > 0;){
+    __m128i sh_b   = _mm_cvtsi32_si128((int)b);
+    __m128i sh_b1  = _mm_cvtsi32_si128((int)(b+1));
+    __m128i sh_row = _mm_cvtsi32_si128((int)(topo->x_shift-(b+1)));
+    __m256i index  = _mm256_add_epi32(_mm256_sll_epi32(_mm256_srl_epi32(y, sh_b1), sh_row), _mm256_srl_epi32(x, sh_b1));
+    index          = _mm256_add_epi32(index, _mm256_set1_epi32((int)topo->occ_offset[b]));
+    __m256i occ    = _mm256_and_si256(_mm256_i32gather_epi32((const int*)occupancy, index, 1), _mm256_set1_epi32(0xF));
+
+    /* 2D node */
+    __m256i h_active = fsync_soa_split(occ, x_l, x_h);
+    __m256i v_active = fsync_soa_split(occ, y_l, y_h);
+    __m256i active   = _mm256_and_si256(h_active, v_active);
+    __m256i first    = _mm256_andnot_si256(found, active);
+    aggr  = _mm256_or_si256(_mm256_slli_epi32(aggr, 1), _mm256_srli_epi32(active, 31));
+    node  = _mm256_blendv_epi8(node, _mm256_set1_epi32(hv_fs_node), first);
+    id    = _mm256_blendv_epi8(id, dir, first);
+    found = _mm256_or_si256(found, active);
+    dir   = _mm256_blendv_epi8(dir, _mm256_andnot_si256(h_active, ones), _mm256_xor_si256(h_active, v_active));
+
+    /* 1D node */
+    __m256i y_bit  = _mm256_and_si256(_mm256_srl_epi32(y, sh_b), ones);
+    __m256i x_bit  = _mm256_and_si256(_mm256_srl_epi32(x, sh_b), ones);
+    __m256i h_occ  = _mm256_and_si256(occ, _mm256_sllv_epi32(y_l, _mm256_slli_epi32(y_bit, 1)));
+    __m256i v_occ  = _mm256_and_si256(occ, _mm256_sllv_epi32(x_l, x_bit));
+    __m256i v_dir  = _mm256_cmpeq_epi32(dir, ones);
+    active = _mm256_blendv_epi8(fsync_soa_split(h_occ, x_l, x_h), fsync_soa_split(v_occ, y_l, y_h), v_dir);
+    first  = _mm256_andnot_si256(found, active);
+    aggr   = _mm256_or_si256(_mm256_slli_epi32(aggr, 1), _mm256_srli_epi32(active, 31));
+    node   = _mm256_blendv_epi8(node, _mm256_add_epi32(dir, _mm256_set1_epi32(h_fs_node)), first);
+    id     = _mm256_blendv_epi8(id, dir, first);
+    found  = _mm256_or_si256(found, active);
+  }
+  _mm256_storeu_si256((__m256i*)&cus->fs_req_aggr[i], aggr);
+  _mm256_storeu_si256((__m256i*)&cus->fs_req_id[i],   id);
+  _mm256_storeu_si256((__m256i*)&cus->req_node[i],    node);
+  return found;
+}
+#endif
+
+static void fsync_soa_init_reqs(fsync_cus_soa_t *cus){
+  for (unsigned int i = 0; i < cus->num_cus; i++){
+    cus->fs_req_aggr[i] = 0;
+    cus->fs_req_id[i]   = 0;
+    cus->req_node[i]    = null_fs_node;
+  }
+}
+
+bool fsync_gen_reqs_soa(const fsync_topology_t *topo, fsync_cus_soa_t *cus, const fsync_dir default_dir){
+  if (cus->num_cus < 2){
+    fsync_soa_init_reqs(cus);
+    return false;
+  }
+
+  if (cus->num_cus == 2){
+    fsync_cu_t pair[2];
+    for (unsigned int i = 0; i < 2; i++){
+      pair[i].cu_id = i;
+      pair[i].y_pos = cus->y_pos[i];
+      pair[i].x_pos = cus->x_pos[i];
+    }
+    bool generated_reqs = fsync_gen_reqs_fast(topo, pair, 2, default_dir);
+    for (unsigned int i = 0; i < 2; i++){
+      cus->fs_req_aggr[i] = pair[i].fsync_req.fs_req_aggr;
+      cus->fs_req_id[i]   = pair[i].fsync_req.fs_req_id;
+      cus->req_node[i]    = pair[i].fsync_req.req_node;
+    }
+    return generated_reqs;
+  }
+
+  /* Coordinates are powers of two: all CUs are in the mesh iff the OR of the coordinates is */
+  fsync_soa_reduction_t reduction = fsync_soa_reduce(cus);
+  if (reduction.pos_or >= topo->n_cu_x){
+    fsync_soa_init_reqs(cus);
+    return false;
+  }
+  /* All nodes above the highest differing coordinate bit are inactive */
+  if (reduction.diff_or == 0){
+    fsync_soa_init_reqs(cus);
+    return false;
+  }
+  unsigned int top_lvl = fsync_soa_msb(reduction.diff_or);
+
+  unsigned char occupancy[__FSYNC_MAX_N_2D_NODES__ + 3];
+  unsigned int  n_nodes = (top_lvl+1 < topo->n_2d_lvl) ? topo->occ_offset[top_lvl+1] : topo->n_2d_nodes;
+  for (unsigned int i = 0; i < n_nodes + 3; i++) occupancy[i] = 0;
+  for (unsigned int i = 0; i < cus->num_cus; i++){
+    unsigned int x = cus->x_pos[i];
+    unsigned int y = cus->y_pos[i];
+    for (unsigned int b = 0; b <= top_lvl; b++)
+      occupancy[topo->occ_offset[b] + ((y >> (b+1)) << (topo->x_shift-(b+1))) + (x >> (b+1))] |= 1 << ((((y >> b) & 1) << 1) | ((x >> b) & 1));
+  }
+
+  unsigned int i = 0;
+#if defined(__AVX2__)
+  __m256i found = _mm256_setzero_si256();
+  for (; i + 8 <= cus->num_cus; i += 8)
+    found = _mm256_or_si256(found, fsync_soa_walk_cus(topo, occupancy, top_lvl, cus, i, default_dir));
+  bool generated_reqs = !_mm256_testz_si256(found, found);
+#else
+  bool generated_reqs = false;
+#endif
+  for (; i < cus->num_cus; i++){
+    fsync_soa_walk_cu(topo, occupancy, top_lvl, cus, i, default_dir);
+    generated_reqs |= (cus->req_node[i] != null_fs_node);
+  }
+
+  return generated_reqs;
+}
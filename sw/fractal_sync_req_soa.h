@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization request (id, aggregate) generator over structure-of-arrays CUs header
+ * SIMD paths are selected at compile time: AVX2 (-mavx2), SSE2 (x86-64 default) or portable scalar
+ */
+
+#ifndef FSYNC_REQ_SOA_H
+#define FSYNC_REQ_SOA_H
+
+#include "fractal_sync_req_gen.h"
+
+typedef struct fsync_cus_soa{
+  unsigned int  num_cus;
+  unsigned int *y_pos;
+  unsigned int *x_pos;
+  unsigned int *fs_req_aggr;
+  unsigned int *fs_req_id;
+  fsync_node   *req_node;
+} fsync_cus_soa_t;
+
+/**
+ * @brief same as fsync_gen_reqs_fast, over a structure-of-arrays CU layout
+ * @param topo topology descriptor
+ * @param cus CU coordinate arrays (input) and request arrays (output)
+ * @param default_dir default barrier direction when the barrier can be reached both horizontaly and vertically (i.e. synchronization at 2D node)
+ * @return true if synchronization requests have been generated properly, false otherwise (e.g. degenerate array of CUs, CU outside of the mesh)
+ */
+bool fsync_gen_reqs_soa(const fsync_topology_t *topo, fsync_cus_soa_t *cus, const fsync_dir default_dir);
+
+#endif /*FSYNC_REQ_SOA_H*/
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization multi-team barrier allocator
+ * Concurrent teams only compete for the local RF of their barrier node: requests of teams with different barrier nodes
+ * traverse disjoint subtrees or are told apart by level in the remote RFs, so only teams sharing a barrier node (and, for
+ * 2D nodes, a direction) need distinct registers.
+ */
+
+#include <stdint.h>
+#include "fractal_sync_team_alloc.h"
+
+static inline unsigned int fsync_team_lvl(unsigned int aggr){
+  unsigned int lvl = 0;
+  while (aggr){
+    aggr >>= 1;
+    lvl++;
+  }
+  return lvl;
+}
+
+/* Barrier node: 2D node at even levels, 1D node of the barrier direction at odd levels (the two-CU generator reports h/v nodes at both) */
+static void fsync_team_root(fsync_team_t *team){
+  unsigned int x   = team->cus[0].x_pos;
+  unsigned int y   = team->cus[0].y_pos;
+  unsigned int dir = team->cus[0].fsync_req.fs_req_id & 1;
+  team->lvl = fsync_team_lvl(team->cus[0].fsync_req.fs_req_aggr);
+  unsigned int b = (team->lvl-1)/2;
+  if      (!(team->lvl & 1)) team->node_idx = ((y >> (b+1)) << 16) | (x >> (b+1));
+  else if (dir == h_fs_dir)  team->node_idx = ((y >> b)     << 16) | (x >> (b+1));
+  else                       team->node_idx = ((y >> (b+1)) << 16) | (x >> b);
+}
+
+static inline bool fsync_team_same_reg_space(const fsync_team_t *team1, const fsync_team_t *team2, const unsigned int dir){
+  return team2->valid && !team2->nbr                      &&
+         (team1->lvl      == team2->lvl)                  &&
+         (team1->node_idx == team2->node_idx)             &&
+         ((team2->cus[0].fsync_req.fs_req_id & 1) == dir);
+}
+
+/* Number of teams before the current one that use the registers of the same barrier node and direction */
+static unsigned int fsync_team_users(const fsync_team_t *teams, const unsigned int team, const unsigned int dir){
+  unsigned int users = 0;
+  for (unsigned int t = 0; t < team; t++)
+    if (fsync_team_same_reg_space(&teams[team], &teams[t], dir)) users++;
+  return users;
+}
+
+static void fsync_team_set_id(fsync_team_t *team, const unsigned int dir){
+  for (unsigned int i = 0; i < team->num_cus; i++)
+    team->cus[i].fsync_req.fs_req_id = (team->reg << 1) | dir;
+}
+
+bool fsync_alloc_teams(const fsync_topology_t *topo, fsync_team_t *teams, const unsigned int num_teams, const fsync_dir default_dir, unsigned int *num_phases){
+  bool     allocated = true;
+  uint64_t members[__FSYNC_MAX_N_CU__/64 + 1] = {0};
+
+  *num_phases = 0;
+  for (unsigned int t = 0; t < num_teams; t++){
+    fsync_team_t *team = &teams[t];
+    team->nbr      = false;
+    team->lvl      = 0;
+    team->node_idx = 0;
+    team->reg      = 0;
+    team->phase    = 0;
+
+    /* Teams must be disjoint */
+    bool disjoint = true;
+    for (unsigned int i = 0; i < team->num_cus; i++){
+      unsigned int pos = (team->cus[i].y_pos << topo->x_shift) + team->cus[i].x_pos;
+      if (team->cus[i].x_pos >= topo->n_cu_x || team->cus[i].y_pos >= topo->n_cu_y) continue;
+      if ((members[pos >> 6] >> (pos & 63)) & 1) disjoint = false;
+      members[pos >> 6] |= 1ULL << (pos & 63);
+    }
+
+    team->valid = disjoint && fsync_gen_reqs_fast(topo, team->cus, team->num_cus, default_dir);
+    if (!team->valid){
+      fsync_init_reqs(team->cus, team->num_cus);
+      allocated = false;
+      continue;
+    }
+
+    fsync_team_root(team);
+    /* Dedicated neighbor link (ids 2/3 of the two-CU generator): no register to share */
+    team->nbr = (team->num_cus == 2) && (team->cus[0].fsync_req.fs_req_id >= 2);
+    if (team->nbr){
+      if (*num_phases == 0) *num_phases = 1;
+      continue;
+    }
+
+    unsigned int max_regs = 1 << (topo->id_width-1);
+    unsigned int n_regs   = (topo->n_dir_regs[team->lvl-1] < max_regs) ? topo->n_dir_regs[team->lvl-1] : max_regs;
+    unsigned int dir      = team->cus[0].fsync_req.fs_req_id & 1;
+    unsigned int users    = fsync_team_users(teams, t, dir);
+
+    /* A barrier at a 2D node can be reached in both directions: use the other half of the RF if it frees the team earlier */
+    if (!(team->lvl & 1)){
+      unsigned int alt_users = fsync_team_users(teams, t, dir ^ 1);
+      if (alt_users/n_regs < users/n_regs){
+        fsync_gen_reqs_fast(topo, team->cus, team->num_cus, (dir ^ 1) ? v_fs_dir : h_fs_dir);
+        /* Two-CU barriers may have a fixed direction */
+        if ((team->cus[0].fsync_req.fs_req_id & 1) != dir){
+          dir   = dir ^ 1;
+          users = alt_users;
+        }
+      }
+    }
+
+    team->reg   = users % n_regs;
+    team->phase = users / n_regs;
+    fsync_team_set_id(team, dir);
+    if (team->phase + 1 > *num_phases) *num_phases = team->phase + 1;
+  }
+
+  return allocated;
+}
+
+bool fsync_gen_nbr_reqs(const fsync_topology_t *topo, fsync_cu_t *cus, const unsigned int num_pairs, const fsync_dir default_dir, fsync_team_t *teams, unsigned int *num_phases){
+  for (unsigned int p = 0; p < num_pairs; p++){
+    teams[p].cus     = &cus[2*p];
+    teams[p].num_cus = 2;
+  }
+  /* The two-CU generator already picks the neighbor link or the lowest common level, teams share the barrier node registers */
+  return fsync_alloc_teams(topo, teams, num_pairs, default_dir, num_phases);
+}
+
+unsigned int fsync_torus_pairs(const fsync_topology_t *topo, const fsync_dir dir, const bool odd, fsync_cu_t *cus){
+  const unsigned int n_lines = (dir == h_fs_dir) ? topo->n_cu_y : topo->n_cu_x;
+  const unsigned int n_pos   = (dir == h_fs_dir) ? topo->n_cu_x : topo->n_cu_y;
+  unsigned int       n_cus   = 0;
+
+  for (unsigned int l = 0; l < n_lines; l++){
+    for (unsigned int p = 0; p < n_pos; p++){
+      /* Position along the exchange direction: rotated by one for the odd pairs so that the last pair wraps around */
+      unsigned int pos = (p + (odd ? 1 : 0)) % n_pos;
+      fsync_cu_t  *cu  = &cus[n_cus++];
+      cu->y_pos = (dir == h_fs_dir) ? l   : pos;
+      cu->x_pos = (dir == h_fs_dir) ? pos : l;
+      cu->cu_id = (cu->y_pos << topo->x_shift) + cu->x_pos;
+    }
+  }
+
+  return n_cus/2;
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization multi-team barrier allocator header
+ */
+
+#ifndef FSYNC_TEAM_ALLOC_H
+#define FSYNC_TEAM_ALLOC_H
+
+#include "fractal_sync_req_gen.h"
+
+typedef struct fsync_team{
+  fsync_cu_t   *cus;      /* CUs of the team (requests are written here) */
+  unsigned int  num_cus;
+  /* Allocation results */
+  bool          valid;    /* A barrier has been assigned to the team */
+  bool          nbr;      /* The team synchronizes over a dedicated neighbor link (no register, always in phase 0) */
+  unsigned int  lvl;      /* Barrier level (1 refers to the leaf 1D nodes) */
+  unsigned int  node_idx; /* Barrier node within the level: {node_y, node_x} */
+  unsigned int  reg;      /* Local register of the barrier node (id[ID_WIDTH-1:1]) */
+  unsigned int  phase;    /* Teams in the same phase can synchronize in parallel, phases are serialized */
+} fsync_team_t;
+
+/**
+ * @brief generate the FractalSync requests of a set of disjoint CU teams that synchronize concurrently,
+ *        sharing the local RF registers of the barrier nodes and serializing teams that do not fit
+ * @param topo topology descriptor
+ * @param teams array of teams
+ * @param num_teams size of the array of teams
+ * @param default_dir default barrier direction when the barrier can be reached both horizontaly and vertically (i.e. synchronization at 2D node)
+ * @param num_phases number of serialized phases needed by the teams (0 if no barrier has been assigned)
+ * @return true if the teams are disjoint and all their requests have been generated properly, false otherwise
+ */
+bool fsync_alloc_teams(const fsync_topology_t *topo, fsync_team_t *teams, const unsigned int num_teams, const fsync_dir default_dir, unsigned int *num_phases);
+
+/**
+ * @brief generate the FractalSync requests of a set of disjoint CU pairs that synchronize concurrently (e.g. halo exchange),
+ *        using the dedicated neighbor link of a pair when it exists and the lowest common tree level otherwise
+ * @param topo topology descriptor
+ * @param cus array of CUs: pair k is made of cus[2k] and cus[2k+1]
+ * @param num_pairs number of pairs
+ * @param default_dir default barrier direction when the barrier can be reached both horizontaly and vertically (i.e. synchronization at 2D node)
+ * @param teams array of num_pairs teams, set to the allocation results of each pair
+ * @param num_phases number of serialized phases needed by the pairs (0 if no barrier has been assigned)
+ * @return true if the pairs are disjoint and all their requests have been generated properly, false otherwise
+ */
+bool fsync_gen_nbr_reqs(const fsync_topology_t *topo, fsync_cu_t *cus, const unsigned int num_pairs, const fsync_dir default_dir, fsync_team_t *teams, unsigned int *num_phases);
+
+/**
+ * @brief fill an array of CUs with the pairs of a neighbor exchange along the rows (h) or columns (v) of the mesh, wrapping around its edges (torus)
+ * @param topo topology descriptor
+ * @param dir direction of the exchange
+ * @param odd false for pairs (0, 1), (2, 3), ..., true for pairs (1, 2), (3, 4), ..., (N-1, 0)
+ * @param cus array of at least topo->n_cu CUs: pair k is made of cus[2k] and cus[2k+1] (cu_id is the row-major position)
+ * @return number of pairs
+ */
+unsigned int fsync_torus_pairs(const fsync_topology_t *topo, const fsync_dir dir, const bool odd, fsync_cu_t *cus);
+
+#endif /*FSYNC_TEAM_ALLOC_H*/
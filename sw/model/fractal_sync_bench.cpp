@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization latency benchmark on the C++ model (-std=c++20)
+ *
+ * Every pattern of tb_bfm (neighbor, torus, row, column, global) plus random subgroups (one random subtree team per
+ * barrier, requests from the constexpr generator) runs as a back-to-back stream of ITERATIONS barriers on every tree size.
+ * Each row reports the per-CU latency (request sampled to wake, in cycles) over the whole stream, the barrier rounds
+ * completed per kilocycle and the hash of the tree configuration.
+ *
+ * Usage: fractal_sync_bench [csv|json] [ITERATIONS] [MAX_RAND_CYCLES] [SEED] [N_CU_X...]
+ */
+
+#include "fractal_sync_bfm.hpp"
+#include "fractal_sync_model.hpp"
+#include "../fractal_sync_req_gen.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace model = fractal_sync::model;
+
+struct result_t{
+  unsigned int  n_cu_x;
+  std::string   pattern;
+  std::uint64_t config_hash;
+  unsigned int  barriers;
+  std::uint64_t cycles;
+  unsigned int  samples;
+  std::uint64_t min;
+  std::uint64_t median;
+  std::uint64_t p99;
+  std::uint64_t max;
+  double        barriers_per_kcycle;
+  unsigned int  errors;
+};
+
+/* Nearest-rank percentile of sorted samples */
+std::uint64_t percentile(const std::vector<std::uint64_t> &sorted, const unsigned int pct){
+  if (sorted.empty()) return 0;
+  const std::size_t rank = (sorted.size()*pct + 99)/100;
+  return sorted[std::max<std::size_t>(rank, 1) - 1];
+}
+
+/*
+ * Random team: all the CUs below a random node of the trees (2D node: square block, 1D node: two adjacent blocks),
+ * as transactions of the generated requests (idle CUs have level 0)
+ */
+std::vector<model::transaction_t> random_group(const unsigned int n_cu_x, std::mt19937 &rng){
+  const unsigned int n_cu  = n_cu_x*n_cu_x;
+  unsigned int       n_lvl = 0;
+  while ((1u << n_lvl) < n_cu) n_lvl++;
+
+  const unsigned int level   = std::uniform_int_distribution<unsigned int>(1, n_lvl)(rng);
+  const bool         v_dir   = std::uniform_int_distribution<unsigned int>(0, 1)(rng);
+  const bool         node_1d = level%2;
+  const unsigned int block   = 1u << ((level-1)/2);
+  const unsigned int size_x  = (node_1d &&  v_dir) ? block : 2*block;
+  const unsigned int size_y  = (node_1d && !v_dir) ? block : 2*block;
+  const unsigned int x0      = size_x*std::uniform_int_distribution<unsigned int>(0, n_cu_x/size_x-1)(rng);
+  const unsigned int y0      = size_y*std::uniform_int_distribution<unsigned int>(0, n_cu_x/size_y-1)(rng);
+
+  std::vector<fsync::cu_t> cus;
+  for (unsigned int y = y0; y < y0+size_y; y++)
+    for (unsigned int x = x0; x < x0+size_x; x++) cus.push_back(fsync::cu_t{y, x});
+  std::vector<fsync::req_t>         reqs(cus.size());
+  std::vector<model::transaction_t> group(n_cu, model::transaction_t{0, 0, 0});
+  if (!fsync::gen_reqs(n_cu_x, n_cu_x, cus, reqs, v_dir ? fsync::dir_e::v : fsync::dir_e::h)) return group;
+
+  for (std::size_t i = 0; i < cus.size(); i++){
+    if (reqs[i].req_node == fsync::node_e::null) continue;
+    unsigned int msb = 0;
+    while (reqs[i].fs_req_aggr >> msb) msb++;
+    group[cus[i].y_pos*n_cu_x + cus[i].x_pos] = model::transaction_t{msb, reqs[i].fs_req_aggr & ~(1u << (msb-1)), reqs[i].fs_req_id};
+  }
+  return group;
+}
+
+result_t run_pattern(const unsigned int n_cu_x, const unsigned int pattern, const unsigned int iterations, const unsigned int max_rand, const unsigned int seed){
+  model::network               net(model::preset(n_cu_x));
+  model::bfm_t<model::network> bfm(net, net.n_cu(), 0, 0, max_rand, seed);
+  std::mt19937                 rng(seed);
+
+  result_t res{};
+  res.n_cu_x      = n_cu_x;
+  res.pattern     = (pattern < model::n_bfm_tests) ? model::bfm_test_name(pattern) : "random_group";
+  res.config_hash = model::config_hash(net.cfg());
+
+  std::vector<std::uint64_t> latency;
+  const std::uint64_t start = bfm.cycles();
+  for (unsigned int it = 0; it < iterations && !bfm.hung(); it++){
+    const auto reqs = (pattern < model::n_bfm_tests) ? model::bfm_test(pattern, n_cu_x) : random_group(n_cu_x, rng);
+    const auto lat  = bfm.run(reqs);
+    for (unsigned int i = 0; i < net.n_cu(); i++)
+      if (reqs[i].level && lat[i]) latency.push_back(lat[i]/model::bfm_t<model::network>::clk_period);
+    res.barriers += !bfm.hung();
+  }
+  std::sort(latency.begin(), latency.end());
+
+  res.cycles              = bfm.cycles() - start;
+  res.samples             = latency.size();
+  res.min                 = latency.empty() ? 0 : latency.front();
+  res.median              = percentile(latency, 50);
+  res.p99                 = percentile(latency, 99);
+  res.max                 = latency.empty() ? 0 : latency.back();
+  res.barriers_per_kcycle = res.cycles ? 1000.0*res.barriers/res.cycles : 0.0;
+  res.errors              = bfm.errors();
+  return res;
+}
+
+void print_csv(const std::vector<result_t> &results){
+  std::printf("n_cu_x,pattern,config_hash,barriers,cycles,samples,min,median,p99,max,barriers_per_kcycle,errors\n");
+  for (const auto &r : results)
+    std::printf("%u,%s,%016llx,%u,%llu,%u,%llu,%llu,%llu,%llu,%.3f,%u\n", r.n_cu_x, r.pattern.c_str(), static_cast<unsigned long long>(r.config_hash),
+                r.barriers, static_cast<unsigned long long>(r.cycles), r.samples, static_cast<unsigned long long>(r.min), static_cast<unsigned long long>(r.median),
+                static_cast<unsigned long long>(r.p99), static_cast<unsigned long long>(r.max), r.barriers_per_kcycle, r.errors);
+}
+
+void print_json(const std::vector<result_t> &results){
+  std::printf("[\n");
+  for (std::size_t i = 0; i < results.size(); i++){
+    const auto &r = results[i];
+    std::printf("  {\"n_cu_x\": %u, \"pattern\": \"%s\", \"config_hash\": \"%016llx\", \"barriers\": %u, \"cycles\": %llu, \"samples\": %u, "
+                "\"latency\": {\"min\": %llu, \"median\": %llu, \"p99\": %llu, \"max\": %llu}, \"barriers_per_kcycle\": %.3f, \"errors\": %u}%s\n",
+                r.n_cu_x, r.pattern.c_str(), static_cast<unsigned long long>(r.config_hash), r.barriers, static_cast<unsigned long long>(r.cycles), r.samples,
+                static_cast<unsigned long long>(r.min), static_cast<unsigned long long>(r.median), static_cast<unsigned long long>(r.p99),
+                static_cast<unsigned long long>(r.max), r.barriers_per_kcycle, r.errors, (i+1 < results.size()) ? "," : "");
+  }
+  std::printf("]\n");
+}
+
+int main(int argc, char *argv[]){
+  const bool         json       = (argc > 1) && !std::strcmp(argv[1], "json");
+  const unsigned int iterations = (argc > 2) ? std::atoi(argv[2]) : 16;
+  const unsigned int max_rand   = (argc > 3) ? std::atoi(argv[3]) : 0;
+  const unsigned int seed       = (argc > 4) ? std::atoi(argv[4]) : 1;
+  std::vector<unsigned int> sizes;
+  for (int i = 5; i < argc; i++) sizes.push_back(std::atoi(argv[i]));
+  if (sizes.empty()) sizes = {2, 4, 8, 16, 32};
+
+  try {
+    std::vector<result_t> results;
+    unsigned int          errors = 0;
+    for (const auto n_cu_x : sizes){
+      for (unsigned int pattern = 0; pattern <= model::n_bfm_tests; pattern++){
+        results.push_back(run_pattern(n_cu_x, pattern, iterations, max_rand, seed));
+        errors += results.back().errors;
+      }
+    }
+    if (json) print_json(results);
+    else      print_csv(results);
+    return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+  } catch (const std::exception &e){
+    std::fprintf(stderr, "%s\n", e.what());
+    return EXIT_FAILURE;
+  }
+}
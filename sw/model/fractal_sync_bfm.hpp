@@ -0,0 +1,574 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization C++ CU BFM: same transactions, timing and checks as dv/cu_bfm and dv/tb_bfm (-std=c++20)
+ *
+ * The BFM drives any DUT providing:
+ *   req_t       &req(unsigned int cu, iface_e iface)       - CU request, sampled at tick()
+ *   const rsp_t &rsp(unsigned int cu, iface_e iface) const - CU response, valid after eval()
+ *   void         eval()                                    - evaluate outputs before the rising edge
+ *   void         tick()                                    - rising edge
+ * e.g. the C++ model (fractal_sync::model::network) or a Verilated tree (dv/tb_verilator.cpp).
+ */
+
+#ifndef FSYNC_BFM_HPP
+#define FSYNC_BFM_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "fractal_sync_model.hpp"
+#include "fractal_sync_trace.hpp"
+
+namespace fractal_sync::model {
+
+/* Same fields as sync_transaction: level 0 marks a CU that does not take part in the barrier */
+struct transaction_t{
+  unsigned int level;
+  unsigned int aggregate;
+  unsigned int id;
+};
+
+/* Same routing as cu_bfm::sync_req */
+inline iface_e route(const transaction_t &t){
+  if (t.level == 1) return static_cast<iface_e>(t.id & 3);
+  return (t.id & 1) ? iface_e::v_tree : iface_e::h_tree;
+}
+
+inline constexpr unsigned int n_bfm_tests = 7;
+
+inline const char *bfm_test_name(const unsigned int test){
+  static const char *names[n_bfm_tests] = {"nbr_h_sync", "nbr_h_tor_sync", "nbr_v_sync", "nbr_v_tor_sync", "row_sync", "col_sync", "global_sync"};
+  return (test < n_bfm_tests) ? names[test] : "unknown";
+}
+
+/**
+ * @brief transactions of the tb_bfm tests
+ * @param test test index (same order as tb_bfm: nbr_h_sync, nbr_h_tor_sync, nbr_v_sync, nbr_v_tor_sync, row_sync, col_sync, global_sync)
+ * @param n_cu_x number of CUs in a row of the mesh
+ * @return one transaction per CU
+ */
+inline std::vector<transaction_t> bfm_test(const unsigned int test, const unsigned int n_cu_x){
+  const unsigned int n     = n_cu_x;
+  const unsigned int n_cu  = n*n;
+  unsigned int       n_lvl = 0;
+  while ((1u << n_lvl) < n_cu) n_lvl++;
+
+  std::vector<transaction_t> reqs(n_cu);
+  unsigned int aggregate = 0;
+  for (unsigned int i = 0; i < (n_lvl-1)/2; i++) aggregate |= 1u << (2*i);
+  for (unsigned int i = 0; i < n_cu; i++){
+    const bool h_border = i%n == 0 || i%n == n-1;
+    const bool v_border = i/n == 0 || i/n == n-1;
+    switch (test){
+      case 0:  reqs[i] = {1, 0, 0}; break;
+      case 1:  reqs[i] = h_border ? transaction_t{n_lvl-1, 0, 2*((i/n)%(n/2))} : transaction_t{1, 0, 2}; break;
+      case 2:  reqs[i] = {1, 0, 1}; break;
+      case 3:  reqs[i] = v_border ? transaction_t{n_lvl-1, 0, 2*((i%n)%(n/2))+1} : transaction_t{1, 0, 3}; break;
+      case 4:  reqs[i] = {n_lvl-1, aggregate, 2*((i/n)%(n/2))}; break;
+      case 5:  reqs[i] = {n_lvl-1, aggregate, 2*((i%n)%(n/2))+1}; break;
+      default: reqs[i] = {n_lvl, (1u << (n_lvl-1)) - 1, (1u << (n_lvl-1)) - 1}; break;
+    }
+  }
+  return reqs;
+}
+
+/* Number of independent barriers (groups) of a tb_bfm test */
+inline unsigned int bfm_test_groups(const unsigned int test, const unsigned int n_cu_x){
+  if (test < 4) return n_cu_x*n_cu_x/2;
+  if (test < 6) return n_cu_x;
+  return 1;
+}
+
+/* Streaming results: the steady state of a CU goes from its last warm-up barrier to its last barrier, so that groups
+   streaming at different rates (e.g. neighbor pairs and tree barriers of the torus tests) are measured separately */
+struct stream_t{
+  std::uint64_t cycles;      // whole stream
+  std::uint64_t wakes;       // barriers completed by all the CUs
+  double        steady_rate; // sum over the CUs of the barriers completed per cycle in steady state
+  unsigned int  n_active;    // CUs taking part in the barriers
+  /* Barrier rounds (one barrier per CU) per cycle in steady state */
+  double rounds_per_cycle() const { return n_active ? steady_rate/n_active : 0.0; }
+};
+
+template <typename DUT>
+class bfm_t{
+public:
+  /* Clock period (ns): negedges at 10*k, posedges at 10*k+5 as in tb_bfm */
+  static constexpr std::uint64_t clk_period = 10;
+  /* tb_bfm starts the tests after reset, at the 10th negedge */
+  static constexpr std::uint64_t reset_time = 100;
+  /* Cycles without any wake after which a test is declared hung */
+  static constexpr std::uint64_t watchdog   = 100000;
+
+  bfm_t(DUT &dut, const unsigned int n_cu, const unsigned int min_comp = 0, const unsigned int max_comp = 0, const unsigned int max_rand = 0, const unsigned int seed = 1)
+    : dut_(dut), n_cu_(n_cu), min_comp_(min_comp), max_comp_(max_comp), max_rand_(max_rand), rng_(seed) {}
+
+  /**
+   * @brief issue one transaction per CU and wait for all the wakes (same as tb_bfm::run_test)
+   * @param reqs transaction of each CU (level 0: idle CU)
+   * @return latency (ns) of each CU: from the sampled request to the wake, 0 if the CU is idle or the test hung
+   */
+  std::vector<std::uint64_t> run(const std::vector<transaction_t> &reqs){
+    const std::uint64_t t_start = time_;
+    std::vector<std::uint64_t> sample_time(n_cu_);
+    std::vector<std::uint64_t> rsp_time(n_cu_, 0);
+    for (unsigned int i = 0; i < n_cu_; i++) sample_time[i] = next_sample(t_start);
+
+    unsigned int  pending   = 0;
+    for (const auto &req : reqs) pending += (req.level != 0);
+    std::uint64_t end_time  = 0;
+    std::uint64_t last_wake = t_start;
+    hung_ = false;
+    while (pending > 0 || time_ < end_time){
+      if (time_ - last_wake > watchdog*clk_period){
+        std::fprintf(stderr, "[ERROR] Synchronization timeout: %u CUs did not receive a wake\n", pending);
+        hung_    = true;
+        errors_ += pending;
+        break;
+      }
+      const std::uint64_t posedge = (time_/clk_period)*clk_period + clk_period/2 + ((time_%clk_period >= clk_period/2) ? clk_period : 0);
+      for (unsigned int i = 0; i < n_cu_; i++){
+        if (!reqs[i].level) continue;
+        req_t &req = dut_.req(i, route(reqs[i]));
+        req.sync = posedge == sample_time[i];
+        req.aggr = (1u << (reqs[i].level-1)) | reqs[i].aggregate;
+        req.id   = reqs[i].id;
+      }
+      dut_.eval();
+      for (unsigned int i = 0; i < n_cu_; i++){
+        if (rsp_time[i] || !reqs[i].level) continue;
+        transaction_t rsp;
+        if (!wake(i, rsp)) continue;
+        rsp_time[i] = posedge;
+        last_wake   = posedge;
+        const bool error = rsp.level != reqs[i].level || rsp.id != reqs[i].id;
+        if (error){
+          std::fprintf(stderr, "[ERROR] Detected synchronization error: req and rsp do not match (CU %u)\n", i);
+          errors_++;
+        }
+        log(i, reqs[i], sample_time[i], posedge, error ? trace_error : 0);
+        end_time = std::max({end_time, posedge, sample_time[i] + clk_period/2});
+        pending--;
+      }
+      dut_.tick();
+      cycles_++;
+      time_ = posedge;
+    }
+
+    std::vector<std::uint64_t> latency(n_cu_, 0);
+    for (unsigned int i = 0; i < n_cu_; i++){
+      if (!reqs[i].level) continue;
+      if (rsp_time[i]) latency[i] = rsp_time[i] - sample_time[i];
+      else             log(i, reqs[i], sample_time[i], 0, trace_hung);
+      dut_.req(i, route(reqs[i])).sync = false;
+    }
+    return latency;
+  }
+
+  /**
+   * @brief streaming mode: every CU issues its transaction again as soon as it is woken up (after its computation
+   *        and random cycles), for a given number of iterations; CUs of different groups are not kept in step.
+   *        With split-phase barriers (see split()) every CU arrives, computes the next iteration while the barrier
+   *        completes and then waits for the wake latched by its split_phase endpoint: the next arrive is issued after
+   *        both the computation and the wait
+   * @param reqs transaction of each CU (level 0: idle CU)
+   * @param iterations barriers issued by each CU
+   * @param warmup barriers completed by each CU before the steady-state window starts
+   * @param probe called after every rising edge with the cycle of the stream (e.g. to sample the DUT occupancy)
+   * @return stream statistics
+   */
+  template <typename PROBE>
+  stream_t stream(const std::vector<transaction_t> &reqs, const unsigned int iterations, const unsigned int warmup, PROBE &&probe){
+    std::vector<std::uint64_t> sample_time(n_cu_);
+    std::vector<std::uint64_t> warm_cycle(n_cu_, 0);
+    std::vector<unsigned int>  done(n_cu_, 0);
+    std::vector<char>          issued(n_cu_, 0);
+    stream_t                   res{};
+    for (unsigned int i = 0; i < n_cu_; i++){
+      res.n_active  += (reqs[i].level != 0);
+      sample_time[i] = next_sample(time_);
+    }
+
+    std::vector<std::uint64_t> next_arrive(n_cu_, 0);
+    std::vector<split_phase>   sp(split_wakes_ ? n_cu_ : 0);
+    for (auto &s : sp) s.init(split_wakes_);
+
+    unsigned int  pending   = (iterations > 0) ? res.n_active : 0;
+    std::uint64_t last_wake = time_;
+    hung_ = false;
+    while (pending > 0){
+      if (time_ - last_wake > watchdog*clk_period){
+        std::fprintf(stderr, "[ERROR] Synchronization timeout: %u CUs did not complete the stream\n", pending);
+        hung_    = true;
+        errors_ += pending;
+        break;
+      }
+      const std::uint64_t posedge = (time_/clk_period)*clk_period + clk_period/2 + ((time_%clk_period >= clk_period/2) ? clk_period : 0);
+      for (unsigned int i = 0; i < n_cu_; i++){
+        if (!reqs[i].level) continue;
+        req_t &req = dut_.req(i, route(reqs[i]));
+        req.sync = !issued[i] && done[i] < iterations && posedge == sample_time[i];
+        req.aggr = (1u << (reqs[i].level-1)) | reqs[i].aggregate;
+        req.id   = reqs[i].id;
+        issued[i] |= req.sync;
+        if (req.sync && split_wakes_){
+          next_arrive[i] = next_sample(posedge);
+          sp[i].arrive(reqs[i].level - (tree_iface(route(reqs[i])) ? 1 : 0), reqs[i].id);
+        }
+      }
+      dut_.eval();
+      res.cycles++;
+      for (unsigned int i = 0; i < n_cu_; i++){
+        transaction_t rsp = reqs[i];
+        if (split_wakes_ && reqs[i].level){
+          /* The CU waits once the computation overlapped with the barrier is over */
+          const iface_e iface = route(reqs[i]);
+          const bool    wait  = issued[i] && posedge != sample_time[i] && posedge + clk_period >= next_arrive[i];
+          bool          error = false;
+          const bool    woken = sp[i].eval(dut_.rsp(i, iface), wait, reqs[i].level - (tree_iface(iface) ? 1 : 0), reqs[i].id, &error);
+          if (posedge == sample_time[i] && issued[i] && !sp[i].accepted()){
+            /* Rejected by the endpoint (barrier table full): arrive again in the next cycle */
+            dut_.req(i, iface).sync = false;
+            issued[i]      = 0;
+            sample_time[i] = posedge + clk_period;
+          }
+          if (!woken){
+            if (sp[i].overflow()){
+              std::fprintf(stderr, "[ERROR] Detected synchronization error: wake dropped by the split-phase endpoint (CU %u)\n", i);
+              errors_++;
+            }
+            continue;
+          }
+          if (error){
+            std::fprintf(stderr, "[ERROR] Detected synchronization error: wake with error (CU %u)\n", i);
+            errors_++;
+          }
+        } else if (!reqs[i].level || !issued[i] || posedge == sample_time[i] || !wake(i, rsp)) continue;
+        const bool error = rsp.level != reqs[i].level || rsp.id != reqs[i].id;
+        if (error){
+          std::fprintf(stderr, "[ERROR] Detected synchronization error: req and rsp do not match (CU %u)\n", i);
+          errors_++;
+        }
+        log(i, reqs[i], sample_time[i], posedge, error ? trace_error : 0);
+        issued[i]      = 0;
+        last_wake      = posedge;
+        sample_time[i] = split_wakes_ ? std::max(next_arrive[i], posedge + clk_period) : next_sample(posedge);
+        res.wakes++;
+        if (++done[i] == warmup) warm_cycle[i] = res.cycles;
+        if (done[i] == iterations){
+          pending--;
+          if (iterations > warmup) res.steady_rate += double(iterations - warmup)/(res.cycles - warm_cycle[i]);
+        }
+      }
+      dut_.tick();
+      for (auto &s : sp) s.commit();
+      cycles_++;
+      time_ = posedge;
+      probe(res.cycles);
+    }
+
+    for (unsigned int i = 0; i < n_cu_; i++)
+      if (reqs[i].level) dut_.req(i, route(reqs[i])).sync = false;
+    return res;
+  }
+
+  stream_t stream(const std::vector<transaction_t> &reqs, const unsigned int iterations, const unsigned int warmup = 0){
+    return stream(reqs, iterations, warmup, [](std::uint64_t){});
+  }
+
+  /**
+   * @brief trace-driven mode: every CU issues the transactions of a trace in order, keeping the recorded gap between
+   *        each wake and the next request (the computation of the application) and the skew of the first requests.
+   *        The transactions of hung CUs are issued as well (their barriers count them) but not waited for, so that a
+   *        trace recorded on the model is replayed cycle for cycle, hangs included
+   * @param trace recorded transactions
+   * @return the transactions of the trace with the issue and wake cycles (and flags) of this run, in the same order
+   */
+  std::vector<trace_record_t> replay(const std::vector<trace_record_t> &trace){
+    std::vector<std::vector<std::size_t>> queue(n_cu_);
+    std::uint32_t                         first_issue = UINT32_MAX;
+    for (std::size_t r = 0; r < trace.size(); r++){
+      if (trace[r].cu >= n_cu_ || trace[r].level == 0) throw std::runtime_error("Trace transaction not valid for the DUT");
+      queue[trace[r].cu].push_back(r);
+      first_issue = std::min(first_issue, trace[r].issue);
+    }
+    for (auto &q : queue)
+      std::stable_sort(q.begin(), q.end(), [&](const std::size_t a, const std::size_t b){ return trace[a].issue < trace[b].issue; });
+
+    std::vector<trace_record_t> out(trace);
+    std::vector<std::size_t>    next(n_cu_, 0);
+    std::vector<std::uint64_t>  sample_time(n_cu_, 0);
+    std::vector<char>           issued(n_cu_, 0);
+    std::vector<char>           hung(n_cu_, 0);
+    unsigned int                pending = 0;
+    const std::uint64_t         start   = time_/clk_period + 1;
+    for (unsigned int i = 0; i < n_cu_; i++){
+      if (queue[i].empty()) continue;
+      sample_time[i] = (start + trace[queue[i][0]].issue - first_issue)*clk_period + clk_period/2;
+      pending++;
+    }
+
+    std::uint64_t last_wake = time_;
+    hung_ = false;
+    while (pending > 0){
+      if (time_ - last_wake > watchdog*clk_period){
+        std::fprintf(stderr, "[ERROR] Synchronization timeout: %u CUs did not complete the trace\n", pending);
+        for (unsigned int i = 0; i < n_cu_; i++)
+          for (std::size_t k = next[i]; k < queue[i].size(); k++) out[queue[i][k]].flags = trace_hung;
+        hung_    = true;
+        errors_ += pending;
+        break;
+      }
+      const std::uint64_t posedge = (time_/clk_period)*clk_period + clk_period/2 + ((time_%clk_period >= clk_period/2) ? clk_period : 0);
+      for (unsigned int i = 0; i < n_cu_; i++){
+        if (next[i] == queue[i].size()) continue;
+        const transaction_t t   = transaction(trace[queue[i][next[i]]]);
+        req_t              &req = dut_.req(i, route(t));
+        req.sync = !issued[i] && posedge == sample_time[i];
+        req.aggr = (1u << (t.level-1)) | t.aggregate;
+        req.id   = t.id;
+        issued[i] |= req.sync;
+        if (!req.sync || !(trace[queue[i][next[i]]].flags & trace_hung)) continue;
+        /* Recorded without a wake: the CU stops after the request, a late wake is still recorded below */
+        out[queue[i][next[i]]].issue = static_cast<std::uint32_t>(posedge/clk_period);
+        hung[i] = 1;
+        pending--;
+      }
+      dut_.eval();
+      for (unsigned int i = 0; i < n_cu_; i++){
+        transaction_t rsp;
+        if (next[i] == queue[i].size() || !issued[i] || posedge == sample_time[i] || !wake(i, rsp)) continue;
+        if (hung[i]){
+          /* Woken although the recording hung: the replay diverges from the trace */
+          trace_record_t &res = out[queue[i][next[i]]];
+          res.wake  = static_cast<std::uint32_t>(posedge/clk_period);
+          res.flags = (rsp.level != res.level || rsp.id != res.id) ? trace_error : 0;
+          dut_.req(i, route(transaction(res))).sync = false;
+          issued[i] = 0;
+          next[i]++;
+          continue;
+        }
+        const trace_record_t &rec = trace[queue[i][next[i]]];
+        const transaction_t   t   = transaction(rec);
+        trace_record_t       &res = out[queue[i][next[i]]];
+        res.issue = static_cast<std::uint32_t>(sample_time[i]/clk_period);
+        res.wake  = static_cast<std::uint32_t>(posedge/clk_period);
+        res.flags = (rsp.level != t.level || rsp.id != t.id) ? trace_error : 0;
+        if (res.flags){
+          std::fprintf(stderr, "[ERROR] Detected synchronization error: req and rsp do not match (CU %u)\n", i);
+          errors_++;
+        }
+        dut_.req(i, route(t)).sync = false;
+        issued[i] = 0;
+        last_wake = posedge;
+        if (++next[i] == queue[i].size()){
+          pending--;
+          continue;
+        }
+        const std::uint32_t gap = trace[queue[i][next[i]]].issue - rec.wake;
+        sample_time[i] = posedge + ((rec.wake && gap >= 1 && gap < 0x80000000u) ? gap : 1)*clk_period;
+      }
+      dut_.tick();
+      cycles_++;
+      time_ = posedge;
+    }
+    return out;
+  }
+
+  /**
+   * @brief pipelined barriers: in every iteration each CU arrives at the barrier of every phase in order, one per cycle,
+   *        computes and then waits for the barriers in the same order; the next iteration starts after the last wake.
+   *        With split-phase barriers (see split()) the barriers of an iteration are in flight together and the
+   *        computation overlaps with them; otherwise the CU waits for each barrier right after arriving and computes
+   *        after the last one (blocking barriers, issued one after the other)
+   * @param phases transaction of each CU (level 0: idle CU) for every barrier of an iteration
+   * @param iterations iterations of each CU
+   * @return stream statistics (rounds: iterations)
+   */
+  stream_t pipeline(const std::vector<std::vector<transaction_t>> &phases, const unsigned int iterations){
+    std::vector<std::vector<transaction_t>> cu_phases(n_cu_);
+    for (const auto &phase : phases)
+      for (unsigned int i = 0; i < n_cu_; i++)
+        if (phase[i].level) cu_phases[i].push_back(phase[i]);
+
+    const unsigned int         n_barriers = split_wakes_ ? split_wakes_ : 1;
+    std::vector<split_phase>   sp(4*n_cu_);
+    std::vector<std::uint64_t> sample_time(n_cu_);
+    std::vector<std::uint64_t> wait_time(n_cu_, UINT64_MAX);
+    std::vector<std::uint64_t> issue(n_cu_*phases.size(), 0);
+    std::vector<unsigned int>  next_arrive(n_cu_, 0);
+    std::vector<unsigned int>  next_wait(n_cu_, 0);
+    std::vector<unsigned int>  done(n_cu_, 0);
+    std::vector<int>           arrived(n_cu_, -1);
+    stream_t                   res{};
+    for (auto &s : sp) s.init(n_barriers);
+    for (unsigned int i = 0; i < n_cu_; i++){
+      res.n_active  += !cu_phases[i].empty();
+      sample_time[i] = next_sample(time_);
+    }
+
+    unsigned int  pending   = (iterations > 0) ? res.n_active : 0;
+    std::uint64_t last_wake = time_;
+    hung_ = false;
+    while (pending > 0){
+      if (time_ - last_wake > watchdog*clk_period){
+        std::fprintf(stderr, "[ERROR] Synchronization timeout: %u CUs did not complete the pipeline\n", pending);
+        hung_    = true;
+        errors_ += pending;
+        break;
+      }
+      const std::uint64_t posedge = (time_/clk_period)*clk_period + clk_period/2 + ((time_%clk_period >= clk_period/2) ? clk_period : 0);
+      for (unsigned int i = 0; i < n_cu_; i++){
+        arrived[i] = -1;
+        const auto &t = cu_phases[i];
+        if (t.empty() || done[i] == iterations) continue;
+        for (const auto &p : t) dut_.req(i, route(p)).sync = false;
+        /* One arrive per cycle; blocking barriers are issued after the wake of the previous one */
+        if (next_arrive[i] == t.size() || posedge < sample_time[i] || (!split_wakes_ && next_wait[i] != next_arrive[i])) continue;
+        const transaction_t &a     = t[next_arrive[i]];
+        const iface_e        iface = route(a);
+        if (!sp[4*i+static_cast<unsigned int>(iface)].ready()){
+          /* Full table: wait for the barriers in flight */
+          wait_time[i] = std::min(wait_time[i], posedge);
+          continue;
+        }
+        req_t &req = dut_.req(i, iface);
+        req.sync = true;
+        req.aggr = (1u << (a.level-1)) | a.aggregate;
+        req.id   = a.id;
+        sp[4*i+static_cast<unsigned int>(iface)].arrive(a.level - (tree_iface(iface) ? 1 : 0), a.id);
+        arrived[i] = static_cast<int>(iface);
+      }
+      dut_.eval();
+      res.cycles++;
+      for (unsigned int i = 0; i < n_cu_; i++){
+        const auto &t = cu_phases[i];
+        if (t.empty() || done[i] == iterations) continue;
+        const transaction_t w       = t[std::min<std::size_t>(next_wait[i], t.size()-1)];
+        const bool          waiting = next_wait[i] < next_arrive[i] && posedge >= wait_time[i];
+        for (unsigned int f = 0; f < 4; f++){
+          const iface_e  iface = static_cast<iface_e>(f);
+          split_phase   &s     = sp[4*i+f];
+          const bool     wait  = waiting && route(w) == iface;
+          bool           error = false;
+          const bool     woken = s.eval(dut_.rsp(i, iface), wait, w.level - (tree_iface(iface) ? 1 : 0), w.id, &error);
+          if (s.overflow()){
+            std::fprintf(stderr, "[ERROR] Detected synchronization error: wake dropped by the split-phase endpoint (CU %u)\n", i);
+            errors_++;
+          }
+          if (arrived[i] == static_cast<int>(f)){
+            if (s.accepted()){
+              issue[i*phases.size()+next_arrive[i]] = posedge;
+              sample_time[i] = posedge + clk_period;
+              if (++next_arrive[i] == t.size() && split_wakes_) wait_time[i] = std::min(wait_time[i], next_sample(posedge) - clk_period);
+              if (!split_wakes_) wait_time[i] = posedge + clk_period;
+            } else dut_.req(i, iface).sync = false;
+          }
+          if (!woken) continue;
+          if (error){
+            std::fprintf(stderr, "[ERROR] Detected synchronization error: wake with error (CU %u)\n", i);
+            errors_++;
+          }
+          log(i, w, issue[i*phases.size()+next_wait[i]], posedge, error ? trace_error : 0);
+          last_wake = posedge;
+          res.wakes++;
+          if (++next_wait[i] < t.size()) continue;
+          next_arrive[i] = next_wait[i] = 0;
+          wait_time[i]   = UINT64_MAX;
+          sample_time[i] = split_wakes_ ? posedge + clk_period : next_sample(posedge);
+          if (++done[i] == iterations){
+            pending--;
+            res.steady_rate += double(iterations)/res.cycles;
+          }
+        }
+      }
+      dut_.tick();
+      for (auto &s : sp) s.commit();
+      cycles_++;
+      time_ = posedge;
+    }
+
+    for (unsigned int i = 0; i < n_cu_; i++)
+      for (const auto &p : cu_phases[i]) dut_.req(i, route(p)).sync = false;
+    return res;
+  }
+
+  /* Split-phase barriers in stream() and pipeline(), with n_barriers outstanding barriers per CU interface (0: blocking
+     barriers) */
+  void split(const unsigned int n_barriers){ split_wakes_ = n_barriers; }
+
+  /* Append every completed transaction of run() and stream() to a trace (nullptr: no recording) */
+  void record(std::vector<trace_record_t> *trace){ trace_ = trace; }
+
+  unsigned int  errors() const { return errors_; }
+  bool          hung()   const { return hung_; }
+  std::uint64_t cycles() const { return cycles_; }
+  std::uint64_t time()   const { return time_; }
+
+private:
+  /* Sampling time of a request driven after time t (next negedge plus the computation and random cycles) */
+  std::uint64_t next_sample(const std::uint64_t t){
+    std::uniform_int_distribution<unsigned int> comp(min_comp_, max_comp_);
+    std::uniform_int_distribution<unsigned int> rand(0, max_rand_);
+    return (t/clk_period + 1 + comp(rng_) + rand(rng_))*clk_period + clk_period/2;
+  }
+
+  static bool tree_iface(const iface_e iface){ return iface == iface_e::h_tree || iface == iface_e::v_tree; }
+
+  static transaction_t transaction(const trace_record_t &r){ return transaction_t{r.level, r.aggregate, r.id}; }
+
+  void log(const unsigned int cu, const transaction_t &t, const std::uint64_t issue, const std::uint64_t wake, const unsigned int flags){
+    if (trace_) trace_->push_back(trace_record_t{cu, t.level, t.aggregate, t.id, static_cast<std::uint32_t>(issue/clk_period),
+                                                 static_cast<std::uint32_t>(wake/clk_period), flags});
+  }
+
+  /* Same priority as cu_bfm::sync_rsp: tree levels are counted from the CU */
+  bool wake(const unsigned int cu, transaction_t &rsp) const{
+    static constexpr iface_e ifaces[] = {iface_e::h_tree, iface_e::v_tree, iface_e::h_nbr, iface_e::v_nbr};
+    for (const auto iface : ifaces){
+      const rsp_t &r = dut_.rsp(cu, iface);
+      if (!r.wake) continue;
+      const bool tree = iface == iface_e::h_tree || iface == iface_e::v_tree;
+      rsp = transaction_t{r.lvl + (tree ? 1 : 0), 0, r.id};
+      return true;
+    }
+    return false;
+  }
+
+  DUT          &dut_;
+  unsigned int  n_cu_;
+  unsigned int  min_comp_;
+  unsigned int  max_comp_;
+  unsigned int  max_rand_;
+  std::mt19937  rng_;
+  std::uint64_t time_   = reset_time;
+  std::uint64_t cycles_ = 0;
+  unsigned int  errors_ = 0;
+  bool          hung_   = false;
+  unsigned int  split_wakes_ = 0;
+  std::vector<trace_record_t> *trace_ = nullptr;
+};
+
+} // namespace fractal_sync::model
+
+#endif /*FSYNC_BFM_HPP*/
@@ -0,0 +1,321 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization design-space exploration on the C++ model (-std=c++20)
+ *
+ * The per-level parameters of fractal_sync_NxN_pkg (RF_TYPE_1D/2D, ARBITER_TYPE_1D/2D, N_LOCAL_REGS_1D/2D,
+ * N_REMOTE_LINES_1D/2D, FIFO combinational outputs, N_LINKS_ITL, N_PIPELINE_STAGES) span a space around the preset of
+ * the tree: every point is enumerated if the space has at most POINTS configurations, otherwise POINTS distinct points
+ * are sampled at random (the preset is always the first point). For each point:
+ *   - latency: every tb_bfm test runs ITERATIONS times, mean and max latency (request sampled to wake, in cycles);
+ *   - throughput: every tb_bfm test streams ITERATIONS barriers, mean barrier rounds per kilocycle;
+ *   - workload: the transactions of TRACE (see fractal_sync_replay) are replayed, mean latency and makespan;
+ *   - area proxy: flops + CAM_BIT_WEIGHT*CAM bits of the network (network::area).
+ * Points with errors or timeouts are reported but infeasible. The Pareto frontier minimizes the area and the latency of
+ * the workload (TRACE if given, the tb_bfm tests otherwise). Pipeline stages only add latency and area in a cycle model:
+ * they are explored to quantify that cost, their timing benefit must be evaluated in synthesis.
+ *
+ * Usage: fractal_sync_dse [csv|json] [N_CU_X] [POINTS] [ITERATIONS] [SEED] [TRACE]
+ */
+
+#include "fractal_sync_bfm.hpp"
+#include "fractal_sync_model.hpp"
+#include "fractal_sync_trace.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace model = fractal_sync::model;
+
+using bfm_t = model::bfm_t<model::network>;
+
+/* A CAM bit costs a flop plus its share of the match logic */
+constexpr unsigned int cam_bit_weight = 2;
+
+/* One parameter of one level: number of values and how to apply the c-th one to a configuration */
+struct knob_t{
+  std::string                                         name;
+  unsigned int                                        n_values;
+  std::function<void(model::config_t&, unsigned int)> apply;
+};
+
+struct point_t{
+  model::config_t cfg;
+  std::uint64_t   config_hash;
+  model::area_t   area;
+  double          latency;        // tb_bfm tests, mean (cycles)
+  std::uint64_t   max_latency;    // tb_bfm tests, max (cycles)
+  double          rounds_per_kcycle;
+  double          trace_latency;  // workload trace, mean (cycles)
+  std::uint64_t   trace_makespan; // workload trace (cycles)
+  unsigned int    errors;
+  bool            pareto;
+
+  unsigned int cost() const { return area.flops + cam_bit_weight*area.cam_bits; }
+  bool feasible() const { return errors == 0; }
+};
+
+/* Values around the preset: half and double of the sizes, every RF/arbiter type (but PP, which grants as FA), both
+ * FIFO output flavours, with and without flow control */
+std::vector<knob_t> knobs(const model::config_t &preset){
+  std::vector<knob_t> space;
+  const auto          halve = [](const unsigned int v){ return std::max(v/2, 1u); };
+  const unsigned int  n_pairs = static_cast<unsigned int>(preset.rf_type_1d.size());
+
+  for (unsigned int p = 0; p < n_pairs; p++){
+    const std::string lvl = std::to_string(p);
+    space.push_back({"rf_type_1d[" + lvl + "]", 3, [p](model::config_t &c, unsigned int v){ c.rf_type_1d[p] = static_cast<model::remote_rf_e>(v); }});
+    space.push_back({"rf_type_2d[" + lvl + "]", 3, [p](model::config_t &c, unsigned int v){ c.rf_type_2d[p] = static_cast<model::remote_rf_e>(v); }});
+    space.push_back({"arbiter_type_1d[" + lvl + "]", 3, [p](model::config_t &c, unsigned int v){ c.arbiter_type_1d[p] = static_cast<model::arb_e>(v); }});
+    space.push_back({"arbiter_type_2d[" + lvl + "]", 3, [p](model::config_t &c, unsigned int v){ c.arbiter_type_2d[p] = static_cast<model::arb_e>(v); }});
+    const unsigned int regs_1d = preset.n_local_regs_1d[p], regs_2d = preset.n_local_regs_2d[p];
+    const unsigned int lines_1d = preset.n_remote_lines_1d[p], lines_2d = preset.n_remote_lines_2d[p];
+    space.push_back({"n_local_regs_1d[" + lvl + "]", 2, [=](model::config_t &c, unsigned int v){ c.n_local_regs_1d[p] = v ? regs_1d : halve(regs_1d); }});
+    space.push_back({"n_local_regs_2d[" + lvl + "]", 2, [=](model::config_t &c, unsigned int v){ c.n_local_regs_2d[p] = v ? regs_2d : halve(regs_2d); }});
+    space.push_back({"n_remote_lines_1d[" + lvl + "]", 2, [=](model::config_t &c, unsigned int v){ c.n_remote_lines_1d[p] = v ? lines_1d : halve(lines_1d); }});
+    space.push_back({"n_remote_lines_2d[" + lvl + "]", 2, [=](model::config_t &c, unsigned int v){ c.n_remote_lines_2d[p] = v ? lines_2d : halve(lines_2d); }});
+    space.push_back({"fifo_comb_1d[" + lvl + "]", 2, [p](model::config_t &c, unsigned int v){
+      c.rx_fifo_comb_1d[p] = c.tx_fifo_comb_1d[p] = c.local_fifo_comb_1d[p] = c.remote_fifo_comb_1d[p] = v; }});
+    space.push_back({"fifo_comb_2d[" + lvl + "]", 2, [p](model::config_t &c, unsigned int v){
+      c.rx_fifo_comb_2d[p] = c.tx_fifo_comb_2d[p] = c.local_fifo_comb_2d[p] = c.remote_fifo_comb_2d[p] = v; }});
+  }
+  for (unsigned int i = 0; i < preset.n_links_itl.size(); i++){
+    const unsigned int links = preset.n_links_itl[i];
+    space.push_back({"n_links_itl[" + std::to_string(i) + "]", (links > 1) ? 3u : 2u, [=](model::config_t &c, unsigned int v){
+      c.n_links_itl[i] = (links > 1) ? ((v == 0) ? halve(links) : (v == 1) ? links : 2*links) : (v ? 2 : 1); }});
+  }
+  for (unsigned int i = 0; i < preset.n_pipeline_stages.size(); i++){
+    const unsigned int stages = preset.n_pipeline_stages[i];
+    space.push_back({"n_pipeline_stages[" + std::to_string(i) + "]", 2, [=](model::config_t &c, unsigned int v){
+      c.n_pipeline_stages[i] = v ? std::max(stages, 1u) : 0; }});
+  }
+  // No flow control (worst-case FIFOs of the preset), or credits over 1- or 2-deep FIFOs
+  space.push_back({"fifo_depth", 3, [](model::config_t &c, unsigned int v){
+    c.flow_ctrl  = v > 0;
+    c.fifo_depth = v; }});
+  return space;
+}
+
+/* The number of CAM lines is meaningless for DM RFs: it is reset to the preset so that equivalent points share a hash */
+void canonicalize(model::config_t &cfg, const model::config_t &preset){
+  for (unsigned int p = 0; p < cfg.rf_type_1d.size(); p++){
+    if (cfg.rf_type_1d[p] == model::remote_rf_e::dm) cfg.n_remote_lines_1d[p] = preset.n_remote_lines_1d[p];
+    if (cfg.rf_type_2d[p] == model::remote_rf_e::dm) cfg.n_remote_lines_2d[p] = preset.n_remote_lines_2d[p];
+  }
+}
+
+std::vector<model::config_t> gen_points(const model::config_t &preset, const unsigned int n_points, const unsigned int seed){
+  const auto                   space = knobs(preset);
+  std::vector<model::config_t> points{preset};
+  std::set<std::uint64_t>      seen{model::config_hash(preset)};
+  const auto add = [&](model::config_t cfg){
+    canonicalize(cfg, preset);
+    if (seen.insert(model::config_hash(cfg)).second) points.push_back(cfg);
+  };
+
+  double size = 1.0;
+  for (const auto &knob : space) size *= knob.n_values;
+  if (size <= n_points){
+    std::vector<unsigned int> value(space.size(), 0);
+    for (;;){
+      model::config_t cfg = preset;
+      for (std::size_t k = 0; k < space.size(); k++) space[k].apply(cfg, value[k]);
+      add(cfg);
+      std::size_t k = 0;
+      while (k < space.size() && ++value[k] == space[k].n_values) value[k++] = 0;
+      if (k == space.size()) break;
+    }
+  } else {
+    std::mt19937 rng(seed);
+    for (unsigned int tries = 0; points.size() < n_points && tries < 64*n_points; tries++){
+      model::config_t cfg = preset;
+      for (const auto &knob : space) knob.apply(cfg, std::uniform_int_distribution<unsigned int>(0, knob.n_values-1)(rng));
+      add(cfg);
+    }
+  }
+  return points;
+}
+
+point_t evaluate(const model::config_t &cfg, const unsigned int iterations, const std::vector<model::trace_record_t> *trace){
+  point_t pt{};
+  pt.cfg         = cfg;
+  pt.config_hash = model::config_hash(cfg);
+  {
+    model::network net(cfg);
+    pt.area = net.area();
+  }
+
+  const unsigned int n_cu_x = cfg.n_cu_x;
+  std::uint64_t      sum = 0, samples = 0;
+  {
+    model::network net(cfg);
+    bfm_t          bfm(net, net.n_cu());
+    for (unsigned int t = 0; t < model::n_bfm_tests && !bfm.hung(); t++){
+      const auto reqs = model::bfm_test(t, n_cu_x);
+      for (unsigned int it = 0; it < iterations && !bfm.hung(); it++){
+        const auto lat = bfm.run(reqs);
+        for (unsigned int i = 0; i < net.n_cu(); i++){
+          if (!reqs[i].level || !lat[i]) continue;
+          sum            += lat[i]/bfm_t::clk_period;
+          pt.max_latency  = std::max<std::uint64_t>(pt.max_latency, lat[i]/bfm_t::clk_period);
+          samples++;
+        }
+      }
+    }
+    pt.latency = samples ? static_cast<double>(sum)/samples : 0.0;
+    pt.errors += bfm.errors();
+  }
+
+  if (!pt.errors){
+    double rate = 0.0;
+    for (unsigned int t = 0; t < model::n_bfm_tests; t++){
+      model::network net(cfg);
+      bfm_t          bfm(net, net.n_cu());
+      rate      += 1000.0*bfm.stream(model::bfm_test(t, n_cu_x), iterations).rounds_per_cycle();
+      pt.errors += bfm.errors();
+      if (bfm.hung()) break;
+    }
+    pt.rounds_per_kcycle = rate/model::n_bfm_tests;
+  }
+
+  if (trace && !pt.errors){
+    model::network net(cfg);
+    bfm_t          bfm(net, net.n_cu());
+    const auto     replayed = bfm.replay(*trace);
+    std::uint64_t  first = UINT64_MAX, last = 0;
+    sum = samples = 0;
+    for (const auto &r : replayed){
+      if (r.flags) continue;
+      sum  += r.wake - r.issue;
+      first = std::min<std::uint64_t>(first, r.issue);
+      last  = std::max<std::uint64_t>(last, r.wake);
+      samples++;
+    }
+    pt.trace_latency  = samples ? static_cast<double>(sum)/samples : 0.0;
+    pt.trace_makespan = samples ? last - first : 0;
+    pt.errors        += bfm.errors();
+  }
+  return pt;
+}
+
+/* Feasible points not dominated in (area, workload latency) */
+void pareto(std::vector<point_t> &points, const bool use_trace){
+  const auto latency = [use_trace](const point_t &p){ return use_trace ? p.trace_latency : p.latency; };
+  std::vector<point_t*> feasible;
+  for (auto &p : points)
+    if (p.feasible()) feasible.push_back(&p);
+  std::sort(feasible.begin(), feasible.end(), [&](const point_t *a, const point_t *b){
+    return (a->cost() != b->cost()) ? a->cost() < b->cost() : latency(*a) < latency(*b);
+  });
+  double best = 1e300;
+  for (auto *p : feasible){
+    if (latency(*p) < best){
+      p->pareto = true;
+      best      = latency(*p);
+    }
+  }
+}
+
+template <typename T>
+std::string join(const std::vector<T> &values){
+  std::string str;
+  for (std::size_t i = 0; i < values.size(); i++) str += (i ? "/" : "") + std::to_string(static_cast<unsigned int>(values[i]));
+  return str;
+}
+
+/* Knobs of a point: enum values as in fractal_sync_pkg, one entry per level separated by '/' */
+std::vector<std::pair<const char*, std::string>> describe(const model::config_t &c){
+  std::vector<bool> comb_1d(c.rx_fifo_comb_1d), comb_2d(c.rx_fifo_comb_2d);
+  return {{"rf_type_1d", join(c.rf_type_1d)}, {"rf_type_2d", join(c.rf_type_2d)},
+          {"arbiter_type_1d", join(c.arbiter_type_1d)}, {"arbiter_type_2d", join(c.arbiter_type_2d)},
+          {"n_local_regs_1d", join(c.n_local_regs_1d)}, {"n_local_regs_2d", join(c.n_local_regs_2d)},
+          {"n_remote_lines_1d", join(c.n_remote_lines_1d)}, {"n_remote_lines_2d", join(c.n_remote_lines_2d)},
+          {"fifo_comb_1d", join(comb_1d)}, {"fifo_comb_2d", join(comb_2d)},
+          {"n_links_itl", join(c.n_links_itl)}, {"n_pipeline_stages", join(c.n_pipeline_stages)},
+          {"flow_ctrl", std::to_string(c.flow_ctrl)}, {"fifo_depth", std::to_string(c.fifo_depth)}};
+}
+
+void print_csv(const std::vector<point_t> &points){
+  std::printf("point,config_hash,pareto,flops,cam_bits,area,latency,max_latency,rounds_per_kcycle,trace_latency,trace_makespan,errors");
+  for (const auto &[name, value] : describe(points[0].cfg)) std::printf(",%s", name);
+  std::printf("\n");
+  for (std::size_t i = 0; i < points.size(); i++){
+    const auto &p = points[i];
+    std::printf("%zu,%016llx,%d,%u,%u,%u,%.3f,%llu,%.3f,%.3f,%llu,%u", i, static_cast<unsigned long long>(p.config_hash), p.pareto, p.area.flops,
+                p.area.cam_bits, p.cost(), p.latency, static_cast<unsigned long long>(p.max_latency), p.rounds_per_kcycle, p.trace_latency,
+                static_cast<unsigned long long>(p.trace_makespan), p.errors);
+    for (const auto &[name, value] : describe(p.cfg)) std::printf(",%s", value.c_str());
+    std::printf("\n");
+  }
+}
+
+void print_json(const std::vector<point_t> &points){
+  std::printf("[\n");
+  for (std::size_t i = 0; i < points.size(); i++){
+    const auto &p = points[i];
+    std::printf("  {\"point\": %zu, \"config_hash\": \"%016llx\", \"pareto\": %s, \"area\": {\"flops\": %u, \"cam_bits\": %u, \"proxy\": %u}, "
+                "\"latency\": {\"mean\": %.3f, \"max\": %llu}, \"rounds_per_kcycle\": %.3f, \"trace\": {\"latency\": %.3f, \"makespan\": %llu}, "
+                "\"errors\": %u, \"config\": {", i, static_cast<unsigned long long>(p.config_hash), p.pareto ? "true" : "false", p.area.flops,
+                p.area.cam_bits, p.cost(), p.latency, static_cast<unsigned long long>(p.max_latency), p.rounds_per_kcycle, p.trace_latency,
+                static_cast<unsigned long long>(p.trace_makespan), p.errors);
+    const auto knob = describe(p.cfg);
+    for (std::size_t k = 0; k < knob.size(); k++) std::printf("%s\"%s\": \"%s\"", k ? ", " : "", knob[k].first, knob[k].second.c_str());
+    std::printf("}}%s\n", (i+1 < points.size()) ? "," : "");
+  }
+  std::printf("]\n");
+}
+
+int main(int argc, char *argv[]){
+  const bool         json       = (argc > 1) && !std::strcmp(argv[1], "json");
+  const unsigned int n_cu_x     = (argc > 2) ? std::atoi(argv[2]) : 4;
+  const unsigned int n_points   = (argc > 3) ? std::atoi(argv[3]) : 64;
+  const unsigned int iterations = (argc > 4) ? std::atoi(argv[4]) : 4;
+  const unsigned int seed       = (argc > 5) ? std::atoi(argv[5]) : 1;
+  const char        *trace_path = (argc > 6) ? argv[6] : nullptr;
+
+  try {
+    std::vector<model::trace_record_t> trace;
+    if (trace_path){
+      model::trace_header_t header;
+      trace = model::read_trace(trace_path, header);
+      if (header.n_cu_x != n_cu_x || header.n_cu_y != n_cu_x) throw std::runtime_error("Trace recorded on a different mesh");
+    }
+
+    std::vector<point_t> points;
+    for (const auto &cfg : gen_points(model::preset(n_cu_x), n_points, seed)) points.push_back(evaluate(cfg, iterations, trace_path ? &trace : nullptr));
+    pareto(points, trace_path != nullptr);
+    std::fprintf(stderr, "Evaluated %zu points: %zu feasible, %zu on the Pareto frontier\n", points.size(),
+                 static_cast<std::size_t>(std::count_if(points.begin(), points.end(), [](const point_t &p){ return p.feasible(); })),
+                 static_cast<std::size_t>(std::count_if(points.begin(), points.end(), [](const point_t &p){ return p.pareto; })));
+
+    if (json) print_json(points);
+    else      print_csv(points);
+    return points[0].feasible() ? EXIT_SUCCESS : EXIT_FAILURE;
+  } catch (const std::exception &e){
+    std::fprintf(stderr, "%s\n", e.what());
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,1234 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization cycle-accurate C++ model
+ */
+
+#include "fractal_sync_model.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace fractal_sync::model {
+
+namespace {
+
+unsigned int clog2(const unsigned int value){
+  unsigned int log = 0;
+  while ((1u << log) < value) log++;
+  return log;
+}
+
+unsigned int log2(unsigned int value){
+  unsigned int log = 0;
+  while (value >>= 1) log++;
+  return log;
+}
+
+unsigned int mask(const unsigned int width){
+  return (width >= 32) ? ~0u : (1u << width) - 1;
+}
+
+/* Request (sync, aggregate, id, credit) and response (wake, level, id, error, credit) bits of a node input */
+unsigned int req_bits(const node_cfg_t &cfg){
+  return 1 + cfg.aggregate_width + cfg.id_width + cfg.flow_ctrl;
+}
+
+unsigned int rsp_bits(const node_cfg_t &cfg){
+  return 1 + cfg.lvl_width + cfg.id_width + 1 + cfg.flow_ctrl;
+}
+
+/* LVL_SIG_LOOKUP of fractal_sync_1d_remote_rf (index 16 is the sentinel) */
+unsigned int lvl_sig(const unsigned int level){
+  unsigned int sig = 0;
+  for (unsigned int l = 1; l <= level; l++) sig += 1u << (2*((l-1)/2));
+  return sig;
+}
+
+} // namespace
+
+/*******************************************************/
+/**                      Presets                      **/
+/*******************************************************/
+
+config_t preset(const unsigned int n_cu_x){
+  config_t cfg{};
+  cfg.n_cu_x        = n_cu_x;
+  cfg.top_node_type = node_type_e::hv;
+  cfg.n_links_in    = 1;
+  cfg.n_links_out   = 1;
+  cfg.lvl_offset    = 0;
+
+  const unsigned int n_pairs = log2(n_cu_x);
+  if (n_cu_x < 2 || n_cu_x != (1u << n_pairs) || n_pairs > 15)
+    throw std::invalid_argument("Unsupported FractalSync tree: " + std::to_string(n_cu_x) + "x" + std::to_string(n_cu_x));
+
+  /* Same defaults as hw/trees (generated by sw/tools/fractal_sync_tree_gen.c from 8x8), p being the level pair:
+   * CAM RF at p = 0 (DM above, SA from 64x64), DM_ALT arbiters at p >= 2 from 16x16, 4^p (1D) and 2*4^p (2D) local
+   * registers, twice as many remote lines (at most 256 in SA RFs), links doubling every other level, 2^(p-1)-1
+   * pipeline stages at p >= 2 */
+  constexpr unsigned int max_sa_lines = 256;
+  for (unsigned int p = 0; p < n_pairs; p++){
+    const bool sa = (p > 0) && (n_cu_x >= 64);
+    cfg.rf_type_1d.push_back((p == 0) ? remote_rf_e::cam : sa ? remote_rf_e::sa : remote_rf_e::dm);
+    cfg.arbiter_type_1d.push_back((n_cu_x >= 16 && p >= 2) ? arb_e::dm_alt : arb_e::fa);
+    cfg.n_local_regs_1d.push_back(1u << 2*p);
+    cfg.n_remote_lines_1d.push_back(sa ? std::min(2u << 2*p, max_sa_lines) : 2u << 2*p);
+    cfg.n_local_regs_2d.push_back(2u << 2*p);
+    cfg.n_remote_lines_2d.push_back(sa ? std::min(4u << 2*p, max_sa_lines) : 4u << 2*p);
+    cfg.n_pipeline_stages.push_back((p < 2) ? 0 : (1u << (p-1)) - 1);
+    cfg.n_pipeline_stages.push_back(cfg.n_pipeline_stages.back());
+  }
+  for (unsigned int i = 0; i < 2*n_pairs - 1; i++) cfg.n_links_itl.push_back(1u << (i+1)/2);
+  cfg.rf_type_2d      = cfg.rf_type_1d;
+  cfg.arbiter_type_2d = cfg.arbiter_type_1d;
+
+  /* 8x8: combinational FIFO outputs on the first two levels only; 16x16 and larger: registered FIFO outputs */
+  std::vector<bool> comb(n_pairs, n_cu_x <= 4);
+  if (n_cu_x == 8) comb = {true, true, false};
+  cfg.rx_fifo_comb_1d     = comb;
+  cfg.tx_fifo_comb_1d     = comb;
+  cfg.local_fifo_comb_1d  = comb;
+  cfg.remote_fifo_comb_1d = comb;
+  cfg.rx_fifo_comb_2d     = comb;
+  cfg.tx_fifo_comb_2d     = comb;
+  cfg.local_fifo_comb_2d  = comb;
+  cfg.remote_fifo_comb_2d = comb;
+
+  cfg.aggregate_width = 2*n_pairs + 1;
+  cfg.lvl_width       = clog2(cfg.aggregate_width - 1);
+  cfg.id_width        = (n_cu_x == 2) ? 2 : 2*n_pairs - 1;
+  return cfg;
+}
+
+std::uint64_t config_hash(const config_t &cfg){
+  std::uint64_t hash = 0xcbf29ce484222325ull;
+  const auto add = [&hash](const unsigned int value){
+    for (unsigned int b = 0; b < 4; b++){
+      hash ^= (value >> (8*b)) & 0xff;
+      hash *= 0x100000001b3ull;
+    }
+  };
+  // Vector sizes are hashed too, so that the same values over a different number of levels differ
+  const auto add_vec = [&add](const auto &values){
+    add(static_cast<unsigned int>(values.size()));
+    for (const auto value : values) add(static_cast<unsigned int>(value));
+  };
+
+  add(cfg.n_cu_x);
+  add(static_cast<unsigned int>(cfg.top_node_type));
+  add_vec(cfg.rf_type_1d);
+  add_vec(cfg.arbiter_type_1d);
+  add_vec(cfg.n_local_regs_1d);
+  add_vec(cfg.n_remote_lines_1d);
+  add_vec(cfg.rx_fifo_comb_1d);
+  add_vec(cfg.tx_fifo_comb_1d);
+  add_vec(cfg.local_fifo_comb_1d);
+  add_vec(cfg.remote_fifo_comb_1d);
+  add_vec(cfg.rf_type_2d);
+  add_vec(cfg.arbiter_type_2d);
+  add_vec(cfg.n_local_regs_2d);
+  add_vec(cfg.n_remote_lines_2d);
+  add_vec(cfg.rx_fifo_comb_2d);
+  add_vec(cfg.tx_fifo_comb_2d);
+  add_vec(cfg.local_fifo_comb_2d);
+  add_vec(cfg.remote_fifo_comb_2d);
+  add(cfg.n_links_in);
+  add_vec(cfg.n_links_itl);
+  add(cfg.n_links_out);
+  add_vec(cfg.n_pipeline_stages);
+  add(cfg.aggregate_width);
+  add(cfg.lvl_width);
+  add(cfg.id_width);
+  add(cfg.lvl_offset);
+  // Hashed only when set, so that the hashes of the configurations without flow control are unchanged
+  if (cfg.flow_ctrl || cfg.fifo_depth){
+    add(cfg.flow_ctrl);
+    add(cfg.fifo_depth);
+  }
+  return hash;
+}
+
+/*******************************************************/
+/**                      Arbiter                      **/
+/*******************************************************/
+
+void arbiter::init(const arb_e type, const unsigned int in_ports, const unsigned int out_ports){
+  fa_.clear();
+  pp_ = type == arb_e::pp;
+  if (type == arb_e::fa || type == arb_e::pp){
+    fa_.resize(1);
+    for (unsigned int i = 0; i < in_ports; i++)  fa_[0].in.push_back(i);
+    for (unsigned int o = 0; o < out_ports; o++) fa_[0].out.push_back(o);
+  } else {
+    /* One single-output FA arbiter per output; ODD_MAPPING (DM_ALT) reverses the mapping of odd input rows */
+    fa_.resize(out_ports);
+    for (unsigned int o = 0; o < out_ports; o++) fa_[o].out.push_back(o);
+    for (unsigned int i = 0; i < in_ports; i++){
+      const unsigned int row = i/out_ports;
+      const unsigned int col = i%out_ports;
+      const unsigned int arb = (type == arb_e::dm_alt && (row & 1)) ? out_ports-1-col : col;
+      fa_[arb].in.push_back(i);
+    }
+  }
+  for (auto &fa : fa_){
+    fa.c_mask.assign(fa.in.size(), 1);
+    fa.n_mask.assign(fa.in.size(), 1);
+    fa.pending.assign(fa.in.size(), 0);
+    fa.gnt.assign(fa.in.size(), 0);
+    fa.rank.assign(fa.in.size(), 0);
+    fa.ready.assign(fa.out.size(), -1);
+  }
+}
+
+void arbiter::eval(const char *empty, int *sel, char *pop, const char *ready){
+  for (auto &fa : fa_){
+    const std::size_t n = fa.in.size();
+    bool clear = false;
+    for (std::size_t j = 0; j < n; j++){
+      fa.pending[j] = !empty[fa.in[j]];
+      fa.gnt[j]     = 0;
+    }
+    if (pp_){
+      /* The k-th ready output is granted the pending input of rank k (masked inputs first, in index order) */
+      unsigned int n_masked = 0, n_ready = 0, masked = 0, unmasked = 0;
+      for (std::size_t j = 0; j < n; j++) n_masked += fa.pending[j] && fa.c_mask[j];
+      for (const auto o : fa.out){
+        sel[o] = -1;
+        if (!ready || ready[o]) fa.ready[n_ready++] = static_cast<int>(o);
+      }
+      for (std::size_t j = 0; j < n; j++){
+        if (!fa.pending[j]) continue;
+        fa.rank[j] = fa.c_mask[j] ? masked++ : n_masked + unmasked++;
+        fa.gnt[j]  = fa.rank[j] < n_ready;
+        if (fa.gnt[j]) sel[fa.ready[fa.rank[j]]] = static_cast<int>(fa.in[j]);
+      }
+      clear = n_ready > n_masked;
+    } else for (const auto o : fa.out){
+      if (ready && !ready[o]){
+        sel[o] = -1;
+        continue;
+      }
+      int g = -1;
+      for (std::size_t j = 0; j < n; j++)
+        if (fa.pending[j] && fa.c_mask[j]){ g = static_cast<int>(j); break; }
+      if (g < 0){
+        clear = true;
+        for (std::size_t j = 0; j < n; j++)
+          if (fa.pending[j]){ g = static_cast<int>(j); break; }
+      }
+      if (g >= 0){
+        fa.pending[g] = 0;
+        fa.gnt[g]     = 1;
+        sel[o]        = static_cast<int>(fa.in[g]);
+      } else sel[o] = -1;
+    }
+    for (std::size_t j = 0; j < n; j++){
+      pop[fa.in[j]] = fa.gnt[j];
+      fa.n_mask[j]  = (fa.c_mask[j] && clear && fa.gnt[j]) || (!fa.gnt[j] && (fa.c_mask[j] || clear));
+    }
+  }
+}
+
+void arbiter::commit(){
+  for (auto &fa : fa_) fa.c_mask = fa.n_mask;
+}
+
+/*******************************************************/
+/**                 Local Register File               **/
+/*******************************************************/
+
+void local_rf::init(const unsigned int n_regs, const unsigned int id_width, const unsigned int n_ports){
+  n_regs_        = n_regs;
+  n_ports_       = n_ports;
+  local_id_mask_ = mask(id_width-1);
+  reg_idx_mask_  = mask(std::max(clog2(n_regs), 1u));
+  reg_q_.assign(n_regs, 0);
+  toggle_.assign(n_regs, 0);
+  touched_.clear();
+  active_.clear();
+  local_id_.assign(n_ports, 0);
+  ignore_.assign(n_ports, 0);
+}
+
+void local_rf::eval(const unsigned int *id, const char *check, char *present, char *id_err, char *bypass){
+  active_.clear();
+  for (unsigned int p = 0; p < n_ports_; p++){
+    present[p] = false;
+    id_err[p]  = false;
+    bypass[p]  = false;
+    ignore_[p] = 0;
+    if (check[p]) active_.push_back(p);
+  }
+  touched_.clear();
+  if (active_.empty()) return;
+
+  for (const auto p : active_){
+    local_id_[p] = (id[p] >> 1) & local_id_mask_;
+    id_err[p]    = local_id_[p] > n_regs_-1;
+  }
+  /* First checking port of a barrier is bypassed if another port checks the same barrier, the others are ignored */
+  for (std::size_t a = 0; a < active_.size(); a++){
+    const unsigned int p = active_[a];
+    if (local_id_[p] >= n_regs_) continue;
+    for (std::size_t b = 0; b < a; b++){
+      if (local_id_[active_[b]] == local_id_[p]){
+        ignore_[p]           = 1;
+        bypass[active_[b]]   = true;
+        break;
+      }
+    }
+  }
+  for (const auto p : active_){
+    const unsigned int idx = local_id_[p] & reg_idx_mask_;
+    if (!id_err[p]) present[p] = reg_q_[idx];
+    if (!(bypass[p] || ignore_[p]) && idx < n_regs_){
+      if (!toggle_[idx]) touched_.push_back(idx);
+      toggle_[idx] = 1;
+    }
+  }
+}
+
+void local_rf::commit(){
+  for (const auto idx : touched_){
+    reg_q_[idx]  = !reg_q_[idx];
+    toggle_[idx] = 0;
+  }
+  touched_.clear();
+}
+
+unsigned int local_rf::occupancy() const{
+  return static_cast<unsigned int>(std::count(reg_q_.begin(), reg_q_.end(), 1));
+}
+
+void local_rf::area(area_t &area) const{
+  area.flops += n_regs_;
+}
+
+/*******************************************************/
+/**                Remote Register File               **/
+/*******************************************************/
+
+void remote_rf::init(const bool enable, const remote_rf_e type, const unsigned int n_cam_lines, const unsigned int id_width, const unsigned int n_ports){
+  enable_        = enable;
+  type_          = type;
+  n_ports_       = n_ports;
+  n_dm_regs_     = ((1u << (id_width+2)) - 2)/3;
+  local_id_mask_ = mask(id_width-1);
+  sig_mask_      = mask(clog2(n_dm_regs_));
+  reg_idx_mask_  = mask(std::max(clog2(n_dm_regs_), 1u));
+  touched_.clear();
+  if (type == remote_rf_e::dm){
+    reg_q_.assign(n_dm_regs_, 0);
+    sd_q_.assign(n_dm_regs_, 0);
+    chk_reg_.assign(n_dm_regs_, 0);
+    set_reg_.assign(n_dm_regs_, 0);
+    sd_mask_.assign(n_dm_regs_, -1);
+  } else if (type == remote_rf_e::sa){
+    /* At most half as many sets as signatures: the extra lines become ways */
+    const unsigned int n_sets = std::min(n_cam_lines/std::max(std::min(sa_rf_ways, n_cam_lines), 1u), 1u << (clog2(n_dm_regs_)-1));
+    n_ways_   = n_sets ? n_cam_lines/n_sets : 0;
+    idx_bits_ = clog2(n_sets);
+    if (enable && (n_sets == 0 || n_sets*n_ways_ != n_cam_lines || (1u << idx_bits_) != n_sets))
+      throw std::invalid_argument("Unsupported FractalSync set-associative RF: " + std::to_string(n_cam_lines) + " lines");
+    n_set_lines_ = n_cam_lines;
+    lines_.assign(n_cam_lines + sa_rf_spill_lines, line_t{false, 0, 0});
+    sa_d_ = lines_;
+  } else {
+    lines_.assign(n_cam_lines, line_t{false, 0, 0});
+    write_.assign(n_cam_lines, 0);
+    free_.assign(n_cam_lines, 0);
+    update_.assign(n_cam_lines, 0);
+    w_idx_.assign(n_cam_lines, 0);
+    sd_d_.assign(n_cam_lines, 0);
+  }
+  active_.clear();
+  local_id_.assign(n_ports, 0);
+  local_sig_.assign(n_ports, 0);
+  valid_.assign(n_ports, 0);
+  ignore_.assign(n_ports, 0);
+  check_rf_.assign(n_ports, 0);
+  set_rf_.assign(n_ports, 0);
+  sd_rf_.assign(n_ports, 0);
+  store_.assign(n_ports, 0);
+  set_.assign(n_ports, 0);
+}
+
+void remote_rf::eval(const unsigned int *level, const unsigned int *id, const unsigned int *sd, const char *check, const char *set,
+                     char *present, unsigned int *sd_o, char *sig_err, char *bypass){
+  active_.clear();
+  for (unsigned int p = 0; p < n_ports_; p++){
+    present[p] = false;
+    sd_o[p]    = 0;
+    sig_err[p] = false;
+    bypass[p]  = false;
+    ignore_[p] = 0;
+    if (enable_ && (check[p] || set[p])) active_.push_back(p);
+  }
+  touched_.clear();
+  if (active_.empty()) return;
+
+  for (const auto p : active_){
+    const unsigned int sig = lvl_sig(level[p]) + ((id[p] >> 1) & local_id_mask_);
+    local_id_[p]  = (id[p] >> 1) & local_id_mask_;
+    local_sig_[p] = sig & sig_mask_;
+    valid_[p]     = sig <= n_dm_regs_-1 && sig < lvl_sig(level[p]+1);
+    sig_err[p]    = !valid_[p];
+  }
+  for (std::size_t a = 0; a < active_.size(); a++){
+    const unsigned int p = active_[a];
+    for (std::size_t b = 0; b < a; b++){
+      if (local_id_[active_[b]] == local_id_[p]){
+        ignore_[p]         = 1;
+        bypass[active_[b]] = true;
+        break;
+      }
+    }
+  }
+  for (const auto p : active_){
+    sd_rf_[p]    = (bypass[p] || ignore_[p]) ? sd_both : sd[p];
+    check_rf_[p] = !(bypass[p] || ignore_[p]) && check[p];
+    set_rf_[p]   = !ignore_[p] && set[p];
+  }
+
+  if (type_ == remote_rf_e::dm){
+    for (const auto p : active_){
+      const unsigned int idx = local_sig_[p] & reg_idx_mask_;
+      if (idx >= n_dm_regs_) continue;
+      present[p] = valid_[p] && reg_q_[idx];
+      sd_o[p]    = present[p] ? sd_q_[idx] : 0;
+      if (check_rf_[p] || set_rf_[p]){
+        if (sd_mask_[idx] < 0) touched_.push_back(idx);
+        chk_reg_[idx] |= check_rf_[p];
+        set_reg_[idx] |= set_rf_[p];
+        sd_mask_[idx]  = static_cast<int>(sd_rf_[p]);
+      }
+    }
+    return;
+  }
+
+  if (type_ == remote_rf_e::sa){
+    /* SA: look-up in the ways of the set and in the spill lines, free or update the hit lines */
+    const unsigned int n_lines = static_cast<unsigned int>(lines_.size());
+    const auto hit = [&](const unsigned int p, const unsigned int l){
+      if (!lines_[l].full || lines_[l].sig != local_sig_[p]) return;
+      present[p] = true;
+      sd_o[p]    = lines_[l].sd;
+      store_[p]  = 0;
+      if (check_rf_[p]){
+        sa_d_[l].full = false;
+        sa_d_[l].sd   = 0;
+      } else if (set_rf_[p]) sa_d_[l].sd = lines_[l].sd | sd_rf_[p];
+      touched_.push_back(l);
+    };
+    for (const auto p : active_){
+      store_[p] = (check_rf_[p] || set_rf_[p]) && valid_[p];
+      set_[p]   = (local_sig_[p] ^ (local_sig_[p] >> idx_bits_)) & mask(idx_bits_);
+      if (!valid_[p]) continue;
+      for (unsigned int w = 0; w < n_ways_; w++) hit(p, set_[p]*n_ways_ + w);
+      for (unsigned int l = n_set_lines_; l < n_lines; l++) hit(p, l);
+    }
+    /* SA: store the missing signatures in a free way of their set, then in a free spill line */
+    const auto store = [&](const unsigned int p, const unsigned int l){
+      if (!store_[p] || sa_d_[l].full) return;
+      sa_d_[l] = line_t{true, local_sig_[p], sd_rf_[p]};
+      store_[p] = 0;
+      touched_.push_back(l);
+    };
+    for (const auto p : active_){
+      for (unsigned int w = 0; w < n_ways_; w++) store(p, set_[p]*n_ways_ + w);
+      for (unsigned int l = n_set_lines_; l < n_lines; l++) store(p, l);
+    }
+    return;
+  }
+
+  /* CAM: look-up */
+  const std::size_t n_lines = lines_.size();
+  for (const auto i : active_){
+    store_[i] = check_rf_[i] || set_rf_[i];
+    if (!valid_[i]) continue;
+    for (std::size_t j = 0; j < n_lines; j++){
+      if (!lines_[j].full || lines_[j].sig != local_sig_[i]) continue;
+      present[i] = true;
+      sd_o[i]    = lines_[j].sd;
+      if (check_rf_[i]){
+        free_[j]  = 1;
+        store_[i] = 0;
+      } else if (set_rf_[i]){
+        update_[j] = 1;
+        store_[i]  = 0;
+      }
+    }
+  }
+  /* CAM: write/update */
+  for (std::size_t l = 0; l < n_lines; l++){
+    sd_d_[l] = lines_[l].sd;
+    for (const auto j : active_){
+      if (!valid_[j]) continue;
+      if (store_[j] && (!lines_[l].full || free_[l])){
+        write_[l] = 1;
+        w_idx_[l] = j;
+        store_[j] = 0;
+        sd_d_[l]  = sd_rf_[j];
+        break;
+      } else if (update_[l] && lines_[l].full && lines_[l].sig == local_sig_[j] && set_rf_[j]){
+        sd_d_[l] = lines_[l].sd | sd_rf_[j];
+        break;
+      }
+    }
+    if (write_[l] || free_[l] || update_[l]) touched_.push_back(static_cast<unsigned int>(l));
+  }
+}
+
+void remote_rf::commit(){
+  if (type_ == remote_rf_e::dm){
+    for (const auto idx : touched_){
+      /* A cleared register forgets its back-routing ports */
+      sd_q_[idx]    = (chk_reg_[idx] && reg_q_[idx]) ? 0 : sd_q_[idx] | static_cast<unsigned int>(sd_mask_[idx]);
+      if      (chk_reg_[idx]) reg_q_[idx] = !reg_q_[idx];
+      else if (set_reg_[idx]) reg_q_[idx] = 1;
+      chk_reg_[idx] = 0;
+      set_reg_[idx] = 0;
+      sd_mask_[idx] = -1;
+    }
+  } else if (type_ == remote_rf_e::sa){
+    for (const auto l : touched_) lines_[l] = sa_d_[l];
+  } else {
+    for (const auto l : touched_){
+      line_t &line = lines_[l];
+      if      (write_[l]) line.full = true;
+      else if (free_[l])  line.full = false;
+      if (write_[l]) line.sig = local_sig_[w_idx_[l]];
+      line.sd   = (free_[l] && !write_[l]) ? 0 : sd_d_[l];
+      write_[l]  = 0;
+      free_[l]   = 0;
+      update_[l] = 0;
+    }
+  }
+  touched_.clear();
+}
+
+unsigned int remote_rf::occupancy() const{
+  if (!enable_) return 0;
+  if (type_ == remote_rf_e::dm) return static_cast<unsigned int>(std::count(reg_q_.begin(), reg_q_.end(), 1));
+  return static_cast<unsigned int>(std::count_if(lines_.begin(), lines_.end(), [](const line_t &line){ return line.full; }));
+}
+
+/* DM: present and SD bits of every register; CAM: full and SD bits plus the signature of every line; SA: full and SD
+ * bits of every line, the tags of the set lines (compared only within a set) and the signatures of the spill lines */
+void remote_rf::area(area_t &area) const{
+  if (!enable_) return;
+  if (type_ == remote_rf_e::dm){
+    area.flops += 3*n_dm_regs_;
+    return;
+  }
+  if (type_ == remote_rf_e::sa){
+    const unsigned int n_spill = static_cast<unsigned int>(lines_.size()) - n_set_lines_;
+    area.flops    += 3*static_cast<unsigned int>(lines_.size()) + n_set_lines_*(clog2(n_dm_regs_) - idx_bits_);
+    area.cam_bits += n_spill*clog2(n_dm_regs_);
+    return;
+  }
+  const unsigned int n_lines = static_cast<unsigned int>(lines_.size());
+  area.flops    += 3*n_lines;
+  area.cam_bits += n_lines*clog2(n_dm_regs_);
+}
+
+/*******************************************************/
+/**                      1D Node                      **/
+/*******************************************************/
+
+node_1d::node_1d(const node_cfg_t &cfg) : cfg_(cfg){
+  const unsigned int in    = cfg.in_ports;
+  const unsigned int out   = cfg.out_ports;
+  const unsigned int ports = in + out;
+  if (in == 0 || out == 0 || (in & 1))
+    throw std::invalid_argument("Unsupported FractalSync 1D node: " + std::to_string(in) + " inputs, " + std::to_string(out) + " outputs");
+
+  level_mask_ = mask(clog2(cfg.id_width+1));
+  lvl_mask_   = mask(cfg.lvl_width);
+  aggr_mask_  = mask(cfg.aggregate_width);
+  id_mask_    = mask(cfg.id_width);
+
+  req_in.assign(in, nullptr);
+  rsp_in.assign(in, rsp_t{});
+  req_out.assign(out, req_t{});
+  rsp_out.assign(out, nullptr);
+
+  rx_sync_.assign(in, 0);
+  rx_req_.assign(in, req_t{});
+  rx_fifo_.resize(in);
+  local_fifo_.resize(in);
+  remote_fifo_.resize(in);
+  for (unsigned int i = 0; i < in; i++){
+    rx_fifo_[i].init(cfg.fifo_depth, cfg.rx_fifo_comb_out);
+    local_fifo_[i].init(cfg.fifo_depth, cfg.local_fifo_comb_out);
+    remote_fifo_[i].init(cfg.fifo_depth, cfg.remote_fifo_comb_out);
+  }
+  local_pop_q_.assign(in, 0);
+  tx_wake_.assign(out, 0);
+  tx_rsp_.assign(out, rsp_t{});
+  en_fifo_.resize(out);
+  ws_fifo_.resize(out);
+  for (unsigned int t = 0; t < out; t++){
+    en_fifo_[t].init(cfg.fifo_depth, cfg.tx_fifo_comb_out);
+    ws_fifo_[t].init(cfg.fifo_depth, cfg.tx_fifo_comb_out);
+  }
+  req_arb_.init(cfg.arbiter_type, 2*in, out);
+  en_arb_.init(cfg.arbiter_type, in+out, in/2);
+  ws_arb_.init(cfg.arbiter_type, in+out, in/2);
+  local_rf_.init(cfg.n_local_regs, cfg.id_width, in);
+  remote_rf_.init(cfg.node_type != node_type_e::rt, cfg.rf_type, cfg.n_remote_lines, cfg.id_width, ports);
+  rx_owed_.assign(in, cfg.fifo_depth);
+  tx_owed_.assign(out, cfg.fifo_depth);
+  en_cnt_.assign(out, 0);
+  ws_cnt_.assign(out, 0);
+  req_credits_.assign(out, 0);
+  rsp_credits_.assign(in, 0);
+  credit_busy_ = cfg.flow_ctrl;
+
+  level_.assign(ports, 0);
+  id_.assign(ports, 0);
+  sd_in_.assign(ports, 0);
+  sd_out_.assign(ports, 0);
+  check_local_.assign(in, 0);
+  check_remote_.assign(ports, 0);
+  set_remote_.assign(ports, 0);
+  present_local_.assign(in, 0);
+  present_remote_.assign(ports, 0);
+  id_err_.assign(in, 0);
+  sig_err_.assign(ports, 0);
+  bypass_local_.assign(in, 0);
+  bypass_remote_.assign(ports, 0);
+  rx_push_.assign(in, 0);
+  local_push_.assign(in, 0);
+  remote_push_.assign(in, 0);
+  en_push_.assign(out, 0);
+  ws_push_.assign(out, 0);
+  req_empty_.assign(2*in, 0);
+  req_pop_.assign(2*in, 0);
+  en_empty_.assign(ports, 0);
+  en_pop_.assign(ports, 0);
+  ws_empty_.assign(ports, 0);
+  ws_pop_.assign(ports, 0);
+  local_pop_.assign(in, 0);
+  rx_elem_.assign(in, req_t{});
+  local_elem_.assign(in, rsp_t{});
+  req_sel_.assign(out, -1);
+  en_sel_.assign(in/2, -1);
+  ws_sel_.assign(in/2, -1);
+  local_pop_d_.assign(in, 0);
+  req_ready_.assign(out, 1);
+  en_ready_.assign(in/2, 1);
+  ws_ready_.assign(in/2, 1);
+}
+
+bool node_1d::fifo_busy() const{
+  for (unsigned int i = 0; i < cfg_.in_ports; i++)
+    if (!rx_fifo_[i].empty_fifo() || !local_fifo_[i].empty_fifo() || !remote_fifo_[i].empty_fifo()) return true;
+  for (unsigned int t = 0; t < cfg_.out_ports; t++)
+    if (!en_fifo_[t].empty_fifo() || !ws_fifo_[t].empty_fifo()) return true;
+  return false;
+}
+
+void node_1d::eval(){
+  /* An idle node that already evaluated one idle cycle has zero outputs and reset arbiter masks: nothing changes */
+  busy_ = input_busy_ || fifo_busy_ || credit_busy_;
+  if (quiet_ && !busy_) return;
+
+  const unsigned int in  = cfg_.in_ports;
+  const unsigned int out = cfg_.out_ports;
+
+  /* RX */
+  for (unsigned int i = 0; i < in; i++){
+    const req_t &req = rx_req_[i];
+    const bool check = rx_sync_[i];
+    const bool local = check && (req.aggr & 1);
+    const bool root  = req.aggr == 1;
+    unsigned int level = 0;
+    for (unsigned int b = cfg_.aggregate_width; b-- > 0;)
+      if ((req.aggr >> b) & 1){ level = b + cfg_.lvl_offset; break; }
+    rx_push_[i]     = check && !(req.aggr & 1);
+    rx_elem_[i]     = req_t{req.sync, req.aggr >> 1, req.id, false};
+    level_[i]       = level & level_mask_;
+    id_[i]          = req.id;
+    sd_in_[i]       = (i & 1) ? sd_west_south : sd_east_north;
+    check_local_[i] = local && root;
+    set_remote_[i]  = check && !(local && root);
+    check_remote_[i] = false;
+  }
+  /* TX */
+  for (unsigned int t = 0; t < out; t++){
+    const unsigned int p = in + t;
+    level_[p]        = tx_rsp_[t].lvl & level_mask_;
+    id_[p]           = tx_rsp_[t].id;
+    sd_in_[p]        = 0;
+    check_remote_[p] = tx_wake_[t];
+    set_remote_[p]   = false;
+  }
+
+  /* CC */
+  local_rf_.eval(id_.data(), check_local_.data(), present_local_.data(), id_err_.data(), bypass_local_.data());
+  remote_rf_.eval(level_.data(), id_.data(), sd_in_.data(), check_remote_.data(), set_remote_.data(),
+                  present_remote_.data(), sd_out_.data(), sig_err_.data(), bypass_remote_.data());
+  for (unsigned int i = 0; i < in; i++){
+    const bool rf_err = id_err_[i] || sig_err_[i];
+    const bool local  = rx_sync_[i] && (rx_req_[i].aggr & 1);
+    local_push_[i]  = false;
+    remote_push_[i] = false;
+    if (local){
+      if (rx_req_[i].aggr != 1){
+        remote_push_[i] = (bypass_remote_[i] || present_remote_[i]) && !rf_err;
+        local_push_[i]  = rf_err;
+      } else local_push_[i] = bypass_local_[i] || present_local_[i] || rf_err;
+    }
+    local_elem_[i] = rsp_t{true, level_[i] & lvl_mask_, id_[i], rf_err, false};
+  }
+  for (unsigned int t = 0; t < out; t++){
+    const unsigned int p  = in + t;
+    const unsigned int sd = (tx_wake_[t] && !sig_err_[p]) ? sd_out_[p] : 0;
+    en_push_[t] = tx_wake_[t] && (sd & sd_east_north);
+    ws_push_[t] = tx_wake_[t] && (sd & sd_west_south);
+  }
+
+  /* Arbiters */
+  for (unsigned int i = 0; i < in; i++){
+    req_empty_[i]    = remote_fifo_[i].empty(remote_push_[i]);
+    req_empty_[in+i] = rx_fifo_[i].empty(rx_push_[i]);
+    en_empty_[i]     = local_fifo_[i].empty(local_push_[i]);
+    ws_empty_[i]     = en_empty_[i];
+  }
+  for (unsigned int t = 0; t < out; t++){
+    en_empty_[in+t] = en_fifo_[t].empty(en_push_[t]);
+    ws_empty_[in+t] = ws_fifo_[t].empty(ws_push_[t]);
+  }
+  /* Without credits for a link the arbiter output is not granted */
+  if (cfg_.flow_ctrl){
+    for (unsigned int o = 0; o < out; o++) req_ready_[o] = req_credits_[o] > 0;
+    for (unsigned int o = 0; o < in/2; o++){
+      en_ready_[o] = rsp_credits_[2*o] > 0;
+      ws_ready_[o] = rsp_credits_[2*o+1] > 0;
+    }
+  }
+  req_arb_.eval(req_empty_.data(), req_sel_.data(), req_pop_.data(), req_ready_.data());
+  en_arb_.eval(en_empty_.data(), en_sel_.data(), en_pop_.data(), en_ready_.data());
+  ws_arb_.eval(ws_empty_.data(), ws_sel_.data(), ws_pop_.data(), ws_ready_.data());
+
+  for (unsigned int o = 0; o < out; o++){
+    const int s = req_sel_[o];
+    if      (s < 0)                          req_out[o] = req_t{};
+    else if (s < static_cast<int>(in))       req_out[o] = remote_fifo_[s].element(remote_push_[s], rx_elem_[s]);
+    else                                     req_out[o] = rx_fifo_[s-in].element(rx_push_[s-in], rx_elem_[s-in]);
+  }
+  auto rsp_element = [&](const int s, fifo<rsp_t> *tx_fifo, const char *tx_push) -> rsp_t{
+    if (s < 0) return rsp_t{};
+    if (s < static_cast<int>(in)) return local_fifo_[s].element(local_push_[s], local_elem_[s]);
+    return tx_fifo[s-in].element(tx_push[s-in], tx_rsp_[s-in]);
+  };
+  for (unsigned int o = 0; o < in/2; o++){
+    rsp_in[2*o]   = rsp_element(en_sel_[o], en_fifo_.data(), en_push_.data());
+    rsp_in[2*o+1] = rsp_element(ws_sel_[o], ws_fifo_.data(), ws_push_.data());
+  }
+  for (unsigned int o = 0; o < out; o++) req_out[o].credit = tx_owed_[o] > 0;
+  for (unsigned int i = 0; i < in; i++)  rsp_in[i].credit  = rx_owed_[i] > 0;
+
+  /* A local response is popped once it has been sent through both the EN and WS channels */
+  for (unsigned int i = 0; i < in; i++){
+    local_pop_d_[i] = local_pop_q_[i] | (ws_pop_[i] ? 2 : 0) | (en_pop_[i] ? 1 : 0);
+    local_pop_[i]   = local_pop_d_[i] == 3;
+  }
+}
+
+void node_1d::tick(){
+  const unsigned int in  = cfg_.in_ports;
+  const unsigned int out = cfg_.out_ports;
+
+  if (!(quiet_ && !busy_)){
+    for (unsigned int i = 0; i < in; i++){
+      rx_fifo_[i].commit(rx_push_[i], rx_elem_[i], req_pop_[in+i]);
+      remote_fifo_[i].commit(remote_push_[i], rx_elem_[i], req_pop_[i]);
+      local_fifo_[i].commit(local_push_[i], local_elem_[i], local_pop_[i]);
+      local_pop_q_[i] = local_pop_[i] ? 0 : local_pop_d_[i];
+    }
+    for (unsigned int t = 0; t < out; t++){
+      en_fifo_[t].commit(en_push_[t], tx_rsp_[t], en_pop_[in+t]);
+      ws_fifo_[t].commit(ws_push_[t], tx_rsp_[t], ws_pop_[in+t]);
+    }
+    req_arb_.commit();
+    en_arb_.commit();
+    ws_arb_.commit();
+    local_rf_.commit();
+    remote_rf_.commit();
+    if (cfg_.flow_ctrl) credit_busy_ = credit_commit();
+    fifo_busy_ = fifo_busy();
+    quiet_     = !busy_;
+  }
+
+  /* FIFOs of a quiet node do not change: only the sampled inputs can wake it up */
+  input_busy_ = false;
+  for (unsigned int i = 0; i < in; i++){
+    rx_sync_[i]  = req_in[i]->sync;
+    input_busy_ |= rx_sync_[i];
+    if (rx_sync_[i]) rx_req_[i] = req_t{true, req_in[i]->aggr & aggr_mask_, req_in[i]->id & id_mask_, false};
+  }
+  for (unsigned int t = 0; t < out; t++){
+    tx_wake_[t]  = rsp_out[t]->wake;
+    input_busy_ |= tx_wake_[t];
+    if (tx_wake_[t]) tx_rsp_[t] = *rsp_out[t];
+  }
+}
+
+/* Owed credits of the RX (stored requests of the port) and TX (fuller of the EN/WS FIFOs) and credit counters of the
+ * links: the node stays busy while it owes credits or misses some (an idle link holds FIFO_DEPTH credits) */
+bool node_1d::credit_commit(){
+  const unsigned int in    = cfg_.in_ports;
+  const unsigned int out   = cfg_.out_ports;
+  const unsigned int depth = cfg_.fifo_depth;
+  const auto receive = [depth](unsigned int &credits, const bool send, const bool credit){
+    credits -= send;
+    if (credit && credits < depth) credits++;
+    return credits < depth;
+  };
+  bool busy = false;
+  for (unsigned int i = 0; i < in; i++){
+    const bool returned = rx_sync_[i] && !rx_push_[i] && !local_push_[i] && !remote_push_[i];
+    rx_owed_[i] += returned + req_pop_[in+i] + local_pop_[i] + req_pop_[i] - rsp_in[i].credit;
+    busy |= rx_owed_[i] > 0;
+    busy |= receive(rsp_credits_[i], rsp_in[i].wake, req_in[i]->credit);
+  }
+  for (unsigned int t = 0; t < out; t++){
+    const unsigned int c_max = std::max(en_cnt_[t], ws_cnt_[t]);
+    en_cnt_[t] += en_push_[t] - en_pop_[in+t];
+    ws_cnt_[t] += ws_push_[t] - ws_pop_[in+t];
+    tx_owed_[t] += tx_wake_[t] + c_max - std::max(en_cnt_[t], ws_cnt_[t]) - req_out[t].credit;
+    busy |= tx_owed_[t] > 0;
+    busy |= receive(req_credits_[t], req_out[t].sync, rsp_out[t]->credit);
+  }
+  return busy;
+}
+
+void node_1d::occupancy(occupancy_t &occ) const{
+  const auto add = [&occ](const unsigned int size){
+    occ.fifo_entries += size;
+    occ.fifo_peak     = std::max(occ.fifo_peak, size);
+  };
+  for (unsigned int i = 0; i < cfg_.in_ports; i++){
+    add(rx_fifo_[i].size());
+    add(local_fifo_[i].size());
+    add(remote_fifo_[i].size());
+  }
+  for (unsigned int t = 0; t < cfg_.out_ports; t++){
+    add(en_fifo_[t].size());
+    add(ws_fifo_[t].size());
+  }
+  const unsigned int remote = remote_rf_.occupancy();
+  occ.local_regs  += local_rf_.occupancy();
+  occ.remote_regs += remote;
+  if (remote_rf_.cam()) occ.cam_peak = std::max(occ.cam_peak, remote);
+}
+
+/* Input registers, RX/remote (requests) and local (responses) FIFOs, TX registers, EN/WS FIFOs, arbiter masks, RFs and
+ * credit counters */
+void node_1d::area(area_t &area) const{
+  const unsigned int req   = req_bits(cfg_);
+  const unsigned int rsp   = rsp_bits(cfg_);
+  const unsigned int depth = cfg_.fifo_depth;
+  const unsigned int ptrs  = 2*(clog2(depth) + 1);
+  const unsigned int in    = cfg_.in_ports;
+  const unsigned int out   = cfg_.out_ports;
+  area.flops += in*(req + depth*(2*req + rsp) + 3*ptrs + 1);
+  area.flops += out*(rsp + 2*(depth*rsp + ptrs));
+  area.flops += 2*in + 2*(in + out);
+  if (cfg_.flow_ctrl) area.flops += (2*in + 4*out)*clog2(depth+1);
+  local_rf_.area(area);
+  remote_rf_.area(area);
+}
+
+/*******************************************************/
+/**                      2D Node                      **/
+/*******************************************************/
+
+node_2d::node_2d(const node_cfg_t &cfg) : h(half(cfg)), v(half(cfg)) {}
+
+node_cfg_t node_2d::half(const node_cfg_t &cfg){
+  node_cfg_t h_cfg      = cfg;
+  h_cfg.n_local_regs    = std::max(cfg.n_local_regs/2, 1u);
+  h_cfg.n_remote_lines  = std::max(cfg.n_remote_lines/2, 1u);
+  h_cfg.in_ports        = cfg.in_ports/2;
+  h_cfg.out_ports       = cfg.out_ports/2;
+  return h_cfg;
+}
+
+/*******************************************************/
+/**                Pipeline and Neighbor              **/
+/*******************************************************/
+
+pipeline::pipeline(const unsigned int n_stages, const unsigned int stage_bits)
+  : n_stages_(n_stages), stage_bits_(stage_bits), req_(n_stages, req_t{}), rsp_(n_stages, rsp_t{}) {}
+
+void pipeline::tick(){
+  for (unsigned int s = n_stages_-1; s > 0; s--){
+    req_[s]   = req_[s-1];
+    rsp_[s-1] = rsp_[s];
+  }
+  req_[0]           = *req_d;
+  rsp_[n_stages_-1] = *rsp_d;
+}
+
+void nbr_node::eval(){
+  const bool wake = present_q_[0] && present_q_[1];
+  const bool same = id_q_[0] == id_q_[1];
+  for (auto &rsp : rsp_out) rsp = rsp_t{wake, 1, (wake && same) ? id_q_[0] : 0, !(wake && same), false};
+}
+
+void nbr_node::tick(){
+  if (present_q_[0] && present_q_[1]){
+    for (unsigned int i = 0; i < 2; i++){
+      present_q_[i] = false;
+      id_q_[i]      = 0;
+    }
+    return;
+  }
+  for (unsigned int i = 0; i < 2; i++){
+    present_q_[i] |= req_in[i]->sync;
+    if (req_in[i]->sync) id_q_[i] = req_in[i]->id & 3;
+  }
+}
+
+/*******************************************************/
+/**                      Network                      **/
+/*******************************************************/
+
+network::network(const config_t &cfg) : cfg_(cfg){
+  const unsigned int n_cu_x = cfg.n_cu_x;
+  if (n_cu_x < 2 || (n_cu_x & (n_cu_x-1)))
+    throw std::invalid_argument("FractalSync meshes are square powers of two");
+  n_cu_    = n_cu_x*n_cu_x;
+  n_pairs_ = log2(n_cu_x);
+  if (cfg.n_links_itl.size() != 2*n_pairs_-1 || cfg.n_pipeline_stages.size() != 2*n_pairs_ ||
+      cfg.rf_type_1d.size() != n_pairs_ || cfg.rf_type_2d.size() != n_pairs_)
+    throw std::invalid_argument("Inconsistent FractalSync network configuration");
+
+  h_tree_req_.assign(n_cu_, idle_req_);
+  v_tree_req_.assign(n_cu_, idle_req_);
+  h_nbr_req_.assign(n_cu_, idle_req_);
+  v_nbr_req_.assign(n_cu_, idle_req_);
+  h_tree_rsp_.assign(n_cu_, &zero_rsp_);
+  v_tree_rsp_.assign(n_cu_, &zero_rsp_);
+  h_nbr_rsp_.assign(n_cu_, &zero_rsp_);
+  v_nbr_rsp_.assign(n_cu_, &zero_rsp_);
+
+  core_t core = build_core(n_cu_x, 0);
+  const unsigned int l_in = cfg.n_links_in;
+  for (unsigned int cu = 0; cu < n_cu_; cu++){
+    for (unsigned int l = 0; l < l_in; l++){
+      *core.h_in[cu*l_in + l].req = (l == 0) ? &h_tree_req_[cu] : &idle_req_;
+      *core.v_in[cu*l_in + l].req = (l == 0) ? &v_tree_req_[cu] : &idle_req_;
+    }
+    h_tree_rsp_[cu] = core.h_in[cu*l_in].rsp;
+    v_tree_rsp_[cu] = core.v_in[cu*l_in].rsp;
+  }
+  for (auto &port : core.h_out) *port.rsp = &idle_rsp_;
+  for (auto &port : core.v_out) *port.rsp = &idle_rsp_;
+
+  build_nbr();
+}
+
+unsigned int network::links_in(const unsigned int pair) const{
+  return (pair == 0) ? cfg_.n_links_in : cfg_.n_links_itl[2*pair-1];
+}
+
+unsigned int network::links_itl(const unsigned int pair) const{
+  return cfg_.n_links_itl[2*pair];
+}
+
+unsigned int network::links_out(const unsigned int pair) const{
+  return (pair == n_pairs_-1) ? cfg_.n_links_out : cfg_.n_links_itl[2*pair+1];
+}
+
+network::in_port_t network::pipe(const in_port_t consumer, const unsigned int n_stages, const node_cfg_t &cfg){
+  if (n_stages == 0) return consumer;
+  pipeline &ppl = pipelines_.emplace_back(n_stages, req_bits(cfg) + rsp_bits(cfg));
+  *consumer.req = &ppl.req_q();
+  ppl.rsp_d     = consumer.rsp;
+  return in_port_t{&ppl.req_d, &ppl.rsp_q()};
+}
+
+void network::connect(const out_port_t &producer, const in_port_t &consumer){
+  *consumer.req = producer.req;
+  *producer.rsp = consumer.rsp;
+}
+
+/* Same as fractal_sync_2x2_core: four 1D nodes (two H, two V) feeding a 2D node */
+network::core_t network::build_2x2(const unsigned int pair){
+  const unsigned int l_in  = links_in(pair);
+  const unsigned int l     = links_itl(pair);
+  const unsigned int l_out = links_out(pair);
+
+  node_cfg_t cfg_1d{};
+  cfg_1d.rf_type              = cfg_.rf_type_1d[pair];
+  cfg_1d.arbiter_type         = cfg_.arbiter_type_1d[pair];
+  cfg_1d.n_local_regs         = cfg_.n_local_regs_1d[pair];
+  cfg_1d.n_remote_lines       = cfg_.n_remote_lines_1d[pair];
+  cfg_1d.aggregate_width      = cfg_.aggregate_width - 2*pair;
+  cfg_1d.id_width             = cfg_.id_width;
+  cfg_1d.lvl_width            = cfg_.lvl_width;
+  cfg_1d.lvl_offset           = cfg_.lvl_offset + 2*pair;
+  cfg_1d.fifo_depth           = cfg_.fifo_depth ? cfg_.fifo_depth : std::max(l/l_in, 1u);
+  cfg_1d.rx_fifo_comb_out     = cfg_.rx_fifo_comb_1d[pair];
+  cfg_1d.tx_fifo_comb_out     = cfg_.tx_fifo_comb_1d[pair];
+  cfg_1d.local_fifo_comb_out  = cfg_.local_fifo_comb_1d[pair];
+  cfg_1d.remote_fifo_comb_out = cfg_.remote_fifo_comb_1d[pair];
+  cfg_1d.in_ports             = 2*l_in;
+  cfg_1d.out_ports            = l;
+  cfg_1d.flow_ctrl            = cfg_.flow_ctrl;
+
+  node_cfg_t cfg_2d{};
+  cfg_2d.node_type            = (pair == n_pairs_-1) ? cfg_.top_node_type : node_type_e::hv;
+  cfg_2d.rf_type              = cfg_.rf_type_2d[pair];
+  cfg_2d.arbiter_type         = cfg_.arbiter_type_2d[pair];
+  cfg_2d.n_local_regs         = cfg_.n_local_regs_2d[pair];
+  cfg_2d.n_remote_lines       = cfg_.n_remote_lines_2d[pair];
+  cfg_2d.aggregate_width      = std::max(static_cast<int>(cfg_1d.aggregate_width) - 1, 1);
+  cfg_2d.id_width             = cfg_.id_width;
+  cfg_2d.lvl_width            = cfg_.lvl_width;
+  cfg_2d.lvl_offset           = cfg_1d.lvl_offset + 1;
+  cfg_2d.fifo_depth           = cfg_.fifo_depth ? cfg_.fifo_depth : std::max(l_out/l, 1u);
+  cfg_2d.rx_fifo_comb_out     = cfg_.rx_fifo_comb_2d[pair];
+  cfg_2d.tx_fifo_comb_out     = cfg_.tx_fifo_comb_2d[pair];
+  cfg_2d.local_fifo_comb_out  = cfg_.local_fifo_comb_2d[pair];
+  cfg_2d.remote_fifo_comb_out = cfg_.remote_fifo_comb_2d[pair];
+  cfg_2d.in_ports             = 2*2*l;
+  cfg_2d.out_ports            = 2*l_out;
+  cfg_2d.flow_ctrl            = cfg_.flow_ctrl;
+
+  node_1d *h_1d[2];
+  node_1d *v_1d[2];
+  for (unsigned int n = 0; n < 2; n++){
+    cfg_1d.node_type = node_type_e::hor;
+    h_1d[n] = &nodes_1d_.emplace_back(cfg_1d);
+    cfg_1d.node_type = node_type_e::ver;
+    v_1d[n] = &nodes_1d_.emplace_back(cfg_1d);
+  }
+  node_2d &node = nodes_2d_.emplace_back(cfg_2d);
+
+  const unsigned int ppl_in  = cfg_.n_pipeline_stages[2*pair];
+  const unsigned int ppl_itl = cfg_.n_pipeline_stages[2*pair+1];
+  core_t core;
+  core.h_in.resize(4*l_in);
+  core.v_in.resize(4*l_in);
+  for (unsigned int p = 0; p < 4; p++){
+    for (unsigned int j = 0; j < l_in; j++){
+      node_1d &h = *h_1d[p/2];
+      node_1d &v = *v_1d[p%2];
+      const unsigned int h_idx = 2*j + p%2;
+      const unsigned int v_idx = 2*j + p/2;
+      core.h_in[p*l_in + j] = pipe(in_port_t{&h.req_in[h_idx], &h.rsp_in[h_idx]}, ppl_in, cfg_1d);
+      core.v_in[p*l_in + j] = pipe(in_port_t{&v.req_in[v_idx], &v.rsp_in[v_idx]}, ppl_in, cfg_1d);
+    }
+  }
+  for (unsigned int n = 0; n < 2; n++){
+    for (unsigned int o = 0; o < l; o++){
+      const unsigned int idx = 2*o + n;
+      connect(out_port_t{&h_1d[n]->req_out[o], &h_1d[n]->rsp_out[o]},
+              pipe(in_port_t{&node.h.req_in[idx], &node.h.rsp_in[idx]}, ppl_itl, cfg_2d));
+      connect(out_port_t{&v_1d[n]->req_out[o], &v_1d[n]->rsp_out[o]},
+              pipe(in_port_t{&node.v.req_in[idx], &node.v.rsp_in[idx]}, ppl_itl, cfg_2d));
+    }
+  }
+  for (unsigned int o = 0; o < l_out; o++){
+    core.h_out.push_back(out_port_t{&node.h.req_out[o], &node.h.rsp_out[o]});
+    core.v_out.push_back(out_port_t{&node.v.req_out[o], &node.v.rsp_out[o]});
+  }
+  return core;
+}
+
+/* Same as the fractal_sync_NxN_core modules: four (N/2)x(N/2) cores under a 2x2 root */
+network::core_t network::build_core(const unsigned int n_cu_x, const unsigned int pair){
+  if (n_cu_x == 2) return build_2x2(pair);
+
+  const unsigned int n_leaf_x = n_cu_x/2;
+  const unsigned int l_in     = links_in(pair);
+  core_t leaf[4];
+  for (unsigned int i = 0; i < 4; i++) leaf[i] = build_core(n_leaf_x, pair);
+  core_t root = build_2x2(pair + log2(n_cu_x) - 1);
+
+  const unsigned int l_leaf = static_cast<unsigned int>(leaf[0].h_out.size());
+  core_t core;
+  core.h_in.resize(n_cu_x*n_cu_x*l_in);
+  core.v_in.resize(n_cu_x*n_cu_x*l_in);
+  for (unsigned int i = 0; i < 4; i++){
+    for (unsigned int j = 0; j < l_leaf; j++){
+      connect(leaf[i].h_out[j], root.h_in[i*l_leaf + j]);
+      connect(leaf[i].v_out[j], root.v_in[i*l_leaf + j]);
+    }
+    for (unsigned int j = 0; j < n_leaf_x*n_leaf_x; j++){
+      const unsigned int port = ((i/2)*n_leaf_x + j/n_leaf_x)*n_cu_x + (i%2)*n_leaf_x + j%n_leaf_x;
+      for (unsigned int k = 0; k < l_in; k++){
+        core.h_in[port*l_in + k] = leaf[i].h_in[j*l_in + k];
+        core.v_in[port*l_in + k] = leaf[i].v_in[j*l_in + k];
+      }
+    }
+  }
+  core.h_out = root.h_out;
+  core.v_out = root.v_out;
+  return core;
+}
+
+/* Same as the neighbor networks of the fractal_sync_NxN modules: border CUs have no neighbor node */
+void network::build_nbr(){
+  const unsigned int n = cfg_.n_cu_x;
+  if (n == 2) return;
+  for (unsigned int i = 0; i < n_cu_; i++){
+    const unsigned int c = i%n;
+    if (c != 0 && c != n-1 && (c & 1)){
+      nbr_node &node = nbr_nodes_.emplace_back();
+      node.req_in[0] = &h_nbr_req_[i];
+      node.req_in[1] = &h_nbr_req_[i+1];
+      h_nbr_rsp_[i]   = &node.rsp_out[0];
+      h_nbr_rsp_[i+1] = &node.rsp_out[1];
+    }
+    const unsigned int r = i/n;
+    if (r != 0 && r != n-1 && (r & 1)){
+      nbr_node &node = nbr_nodes_.emplace_back();
+      node.req_in[0] = &v_nbr_req_[i];
+      node.req_in[1] = &v_nbr_req_[i+n];
+      v_nbr_rsp_[i]   = &node.rsp_out[0];
+      v_nbr_rsp_[i+n] = &node.rsp_out[1];
+    }
+  }
+}
+
+void network::eval(){
+  for (auto &node : nodes_1d_) node.eval();
+  for (auto &node : nodes_2d_) node.eval();
+  for (auto &node : nbr_nodes_) node.eval();
+}
+
+void network::tick(){
+  for (auto &node : nodes_1d_) node.tick();
+  for (auto &node : nodes_2d_) node.tick();
+  for (auto &node : nbr_nodes_) node.tick();
+  for (auto &ppl : pipelines_) ppl.tick();
+}
+
+occupancy_t network::occupancy() const{
+  occupancy_t occ{};
+  for (const auto &node : nodes_1d_) node.occupancy(occ);
+  for (const auto &node : nodes_2d_){
+    node.h.occupancy(occ);
+    node.v.occupancy(occ);
+  }
+  return occ;
+}
+
+area_t network::area() const{
+  area_t area{};
+  for (const auto &node : nodes_1d_) node.area(area);
+  for (const auto &node : nodes_2d_){
+    node.h.area(area);
+    node.v.area(area);
+  }
+  for (const auto &node : nbr_nodes_) node.area(area);
+  for (const auto &ppl : pipelines_) ppl.area(area);
+  return area;
+}
+
+/*******************************************************/
+/**                    Split-phase                    **/
+/*******************************************************/
+
+void split_phase::init(const unsigned int n_barriers){
+  c_lines_.assign(n_barriers, line_t{false, false, 0, 0, false});
+  n_lines_  = c_lines_;
+  arrive_   = false;
+  accepted_ = false;
+  overflow_ = false;
+}
+
+bool split_phase::eval(const rsp_t &rsp, const bool wait, const unsigned int lvl, const unsigned int id, bool *error){
+  n_lines_ = c_lines_;
+  const bool bypass = rsp.wake && rsp.lvl == lvl && rsp.id == id;
+  bool done = false, wake_used = false;
+  if (wait)
+    for (auto &line : n_lines_)
+      if (line.valid && line.lvl == lvl && line.id == id && (line.woken || bypass)){
+        done      = true;
+        wake_used = !line.woken;
+        if (error) *error = line.woken ? line.error : rsp.error;
+        line.valid = line.woken = false;
+        break;
+      }
+  if (wait && !done && bypass){
+    done      = true;
+    wake_used = true;
+    if (error) *error = rsp.error;
+  }
+
+  bool store = rsp.wake && !wake_used;
+  for (auto &line : n_lines_)
+    if (store && line.valid && !line.woken && line.lvl == rsp.lvl && line.id == rsp.id){
+      line.woken = true;
+      line.error = rsp.error;
+      store      = false;
+    }
+  for (auto &line : n_lines_)
+    if (store && !line.valid){
+      line  = line_t{true, true, rsp.lvl, rsp.id, rsp.error};
+      store = false;
+    }
+  overflow_ = store;
+
+  /* One pending line per barrier: a second arrive would be counted as another participant */
+  accepted_ = arrive_;
+  for (const auto &line : n_lines_)
+    if (line.valid && !line.woken && line.lvl == arrive_lvl_ && line.id == arrive_id_) accepted_ = false;
+  bool alloc = accepted_;
+  /* A woken line of the barrier is stale (the CU arrives again without having waited for it): reuse it */
+  for (auto &line : n_lines_)
+    if (alloc && line.valid && line.woken && line.lvl == arrive_lvl_ && line.id == arrive_id_){
+      line.woken = line.error = false;
+      alloc      = false;
+    }
+  for (auto &line : n_lines_)
+    if (alloc && !line.valid){
+      line  = line_t{true, false, arrive_lvl_, arrive_id_, false};
+      alloc = false;
+    }
+  if (alloc) accepted_ = false;
+  arrive_ = false;
+  return done;
+}
+
+void split_phase::commit(){
+  c_lines_ = n_lines_;
+}
+
+bool split_phase::ready() const{
+  for (const auto &line : c_lines_)
+    if (!line.valid) return true;
+  return false;
+}
+
+unsigned int split_phase::occupancy() const{
+  unsigned int n = 0;
+  for (const auto &line : c_lines_) n += line.valid;
+  return n;
+}
+
+} // namespace fractal_sync::model
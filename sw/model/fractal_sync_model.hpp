@@ -0,0 +1,568 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization cycle-accurate C++ model (-std=c++20)
+ *
+ * Every block of hw/ has a counterpart: fifo (fractal_sync_fifo), arbiter (fractal_sync_arbiter, all flavours),
+ * local_rf/remote_rf (fractal_sync_1d_local_rf/fractal_sync_1d_remote_rf over the mp_rf/mp_cam/mp_sa primitives),
+ * node_1d (fractal_sync_1d: RX, TX, CC), node_2d (fractal_sync_2d), pipeline (fractal_sync_pipeline) and
+ * nbr_node (fractal_sync_neighbor). The network is composed recursively like the hw/trees cores and is
+ * parameterized by the same per-level arrays as the fractal_sync_NxN_pkg packages.
+ *
+ * Evaluation is split in two phases per clock cycle:
+ *   eval() - combinational logic: outputs and next state from the current state (inputs are always sampled by RX/TX)
+ *   tick() - rising edge: commit the next state and sample the inputs
+ */
+
+#ifndef FSYNC_MODEL_HPP
+#define FSYNC_MODEL_HPP
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace fractal_sync::model {
+
+/* Same encodings as fractal_sync_pkg */
+enum class remote_rf_e : unsigned int {cam = 0, dm = 1, sa = 2};
+enum class arb_e       : unsigned int {fa = 0, dm_wa = 1, dm_alt = 2, pp = 3};
+enum class node_type_e : unsigned int {nbr = 0, hor = 1, ver = 2, hv = 3, rt = 4};
+
+/* CU interfaces (same routing as cu_bfm) */
+enum class iface_e : unsigned int {h_tree = 0, v_tree = 1, h_nbr = 2, v_nbr = 3};
+
+inline constexpr unsigned int sd_east_north = 0b01;
+inline constexpr unsigned int sd_west_south = 0b10;
+inline constexpr unsigned int sd_both       = 0b11;
+
+/* SA_RF_WAYS and SA_RF_SPILL_LINES */
+inline constexpr unsigned int sa_rf_ways        = 2;
+inline constexpr unsigned int sa_rf_spill_lines = 2;
+
+/* credit: flow-control credit returned to the other side of the link (FLOW_CTRL = 1 only) */
+struct req_t{
+  bool         sync;
+  unsigned int aggr;
+  unsigned int id;
+  bool         credit;
+};
+
+struct rsp_t{
+  bool         wake;
+  unsigned int lvl;
+  unsigned int id;
+  bool         error;
+  bool         credit;
+};
+
+/* Queueing state of the nodes (see network::occupancy) */
+struct occupancy_t{
+  unsigned int fifo_entries; // elements stored in all the FIFOs
+  unsigned int fifo_peak;    // elements of the fullest FIFO
+  unsigned int local_regs;   // set local RF registers
+  unsigned int remote_regs;  // set remote RF registers or valid CAM lines
+  unsigned int cam_peak;     // valid lines of the fullest CAM
+};
+
+/* Storage of the nodes, as an area proxy (see network::area) */
+struct area_t{
+  unsigned int flops;    // flip-flops: I/O registers, FIFOs and their pointers, RFs, arbiter masks, pipelines, neighbor nodes
+  unsigned int cam_bits; // signature bits of the CAM lines (compared on every look-up, on top of their flops)
+};
+
+/* Network parameters: same names and meaning as the fractal_sync_NxN_pkg localparams */
+struct config_t{
+  unsigned int              n_cu_x;
+  node_type_e               top_node_type;
+  std::vector<remote_rf_e>  rf_type_1d;          // [N_1D_ITL_LEVELS]
+  std::vector<arb_e>        arbiter_type_1d;     // [N_1D_ITL_LEVELS]
+  std::vector<unsigned int> n_local_regs_1d;     // [N_1D_ITL_LEVELS]
+  std::vector<unsigned int> n_remote_lines_1d;   // [N_1D_ITL_LEVELS]
+  std::vector<bool>         rx_fifo_comb_1d;     // [N_1D_ITL_LEVELS]
+  std::vector<bool>         tx_fifo_comb_1d;     // [N_1D_ITL_LEVELS]
+  std::vector<bool>         local_fifo_comb_1d;  // [N_1D_ITL_LEVELS]
+  std::vector<bool>         remote_fifo_comb_1d; // [N_1D_ITL_LEVELS]
+  std::vector<remote_rf_e>  rf_type_2d;          // [N_2D_ITL_LEVELS]
+  std::vector<arb_e>        arbiter_type_2d;     // [N_2D_ITL_LEVELS]
+  std::vector<unsigned int> n_local_regs_2d;     // [N_2D_ITL_LEVELS]
+  std::vector<unsigned int> n_remote_lines_2d;   // [N_2D_ITL_LEVELS]
+  std::vector<bool>         rx_fifo_comb_2d;     // [N_2D_ITL_LEVELS]
+  std::vector<bool>         tx_fifo_comb_2d;     // [N_2D_ITL_LEVELS]
+  std::vector<bool>         local_fifo_comb_2d;  // [N_2D_ITL_LEVELS]
+  std::vector<bool>         remote_fifo_comb_2d; // [N_2D_ITL_LEVELS]
+  unsigned int              n_links_in;
+  std::vector<unsigned int> n_links_itl;         // [N_ITL_LEVELS]
+  unsigned int              n_links_out;
+  std::vector<unsigned int> n_pipeline_stages;   // [N_LEVELS]
+  unsigned int              aggregate_width;     // IN_AGGR_WIDTH
+  unsigned int              lvl_width;           // LVL_WIDTH
+  unsigned int              id_width;            // ID_WIDTH
+  unsigned int              lvl_offset;          // IN_LVL_OFFSET
+  bool                      flow_ctrl;           // FLOW_CTRL
+  unsigned int              fifo_depth;          // FIFO_DEPTH (0: sized on the link ratios)
+};
+
+/**
+ * @brief default configuration of a tree, i.e. the fractal_sync_NxN_pkg values
+ * @param n_cu_x number of CUs in a row of the mesh (power of two, 2x2 to 32x32 hand-written, larger trees from fractal_sync_tree_gen)
+ * @return tree configuration (throws std::invalid_argument for unsupported sizes)
+ */
+config_t preset(unsigned int n_cu_x);
+
+/**
+ * @brief hash of a configuration (FNV-1a over every parameter), used to tag benchmark results
+ * @param cfg tree configuration
+ * @return 64-bit hash
+ */
+std::uint64_t config_hash(const config_t &cfg);
+
+/* fractal_sync_fifo: same pointer arithmetic (and corner cases) as the RTL */
+template <typename T>
+class fifo{
+public:
+  void init(const unsigned int depth, const bool comb_out){
+    addr_width_ = 0;
+    while ((1u << addr_width_) < depth) addr_width_++;
+    addr_mask_ = (2u << addr_width_) - 1;
+    ptr_mask_  = (1u << addr_width_) - 1;
+    comb_out_  = comb_out;
+    mem_.assign(ptr_mask_ + 1, T{});
+    w_addr_ = 0;
+    r_addr_ = 0;
+  }
+
+  bool empty_fifo() const { return overlap(w_addr_) == overlap(r_addr_) && ptr(w_addr_) == ptr(r_addr_); }
+  bool full() const { return overlap(w_addr_) != overlap(r_addr_) && ptr(w_addr_) == ptr(r_addr_); }
+  unsigned int size() const { return full() ? ptr_mask_ + 1 : (ptr(w_addr_) - ptr(r_addr_)) & ptr_mask_; }
+  bool empty(const bool push) const { return empty_fifo() && !(comb_out_ && push); }
+  const T &element(const bool push, const T &element) const { return (comb_out_ && push && empty_fifo()) ? element : mem_[ptr(r_addr_)]; }
+
+  void commit(const bool push, const T &element, const bool pop){
+    if (push) mem_[ptr(w_addr_)] = element;
+    w_addr_ = (w_addr_ + (push ? 1 : 0)) & addr_mask_;
+    r_addr_ = (r_addr_ + (pop  ? 1 : 0)) & addr_mask_;
+  }
+
+private:
+  unsigned int overlap(const unsigned int addr) const { return (addr >> addr_width_) & 1; }
+  unsigned int ptr(const unsigned int addr) const { return addr & ptr_mask_; }
+
+  unsigned int   addr_width_ = 0;
+  unsigned int   addr_mask_  = 1;
+  unsigned int   ptr_mask_   = 0;
+  bool           comb_out_   = true;
+  std::vector<T> mem_;
+  unsigned int   w_addr_ = 0;
+  unsigned int   r_addr_ = 0;
+};
+
+/* fractal_sync_arbiter: DM flavours are sets of single-output FA arbiters, PP grants by prefix ranks (same as FA) */
+class arbiter{
+public:
+  void init(arb_e type, unsigned int in_ports, unsigned int out_ports);
+  /* sel[o]: granted input of output o (-1 if none); pop[i]: input i has been granted; ready[o]: output o can be
+   * granted (all outputs if nullptr) */
+  void eval(const char *empty, int *sel, char *pop, const char *ready = nullptr);
+  void commit();
+
+private:
+  struct fa_t{
+    std::vector<unsigned int> in;
+    std::vector<unsigned int> out;
+    std::vector<char>         c_mask;
+    std::vector<char>         n_mask;
+    std::vector<char>         pending;
+    std::vector<char>         gnt;
+    std::vector<unsigned int> rank;  // PP: rank of the pending inputs
+    std::vector<int>          ready; // PP: ready outputs by rank
+  };
+  std::vector<fa_t> fa_;
+  bool              pp_ = false;
+};
+
+/* fractal_sync_1d_local_rf */
+class local_rf{
+public:
+  void init(unsigned int n_regs, unsigned int id_width, unsigned int n_ports);
+  void eval(const unsigned int *id, const char *check, char *present, char *id_err, char *bypass);
+  void commit();
+  unsigned int occupancy() const;
+  void area(area_t &area) const;
+
+private:
+  unsigned int              n_regs_;
+  unsigned int              n_ports_;
+  unsigned int              local_id_mask_;
+  unsigned int              reg_idx_mask_;
+  std::vector<char>         reg_q_;
+  std::vector<char>         toggle_;
+  std::vector<unsigned int> touched_;
+  std::vector<unsigned int> active_;
+  std::vector<unsigned int> local_id_;
+  std::vector<char>         ignore_;
+};
+
+/* fractal_sync_1d_remote_rf (DM: fractal_sync_mp_rf_br; CAM: fractal_sync_mp_cam_br; SA: fractal_sync_mp_sa_br) */
+class remote_rf{
+public:
+  void init(bool enable, remote_rf_e type, unsigned int n_cam_lines, unsigned int id_width, unsigned int n_ports);
+  void eval(const unsigned int *level, const unsigned int *id, const unsigned int *sd, const char *check, const char *set,
+            char *present, unsigned int *sd_o, char *sig_err, char *bypass);
+  void commit();
+  unsigned int occupancy() const;
+  void area(area_t &area) const;
+  bool cam() const { return enable_ && type_ == remote_rf_e::cam; }
+
+private:
+  struct line_t{
+    bool         full;
+    unsigned int sig;
+    unsigned int sd;
+  };
+
+  bool                      enable_;
+  remote_rf_e               type_;
+  unsigned int              n_ports_;
+  unsigned int              n_dm_regs_;
+  unsigned int              local_id_mask_;
+  unsigned int              sig_mask_;
+  unsigned int              reg_idx_mask_;
+  /* DM */
+  std::vector<char>         reg_q_;
+  std::vector<unsigned int> sd_q_;
+  std::vector<char>         chk_reg_;
+  std::vector<char>         set_reg_;
+  std::vector<int>          sd_mask_;
+  std::vector<unsigned int> touched_;
+  /* CAM */
+  std::vector<line_t>       lines_;
+  std::vector<char>         write_;
+  std::vector<char>         free_;
+  std::vector<char>         update_;
+  std::vector<unsigned int> w_idx_;
+  std::vector<unsigned int> sd_d_;
+  /* SA: ways of the sets followed by the spill lines (lines_ is the current state, sa_d_ the next one) */
+  unsigned int              n_ways_;
+  unsigned int              idx_bits_;
+  unsigned int              n_set_lines_;
+  std::vector<line_t>       sa_d_;
+  std::vector<unsigned int> set_;
+  /* Per port */
+  std::vector<unsigned int> active_;
+  std::vector<unsigned int> local_id_;
+  std::vector<unsigned int> local_sig_;
+  std::vector<char>         valid_;
+  std::vector<char>         ignore_;
+  std::vector<char>         check_rf_;
+  std::vector<char>         set_rf_;
+  std::vector<unsigned int> sd_rf_;
+  std::vector<char>         store_;
+};
+
+struct node_cfg_t{
+  node_type_e  node_type;
+  remote_rf_e  rf_type;
+  arb_e        arbiter_type;
+  unsigned int n_local_regs;
+  unsigned int n_remote_lines;
+  unsigned int aggregate_width;
+  unsigned int id_width;
+  unsigned int lvl_width;
+  unsigned int lvl_offset;
+  unsigned int fifo_depth;
+  bool         rx_fifo_comb_out;
+  bool         tx_fifo_comb_out;
+  bool         local_fifo_comb_out;
+  bool         remote_fifo_comb_out;
+  unsigned int in_ports;
+  unsigned int out_ports;
+  bool         flow_ctrl;
+};
+
+/* fractal_sync_1d: inputs are read through req_in/rsp_out pointers at tick(), outputs are valid after eval() */
+class node_1d{
+public:
+  explicit node_1d(const node_cfg_t &cfg);
+  void eval();
+  void tick();
+  void occupancy(occupancy_t &occ) const;
+  void area(area_t &area) const;
+
+  std::vector<const req_t*> req_in;
+  std::vector<rsp_t>        rsp_in;
+  std::vector<req_t>        req_out;
+  std::vector<const rsp_t*> rsp_out;
+
+private:
+  bool fifo_busy() const;
+  bool credit_commit();
+
+  node_cfg_t   cfg_;
+  unsigned int level_mask_;
+  unsigned int lvl_mask_;
+  unsigned int aggr_mask_;
+  unsigned int id_mask_;
+  bool         input_busy_  = false;
+  bool         fifo_busy_   = false;
+  bool         credit_busy_ = false;
+  bool         busy_        = false;
+  bool         quiet_       = false;
+
+  /* State */
+  std::vector<char>          rx_sync_;
+  std::vector<req_t>         rx_req_;
+  std::vector<fifo<req_t>>   rx_fifo_;
+  std::vector<char>          tx_wake_;
+  std::vector<rsp_t>         tx_rsp_;
+  std::vector<fifo<rsp_t>>   en_fifo_;
+  std::vector<fifo<rsp_t>>   ws_fifo_;
+  std::vector<fifo<rsp_t>>   local_fifo_;
+  std::vector<fifo<req_t>>   remote_fifo_;
+  std::vector<unsigned int>  local_pop_q_;
+  arbiter                    req_arb_;
+  arbiter                    en_arb_;
+  arbiter                    ws_arb_;
+  local_rf                   local_rf_;
+  remote_rf                  remote_rf_;
+  /* Flow control (fractal_sync_rx/fractal_sync_tx owed credits, fractal_sync_credit counters) */
+  std::vector<unsigned int>  rx_owed_;
+  std::vector<unsigned int>  tx_owed_;
+  std::vector<unsigned int>  en_cnt_;
+  std::vector<unsigned int>  ws_cnt_;
+  std::vector<unsigned int>  req_credits_;
+  std::vector<unsigned int>  rsp_credits_;
+
+  /* Combinational signals */
+  std::vector<unsigned int>  level_;
+  std::vector<unsigned int>  id_;
+  std::vector<unsigned int>  sd_in_;
+  std::vector<unsigned int>  sd_out_;
+  std::vector<char>          check_local_;
+  std::vector<char>          check_remote_;
+  std::vector<char>          set_remote_;
+  std::vector<char>          present_local_;
+  std::vector<char>          present_remote_;
+  std::vector<char>          id_err_;
+  std::vector<char>          sig_err_;
+  std::vector<char>          bypass_local_;
+  std::vector<char>          bypass_remote_;
+  std::vector<char>          rx_push_;
+  std::vector<char>          local_push_;
+  std::vector<char>          remote_push_;
+  std::vector<char>          en_push_;
+  std::vector<char>          ws_push_;
+  std::vector<char>          req_empty_;
+  std::vector<char>          req_pop_;
+  std::vector<char>          en_empty_;
+  std::vector<char>          en_pop_;
+  std::vector<char>          ws_empty_;
+  std::vector<char>          ws_pop_;
+  std::vector<char>          local_pop_;
+  std::vector<req_t>         rx_elem_;
+  std::vector<rsp_t>         local_elem_;
+  std::vector<int>           req_sel_;
+  std::vector<int>           en_sel_;
+  std::vector<int>           ws_sel_;
+  std::vector<unsigned int>  local_pop_d_;
+  std::vector<char>          req_ready_;
+  std::vector<char>          en_ready_;
+  std::vector<char>          ws_ready_;
+};
+
+/* fractal_sync_2d: the H and V channels of a 2D node never interact, each one behaves as a 1D node */
+class node_2d{
+public:
+  explicit node_2d(const node_cfg_t &cfg);
+  void eval(){ h.eval(); v.eval(); }
+  void tick(){ h.tick(); v.tick(); }
+
+  node_1d h;
+  node_1d v;
+
+private:
+  static node_cfg_t half(const node_cfg_t &cfg);
+};
+
+/* fractal_sync_pipeline (single port) */
+class pipeline{
+public:
+  /* stage_bits: flops of a stage (request and response of the link) */
+  pipeline(unsigned int n_stages, unsigned int stage_bits);
+  void tick();
+  void area(area_t &area) const { area.flops += n_stages_*stage_bits_; }
+
+  const req_t *req_d = nullptr;
+  const rsp_t *rsp_d = nullptr;
+  const req_t &req_q() const { return req_[n_stages_-1]; }
+  const rsp_t &rsp_q() const { return rsp_[0]; }
+
+private:
+  unsigned int       n_stages_;
+  unsigned int       stage_bits_;
+  std::vector<req_t> req_;
+  std::vector<rsp_t> rsp_;
+};
+
+/* fractal_sync_neighbor (COMB = 0) */
+class nbr_node{
+public:
+  void eval();
+  void tick();
+  void area(area_t &area) const { area.flops += 2*(1 + 2); }
+
+  const req_t *req_in[2] = {nullptr, nullptr};
+  rsp_t        rsp_out[2] = {};
+
+private:
+  bool         present_q_[2] = {false, false};
+  unsigned int id_q_[2]      = {0, 0};
+};
+
+/* Complete network: H-tree core plus the neighbor networks, with the CU interfaces of tb_bfm */
+class network{
+public:
+  explicit network(const config_t &cfg);
+
+  void eval();
+  void tick();
+  void cycle(){ eval(); tick(); }
+
+  /* FIFO and RF occupancy summed over every node (scans the whole network) */
+  occupancy_t occupancy() const;
+
+  /* Flops and CAM bits of every node and pipeline (area proxy of the configuration) */
+  area_t area() const;
+
+  unsigned int n_cu() const { return n_cu_; }
+  const config_t &cfg() const { return cfg_; }
+
+  /* CU-side requests (sampled at tick()) and responses (valid after eval()); the requests are created with credit set,
+   * as the CUs always accept the responses of the network */
+  req_t       &req(const unsigned int cu, const iface_e iface){
+    switch (iface){
+      case iface_e::h_tree: return h_tree_req_[cu];
+      case iface_e::v_tree: return v_tree_req_[cu];
+      case iface_e::h_nbr:  return h_nbr_req_[cu];
+      default:              return v_nbr_req_[cu];
+    }
+  }
+  const rsp_t &rsp(const unsigned int cu, const iface_e iface) const{
+    switch (iface){
+      case iface_e::h_tree: return *h_tree_rsp_[cu];
+      case iface_e::v_tree: return *v_tree_rsp_[cu];
+      case iface_e::h_nbr:  return *h_nbr_rsp_[cu];
+      default:              return *v_nbr_rsp_[cu];
+    }
+  }
+  req_t       &h_tree_req(const unsigned int cu)       { return h_tree_req_[cu]; }
+  req_t       &v_tree_req(const unsigned int cu)       { return v_tree_req_[cu]; }
+  req_t       &h_nbr_req(const unsigned int cu)        { return h_nbr_req_[cu]; }
+  req_t       &v_nbr_req(const unsigned int cu)        { return v_nbr_req_[cu]; }
+  const rsp_t &h_tree_rsp(const unsigned int cu) const { return *h_tree_rsp_[cu]; }
+  const rsp_t &v_tree_rsp(const unsigned int cu) const { return *v_tree_rsp_[cu]; }
+  const rsp_t &h_nbr_rsp(const unsigned int cu)  const { return *h_nbr_rsp_[cu]; }
+  const rsp_t &v_nbr_rsp(const unsigned int cu)  const { return *v_nbr_rsp_[cu]; }
+
+private:
+  /* Consumer side of a link: request sink and response source */
+  struct in_port_t{
+    const req_t **req;
+    const rsp_t  *rsp;
+  };
+  /* Producer side of a link: request source and response sink */
+  struct out_port_t{
+    const req_t  *req;
+    const rsp_t **rsp;
+  };
+  struct core_t{
+    std::vector<in_port_t>  h_in;  // [port*links_in + link]
+    std::vector<in_port_t>  v_in;
+    std::vector<out_port_t> h_out; // [link]
+    std::vector<out_port_t> v_out;
+  };
+
+  unsigned int links_in(unsigned int pair) const;
+  unsigned int links_itl(unsigned int pair) const;
+  unsigned int links_out(unsigned int pair) const;
+  in_port_t pipe(in_port_t consumer, unsigned int n_stages, const node_cfg_t &cfg);
+  static void connect(const out_port_t &producer, const in_port_t &consumer);
+  core_t build_2x2(unsigned int pair);
+  core_t build_core(unsigned int n_cu_x, unsigned int pair);
+  void build_nbr();
+
+  config_t     cfg_;
+  unsigned int n_cu_;
+  unsigned int n_pairs_;
+
+  std::deque<node_1d>  nodes_1d_;
+  std::deque<node_2d>  nodes_2d_;
+  std::deque<pipeline> pipelines_;
+  std::deque<nbr_node> nbr_nodes_;
+
+  const rsp_t zero_rsp_ = {};
+  /* Idle CU links and the tree root always accept the transactions of the network */
+  const req_t idle_req_ = {false, 0, 0, true};
+  const rsp_t idle_rsp_ = {false, 0, 0, false, true};
+
+  std::vector<req_t>        h_tree_req_;
+  std::vector<req_t>        v_tree_req_;
+  std::vector<req_t>        h_nbr_req_;
+  std::vector<req_t>        v_nbr_req_;
+  std::vector<const rsp_t*> h_tree_rsp_;
+  std::vector<const rsp_t*> v_tree_rsp_;
+  std::vector<const rsp_t*> h_nbr_rsp_;
+  std::vector<const rsp_t*> v_nbr_rsp_;
+};
+
+/* fractal_sync_sp: split-phase CU endpoint, table of the outstanding barriers (pending until woken, woken until a wait
+ * consumes them) */
+class split_phase{
+public:
+  void init(unsigned int n_barriers);
+  /* Arrive at barrier (lvl, id) in the next eval(): accepted() tells whether it is forwarded to the network */
+  void arrive(const unsigned int lvl, const unsigned int id){ arrive_ = true; arrive_lvl_ = lvl; arrive_id_ = id; }
+  /* rsp: response of the network; wait: the CU waits for barrier (lvl, id). Returns true when the wait is satisfied
+   * (error: error of the consumed wake) */
+  bool eval(const rsp_t &rsp, bool wait, unsigned int lvl, unsigned int id, bool *error = nullptr);
+  void commit();
+  bool ready() const;
+  bool accepted() const { return accepted_; }
+  bool overflow() const { return overflow_; }
+  unsigned int occupancy() const;
+
+private:
+  struct line_t{
+    bool         valid;
+    bool         woken;
+    unsigned int lvl;
+    unsigned int id;
+    bool         error;
+  };
+
+  std::vector<line_t> c_lines_;
+  std::vector<line_t> n_lines_;
+  bool                arrive_     = false;
+  unsigned int        arrive_lvl_ = 0;
+  unsigned int        arrive_id_  = 0;
+  bool                accepted_   = false;
+  bool                overflow_   = false;
+};
+
+} // namespace fractal_sync::model
+
+#endif /*FSYNC_MODEL_HPP*/
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization model testbench: same tests, CU timing and report as dv/tb_bfm
+ *
+ * Streaming mode (STREAM_ITERATIONS > 0): after the tests, each test pattern is streamed back-to-back by every CU and the
+ * steady-state throughput and the FIFO/RF occupancy are reported; the occupancy of every cycle can be dumped as CSV.
+ * Each pattern is then streamed again with split-phase barriers (computation overlapped with the barrier latency).
+ * Finally every CU pipelines the nbr_h_sync, row_sync and col_sync barriers (all in flight on their interfaces before
+ * waiting for them) and is compared with issuing them as blocking barriers one after the other.
+ * FIFO_DEPTH > 0 runs the tree with FLOW_CTRL = 1 and FIFOs of that depth (same as tb_bfm -GFLOW_CTRL=1 -GFIFO_DEPTH=...).
+ * ARBITER_TYPE >= 0 sets the arbiter type (arb_e) of every node (same as tb_bfm -GARBITER_TYPE=...).
+ *
+ * Usage: fractal_sync_model_tb [N_CU_X] [MIN_COMP_CYCLES] [MAX_COMP_CYCLES] [MAX_RAND_CYCLES] [SEED] [STREAM_ITERATIONS] [OCCUPANCY_CSV|-]
+ *                              [FIFO_DEPTH] [ARBITER_TYPE]
+ */
+
+#include "fractal_sync_bfm.hpp"
+#include "fractal_sync_model.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+
+using namespace fractal_sync::model;
+
+int main(int argc, char *argv[]){
+  const unsigned int n_cu_x   = (argc > 1) ? std::atoi(argv[1]) : 4;
+  const unsigned int min_comp = (argc > 2) ? std::atoi(argv[2]) : 0;
+  const unsigned int max_comp = (argc > 3) ? std::atoi(argv[3]) : min_comp;
+  const unsigned int max_rand = (argc > 4) ? std::atoi(argv[4]) : 0;
+  const unsigned int seed     = (argc > 5) ? std::atoi(argv[5]) : 1;
+  const unsigned int n_stream = (argc > 6) ? std::atoi(argv[6]) : 0;
+  const char        *occ_csv  = (argc > 7 && std::strcmp(argv[7], "-")) ? argv[7] : nullptr;
+  const unsigned int depth    = (argc > 8) ? std::atoi(argv[8]) : 0;
+  const int          arb_type = (argc > 9) ? std::atoi(argv[9]) : -1;
+
+  try {
+    config_t cfg = preset(n_cu_x);
+    if (depth){
+      cfg.flow_ctrl  = true;
+      cfg.fifo_depth = depth;
+    }
+    if (arb_type >= 0){
+      for (auto &arb : cfg.arbiter_type_1d) arb = static_cast<arb_e>(arb_type);
+      for (auto &arb : cfg.arbiter_type_2d) arb = static_cast<arb_e>(arb_type);
+    }
+    network        net(cfg);
+    bfm_t<network> bfm(net, net.n_cu(), min_comp, max_comp, max_rand, seed);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int t = 0; t < n_bfm_tests; t++){
+      std::printf("\n  --> STARTED TEST: %s\n", bfm_test_name(t));
+      const auto latency = bfm.run(bfm_test(t, n_cu_x));
+      std::printf("\n  <-- ENDED TEST: synchronization time %lluns\n", static_cast<unsigned long long>(*std::max_element(latency.begin(), latency.end())));
+      if (bfm.hung()) break;
+    }
+
+    std::FILE *trace = occ_csv ? std::fopen(occ_csv, "w") : nullptr;
+    if (trace) std::fprintf(trace, "test,cycle,fifo_entries,fifo_peak,local_regs,remote_regs,cam_peak\n");
+    for (unsigned int t = 0; n_stream && !bfm.hung() && t < n_bfm_tests; t++){
+      occupancy_t   peak{};
+      std::uint64_t fifo_sum = 0, remote_sum = 0;
+      const auto probe = [&](const std::uint64_t cycle){
+        const occupancy_t occ = net.occupancy();
+        fifo_sum       += occ.fifo_entries;
+        remote_sum     += occ.remote_regs;
+        peak.fifo_entries = std::max(peak.fifo_entries, occ.fifo_entries);
+        peak.fifo_peak    = std::max(peak.fifo_peak, occ.fifo_peak);
+        peak.remote_regs  = std::max(peak.remote_regs, occ.remote_regs);
+        peak.cam_peak     = std::max(peak.cam_peak, occ.cam_peak);
+        if (trace) std::fprintf(trace, "%s,%llu,%u,%u,%u,%u,%u\n", bfm_test_name(t), static_cast<unsigned long long>(cycle),
+                                occ.fifo_entries, occ.fifo_peak, occ.local_regs, occ.remote_regs, occ.cam_peak);
+      };
+      const stream_t res = bfm.stream(bfm_test(t, n_cu_x), n_stream, n_stream/4, probe);
+      const double   n   = res.cycles ? static_cast<double>(res.cycles) : 1.0;
+      std::printf("\n  <-> STREAM %s: %llu barriers in %llu cycles, steady state %.4f rounds/cycle (%.4f barriers/cycle)\n", bfm_test_name(t),
+                  static_cast<unsigned long long>(res.wakes), static_cast<unsigned long long>(res.cycles), res.rounds_per_cycle(),
+                  res.rounds_per_cycle()*bfm_test_groups(t, n_cu_x));
+      std::printf("      FIFO entries mean %.2f max %u (fullest FIFO %u), remote RF/CAM lines mean %.2f max %u (fullest CAM %u)\n",
+                  fifo_sum/n, peak.fifo_entries, peak.fifo_peak, remote_sum/n, peak.remote_regs, peak.cam_peak);
+      if (bfm.hung()) break;
+      bfm.split(2);
+      const stream_t sp = bfm.stream(bfm_test(t, n_cu_x), n_stream, n_stream/4);
+      bfm.split(0);
+      std::printf("  <-> SPLIT-PHASE %s: %llu barriers in %llu cycles, steady state %.4f rounds/cycle (x%.2f)\n", bfm_test_name(t),
+                  static_cast<unsigned long long>(sp.wakes), static_cast<unsigned long long>(sp.cycles), sp.rounds_per_cycle(),
+                  res.rounds_per_cycle() > 0 ? sp.rounds_per_cycle()/res.rounds_per_cycle() : 0.0);
+    }
+    if (trace) std::fclose(trace);
+    if (n_stream && !bfm.hung()){
+      const std::vector<std::vector<transaction_t>> phases = {bfm_test(0, n_cu_x), bfm_test(4, n_cu_x), bfm_test(5, n_cu_x)};
+      const stream_t seq = bfm.pipeline(phases, n_stream);
+      bfm.split(2);
+      const stream_t pp  = bfm.pipeline(phases, n_stream);
+      bfm.split(0);
+      std::printf("\n  <-> PIPELINE nbr_h_sync+row_sync+col_sync: %llu barriers in %llu cycles (blocking: %llu cycles), %.4f iterations/cycle (x%.2f)\n",
+                  static_cast<unsigned long long>(pp.wakes), static_cast<unsigned long long>(pp.cycles), static_cast<unsigned long long>(seq.cycles),
+                  pp.rounds_per_cycle(), seq.rounds_per_cycle() > 0 ? pp.rounds_per_cycle()/seq.rounds_per_cycle() : 0.0);
+    }
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("\nTest finished with %u errors: %s\n", bfm.errors(), bfm.errors() ? "[FAIL]" : "[PASS]");
+    std::printf("Simulated %llu cycles in %.3fs (%.0f cycles/s)\n", static_cast<unsigned long long>(bfm.cycles()), wall, wall > 0 ? bfm.cycles()/wall : 0.0);
+    return bfm.errors() ? EXIT_FAILURE : EXIT_SUCCESS;
+  } catch (const std::exception &e){
+    std::fprintf(stderr, "%s\n", e.what());
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization trace recording and replay on the C++ model (-std=c++20)
+ *
+ * record: each tb_bfm test is run ITERATIONS times with random computation cycles (default none) and the transactions
+ *         are dumped to a trace (synthetic traffic, same format as the traces recorded by cu_bfm with +TRACE_OUT).
+ *         As on the RTL, random computation skews on the torus tests may produce mismatched or lost wakes, which are
+ *         flagged in the trace.
+ * replay: the transactions of a trace (e.g. recorded on the RTL or from an application) are replayed on the model of
+ *         the tree, keeping the recorded computation gaps, and the latency and makespan of the replay are compared with
+ *         the recorded ones, per barrier level. The replayed trace can be dumped for further comparisons.
+ * compare: same as replay, then the issue and wake cycles (relative to the first issue of the trace) and the flags of
+ *          every transaction are compared with the recorded ones. On a trace recorded on the RTL (tb_bfm +TRACE_OUT)
+ *          this cross-checks the cycle counts of the model against the RTL: any mismatch fails.
+ *
+ * Usage: fractal_sync_replay record TRACE [N_CU_X] [ITERATIONS] [MAX_COMP_CYCLES] [SEED]
+ *        fractal_sync_replay replay TRACE [REPLAYED_TRACE]
+ *        fractal_sync_replay compare TRACE [REPLAYED_TRACE]
+ */
+
+#include "fractal_sync_bfm.hpp"
+#include "fractal_sync_model.hpp"
+#include "fractal_sync_trace.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+using namespace fractal_sync::model;
+
+struct summary_t{
+  std::uint64_t transactions = 0;
+  std::uint64_t latency      = 0; // sum of the wake - issue cycles
+  std::uint32_t first_issue  = UINT32_MAX;
+  std::uint32_t last_wake    = 0;
+  unsigned int  errors       = 0;
+  unsigned int  hung         = 0;
+
+  void add(const trace_record_t &r){
+    if (r.flags & trace_hung){ hung++; return; }
+    transactions++;
+    latency    += r.wake - r.issue;
+    first_issue = std::min(first_issue, r.issue);
+    last_wake   = std::max(last_wake, r.wake);
+    errors     += (r.flags & trace_error) != 0;
+  }
+  double        mean()     const { return transactions ? static_cast<double>(latency)/transactions : 0.0; }
+  std::uint64_t makespan() const { return transactions ? last_wake - first_issue : 0; }
+};
+
+int record(const std::string &path, const unsigned int n_cu_x, const unsigned int iterations, const unsigned int max_comp, const unsigned int seed){
+  network                     net(preset(n_cu_x));
+  bfm_t<network>              bfm(net, net.n_cu(), 0, max_comp, 0, seed);
+  std::vector<trace_record_t> trace;
+  bfm.record(&trace);
+  for (unsigned int t = 0; t < n_bfm_tests && !bfm.hung(); t++)
+    for (unsigned int it = 0; it < iterations && !bfm.hung(); it++) bfm.run(bfm_test(t, n_cu_x));
+  write_trace(path, trace_header_t{n_cu_x, n_cu_x, static_cast<unsigned int>(bfm_t<network>::clk_period)}, trace);
+  std::printf("Recorded %zu transactions on %ux%u in %llu cycles (%u errors) to %s\n", trace.size(), n_cu_x, n_cu_x,
+              static_cast<unsigned long long>(bfm.cycles()), bfm.errors(), path.c_str());
+  return bfm.errors() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* Transactions of the replay that do not match the recorded ones (cycles relative to the first issue of each trace) */
+unsigned int compare(const std::vector<trace_record_t> &trace, const std::vector<trace_record_t> &replayed){
+  static constexpr unsigned int max_reports = 10;
+  std::uint32_t rec_start = UINT32_MAX, rep_start = UINT32_MAX;
+  for (std::size_t r = 0; r < trace.size(); r++){
+    rec_start = std::min(rec_start, trace[r].issue);
+    if (!(replayed[r].flags & trace_hung)) rep_start = std::min(rep_start, replayed[r].issue);
+  }
+
+  unsigned int mismatches = 0;
+  for (std::size_t r = 0; r < trace.size(); r++){
+    const trace_record_t &a    = trace[r];
+    const trace_record_t &b    = replayed[r];
+    const bool            hung = (a.flags & trace_hung) || (b.flags & trace_hung);
+    if (a.flags == b.flags && a.issue - rec_start == b.issue - rep_start && (hung || a.wake - rec_start == b.wake - rep_start)) continue;
+    if (mismatches++ < max_reports)
+      std::printf("[MISMATCH] CU %u level %u id %u: recorded issue %u wake %u flags %u, replayed issue %u wake %u flags %u\n",
+                  a.cu, a.level, a.id, a.issue - rec_start, a.wake ? a.wake - rec_start : 0, a.flags,
+                  b.issue - rep_start, b.wake ? b.wake - rep_start : 0, b.flags);
+  }
+  std::printf("Compared %zu transactions: %u mismatches\n", trace.size(), mismatches);
+  return mismatches;
+}
+
+int replay(const std::string &path, const char *out_path, const bool check){
+  trace_header_t header;
+  const auto     trace = read_trace(path, header);
+  if (header.n_cu_x != header.n_cu_y) throw std::runtime_error("Only square meshes are supported");
+  if (header.clk_period != bfm_t<network>::clk_period) std::fprintf(stderr, "[WARNING] Trace clock period %uns, replayed at %lluns\n",
+                                                                    header.clk_period, static_cast<unsigned long long>(bfm_t<network>::clk_period));
+
+  network        net(preset(header.n_cu_x));
+  bfm_t<network> bfm(net, net.n_cu());
+  const auto     replayed = bfm.replay(trace);
+
+  unsigned int n_lvl = 0;
+  while ((1u << n_lvl) < net.n_cu()) n_lvl++;
+  std::vector<summary_t> rec_lvl(n_lvl+1), rep_lvl(n_lvl+1);
+  summary_t              rec_all, rep_all;
+  for (std::size_t r = 0; r < trace.size(); r++){
+    const unsigned int lvl = std::min(trace[r].level, n_lvl);
+    rec_lvl[lvl].add(trace[r]);
+    rep_lvl[lvl].add(replayed[r]);
+    rec_all.add(trace[r]);
+    rep_all.add(replayed[r]);
+  }
+
+  std::printf("Replayed %llu transactions of %s on %ux%u (config %016llx)\n", static_cast<unsigned long long>(rep_all.transactions), path.c_str(),
+              header.n_cu_x, header.n_cu_y, static_cast<unsigned long long>(config_hash(net.cfg())));
+  std::printf("%-8s %12s %18s %18s\n", "level", "transactions", "recorded [cycles]", "replayed [cycles]");
+  for (unsigned int l = 1; l <= n_lvl; l++)
+    if (rec_lvl[l].transactions)
+      std::printf("%-8u %12llu %18.2f %18.2f\n", l, static_cast<unsigned long long>(rec_lvl[l].transactions), rec_lvl[l].mean(), rep_lvl[l].mean());
+  std::printf("%-8s %12llu %18.2f %18.2f\n", "all", static_cast<unsigned long long>(rec_all.transactions), rec_all.mean(), rep_all.mean());
+  std::printf("Makespan: recorded %llu cycles, replayed %llu cycles\n", static_cast<unsigned long long>(rec_all.makespan()),
+              static_cast<unsigned long long>(rep_all.makespan()));
+  std::printf("Errors: recorded %u (%u hung), replayed %u (%u hung)\n", rec_all.errors, rec_all.hung, rep_all.errors, rep_all.hung);
+
+  if (out_path) write_trace(out_path, header, replayed);
+  if (check) return compare(trace, replayed) ? EXIT_FAILURE : EXIT_SUCCESS;
+  return bfm.errors() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]){
+  if (argc < 3 || (std::strcmp(argv[1], "record") && std::strcmp(argv[1], "replay") && std::strcmp(argv[1], "compare"))){
+    std::fprintf(stderr, "Usage: %s record TRACE [N_CU_X] [ITERATIONS] [MAX_COMP_CYCLES] [SEED]\n"
+                         "       %s replay TRACE [REPLAYED_TRACE]\n"
+                         "       %s compare TRACE [REPLAYED_TRACE]\n", argv[0], argv[0], argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  try {
+    if (!std::strcmp(argv[1], "record"))
+      return record(argv[2], (argc > 3) ? std::atoi(argv[3]) : 4, (argc > 4) ? std::atoi(argv[4]) : 16,
+                    (argc > 5) ? std::atoi(argv[5]) : 0, (argc > 6) ? std::atoi(argv[6]) : 1);
+    return replay(argv[2], (argc > 3) ? argv[3] : nullptr, !std::strcmp(argv[1], "compare"));
+  } catch (const std::exception &e){
+    std::fprintf(stderr, "%s\n", e.what());
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization transaction traces: same binary format as dv/sync_trace (-std=c++20)
+ *
+ * Little-endian 32-bit words. Header: magic "FSTR", version, n_cu_y << 16 | n_cu_x, clock period (ns).
+ * One record per transaction, in wake order:
+ *   word 0: flags << 24 | level << 16 | CU (row-major index)
+ *   word 1: aggregate (sync_transaction::sync_aggregate, without the level bit)
+ *   word 2: barrier id
+ *   word 3: issue cycle (rising edge sampling the request)
+ *   word 4: wake cycle (rising edge sampling the wake, 0 if the CU hung)
+ */
+
+#ifndef FSYNC_TRACE_HPP
+#define FSYNC_TRACE_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fractal_sync::model {
+
+inline constexpr std::uint32_t trace_magic   = 0x52545346; // "FSTR"
+inline constexpr std::uint32_t trace_version = 1;
+inline constexpr unsigned int  trace_error   = 0x1;        // wake did not match the request
+inline constexpr unsigned int  trace_hung    = 0x2;        // no wake before the watchdog
+
+struct trace_header_t{
+  unsigned int n_cu_x;
+  unsigned int n_cu_y;
+  unsigned int clk_period;
+};
+
+struct trace_record_t{
+  unsigned int  cu;
+  unsigned int  level;
+  unsigned int  aggregate;
+  unsigned int  id;
+  std::uint32_t issue;
+  std::uint32_t wake;
+  unsigned int  flags;
+};
+
+namespace trace_detail {
+
+inline void put(std::FILE *file, const std::uint32_t word){
+  const unsigned char bytes[4] = {static_cast<unsigned char>(word), static_cast<unsigned char>(word >> 8),
+                                  static_cast<unsigned char>(word >> 16), static_cast<unsigned char>(word >> 24)};
+  std::fwrite(bytes, 1, 4, file);
+}
+
+inline bool get(std::FILE *file, std::uint32_t &word){
+  unsigned char bytes[4];
+  if (std::fread(bytes, 1, 4, file) != 4) return false;
+  word = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+  return true;
+}
+
+} // namespace trace_detail
+
+/**
+ * @brief write a trace file
+ * @param path trace file
+ * @param header mesh size and clock period
+ * @param records transactions
+ * @return no return value (throws std::runtime_error if the file cannot be written)
+ */
+inline void write_trace(const std::string &path, const trace_header_t &header, const std::vector<trace_record_t> &records){
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  if (!file) throw std::runtime_error("Cannot write trace " + path);
+  trace_detail::put(file, trace_magic);
+  trace_detail::put(file, trace_version);
+  trace_detail::put(file, header.n_cu_y << 16 | header.n_cu_x);
+  trace_detail::put(file, header.clk_period);
+  for (const auto &r : records){
+    trace_detail::put(file, r.flags << 24 | r.level << 16 | r.cu);
+    trace_detail::put(file, r.aggregate);
+    trace_detail::put(file, r.id);
+    trace_detail::put(file, r.issue);
+    trace_detail::put(file, r.wake);
+  }
+  const bool failed = std::ferror(file);
+  if (std::fclose(file) != 0 || failed) throw std::runtime_error("Cannot write trace " + path);
+}
+
+/**
+ * @brief read a trace file
+ * @param path trace file
+ * @param header mesh size and clock period
+ * @return transactions (throws std::runtime_error if the file cannot be read or is not a trace)
+ */
+inline std::vector<trace_record_t> read_trace(const std::string &path, trace_header_t &header){
+  std::FILE *file = std::fopen(path.c_str(), "rb");
+  if (!file) throw std::runtime_error("Cannot read trace " + path);
+  std::uint32_t magic = 0, version = 0, size = 0, period = 0;
+  if (!trace_detail::get(file, magic) || !trace_detail::get(file, version) || !trace_detail::get(file, size) ||
+      !trace_detail::get(file, period) || magic != trace_magic || version != trace_version){
+    std::fclose(file);
+    throw std::runtime_error("Not a FractalSync trace (or unsupported version): " + path);
+  }
+  header = trace_header_t{size & 0xffff, size >> 16, period};
+
+  std::vector<trace_record_t> records;
+  std::uint32_t               w[5];
+  while (trace_detail::get(file, w[0])){
+    for (unsigned int i = 1; i < 5; i++){
+      if (!trace_detail::get(file, w[i])){
+        std::fclose(file);
+        throw std::runtime_error("Truncated trace " + path);
+      }
+    }
+    records.push_back(trace_record_t{w[0] & 0xffff, (w[0] >> 16) & 0xff, w[1], w[2], w[3], w[4], w[0] >> 24});
+  }
+  std::fclose(file);
+  return records;
+}
+
+} // namespace fractal_sync::model
+
+#endif /*FSYNC_TRACE_HPP*/
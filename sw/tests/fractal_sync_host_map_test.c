@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization host mapping test: a 4x4 mesh is mapped on a fake sysfs of 2 packages (one NUMA node each)
+ * with 2 L3 slices of 4 two-way SMT cores per package (cpu c and c+16 are siblings, as enumerated by Linux)
+ */
+
+#define _GNU_SOURCE
+
+#define N_CU_X  (4)
+#define N_CU_Y  (4)
+#define N_CORES (16)
+#define N_CPUS  (2*N_CORES)
+
+#include <stdio.h>
+#include <ftw.h>
+#include <sys/stat.h>
+#include "../fractal_sync_req_gen.c"
+#include "../fractal_sync_host_map.c"
+
+static char sysfs[] = "/tmp/fsync_sysfs_XXXXXX";
+
+static void write_file(const char *path, const char *str){
+  FILE *file = fopen(path, "w");
+  if (file == NULL) return;
+  fputs(str, file);
+  fclose(file);
+}
+
+static bool make_sysfs(void){
+  char path[256], str[64];
+  if (mkdtemp(sysfs) == NULL) return false;
+  snprintf(path, sizeof(path), "%s/cpu", sysfs); mkdir(path, 0755);
+  snprintf(path, sizeof(path), "%s/cpu/online", sysfs);
+  snprintf(str, sizeof(str), "0-%d\n", N_CPUS-1); write_file(path, str);
+
+  for (unsigned int cpu = 0; cpu < N_CPUS; cpu++){
+    unsigned int core = cpu%N_CORES, pkg = core/8, l3 = core/4;
+    snprintf(path, sizeof(path), "%s/cpu/cpu%u", sysfs, cpu);          mkdir(path, 0755);
+    snprintf(path, sizeof(path), "%s/cpu/cpu%u/node%u", sysfs, cpu, pkg); mkdir(path, 0755);
+    snprintf(path, sizeof(path), "%s/cpu/cpu%u/topology", sysfs, cpu); mkdir(path, 0755);
+    snprintf(path, sizeof(path), "%s/cpu/cpu%u/topology/physical_package_id", sysfs, cpu);
+    snprintf(str, sizeof(str), "%u\n", pkg); write_file(path, str);
+    snprintf(path, sizeof(path), "%s/cpu/cpu%u/topology/thread_siblings_list", sysfs, cpu);
+    snprintf(str, sizeof(str), "%u,%u\n", core, core+N_CORES); write_file(path, str);
+    snprintf(path, sizeof(path), "%s/cpu/cpu%u/cache", sysfs, cpu); mkdir(path, 0755);
+    for (unsigned int index = 0; index < 3; index++){
+      snprintf(path, sizeof(path), "%s/cpu/cpu%u/cache/index%u", sysfs, cpu, index); mkdir(path, 0755);
+      snprintf(path, sizeof(path), "%s/cpu/cpu%u/cache/index%u/level", sysfs, cpu, index);
+      write_file(path, (index == 2) ? "3\n" : (index == 1) ? "2\n" : "1\n");
+      snprintf(path, sizeof(path), "%s/cpu/cpu%u/cache/index%u/type", sysfs, cpu, index);
+      write_file(path, index ? "Unified\n" : "Data\n");
+      snprintf(path, sizeof(path), "%s/cpu/cpu%u/cache/index%u/shared_cpu_list", sysfs, cpu, index);
+      if (index < 2) snprintf(str, sizeof(str), "%u,%u\n", core, core+N_CORES);
+      else           snprintf(str, sizeof(str), "%u-%u,%u-%u\n", 4*l3, 4*l3+3, 4*l3+N_CORES, 4*l3+3+N_CORES);
+      write_file(path, str);
+    }
+  }
+  return true;
+}
+
+static int remove_entry(const char *path, const struct stat *sb, int type, struct FTW *ftw){
+  (void)sb; (void)type; (void)ftw;
+  return remove(path);
+}
+
+int main(void){
+  unsigned int errors = 0;
+
+  // Describe the FractalSync tree (4x4 mesh with the default local RF sizes and links of hw/trees)
+  fsync_topology_t topo;
+  if (!fsync_topology_init(&topo, N_CU_X, N_CU_Y, NULL, NULL)){
+    printf("FractalSync topology not supported.\n");
+    return 1;
+  }
+  if (!make_sysfs()){
+    printf("Fake sysfs not created.\n");
+    return 1;
+  }
+
+  static fsync_host_map_t maps[2];
+  for (unsigned int order = 0; order < 2; order++){
+    if (!fsync_host_map_init(&maps[order], &topo, order ? tree_fs_map : row_fs_map, sysfs, NULL)){
+      printf("FractalSync host mapping not computed.\n");
+      return 1;
+    }
+    printf("%s order (%0d CPUs):\n", order ? "tree" : "row-major", maps[order].n_cpus);
+    for (unsigned int l = 0; l < topo.n_lvl; l++)
+      printf("  level %0d: h %-7s %6.1f ns, v %-7s %6.1f ns\n", l+1, fsync_host_dom_name(maps[order].lvl_dom[l][0]), maps[order].lvl_cost[l][0],
+             fsync_host_dom_name(maps[order].lvl_dom[l][1]), maps[order].lvl_cost[l][1]);
+  }
+
+  // The h subtrees of the tree order land on a core, a core pair and an L3 slice, the root spans the NUMA node
+  const fsync_host_dom expected[4] = {smt_fs_dom, l3_fs_dom, l3_fs_dom, numa_fs_dom};
+  for (unsigned int l = 0; l < topo.n_lvl; l++)
+    if (maps[1].lvl_dom[l][0] != expected[l]){
+      printf("Level %0d spans %s instead of %s.\n", l+1, fsync_host_dom_name(maps[1].lvl_dom[l][0]), fsync_host_dom_name(expected[l]));
+      errors++;
+    }
+
+  // The global barrier is cheaper in tree order
+  fsync_cu_t cus[N_CU_X*N_CU_Y];
+  for (unsigned int i = 0; i < N_CU_X*N_CU_Y; i++){
+    cus[i].cu_id = i; cus[i].y_pos = i/N_CU_X; cus[i].x_pos = i%N_CU_X;
+  }
+  if (!fsync_gen_reqs(&topo, cus, N_CU_X*N_CU_Y, h_fs_dir)) errors++;
+  double row_cost  = fsync_host_map_req_cost(&maps[0], &topo, &cus[0]);
+  double tree_cost = fsync_host_map_req_cost(&maps[1], &topo, &cus[0]);
+  printf("Global barrier: row-major %.1f ns, tree %.1f ns.\n", row_cost, tree_cost);
+  if (!(tree_cost < row_cost)) errors++;
+
+  nftw(sysfs, remove_entry, 16, FTW_DEPTH | FTW_PHYS);
+  printf("FractalSync host mapping: %0d errors.\n", errors);
+  return errors ? 1 : 0;
+}
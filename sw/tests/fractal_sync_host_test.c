@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization host barrier test (build with -pthread): one thread per CU of a 4x4 mesh runs the global,
+ * row, column and torus neighbor barriers of dv/tb_bfm.sv with the generated requests, and checks that no CU leaves a
+ * barrier before all the CUs of its team have arrived
+ */
+
+#define _GNU_SOURCE
+
+#define N_CU_X   (4)
+#define N_CU_Y   (4)
+#define N_CUS    (N_CU_X*N_CU_Y)
+#define N_ROUNDS (1000)
+
+#include <stdio.h>
+#include "../fractal_sync_req_gen.c"
+#include "../fractal_sync_team_alloc.c"
+#include "../fractal_sync_host.c"
+
+#define N_PATTERNS (6)
+
+static const char *pattern_names[N_PATTERNS] = {"global", "rows", "columns", "torus_h_even", "torus_v_even", "torus_h_odd"};
+
+typedef struct pattern{
+  fsync_cu_t   req[N_CUS];   /* Request of each CU (indexed by cu_id) */
+  unsigned int team[N_CUS];  /* Team of each CU */
+  unsigned int phase[N_CUS]; /* Phase of the team of each CU */
+  unsigned int team_size[N_CUS];
+  unsigned int num_phases;
+} pattern_t;
+
+static fsync_topology_t topo;
+static fsync_host_t     host;
+static pattern_t        patterns[N_PATTERNS];
+static atomic_uint      arrivals[N_PATTERNS][N_CUS];
+static atomic_uint      errors;
+
+static bool set_teams(pattern_t *pattern, fsync_team_t *teams, const unsigned int num_teams, const unsigned int num_phases){
+  pattern->num_phases = num_phases;
+  for (unsigned int t = 0; t < num_teams; t++){
+    if (!teams[t].valid) return false;
+    for (unsigned int i = 0; i < teams[t].num_cus; i++){
+      unsigned int cu_id = teams[t].cus[i].cu_id;
+      pattern->req[cu_id]       = teams[t].cus[i];
+      pattern->team[cu_id]      = t;
+      pattern->phase[cu_id]     = teams[t].phase;
+      pattern->team_size[cu_id] = teams[t].num_cus;
+    }
+  }
+  return true;
+}
+
+static bool gen_patterns(void){
+  fsync_cu_t   cus[N_CUS];
+  fsync_team_t teams[N_CUS];
+  unsigned int num_phases;
+
+  // Global barrier
+  for (unsigned int i = 0; i < N_CUS; i++){
+    cus[i].cu_id = i; cus[i].y_pos = i/N_CU_X; cus[i].x_pos = i%N_CU_X;
+  }
+  teams[0].cus = cus; teams[0].num_cus = N_CUS;
+  if (!fsync_alloc_teams(&topo, teams, 1, h_fs_dir, &num_phases) || !set_teams(&patterns[0], teams, 1, num_phases)) return false;
+
+  // Rows and columns: rows 2k and 2k+1 share the level 3 nodes and use different registers
+  for (unsigned int p = 1; p <= 2; p++){
+    for (unsigned int i = 0; i < N_CUS; i++){
+      unsigned int line = i/N_CU_X, pos = i%N_CU_X;
+      cus[i].y_pos = (p == 1) ? line : pos;
+      cus[i].x_pos = (p == 1) ? pos  : line;
+      cus[i].cu_id = cus[i].y_pos*N_CU_X + cus[i].x_pos;
+    }
+    for (unsigned int t = 0; t < N_CU_Y; t++){
+      teams[t].cus = &cus[t*N_CU_X]; teams[t].num_cus = N_CU_X;
+    }
+    if (!fsync_alloc_teams(&topo, teams, N_CU_Y, (p == 1) ? h_fs_dir : v_fs_dir, &num_phases) ||
+        !set_teams(&patterns[p], teams, N_CU_Y, num_phases)) return false;
+  }
+
+  // Torus neighbor pairs: dedicated neighbor links and lowest common levels
+  for (unsigned int p = 3; p < N_PATTERNS; p++){
+    fsync_dir    dir       = (p == 4) ? v_fs_dir : h_fs_dir;
+    unsigned int num_pairs = fsync_torus_pairs(&topo, dir, p == 5, cus);
+    if (!fsync_gen_nbr_reqs(&topo, cus, num_pairs, dir, teams, &num_phases) || !set_teams(&patterns[p], teams, num_pairs, num_phases)) return false;
+  }
+
+  return true;
+}
+
+static void *cu_thread(void *arg){
+  const unsigned int cu_id = (unsigned int)(size_t)arg;
+
+  for (unsigned int r = 0; r < N_ROUNDS; r++){
+    const unsigned int p       = r%N_PATTERNS;
+    const pattern_t   *pattern = &patterns[p];
+    const unsigned int team    = pattern->team[cu_id];
+    const unsigned int size    = pattern->team_size[cu_id];
+    // Serialized phases are separated by global barriers
+    for (unsigned int phase = 0; phase < pattern->num_phases; phase++){
+      if (pattern->phase[cu_id] == phase){
+        unsigned int before = atomic_fetch_add(&arrivals[p][team], 1);
+        if (!fsync_host_sync(&host, &pattern->req[cu_id])) atomic_fetch_add(&errors, 1);
+        // All the CUs of the team arrived before the wake of this round
+        if (atomic_load(&arrivals[p][team]) < (before/size + 1)*size) atomic_fetch_add(&errors, 1);
+      }
+      if (!fsync_host_sync(&host, &patterns[0].req[cu_id])) atomic_fetch_add(&errors, 1);
+    }
+  }
+  return NULL;
+}
+
+int main(void){
+
+  // Describe the FractalSync tree (4x4 mesh with the default local RF sizes and links of hw/trees)
+  if (!fsync_topology_init(&topo, N_CU_X, N_CU_Y, NULL, NULL)){
+    printf("FractalSync topology not supported.\n");
+    return 1;
+  }
+  if (!gen_patterns()){
+    printf("FractalSync requests not generated.\n");
+    return 1;
+  }
+  for (unsigned int p = 0; p < N_PATTERNS; p++)
+    printf("%s: %0d phase(s)\n", pattern_names[p], patterns[p].num_phases);
+
+  if (!fsync_host_init(&host, &topo)){
+    printf("FractalSync host barrier not initialized.\n");
+    return 1;
+  }
+
+  // Requests the trees would answer with an error
+  fsync_cu_t bad = patterns[0].req[0];
+  bad.fsync_req.fs_req_aggr = 0;
+  if (fsync_host_sync(&host, &bad)) atomic_fetch_add(&errors, 1);
+  bad = patterns[0].req[0];
+  bad.fsync_req.fs_req_id = 2*topo.n_dir_regs[topo.n_lvl-1];
+  if (fsync_host_sync(&host, &bad)) atomic_fetch_add(&errors, 1);
+  bad.fsync_req.fs_req_aggr = 0b1; bad.fsync_req.fs_req_id = 2;
+  if (fsync_host_sync(&host, &bad)) atomic_fetch_add(&errors, 1);
+
+  pthread_t threads[N_CUS];
+  for (unsigned int i = 0; i < N_CUS; i++) pthread_create(&threads[i], NULL, cu_thread, (void *)(size_t)i);
+  for (unsigned int i = 0; i < N_CUS; i++) pthread_join(threads[i], NULL);
+  fsync_host_free(&host);
+
+  printf("FractalSync host barrier: %0d rounds, %0d errors.\n", N_ROUNDS, atomic_load(&errors));
+  return atomic_load(&errors) ? 1 : 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization arbiter model test: the parallel-prefix (PP) arbiter must grant the same inputs to the same
+ * outputs as the fair (FA) arbiter at every cycle, for every size up to 12 inputs and 6 outputs, with random pending
+ * inputs and ready outputs (-std=c++20)
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../model/fractal_sync_model.hpp"
+
+namespace model = fractal_sync::model;
+
+#define MAX_IN_PORTS  (12)
+#define MAX_OUT_PORTS (6)
+#define N_CYCLES      (20000)
+
+int main(){
+  unsigned int errors = 0;
+  unsigned int cycles = 0;
+
+  std::srand(1);
+  for (unsigned int in_ports = 1; in_ports <= MAX_IN_PORTS; in_ports++){
+    for (unsigned int out_ports = 1; out_ports <= MAX_OUT_PORTS; out_ports++){
+      model::arbiter fa, pp;
+      fa.init(model::arb_e::fa, in_ports, out_ports);
+      pp.init(model::arb_e::pp, in_ports, out_ports);
+
+      std::vector<char> empty(in_ports), ready(out_ports), fa_pop(in_ports), pp_pop(in_ports);
+      std::vector<int>  fa_sel(out_ports), pp_sel(out_ports);
+      unsigned int mismatches = 0;
+      for (unsigned int c = 0; c < N_CYCLES; c++){
+        /* Sweep the input load from sparse to saturated; outputs are back-pressured one cycle in four on average */
+        const unsigned int load = c % 4;
+        for (auto &e : empty) e = static_cast<unsigned int>(std::rand() % 4) > load;
+        for (auto &r : ready) r = (std::rand() % 4) != 0;
+        const char *rdy = (c & 1) ? ready.data() : nullptr;
+
+        fa.eval(empty.data(), fa_sel.data(), fa_pop.data(), rdy);
+        pp.eval(empty.data(), pp_sel.data(), pp_pop.data(), rdy);
+        if (fa_sel != pp_sel || fa_pop != pp_pop){
+          if (!mismatches) std::printf("%0dx%0d arbiter, cycle %0d: PP grants differ from FA\n", in_ports, out_ports, c);
+          mismatches++;
+        }
+        fa.commit();
+        pp.commit();
+        cycles++;
+      }
+      errors += mismatches;
+    }
+  }
+
+  std::printf("FractalSync PP arbiter model: %0d cycles, %0d errors.\n", cycles, errors);
+
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization remote RF model test: the trees of the 4x4, 8x8 and 16x16 presets with SA remote RFs on
+ * every level must issue and wake every transaction of the BFM tests and streams at the same cycles as with CAM remote
+ * RFs of the same size. Flow control keeps the random computation skews from overflowing the FIFOs (-std=c++20)
+ */
+
+#include <cstdio>
+#include <vector>
+#include "../model/fractal_sync_model.hpp"
+#include "../model/fractal_sync_bfm.hpp"
+
+namespace model = fractal_sync::model;
+
+#define STREAM_ITERATIONS (16)
+
+// Every BFM test once, then streamed back-to-back with random computation: the recorded transactions of the run
+static std::vector<model::trace_record_t> run_tests(const model::config_t &cfg, unsigned int &errors){
+  model::network                     net(cfg);
+  model::bfm_t<model::network>       bfm(net, net.n_cu(), 0, 4, 4, 1);
+  std::vector<model::trace_record_t> trace;
+  bfm.record(&trace);
+  for (unsigned int t = 0; t < model::n_bfm_tests; t++){
+    bfm.run(model::bfm_test(t, cfg.n_cu_x));
+    errors += bfm.hung();
+  }
+  for (unsigned int t = 0; t < model::n_bfm_tests; t++){
+    bfm.stream(model::bfm_test(t, cfg.n_cu_x), STREAM_ITERATIONS);
+    errors += bfm.hung();
+  }
+  errors += bfm.errors();
+  return trace;
+}
+
+int main(){
+  unsigned int errors = 0;
+
+  for (unsigned int n_cu_x = 4; n_cu_x <= 16; n_cu_x *= 2){
+    model::config_t cam = model::preset(n_cu_x);
+    cam.flow_ctrl  = true;
+    cam.fifo_depth = 2;
+    model::config_t sa = cam;
+    for (auto &rf : cam.rf_type_1d) rf = model::remote_rf_e::cam;
+    for (auto &rf : cam.rf_type_2d) rf = model::remote_rf_e::cam;
+    for (auto &rf : sa.rf_type_1d)  rf = model::remote_rf_e::sa;
+    for (auto &rf : sa.rf_type_2d)  rf = model::remote_rf_e::sa;
+
+    unsigned int cam_errors = 0, sa_errors = 0;
+    const std::vector<model::trace_record_t> cam_trace = run_tests(cam, cam_errors);
+    const std::vector<model::trace_record_t> sa_trace  = run_tests(sa, sa_errors);
+
+    unsigned int mismatches = (cam_trace.size() != sa_trace.size());
+    for (std::size_t r = 0; !mismatches && r < cam_trace.size(); r++){
+      const model::trace_record_t &c = cam_trace[r], &s = sa_trace[r];
+      if (c.cu != s.cu || c.level != s.level || c.aggregate != s.aggregate || c.id != s.id || c.issue != s.issue ||
+          c.wake != s.wake || c.flags != s.flags){
+        std::printf("%0dx%0d transaction %0zu (CU %0d, level %0d, id %0d): CAM issue %0d wake %0d, SA issue %0d wake %0d\n",
+                    n_cu_x, n_cu_x, r, c.cu, c.level, c.id, c.issue, c.wake, s.issue, s.wake);
+        mismatches++;
+      }
+    }
+    std::printf("%0dx%0d: %0zu transactions, %0d CAM errors, %0d SA errors, %0d mismatches\n",
+                n_cu_x, n_cu_x, cam_trace.size(), cam_errors, sa_errors, mismatches);
+    errors += cam_errors + sa_errors + mismatches;
+  }
+
+  std::printf("FractalSync remote RF model: %0d errors.\n", errors);
+
+  return errors ? 1 : 0;
+}
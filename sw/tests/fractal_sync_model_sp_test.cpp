@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization split-phase endpoint model test (same sequence as dv/tb_sp): a full table rejects arrives
+ * and drops (reports) wakes without a pending line, every latched wake is consumed once by its wait, and an arrive at
+ * a barrier with a stale woken line reuses the line instead of letting the stale wake satisfy the next wait
+ * (-std=c++20)
+ */
+
+#include <cstdio>
+#include "../model/fractal_sync_model.hpp"
+
+namespace model = fractal_sync::model;
+
+#define N_BARRIERS (4)
+
+static unsigned int errors = 0;
+
+static void check(const bool cond, const char *what){
+  if (!cond){
+    std::printf("[ERROR] %s\n", what);
+    errors++;
+  }
+}
+
+/* One cycle of the endpoint: optional arrive at (lvl, id), network response rsp, wait for (wait_lvl, wait_id) */
+static bool cycle(model::split_phase &sp, const model::rsp_t &rsp, const bool wait = false, const unsigned int wait_lvl = 0, const unsigned int wait_id = 0){
+  const bool done = sp.eval(rsp, wait, wait_lvl, wait_id);
+  sp.commit();
+  return done;
+}
+
+int main(){
+  const model::rsp_t idle = {false, 0, 0, false, true};
+  model::split_phase sp;
+  sp.init(N_BARRIERS);
+
+  // Fill the table with pending barriers: the next arrive is rejected
+  for (unsigned int b = 0; b < N_BARRIERS; b++){
+    check(sp.ready(), "table full before N_BARRIERS arrives");
+    sp.arrive(2, b);
+    cycle(sp, idle);
+    check(sp.accepted(), "arrive with free lines rejected");
+  }
+  check(!sp.ready(), "full table ready");
+  sp.arrive(2, N_BARRIERS);
+  cycle(sp, idle);
+  check(!sp.accepted(), "arrive with a full table accepted");
+  sp.arrive(2, 0);
+  cycle(sp, idle);
+  check(!sp.accepted(), "arrive at a pending barrier accepted");
+
+  // Wake every pending barrier, then a barrier without a pending line: no free line, the wake is dropped and reported
+  for (unsigned int b = 0; b < N_BARRIERS; b++){
+    cycle(sp, model::rsp_t{true, 2, b, false, true});
+    check(!sp.overflow(), "wake of a pending barrier dropped");
+  }
+  cycle(sp, model::rsp_t{true, 2, N_BARRIERS, false, true});
+  check(sp.overflow(), "wake dropped by a full table not reported");
+
+  // Every latched wake satisfies one wait, in any order, and frees its line
+  for (unsigned int b = N_BARRIERS; b-- > 0;){
+    check(cycle(sp, idle, true, 2, b), "latched wake not consumed by its wait");
+    check(!cycle(sp, idle, true, 2, b), "latched wake consumed twice");
+  }
+  check(sp.occupancy() == 0, "lines not freed by the waits");
+
+  // Stale wake: woken but never waited for, then the CU arrives again at the same barrier
+  sp.arrive(3, 1);
+  cycle(sp, idle);
+  cycle(sp, model::rsp_t{true, 3, 1, false, true});
+  sp.arrive(3, 1);
+  cycle(sp, idle);
+  check(sp.accepted(), "arrive at a barrier with a stale wake rejected");
+  check(sp.occupancy() == 1, "stale woken line not reused");
+  check(!cycle(sp, idle, true, 3, 1), "stale wake satisfied the wait of the new arrive");
+  check(cycle(sp, model::rsp_t{true, 3, 1, false, true}, true, 3, 1), "wake of the new arrive not consumed");
+  check(sp.occupancy() == 0, "line not freed by the wait");
+
+  std::printf("FractalSync split-phase model: %0d errors.\n", errors);
+
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization model test: barriers of the constexpr generator on the 4x4 model, FIFO
+ * capacity and reuse of the direct-mapped remote RF registers on the 32x32 model (-std=c++20)
+ */
+
+#include <cstdio>
+#include <vector>
+#include "../fractal_sync_req_gen.hpp"
+#include "../model/fractal_sync_model.hpp"
+#include "../model/fractal_sync_bfm.hpp"
+
+#define N_CU_X (4)
+
+namespace model = fractal_sync::model;
+
+// Issue the barrier of the given CUs at the same cycle: returns the latency (cycles) or 0 if a CU is not woken up properly
+unsigned int run_barrier(model::network &net, const std::vector<fsync::cu_t> &cus){
+  std::vector<fsync::req_t> reqs(cus.size());
+  if (!fsync::gen_reqs(N_CU_X, N_CU_X, cus, reqs)) return 0;
+
+  std::vector<bool> woken(cus.size(), false);
+  unsigned int      n_woken = 0;
+  for (unsigned int cycle = 0; cycle < 1000; cycle++){
+    for (std::size_t i = 0; i < cus.size(); i++){
+      const unsigned int cu  = cus[i].y_pos*N_CU_X + cus[i].x_pos;
+      model::req_t      &req = (reqs[i].req_node == fsync::node_e::v) ? net.v_tree_req(cu) : net.h_tree_req(cu);
+      req = model::req_t{cycle == 0, reqs[i].fs_req_aggr, reqs[i].fs_req_id, true};
+    }
+    net.eval();
+    for (std::size_t i = 0; i < cus.size(); i++){
+      const unsigned int  cu  = cus[i].y_pos*N_CU_X + cus[i].x_pos;
+      const model::rsp_t &rsp = (reqs[i].req_node == fsync::node_e::v) ? net.v_tree_rsp(cu) : net.h_tree_rsp(cu);
+      if (!rsp.wake || woken[i]) continue;
+      if (rsp.error || rsp.id != reqs[i].fs_req_id) return 0;
+      woken[i] = true;
+      n_woken++;
+    }
+    net.tick();
+    if (n_woken == cus.size()) return cycle;
+  }
+  return 0;
+}
+
+int main(){
+  model::network net(model::preset(N_CU_X));
+  unsigned int   errors = 0;
+
+  // Rows, columns and the whole mesh
+  for (unsigned int r = 0; r < N_CU_X; r++){
+    std::vector<fsync::cu_t> row, col;
+    for (unsigned int c = 0; c < N_CU_X; c++){
+      row.push_back(fsync::cu_t{r, c});
+      col.push_back(fsync::cu_t{c, r});
+    }
+    const unsigned int row_lat = run_barrier(net, row);
+    const unsigned int col_lat = run_barrier(net, col);
+    std::printf("row %0d: %0d cycles, column %0d: %0d cycles\n", r, row_lat, r, col_lat);
+    errors += (row_lat == 0) + (col_lat == 0);
+  }
+  std::vector<fsync::cu_t> all;
+  for (unsigned int i = 0; i < N_CU_X*N_CU_X; i++) all.push_back(fsync::cu_t{i/N_CU_X, i%N_CU_X});
+  const unsigned int global_lat = run_barrier(net, all);
+  std::printf("global: %0d cycles\n", global_lat);
+  errors += (global_lat == 0);
+
+  // A FIFO holds (at least) FIFO_DEPTH elements, in order: the credits of a link are sized on it
+  for (unsigned int depth = 1; depth <= 8; depth++){
+    model::fifo<unsigned int> fifo;
+    fifo.init(depth, false);
+    unsigned int pushed = 0;
+    while (!fifo.full() && pushed < 16) fifo.commit(true, pushed++, false);
+    unsigned int popped = 0;
+    while (!fifo.empty_fifo()){
+      errors += (fifo.element(false, 0) != popped++);
+      fifo.commit(false, 0, true);
+    }
+    if (pushed < depth || popped != pushed) std::printf("FIFO_DEPTH %0d: %0d elements stored.\n", depth, pushed);
+    errors += (pushed < depth) + (popped != pushed);
+  }
+
+  // Torus pairs after the rows of the same level and ids: the registers of the rows must not keep the ports of their
+  // subtrees, or the wakes of the pairs are routed into them and leave set registers behind
+  {
+    model::network               dm_net(model::preset(32));
+    model::bfm_t<model::network> bfm(dm_net, dm_net.n_cu(), 0, 0, 0, 1);
+    bfm.run(model::bfm_test(4, 32));
+    bfm.run(model::bfm_test(1, 32));
+    const unsigned int remote = dm_net.occupancy().remote_regs;
+    std::printf("32x32 row_sync then nbr_h_tor_sync: %0d registers left set\n", remote);
+    errors += bfm.errors() + (remote != 0);
+  }
+
+  std::printf("FractalSync model: %0d errors.\n", errors);
+
+  return errors ? 1 : 0;
+}
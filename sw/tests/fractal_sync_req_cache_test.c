@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ * 
+ * Fractal synchronization request cache test
+ */
+
+#define N_CU_X     (4)
+#define N_CU_Y     (4)
+#define N_ENTRIES  (8)
+#define MAX_CUS    (N_CU_X*N_CU_Y)
+#define N_ITERS    (4)
+
+#include <stdio.h>
+#include "../fractal_sync_req_gen.c"
+#include "../fractal_sync_req_cache.c"
+
+int main(void){
+
+  // Describe the FractalSync tree (4x4 mesh with the default local RF sizes and links of hw/trees)
+  fsync_topology_t topo;
+  if (!fsync_topology_init(&topo, N_CU_X, N_CU_Y, NULL, NULL)){
+    printf("FractalSync topology not supported.\n");
+    return 1;
+  }
+
+  // Build the request cache over a statically allocated memory region
+  static uint64_t   cache_mem[1024];
+  fsync_req_cache_t cache;
+  if (fsync_req_cache_size(&topo, N_ENTRIES, MAX_CUS) > sizeof(cache_mem) ||
+      !fsync_req_cache_init(&cache, &topo, N_ENTRIES, MAX_CUS, cache_mem, sizeof(cache_mem))){
+    printf("FractalSync request cache not initialized.\n");
+    return 1;
+  }
+
+  // Synchronize every row and then every column N_ITERS times, compare with the generator
+  unsigned int errors = 0;
+  for (unsigned int iter = 0; iter < N_ITERS; iter++){
+    for (unsigned int dir = 0; dir < 2; dir++){
+      for (unsigned int line = 0; line < N_CU_Y; line++){
+        fsync_cu_t cus[N_CU_X];
+        fsync_cu_t ref_cus[N_CU_X];
+        for (unsigned int i = 0; i < N_CU_X; i++){
+          // Visit the CUs in a different order at every iteration: requests follow the CU, not the index
+          unsigned int j = (i + iter) % N_CU_X;
+          cus[i].y_pos = (dir == 0) ? line : j;
+          cus[i].x_pos = (dir == 0) ? j : line;
+          cus[i].cu_id = cus[i].y_pos*N_CU_X + cus[i].x_pos;
+          ref_cus[i]   = cus[i];
+        }
+        bool generated_reqs     = fsync_req_cache_gen_reqs(&cache, cus, N_CU_X, h_fs_dir);
+        bool ref_generated_reqs = fsync_gen_reqs(&topo, ref_cus, N_CU_X, h_fs_dir);
+        if (generated_reqs != ref_generated_reqs) errors++;
+        for (unsigned int i = 0; i < N_CU_X; i++){
+          if (cus[i].fsync_req.fs_req_aggr != ref_cus[i].fsync_req.fs_req_aggr ||
+              cus[i].fsync_req.fs_req_id   != ref_cus[i].fsync_req.fs_req_id   ||
+              cus[i].fsync_req.req_node    != ref_cus[i].fsync_req.req_node) errors++;
+        }
+      }
+    }
+  }
+
+  printf("FractalSync request cache: %lu hits, %lu misses, %lu bypasses, %0d errors.\n", cache.hits, cache.misses, cache.bypasses, errors);
+
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,371 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ * 
+ * Fractal synchronization request (id, aggregate) generator test corpus, shared by the C and C++ generators
+ *
+ * Flat list of entries, terminated by 0:
+ *  n_cu_x, default_dir, num_cus, generated, followed by num_cus times {y_pos, x_pos, fs_req_aggr, fs_req_id, req_node}
+ */
+
+#ifndef FSYNC_REQ_GEN_CORPUS_H
+#define FSYNC_REQ_GEN_CORPUS_H
+
+#ifdef __cplusplus
+#define FSYNC_CORPUS_CONST constexpr
+#else
+#define FSYNC_CORPUS_CONST static const
+#endif
+
+#define FSYNC_CORPUS_HEADER (4)
+#define FSYNC_CORPUS_CU     (5)
+
+FSYNC_CORPUS_CONST unsigned int fsync_req_gen_corpus[] = {
+  /* 2x2 subset 0x1, h */
+  2, 0, 1, 0,
+    0, 0, 0x0, 0, 0,
+  /* 2x2 subset 0x3, h */
+  2, 0, 2, 1,
+    0, 0, 0x1, 0, 1, 0, 1, 0x1, 0, 1,
+  /* 2x2 subset 0x3, v */
+  2, 1, 2, 1,
+    0, 0, 0x1, 0, 1, 0, 1, 0x1, 0, 1,
+  /* 2x2 subset 0x5, h */
+  2, 0, 2, 1,
+    0, 0, 0x1, 1, 2, 1, 0, 0x1, 1, 2,
+  /* 2x2 subset 0x5, v */
+  2, 1, 2, 1,
+    0, 0, 0x1, 1, 2, 1, 0, 0x1, 1, 2,
+  /* 2x2 subset 0x6, h */
+  2, 0, 2, 1,
+    0, 1, 0x2, 0, 1, 1, 0, 0x2, 0, 1,
+  /* 2x2 subset 0x6, v */
+  2, 1, 2, 1,
+    0, 1, 0x2, 1, 2, 1, 0, 0x2, 1, 2,
+  /* 2x2 subset 0x7, h */
+  2, 0, 3, 1,
+    0, 0, 0x3, 0, 3, 0, 1, 0x3, 0, 3, 1, 0, 0x2, 0, 3,
+  /* 2x2 subset 0x7, v */
+  2, 1, 3, 1,
+    0, 0, 0x3, 1, 3, 0, 1, 0x2, 1, 3, 1, 0, 0x3, 1, 3,
+  /* 2x2 subset 0x9, h */
+  2, 0, 2, 1,
+    0, 0, 0x2, 0, 1, 1, 1, 0x2, 0, 1,
+  /* 2x2 subset 0x9, v */
+  2, 1, 2, 1,
+    0, 0, 0x2, 1, 2, 1, 1, 0x2, 1, 2,
+  /* 2x2 subset 0xa, h */
+  2, 0, 2, 1,
+    0, 1, 0x1, 1, 2, 1, 1, 0x1, 1, 2,
+  /* 2x2 subset 0xa, v */
+  2, 1, 2, 1,
+    0, 1, 0x1, 1, 2, 1, 1, 0x1, 1, 2,
+  /* 2x2 subset 0xb, h */
+  2, 0, 3, 1,
+    0, 0, 0x3, 0, 3, 0, 1, 0x3, 0, 3, 1, 1, 0x2, 0, 3,
+  /* 2x2 subset 0xb, v */
+  2, 1, 3, 1,
+    0, 0, 0x2, 1, 3, 0, 1, 0x3, 1, 3, 1, 1, 0x3, 1, 3,
+  /* 2x2 subset 0xc, h */
+  2, 0, 2, 1,
+    1, 0, 0x1, 0, 1, 1, 1, 0x1, 0, 1,
+  /* 2x2 subset 0xc, v */
+  2, 1, 2, 1,
+    1, 0, 0x1, 0, 1, 1, 1, 0x1, 0, 1,
+  /* 2x2 subset 0xd, h */
+  2, 0, 3, 1,
+    0, 0, 0x2, 0, 3, 1, 0, 0x3, 0, 3, 1, 1, 0x3, 0, 3,
+  /* 2x2 subset 0xd, v */
+  2, 1, 3, 1,
+    0, 0, 0x3, 1, 3, 1, 0, 0x3, 1, 3, 1, 1, 0x2, 1, 3,
+  /* 2x2 subset 0xe, h */
+  2, 0, 3, 1,
+    0, 1, 0x2, 0, 3, 1, 0, 0x3, 0, 3, 1, 1, 0x3, 0, 3,
+  /* 2x2 subset 0xe, v */
+  2, 1, 3, 1,
+    0, 1, 0x3, 1, 3, 1, 0, 0x2, 1, 3, 1, 1, 0x3, 1, 3,
+  /* 2x2 subset 0xf, h */
+  2, 0, 4, 1,
+    0, 0, 0x3, 0, 3, 0, 1, 0x3, 0, 3, 1, 0, 0x3, 0, 3, 1, 1, 0x3, 0, 3,
+  /* 2x2 subset 0xf, v */
+  2, 1, 4, 1,
+    0, 0, 0x3, 1, 3, 0, 1, 0x3, 1, 3, 1, 0, 0x3, 1, 3, 1, 1, 0x3, 1, 3,
+  /* 4x4 test example, h */
+  4, 0, 8, 1,
+    0, 0, 0xe, 0, 3, 1, 1, 0xe, 0, 3, 0, 2, 0xd, 0, 3, 0, 3, 0xd, 0, 3,
+    2, 0, 0xc, 0, 3, 2, 2, 0xf, 0, 3, 2, 3, 0xf, 0, 3, 3, 3, 0xe, 0, 3,
+  /* 4x4 test example, v */
+  4, 1, 8, 1,
+    0, 0, 0xe, 1, 3, 1, 1, 0xe, 1, 3, 0, 2, 0xd, 1, 3, 0, 3, 0xd, 1, 3,
+    2, 0, 0xc, 1, 3, 2, 2, 0xe, 1, 3, 2, 3, 0xf, 1, 3, 3, 3, 0xf, 1, 3,
+  /* 4x4 row 0, h */
+  4, 0, 4, 1,
+    0, 0, 0x5, 0, 1, 0, 1, 0x5, 0, 1, 0, 2, 0x5, 0, 1, 0, 3, 0x5, 0, 1,
+  /* 4x4 row 1, h */
+  4, 0, 4, 1,
+    1, 0, 0x5, 0, 1, 1, 1, 0x5, 0, 1, 1, 2, 0x5, 0, 1, 1, 3, 0x5, 0, 1,
+  /* 4x4 row 2, h */
+  4, 0, 4, 1,
+    2, 0, 0x5, 0, 1, 2, 1, 0x5, 0, 1, 2, 2, 0x5, 0, 1, 2, 3, 0x5, 0, 1,
+  /* 4x4 row 3, h */
+  4, 0, 4, 1,
+    3, 0, 0x5, 0, 1, 3, 1, 0x5, 0, 1, 3, 2, 0x5, 0, 1, 3, 3, 0x5, 0, 1,
+  /* 4x4 column 0, v */
+  4, 1, 4, 1,
+    0, 0, 0x5, 1, 2, 1, 0, 0x5, 1, 2, 2, 0, 0x5, 1, 2, 3, 0, 0x5, 1, 2,
+  /* 4x4 column 1, v */
+  4, 1, 4, 1,
+    0, 1, 0x5, 1, 2, 1, 1, 0x5, 1, 2, 2, 1, 0x5, 1, 2, 3, 1, 0x5, 1, 2,
+  /* 4x4 column 2, v */
+  4, 1, 4, 1,
+    0, 2, 0x5, 1, 2, 1, 2, 0x5, 1, 2, 2, 2, 0x5, 1, 2, 3, 2, 0x5, 1, 2,
+  /* 4x4 column 3, v */
+  4, 1, 4, 1,
+    0, 3, 0x5, 1, 2, 1, 3, 0x5, 1, 2, 2, 3, 0x5, 1, 2, 3, 3, 0x5, 1, 2,
+  /* 4x4 quadrant 0, h */
+  4, 0, 4, 1,
+    0, 0, 0x3, 0, 3, 0, 1, 0x3, 0, 3, 1, 0, 0x3, 0, 3, 1, 1, 0x3, 0, 3,
+  /* 4x4 quadrant 2, v */
+  4, 1, 4, 1,
+    2, 0, 0x3, 1, 3, 2, 1, 0x3, 1, 3, 3, 0, 0x3, 1, 3, 3, 1, 0x3, 1, 3,
+  /* 4x4 global, h */
+  4, 0, 16, 1,
+    0, 0, 0xf, 0, 3, 0, 1, 0xf, 0, 3, 0, 2, 0xf, 0, 3, 0, 3, 0xf, 0, 3,
+    1, 0, 0xf, 0, 3, 1, 1, 0xf, 0, 3, 1, 2, 0xf, 0, 3, 1, 3, 0xf, 0, 3,
+    2, 0, 0xf, 0, 3, 2, 1, 0xf, 0, 3, 2, 2, 0xf, 0, 3, 2, 3, 0xf, 0, 3,
+    3, 0, 0xf, 0, 3, 3, 1, 0xf, 0, 3, 3, 2, 0xf, 0, 3, 3, 3, 0xf, 0, 3,
+  /* 4x4 global, v */
+  4, 1, 16, 1,
+    0, 0, 0xf, 1, 3, 0, 1, 0xf, 1, 3, 0, 2, 0xf, 1, 3, 0, 3, 0xf, 1, 3,
+    1, 0, 0xf, 1, 3, 1, 1, 0xf, 1, 3, 1, 2, 0xf, 1, 3, 1, 3, 0xf, 1, 3,
+    2, 0, 0xf, 1, 3, 2, 1, 0xf, 1, 3, 2, 2, 0xf, 1, 3, 2, 3, 0xf, 1, 3,
+    3, 0, 0xf, 1, 3, 3, 1, 0xf, 1, 3, 3, 2, 0xf, 1, 3, 3, 3, 0xf, 1, 3,
+  /* 4x4 columns 1-2, h */
+  4, 0, 8, 1,
+    0, 1, 0xd, 0, 3, 0, 2, 0xd, 0, 3, 1, 1, 0xd, 0, 3, 1, 2, 0xd, 0, 3,
+    2, 1, 0xd, 0, 3, 2, 2, 0xd, 0, 3, 3, 1, 0xd, 0, 3, 3, 2, 0xd, 0, 3,
+  /* 4x4 rows 1-2, v */
+  4, 1, 8, 1,
+    1, 0, 0xd, 1, 3, 1, 1, 0xd, 1, 3, 1, 2, 0xd, 1, 3, 1, 3, 0xd, 1, 3,
+    2, 0, 0xd, 1, 3, 2, 1, 0xd, 1, 3, 2, 2, 0xd, 1, 3, 2, 3, 0xd, 1, 3,
+  /* 4x4 h neighbor pair, h */
+  4, 0, 2, 1,
+    0, 1, 0x1, 2, 1, 0, 2, 0x1, 2, 1,
+  /* 4x4 h neighbor pair, v */
+  4, 1, 2, 1,
+    0, 1, 0x1, 2, 1, 0, 2, 0x1, 2, 1,
+  /* 4x4 h leaf pair, h */
+  4, 0, 2, 1,
+    0, 0, 0x1, 0, 1, 0, 1, 0x1, 0, 1,
+  /* 4x4 h leaf pair, v */
+  4, 1, 2, 1,
+    0, 0, 0x1, 0, 1, 0, 1, 0x1, 0, 1,
+  /* 4x4 v neighbor pair, h */
+  4, 0, 2, 1,
+    1, 0, 0x1, 3, 2, 2, 0, 0x1, 3, 2,
+  /* 4x4 v neighbor pair, v */
+  4, 1, 2, 1,
+    1, 0, 0x1, 3, 2, 2, 0, 0x1, 3, 2,
+  /* 4x4 v leaf pair, h */
+  4, 0, 2, 1,
+    2, 3, 0x1, 1, 2, 3, 3, 0x1, 1, 2,
+  /* 4x4 v leaf pair, v */
+  4, 1, 2, 1,
+    2, 3, 0x1, 1, 2, 3, 3, 0x1, 1, 2,
+  /* 4x4 diagonal pair, h */
+  4, 0, 2, 1,
+    0, 0, 0x2, 0, 1, 1, 1, 0x2, 0, 1,
+  /* 4x4 diagonal pair, v */
+  4, 1, 2, 1,
+    0, 0, 0x2, 1, 2, 1, 1, 0x2, 1, 2,
+  /* 4x4 distant pair, h */
+  4, 0, 2, 1,
+    0, 0, 0x8, 0, 1, 3, 3, 0x8, 0, 1,
+  /* 4x4 distant pair, v */
+  4, 1, 2, 1,
+    0, 0, 0x8, 1, 2, 3, 3, 0x8, 1, 2,
+  /* 4x4 row-end pair, h */
+  4, 0, 2, 1,
+    0, 0, 0x4, 0, 1, 0, 3, 0x4, 0, 1,
+  /* 4x4 row-end pair, v */
+  4, 1, 2, 1,
+    0, 0, 0x4, 0, 1, 0, 3, 0x4, 0, 1,
+  /* 4x4 repeated CU, h */
+  4, 0, 2, 0,
+    1, 2, 0x0, 0, 0, 1, 2, 0x0, 0, 0,
+  /* 4x4 repeated CU, v */
+  4, 1, 2, 0,
+    1, 2, 0x0, 0, 0, 1, 2, 0x0, 0, 0,
+  /* 4x4 single CU, h */
+  4, 0, 1, 0,
+    2, 1, 0x0, 0, 0,
+  /* 4x4 random, h */
+  4, 0, 4, 1,
+    1, 3, 0x8, 0, 3, 2, 3, 0xe, 0, 3, 3, 0, 0xc, 0, 3, 3, 2, 0xe, 0, 3,
+  /* 4x4 random, h */
+  4, 0, 4, 1,
+    1, 0, 0xd, 0, 3, 1, 1, 0xd, 0, 3, 1, 3, 0xc, 0, 3, 2, 0, 0x8, 0, 3,
+  /* 4x4 random, h */
+  4, 0, 9, 1,
+    0, 1, 0xd, 0, 3, 0, 2, 0xe, 0, 3, 1, 1, 0xd, 0, 3, 1, 2, 0xf, 0, 3,
+    1, 3, 0xf, 0, 3, 2, 0, 0xe, 0, 3, 2, 3, 0xd, 0, 3, 3, 1, 0xe, 0, 3,
+    3, 3, 0xd, 0, 3,
+  /* 4x4 random, h */
+  4, 0, 3, 1,
+    1, 1, 0x8, 0, 3, 2, 0, 0xc, 0, 3, 2, 3, 0xc, 0, 3,
+  /* 4x4 random, h */
+  4, 0, 4, 1,
+    0, 1, 0xa, 0, 3, 1, 0, 0xb, 0, 3, 1, 1, 0xb, 0, 3, 3, 3, 0x8, 0, 3,
+  /* 4x4 random, h */
+  4, 0, 3, 1,
+    0, 1, 0x8, 0, 3, 2, 1, 0xc, 0, 3, 3, 2, 0xc, 0, 3,
+  /* 4x4 random, v */
+  4, 1, 5, 1,
+    0, 1, 0xe, 1, 3, 1, 0, 0xe, 1, 3, 2, 0, 0xc, 1, 3, 3, 2, 0x9, 1, 3,
+    3, 3, 0x9, 1, 3,
+  /* 4x4 random, v */
+  4, 1, 4, 1,
+    0, 0, 0x5, 0, 1, 0, 1, 0x5, 0, 1, 0, 2, 0x5, 0, 1, 1, 2, 0x5, 0, 1,
+  /* 4x4 random, v */
+  4, 1, 5, 1,
+    0, 1, 0x9, 1, 3, 0, 2, 0xc, 1, 3, 1, 1, 0x9, 1, 3, 2, 2, 0xe, 1, 3,
+    3, 3, 0xe, 1, 3,
+  /* 4x4 random, h */
+  4, 0, 3, 1,
+    1, 1, 0xc, 0, 3, 1, 2, 0xc, 0, 3, 3, 0, 0x8, 0, 3,
+  /* 4x4 random, v */
+  4, 1, 7, 1,
+    1, 0, 0xd, 1, 3, 1, 1, 0xd, 1, 3, 1, 2, 0xd, 1, 3, 1, 3, 0xd, 1, 3,
+    2, 2, 0xe, 1, 3, 3, 1, 0xc, 1, 3, 3, 3, 0xe, 1, 3,
+  /* 8x8 row 3, h */
+  8, 0, 8, 1,
+    3, 0, 0x15, 0, 1, 3, 1, 0x15, 0, 1, 3, 2, 0x15, 0, 1, 3, 3, 0x15, 0, 1,
+    3, 4, 0x15, 0, 1, 3, 5, 0x15, 0, 1, 3, 6, 0x15, 0, 1, 3, 7, 0x15, 0, 1,
+  /* 8x8 column 6, v */
+  8, 1, 8, 1,
+    0, 6, 0x15, 1, 2, 1, 6, 0x15, 1, 2, 2, 6, 0x15, 1, 2, 3, 6, 0x15, 1, 2,
+    4, 6, 0x15, 1, 2, 5, 6, 0x15, 1, 2, 6, 6, 0x15, 1, 2, 7, 6, 0x15, 1, 2,
+  /* 8x8 quadrant 2, h */
+  8, 0, 16, 1,
+    4, 0, 0xf, 0, 3, 4, 1, 0xf, 0, 3, 4, 2, 0xf, 0, 3, 4, 3, 0xf, 0, 3,
+    5, 0, 0xf, 0, 3, 5, 1, 0xf, 0, 3, 5, 2, 0xf, 0, 3, 5, 3, 0xf, 0, 3,
+    6, 0, 0xf, 0, 3, 6, 1, 0xf, 0, 3, 6, 2, 0xf, 0, 3, 6, 3, 0xf, 0, 3,
+    7, 0, 0xf, 0, 3, 7, 1, 0xf, 0, 3, 7, 2, 0xf, 0, 3, 7, 3, 0xf, 0, 3,
+  /* 8x8 centre block, v */
+  8, 1, 16, 1,
+    2, 2, 0x33, 1, 3, 2, 3, 0x33, 1, 3, 2, 4, 0x33, 1, 3, 2, 5, 0x33, 1, 3,
+    3, 2, 0x33, 1, 3, 3, 3, 0x33, 1, 3, 3, 4, 0x33, 1, 3, 3, 5, 0x33, 1, 3,
+    4, 2, 0x33, 1, 3, 4, 3, 0x33, 1, 3, 4, 4, 0x33, 1, 3, 4, 5, 0x33, 1, 3,
+    5, 2, 0x33, 1, 3, 5, 3, 0x33, 1, 3, 5, 4, 0x33, 1, 3, 5, 5, 0x33, 1, 3,
+  /* 8x8 h neighbor pair, h */
+  8, 0, 2, 1,
+    5, 3, 0x1, 2, 1, 5, 4, 0x1, 2, 1,
+  /* 8x8 v neighbor pair, v */
+  8, 1, 2, 1,
+    3, 6, 0x1, 3, 2, 4, 6, 0x1, 3, 2,
+  /* 8x8 distant pair, h */
+  8, 0, 2, 1,
+    0, 0, 0x20, 0, 1, 7, 7, 0x20, 0, 1,
+  /* 8x8 anti-diagonal pair, v */
+  8, 1, 2, 1,
+    0, 7, 0x20, 1, 2, 7, 0, 0x20, 1, 2,
+  /* 8x8 column pair, h */
+  8, 0, 2, 1,
+    2, 1, 0x10, 1, 2, 6, 1, 0x10, 1, 2,
+  /* 8x8 random, v */
+  8, 1, 3, 1,
+    5, 1, 0x10, 0, 1, 5, 6, 0x18, 0, 1, 7, 5, 0x18, 0, 1,
+  /* 8x8 random, v */
+  8, 1, 20, 1,
+    0, 0, 0x37, 1, 3, 0, 1, 0x37, 1, 3, 0, 3, 0x36, 1, 3, 0, 6, 0x39, 1, 3,
+    0, 7, 0x39, 1, 3, 1, 0, 0x37, 1, 3, 1, 1, 0x37, 1, 3, 1, 2, 0x36, 1, 3,
+    1, 4, 0x3c, 1, 3, 3, 4, 0x3c, 1, 3, 4, 0, 0x3e, 1, 3, 4, 4, 0x3e, 1, 3,
+    4, 5, 0x3f, 1, 3, 4, 6, 0x38, 1, 3, 5, 1, 0x3e, 1, 3, 5, 3, 0x3c, 1, 3,
+    5, 5, 0x3f, 1, 3, 6, 0, 0x3c, 1, 3, 6, 3, 0x3c, 1, 3, 6, 5, 0x3c, 1, 3,
+  /* 8x8 random, v */
+  8, 1, 8, 1,
+    1, 1, 0x30, 1, 3, 2, 5, 0x30, 1, 3, 4, 1, 0x3c, 1, 3, 4, 2, 0x39, 1, 3,
+    4, 3, 0x39, 1, 3, 4, 5, 0x34, 1, 3, 5, 7, 0x34, 1, 3, 7, 0, 0x3c, 1, 3,
+  /* 8x8 random, h */
+  8, 0, 13, 1,
+    0, 0, 0x3c, 0, 3, 0, 3, 0x3c, 0, 3, 2, 4, 0x32, 0, 3, 3, 3, 0x38, 0, 3,
+    3, 5, 0x32, 0, 3, 4, 4, 0x2e, 0, 3, 4, 6, 0x2e, 0, 3, 5, 5, 0x2e, 0, 3,
+    5, 6, 0x2f, 0, 3, 5, 7, 0x2f, 0, 3, 6, 5, 0x2d, 0, 3, 6, 6, 0x2c, 0, 3,
+    7, 5, 0x2d, 0, 3,
+  /* 8x8 random, v */
+  8, 1, 10, 1,
+    0, 0, 0x38, 1, 3, 0, 3, 0x3c, 1, 3, 0, 5, 0x3c, 1, 3, 2, 3, 0x3c, 1, 3,
+    2, 6, 0x38, 1, 3, 3, 4, 0x3c, 1, 3, 4, 6, 0x34, 1, 3, 5, 2, 0x38, 1, 3,
+    5, 5, 0x34, 1, 3, 7, 0, 0x38, 1, 3,
+  /* 8x8 random, h */
+  8, 0, 10, 1,
+    0, 0, 0x39, 0, 3, 0, 4, 0x38, 0, 3, 1, 0, 0x39, 0, 3, 2, 2, 0x39, 0, 3,
+    2, 6, 0x38, 0, 3, 3, 2, 0x39, 0, 3, 5, 6, 0x35, 0, 3, 5, 7, 0x35, 0, 3,
+    7, 0, 0x30, 0, 3, 7, 6, 0x34, 0, 3,
+  /* 8x8 random, h */
+  8, 0, 11, 1,
+    1, 0, 0x3c, 0, 3, 1, 3, 0x3c, 0, 3, 1, 4, 0x38, 0, 3, 2, 3, 0x38, 0, 3,
+    3, 7, 0x38, 0, 3, 5, 3, 0x38, 0, 3, 6, 0, 0x3e, 0, 3, 6, 7, 0x34, 0, 3,
+    7, 1, 0x3e, 0, 3, 7, 2, 0x3c, 0, 3, 7, 4, 0x34, 0, 3,
+  /* 8x8 random, v */
+  8, 1, 11, 1,
+    1, 1, 0x34, 1, 3, 1, 3, 0x34, 1, 3, 2, 6, 0x30, 1, 3, 4, 0, 0x3c, 1, 3,
+    4, 3, 0x3e, 1, 3, 5, 2, 0x3e, 1, 3, 5, 4, 0x35, 1, 3, 5, 5, 0x35, 1, 3,
+    6, 1, 0x3c, 1, 3, 6, 3, 0x3c, 1, 3, 6, 5, 0x34, 1, 3,
+  /* 8x8 random, h */
+  8, 0, 7, 1,
+    0, 4, 0x34, 0, 3, 2, 2, 0x30, 0, 3, 2, 5, 0x34, 0, 3, 4, 0, 0x29, 0, 3,
+    4, 1, 0x29, 0, 3, 6, 1, 0x2c, 0, 3, 6, 3, 0x2c, 0, 3,
+  /* 8x8 random, h */
+  8, 0, 11, 1,
+    0, 3, 0x38, 0, 3, 1, 4, 0x34, 0, 3, 2, 0, 0x3e, 0, 3, 2, 3, 0x3c, 0, 3,
+    2, 4, 0x35, 0, 3, 3, 1, 0x3e, 0, 3, 3, 4, 0x35, 0, 3, 4, 2, 0x35, 0, 3,
+    5, 2, 0x35, 0, 3, 6, 7, 0x30, 0, 3, 7, 2, 0x34, 0, 3,
+  /* 16x16 random, v */
+  16, 1, 4, 1,
+    14, 6, 0xa0, 1, 3, 15, 13, 0xc0, 1, 3, 9, 0, 0xa0, 1, 3, 6, 13, 0xc0, 1, 3,
+  /* 16x16 random, v */
+  16, 1, 7, 1,
+    7, 14, 0x70, 1, 2, 10, 8, 0x41, 1, 2, 7, 11, 0x64, 1, 2, 10, 9, 0x41, 1, 2,
+    1, 12, 0x70, 1, 2, 10, 8, 0x41, 1, 2, 6, 9, 0x64, 1, 2,
+  /* 16x16 random, h */
+  16, 0, 3, 1,
+    1, 7, 0xc0, 0, 3, 12, 1, 0x80, 0, 3, 0, 12, 0xc0, 0, 3,
+  /* 16x16 random, v */
+  16, 1, 3, 1,
+    0, 13, 0x60, 0, 1, 5, 5, 0x40, 0, 1, 6, 9, 0x60, 0, 1,
+  /* 32x32 random, h */
+  32, 0, 6, 1,
+    4, 28, 0x300, 0, 3, 24, 21, 0x380, 0, 3, 9, 11, 0x340, 0, 3, 20, 25, 0x380, 0, 3,
+    27, 12, 0x300, 0, 3, 2, 10, 0x340, 0, 3,
+  /* 32x32 random, v */
+  32, 1, 3, 1,
+    4, 29, 0x100, 1, 2, 21, 28, 0x140, 1, 2, 18, 17, 0x140, 1, 2,
+  /* 32x32 random, h */
+  32, 0, 3, 1,
+    10, 2, 0x100, 0, 1, 11, 18, 0x140, 0, 1, 11, 31, 0x140, 0, 1,
+  /* 32x32 random, v */
+  32, 1, 3, 1,
+    31, 7, 0x110, 0, 1, 30, 0, 0x110, 0, 1, 30, 24, 0x100, 0, 1,
+  /* 32x32 row-end pair, h */
+  32, 0, 2, 1,
+    31, 0, 0x100, 0, 1, 31, 31, 0x100, 0, 1,
+  /* End of corpus */
+  0
+};
+
+#endif /*FSYNC_REQ_GEN_CORPUS_H*/
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ * 
+ * Fractal synchronization request (id, aggregate) generator corpus test (C generators)
+ */
+
+#define MAX_CUS (1024)
+
+#include <stdio.h>
+#include "../fractal_sync_req_gen.c"
+#include "fractal_sync_req_gen_corpus.h"
+
+static unsigned int check_reqs(const char *gen, const unsigned int entry, const unsigned int *expected, const fsync_cu_t *cus, const unsigned int num_cus, const bool generated_reqs){
+  unsigned int errors = (generated_reqs != (bool)expected[3]);
+  for (unsigned int i = 0; i < num_cus; i++){
+    const unsigned int *cu = &expected[FSYNC_CORPUS_HEADER + i*FSYNC_CORPUS_CU];
+    if (cus[i].fsync_req.fs_req_aggr != cu[2] || cus[i].fsync_req.fs_req_id != cu[3] || cus[i].fsync_req.req_node != (fsync_node)cu[4]) errors++;
+  }
+  if (errors) printf("Corpus entry %0d: %s mismatch.\n", entry, gen);
+  return errors;
+}
+
+int main(void){
+  static fsync_cu_t cus[MAX_CUS];
+  unsigned int      errors  = 0;
+  unsigned int      entries = 0;
+
+  for (const unsigned int *entry = fsync_req_gen_corpus; entry[0] != 0; entry += FSYNC_CORPUS_HEADER + entry[2]*FSYNC_CORPUS_CU, entries++){
+    const unsigned int n_cu_x  = entry[0];
+    const fsync_dir    dir     = entry[1] ? v_fs_dir : h_fs_dir;
+    const unsigned int num_cus = entry[2];
+
+    fsync_topology_t topo;
+    if (!fsync_topology_init(&topo, n_cu_x, n_cu_x, NULL, NULL) || num_cus > MAX_CUS){
+      printf("Corpus entry %0d: unsupported.\n", entries);
+      errors++;
+      continue;
+    }
+
+    for (unsigned int i = 0; i < num_cus; i++){
+      cus[i].cu_id = i;
+      cus[i].y_pos = entry[FSYNC_CORPUS_HEADER + i*FSYNC_CORPUS_CU + 0];
+      cus[i].x_pos = entry[FSYNC_CORPUS_HEADER + i*FSYNC_CORPUS_CU + 1];
+    }
+    errors += check_reqs("fsync_gen_reqs", entries, entry, cus, num_cus, fsync_gen_reqs(&topo, cus, num_cus, dir));
+    errors += check_reqs("fsync_gen_reqs_fast", entries, entry, cus, num_cus, fsync_gen_reqs_fast(&topo, cus, num_cus, dir));
+  }
+
+  printf("FractalSync corpus: %0d entries, %0d errors.\n", entries, errors);
+
+  return errors ? 1 : 0;
+}
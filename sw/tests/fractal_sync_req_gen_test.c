@@ -19,12 +19,21 @@
  * Fractal synchronization request (id, aggregate) generator test
  */
 
-#define N_CUS (8)
+#define N_CU_X (4)
+#define N_CU_Y (4)
+#define N_CUS  (8)
 
 #include <stdio.h>
 #include "../fractal_sync_req_gen.c"
 
 int main(void){
+
+  // Describe the FractalSync tree (4x4 mesh with the default local RF sizes and links of hw/trees)
+  fsync_topology_t topo;
+  if (!fsync_topology_init(&topo, N_CU_X, N_CU_Y, NULL, NULL)){
+    printf("FractalSync topology not supported.\n");
+    return 1;
+  }
   
   // Define an array of CUs indicating ID and position (y, x)
   fsync_cu_t cus[N_CUS] = {
@@ -43,7 +52,7 @@ int main(void){
   fsync_init_reqs(cus, N_CUS);
 
   // Generate the appropriate FractalSync synchronization request fields (id, aggregate)
-  bool generated_reqs = fsync_gen_reqs(cus, N_CUS, h_fs_dir);
+  bool generated_reqs = fsync_gen_reqs(&topo, cus, N_CUS, h_fs_dir);
 
   // If generation was successful print the generated fields
   if (generated_reqs){
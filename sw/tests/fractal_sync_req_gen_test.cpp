@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ * 
+ * Fractal synchronization request (id, aggregate) generator corpus test (constexpr C++ generator, -std=c++20)
+ */
+
+#include <cstdio>
+#include "../fractal_sync_req_gen.hpp"
+#include "fractal_sync_req_gen_corpus.h"
+
+// Check the whole corpus: returns the number of mismatching entries
+constexpr unsigned int check_corpus(){
+  constexpr unsigned int max_cus = 1024;
+  unsigned int           errors  = 0;
+
+  for (const unsigned int *entry = fsync_req_gen_corpus; entry[0] != 0; entry += FSYNC_CORPUS_HEADER + entry[2]*FSYNC_CORPUS_CU){
+    const unsigned int num_cus = entry[2];
+    if (num_cus > max_cus){
+      errors++;
+      continue;
+    }
+    std::array<fsync::cu_t, max_cus>  cus{};
+    std::array<fsync::req_t, max_cus> reqs{};
+    for (unsigned int i = 0; i < num_cus; i++)
+      cus[i] = fsync::cu_t{entry[FSYNC_CORPUS_HEADER + i*FSYNC_CORPUS_CU + 0], entry[FSYNC_CORPUS_HEADER + i*FSYNC_CORPUS_CU + 1]};
+    const bool generated_reqs = fsync::gen_reqs(entry[0], entry[0], std::span<const fsync::cu_t>(cus.data(), num_cus), std::span<fsync::req_t>(reqs.data(), num_cus),
+                                                entry[1] ? fsync::dir_e::v : fsync::dir_e::h);
+    bool error = (generated_reqs != (entry[3] != 0));
+    for (unsigned int i = 0; i < num_cus; i++){
+      const unsigned int *cu = &entry[FSYNC_CORPUS_HEADER + i*FSYNC_CORPUS_CU];
+      if (reqs[i] != fsync::req_t{cu[2], cu[3], static_cast<fsync::node_e>(cu[4])}) error = true;
+    }
+    errors += error ? 1 : 0;
+  }
+
+  return errors;
+}
+
+// The whole corpus is verified at compile time
+static_assert(check_corpus() == 0, "constexpr generator does not match the corpus");
+
+// Static barrier: row 1 of a 4x4 mesh, computed at compile time
+using mesh_4x4_t = fsync::mesh_t<4, 4>;
+constexpr auto row_1 = fsync::barrier_v<mesh_4x4_t, fsync::dir_e::h, fsync::cu_t{1, 0}, fsync::cu_t{1, 1}, fsync::cu_t{1, 2}, fsync::cu_t{1, 3}>;
+static_assert(row_1[0] == fsync::req_t{0x5, 0, fsync::node_e::h});
+
+int main(){
+  for (unsigned int i = 0; i < row_1.size(); i++)
+    std::printf("fsync_req[%0d]:\n  aggregate: 0x%0x\n  id: %0d\n", i, row_1[i].fs_req_aggr, row_1[i].fs_req_id);
+
+  std::printf("FractalSync corpus: %0d errors.\n", check_corpus());
+
+  return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ * 
+ * Fractal synchronization packed request encoding test
+ */
+
+#define N_CU_X (4)
+#define N_CU_Y (4)
+#define N_CUS  (8)
+
+#include <stdio.h>
+#include "../fractal_sync_req_gen.c"
+#include "../fractal_sync_req_pack.c"
+
+static const char *port_name[] = {"h tree", "v tree", "h nbr", "v nbr"};
+
+int main(void){
+
+  // Describe the FractalSync tree (4x4 mesh with the default local RF sizes and links of hw/trees)
+  fsync_topology_t topo;
+  if (!fsync_topology_init(&topo, N_CU_X, N_CU_Y, NULL, NULL)){
+    printf("FractalSync topology not supported.\n");
+    return 1;
+  }
+
+  // Same CUs of the request generator test, and a pair of vertical neighbors
+  fsync_cu_t cus[N_CUS] = {
+    {.cu_id = 0,  .y_pos = 0, .x_pos = 0},
+    {.cu_id = 5,  .y_pos = 1, .x_pos = 1},
+    {.cu_id = 2,  .y_pos = 0, .x_pos = 2},
+    {.cu_id = 3,  .y_pos = 0, .x_pos = 3},
+    {.cu_id = 8,  .y_pos = 2, .x_pos = 0},
+    {.cu_id = 10, .y_pos = 2, .x_pos = 2},
+    {.cu_id = 11, .y_pos = 2, .x_pos = 3},
+    {.cu_id = 15, .y_pos = 3, .x_pos = 3}
+  };
+  fsync_cu_t nbr_cus[2] = {{.cu_id = 6, .y_pos = 1, .x_pos = 2}, {.cu_id = 10, .y_pos = 2, .x_pos = 2}};
+
+  // Generate and pack the requests: each word can be stored as is to the interface it encodes
+  fsync_req_word_t words[N_CUS];
+  fsync_req_word_t nbr_words[2];
+  bool packed_reqs = fsync_gen_reqs_packed(&topo, cus, N_CUS, h_fs_dir, words) &&
+                     fsync_gen_reqs_packed(&topo, nbr_cus, 2, h_fs_dir, nbr_words);
+
+  // Expected words ({port, 1'b1 (sync), aggr, id} with 5-bit aggr and 3-bit id on the 4x4 tree, 1-bit aggr and 2-bit
+  // id on the neighbor interfaces)
+  const fsync_req_word_t exp_words[N_CUS] = {0x170, 0x170, 0x168, 0x168, 0x160, 0x178, 0x178, 0x170};
+  const fsync_req_word_t exp_nbr_words[2] = {0xC000000F, 0xC000000F};
+
+  // If packing was successful print and check the packed words
+  unsigned int errors = 0;
+  if (packed_reqs){
+    printf("FractalSync requests packed.\n");
+    for (int unsigned i = 0; i < N_CUS; i++){
+      printf("fsync_req_word[%0d]:\n  cu_id: %0d\n  port: %s\n  req: 0x%0x\n", i, cus[i].cu_id, port_name[FSYNC_REQ_WORD_PORT(words[i])], FSYNC_REQ_WORD_REQ(words[i]));
+      if (words[i] != exp_words[i]) errors++;
+    }
+    for (int unsigned i = 0; i < 2; i++){
+      printf("fsync_nbr_req_word[%0d]:\n  cu_id: %0d\n  port: %s\n  req: 0x%0x\n", i, nbr_cus[i].cu_id, port_name[FSYNC_REQ_WORD_PORT(nbr_words[i])], FSYNC_REQ_WORD_REQ(nbr_words[i]));
+      if (nbr_words[i] != exp_nbr_words[i]) errors++;
+    }
+  }
+  else {
+    printf("FractalSync requests not packed.\n");
+    errors++;
+  }
+
+  // Single requests of every port, and requests that do not fit the fields of their interface
+  const struct { fsync_req_t req; bool nbr; bool exp_packed; fsync_req_word_t exp_word; } single[] = {
+    {{.fs_req_aggr = 0x3,  .fs_req_id = 0, .req_node = hv_fs_node},   false, true,  0x00000118}, // Level 2, h tree
+    {{.fs_req_aggr = 0x4,  .fs_req_id = 1, .req_node = v_fs_node},    false, true,  0x40000121}, // Level 3, v tree
+    {{.fs_req_aggr = 0x1,  .fs_req_id = 2, .req_node = h_fs_node},    true,  true,  0x8000000E}, // h neighbor
+    {{.fs_req_aggr = 0x1,  .fs_req_id = 3, .req_node = v_fs_node},    true,  true,  0xC000000F}, // v neighbor
+    {{.fs_req_aggr = 0x1,  .fs_req_id = 0, .req_node = null_fs_node}, false, true,  0x00000000}, // Idle CU
+    {{.fs_req_aggr = 0x20, .fs_req_id = 0, .req_node = h_fs_node},    false, false, 0x00000000}, // aggr too wide
+    {{.fs_req_aggr = 0x1,  .fs_req_id = 8, .req_node = h_fs_node},    false, false, 0x00000000}, // id too wide
+    {{.fs_req_aggr = 0x2,  .fs_req_id = 2, .req_node = h_fs_node},    true,  false, 0x00000000}, // neighbor aggr too wide
+    {{.fs_req_aggr = 0x0,  .fs_req_id = 0, .req_node = h_fs_node},    false, false, 0x00000000}  // No level
+  };
+  for (unsigned int i = 0; i < sizeof(single)/sizeof(single[0]); i++){
+    fsync_req_word_t word;
+    bool packed = fsync_pack_req(&topo, &single[i].req, single[i].nbr, &word);
+    if (packed != single[i].exp_packed || (packed && word != single[i].exp_word)) errors++;
+  }
+
+  printf("FractalSync request packing: %0d errors.\n", errors);
+
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization structure-of-arrays generator test: every subset of CUs of the 2x2 and 4x4 meshes (and random
+ * subsets of the 8x8 mesh) is generated by fsync_gen_reqs_soa and compared with fsync_gen_reqs_fast.
+ * Build once per SIMD path: -mavx2 (AVX2), default x86-64 flags (SSE2), -mno-sse2 (scalar)
+ */
+
+#define MAX_CUS      (64)
+#define N_RAND_SETS  (20000)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "../fractal_sync_req_gen.c"
+#include "../fractal_sync_req_soa.c"
+
+static unsigned int check_soa(const fsync_topology_t *topo, const unsigned int *cu_ids, const unsigned int num_cus, const fsync_dir dir){
+  static fsync_cu_t   cus[MAX_CUS];
+  static unsigned int y_pos[MAX_CUS], x_pos[MAX_CUS], aggr[MAX_CUS], id[MAX_CUS];
+  static fsync_node   node[MAX_CUS];
+  fsync_cus_soa_t     soa = {.num_cus = num_cus, .y_pos = y_pos, .x_pos = x_pos, .fs_req_aggr = aggr, .fs_req_id = id, .req_node = node};
+
+  for (unsigned int i = 0; i < num_cus; i++){
+    cus[i].cu_id = cu_ids[i];
+    cus[i].y_pos = y_pos[i] = cu_ids[i] / topo->n_cu_x;
+    cus[i].x_pos = x_pos[i] = cu_ids[i] % topo->n_cu_x;
+  }
+  bool generated_reqs     = fsync_gen_reqs_soa(topo, &soa, dir);
+  bool ref_generated_reqs = fsync_gen_reqs_fast(topo, cus, num_cus, dir);
+
+  unsigned int errors = (generated_reqs != ref_generated_reqs);
+  for (unsigned int i = 0; ref_generated_reqs && i < num_cus; i++){
+    if (aggr[i] != cus[i].fsync_req.fs_req_aggr || id[i] != cus[i].fsync_req.fs_req_id || node[i] != cus[i].fsync_req.req_node) errors++;
+  }
+  if (errors) printf("%0dx%0d mesh, %0d CUs (first %0d), %s: mismatch.\n", topo->n_cu_x, topo->n_cu_x, num_cus, cu_ids[0], dir == h_fs_dir ? "h" : "v");
+  return errors;
+}
+
+int main(void){
+  unsigned int errors = 0;
+  unsigned int sets   = 0;
+  unsigned int cu_ids[MAX_CUS];
+
+  // Every non-empty subset of the 2x2 and 4x4 meshes, in both default directions
+  for (unsigned int n_cu_x = 2; n_cu_x <= 4; n_cu_x *= 2){
+    fsync_topology_t topo;
+    if (!fsync_topology_init(&topo, n_cu_x, n_cu_x, NULL, NULL)){
+      printf("FractalSync %0dx%0d topology not supported.\n", n_cu_x, n_cu_x);
+      return 1;
+    }
+    const unsigned int n_cus = n_cu_x*n_cu_x;
+    for (unsigned int set = 1; set < (1u << n_cus); set++){
+      unsigned int num_cus = 0;
+      for (unsigned int i = 0; i < n_cus; i++)
+        if (set & (1u << i)) cu_ids[num_cus++] = i;
+      errors += check_soa(&topo, cu_ids, num_cus, h_fs_dir);
+      errors += check_soa(&topo, cu_ids, num_cus, v_fs_dir);
+      sets   += 2;
+    }
+  }
+
+  // Random subsets (random order, any size) of the 8x8 mesh, covering every vector tail
+  fsync_topology_t topo;
+  if (!fsync_topology_init(&topo, 8, 8, NULL, NULL)){
+    printf("FractalSync 8x8 topology not supported.\n");
+    return 1;
+  }
+  srand(1);
+  for (unsigned int s = 0; s < N_RAND_SETS; s++){
+    unsigned int perm[MAX_CUS];
+    for (unsigned int i = 0; i < MAX_CUS; i++) perm[i] = i;
+    for (unsigned int i = MAX_CUS-1; i > 0; i--){
+      unsigned int j = rand() % (i+1), t = perm[i];
+      perm[i] = perm[j];
+      perm[j] = t;
+    }
+    const unsigned int num_cus = 1 + s % MAX_CUS;
+    for (unsigned int i = 0; i < num_cus; i++) cu_ids[i] = perm[i];
+    errors += check_soa(&topo, cu_ids, num_cus, (s & 1) ? v_fs_dir : h_fs_dir);
+    sets++;
+  }
+
+  // CU outside of the mesh: both generators must refuse it
+  cu_ids[0] = 0;
+  cu_ids[1] = MAX_CUS;
+  errors += check_soa(&topo, cu_ids, 2, h_fs_dir);
+  sets++;
+
+#if defined(__AVX2__)
+  const char *path = "AVX2";
+#elif defined(__SSE2__)
+  const char *path = "SSE2";
+#else
+  const char *path = "scalar";
+#endif
+  printf("FractalSync structure-of-arrays generator (%s): %0d sets, %0d errors.\n", path, sets, errors);
+
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ * 
+ * Fractal synchronization multi-team barrier allocator test
+ */
+
+#define N_CU_X   (4)
+#define N_CU_Y   (4)
+#define N_LVL    (4)
+#define N_TEAMS  (6)
+
+#include <stdio.h>
+#include "../fractal_sync_req_gen.c"
+#include "../fractal_sync_team_alloc.c"
+
+int main(void){
+
+  // Describe a 4x4 FractalSync tree with two registers in the level 3 1D nodes
+  unsigned int     n_local_regs[N_LVL] = {1, 2, 2, 8};
+  fsync_topology_t topo;
+  if (!fsync_topology_init(&topo, N_CU_X, N_CU_Y, n_local_regs, NULL)){
+    printf("FractalSync topology not supported.\n");
+    return 1;
+  }
+
+  // Rows 0 and 1 share the same level 3 node, rows 2 and 3 are split in two (non-neighbor) pairs each
+  fsync_cu_t row_0[4]    = {{.cu_id = 0,  .y_pos = 0, .x_pos = 0}, {.cu_id = 1,  .y_pos = 0, .x_pos = 1}, {.cu_id = 2,  .y_pos = 0, .x_pos = 2}, {.cu_id = 3,  .y_pos = 0, .x_pos = 3}};
+  fsync_cu_t row_1[4]    = {{.cu_id = 4,  .y_pos = 1, .x_pos = 0}, {.cu_id = 5,  .y_pos = 1, .x_pos = 1}, {.cu_id = 6,  .y_pos = 1, .x_pos = 2}, {.cu_id = 7,  .y_pos = 1, .x_pos = 3}};
+  fsync_cu_t pair_2_0[2] = {{.cu_id = 8,  .y_pos = 2, .x_pos = 0}, {.cu_id = 10, .y_pos = 2, .x_pos = 2}};
+  fsync_cu_t pair_2_1[2] = {{.cu_id = 9,  .y_pos = 2, .x_pos = 1}, {.cu_id = 11, .y_pos = 2, .x_pos = 3}};
+  fsync_cu_t pair_3_0[2] = {{.cu_id = 12, .y_pos = 3, .x_pos = 0}, {.cu_id = 14, .y_pos = 3, .x_pos = 2}};
+  fsync_cu_t pair_3_1[2] = {{.cu_id = 13, .y_pos = 3, .x_pos = 1}, {.cu_id = 15, .y_pos = 3, .x_pos = 3}};
+
+  fsync_team_t teams[N_TEAMS] = {
+    {.cus = row_0,    .num_cus = 4},
+    {.cus = row_1,    .num_cus = 4},
+    {.cus = pair_2_0, .num_cus = 2},
+    {.cus = pair_2_1, .num_cus = 2},
+    {.cus = pair_3_0, .num_cus = 2},
+    {.cus = pair_3_1, .num_cus = 2}
+  };
+
+  // Allocate the barriers of all teams
+  unsigned int num_phases;
+  bool allocated = fsync_alloc_teams(&topo, teams, N_TEAMS, h_fs_dir, &num_phases);
+
+  // Expected barrier of each team: rows 0 and 1 share the two registers of the level 3 node (0, 0), the four pairs of
+  // rows 2 and 3 share the two registers of the level 3 node (1, 0) in two phases
+  const unsigned int exp_num_phases = 2;
+  const struct { unsigned int lvl, node_idx, reg, phase, aggr, id; } exp[N_TEAMS] = {
+    {3, 0x00000, 0, 0, 0x5, 0},
+    {3, 0x00000, 1, 0, 0x5, 2},
+    {3, 0x10000, 0, 0, 0x4, 0},
+    {3, 0x10000, 1, 0, 0x4, 2},
+    {3, 0x10000, 0, 1, 0x4, 0},
+    {3, 0x10000, 1, 1, 0x4, 2}
+  };
+
+  // If allocation was successful print and check the barrier of each team
+  unsigned int errors = 0;
+  if (allocated){
+    printf("FractalSync teams allocated in %0d phases.\n", num_phases);
+    if (num_phases != exp_num_phases) errors++;
+    for (unsigned int t = 0; t < N_TEAMS; t++){
+      printf("team[%0d]:\n  level: %0d\n  node: (%0d, %0d)\n  register: %0d\n  phase: %0d\n  aggregate: 0x%0x\n  id: %0d\n",
+      t, teams[t].lvl, teams[t].node_idx >> 16, teams[t].node_idx & 0xFFFF, teams[t].reg, teams[t].phase,
+      teams[t].cus[0].fsync_req.fs_req_aggr, teams[t].cus[0].fsync_req.fs_req_id);
+      if (!teams[t].valid || teams[t].nbr      ||
+          teams[t].lvl   != exp[t].lvl   || teams[t].node_idx != exp[t].node_idx ||
+          teams[t].reg   != exp[t].reg   || teams[t].phase    != exp[t].phase) errors++;
+      // Every CU of a team issues the same request
+      for (unsigned int i = 0; i < teams[t].num_cus; i++){
+        if (teams[t].cus[i].fsync_req.fs_req_aggr != exp[t].aggr ||
+            teams[t].cus[i].fsync_req.fs_req_id   != exp[t].id) errors++;
+      }
+    }
+  }
+  else {
+    printf("FractalSync teams not allocated.\n");
+    errors++;
+  }
+
+  printf("FractalSync team allocation: %0d errors.\n", errors);
+
+  return errors ? 1 : 0;
+}
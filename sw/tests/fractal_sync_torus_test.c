@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ * 
+ * Fractal synchronization torus neighbor exchange test (same pairs of nbr_h_tor_sync and nbr_v_tor_sync in dv/tb_bfm.sv)
+ */
+
+#define N_CU_X (4)
+#define N_CU_Y (4)
+#define N_CUS  (N_CU_X*N_CU_Y)
+
+#include <stdio.h>
+#include "../fractal_sync_req_gen.c"
+#include "../fractal_sync_team_alloc.c"
+
+int main(void){
+
+  // Describe the FractalSync tree (4x4 mesh with the default local RF sizes and links of hw/trees)
+  fsync_topology_t topo;
+  if (!fsync_topology_init(&topo, N_CU_X, N_CU_Y, NULL, NULL)){
+    printf("FractalSync topology not supported.\n");
+    return 1;
+  }
+
+  unsigned int errors = 0;
+  for (unsigned int d = 0; d < 2; d++){
+    fsync_dir    dir = d ? v_fs_dir : h_fs_dir;
+    fsync_cu_t   cus[N_CUS];
+    fsync_team_t pairs[N_CUS/2];
+    unsigned int num_phases;
+
+    // Pairs (1, 2), (3, 0) of each row/column: the wrap-around pairs synchronize at the lowest common tree level
+    unsigned int num_pairs = fsync_torus_pairs(&topo, dir, true, cus);
+    bool generated_reqs    = fsync_gen_nbr_reqs(&topo, cus, num_pairs, dir, pairs, &num_phases);
+
+    // If generation was successful print and check the barrier of each pair
+    if (generated_reqs){
+      printf("FractalSync %s torus pairs generated in %0d phases.\n", d ? "vertical" : "horizontal", num_phases);
+      // All the pairs fit in one phase: the wrap-around pairs of two rows/columns share the two registers of a level 3 node
+      if (num_pairs != N_CUS/2 || num_phases != 1) errors++;
+      for (unsigned int p = 0; p < num_pairs; p++){
+        printf("pair[%0d]:\n  cu_ids: %0d, %0d\n  link: %s\n  level: %0d\n  aggregate: 0x%0x\n  id: %0d\n",
+        p, pairs[p].cus[0].cu_id, pairs[p].cus[1].cu_id, pairs[p].nbr ? "neighbor" : "tree", pairs[p].lvl,
+        pairs[p].cus[0].fsync_req.fs_req_aggr, pairs[p].cus[0].fsync_req.fs_req_id);
+
+        // Expected pair: (1, 2) over the neighbor link (id 2: h, 3: v), (3, 0) over the level 3 node (id {reg, dir})
+        unsigned int line    = p/2;
+        bool         wrap    = p & 1;
+        unsigned int pos[2]  = {wrap ? 3 : 1, wrap ? 0 : 2};
+        unsigned int exp_lvl = wrap ? 3 : 1;
+        unsigned int exp_agg = wrap ? 0x4 : 0x1;
+        unsigned int exp_id  = wrap ? (((line & 1) << 1) | d) : (2 | d);
+        for (unsigned int c = 0; c < 2; c++){
+          unsigned int exp_cu_id = d ? pos[c]*N_CU_X + line : line*N_CU_X + pos[c];
+          if (pairs[p].cus[c].cu_id               != exp_cu_id ||
+              pairs[p].cus[c].fsync_req.fs_req_aggr != exp_agg ||
+              pairs[p].cus[c].fsync_req.fs_req_id   != exp_id) errors++;
+        }
+        if (!pairs[p].valid || pairs[p].nbr == wrap || pairs[p].lvl != exp_lvl || pairs[p].phase != 0) errors++;
+      }
+    }
+    else {
+      printf("FractalSync %s torus pairs not generated.\n", d ? "vertical" : "horizontal");
+      errors++;
+    }
+  }
+
+  printf("FractalSync torus pairs: %0d errors.\n", errors);
+
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,298 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization request generator microbenchmark
+ *
+ * Usage: fractal_sync_gen_bench [csv] [<n_cu_x>] [<min_time_ms>]
+ *
+ * Every generator flavour (fsync_gen_reqs, fsync_gen_reqs_workspace, fsync_gen_reqs_fast, fsync_gen_reqs_soa and the
+ * request cache on hits) is timed on groups of 2 to N_CU CUs (powers of two) of a n_cu_x*n_cu_x mesh (default 32x32),
+ * with the CUs laid out as a random set, a row (row-major fill), a column (column-major fill), an aligned block or a
+ * checkerboard. Each measurement reports ns/call, heap allocations/call (when built with FSYNC_BENCH_WRAP_MALLOC and
+ * linked with -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc) and retired instructions/call (Linux perf counters,
+ * n/a when perf events are not available).
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "../fractal_sync_req_gen.h"
+#include "../fractal_sync_req_soa.h"
+#include "../fractal_sync_req_cache.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#define N_SHAPES  (5)
+#define N_IMPLS   (5)
+#define MIN_CALLS (16)
+
+typedef enum {random_shape, row_shape, column_shape, block_shape, checkerboard_shape} shape_t;
+typedef enum {gen_impl, workspace_impl, fast_impl, soa_impl, cache_impl} impl_t;
+
+static const char *shape_names[N_SHAPES] = {"random", "row", "column", "block", "checkerboard"};
+static const char *impl_names[N_IMPLS]   = {"gen_reqs", "workspace", "fast", "soa", "cache"};
+
+/*******************************************************/
+/**                Allocation counting                **/
+/*******************************************************/
+
+#ifdef FSYNC_BENCH_WRAP_MALLOC
+static unsigned long allocs = 0;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size){ allocs++; return __real_malloc(size); }
+void *__wrap_calloc(size_t n, size_t size){ allocs++; return __real_calloc(n, size); }
+void *__wrap_realloc(void *ptr, size_t size){ allocs++; return __real_realloc(ptr, size); }
+#endif
+
+/*******************************************************/
+/**                 Instruction count                 **/
+/*******************************************************/
+
+static int perf_fd = -1;
+
+static void perf_open(void){
+#ifdef __linux__
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.type           = PERF_TYPE_HARDWARE;
+  attr.size           = sizeof(attr);
+  attr.config         = PERF_COUNT_HW_INSTRUCTIONS;
+  attr.disabled       = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv     = 1;
+  perf_fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+}
+
+static void perf_start(void){
+#ifdef __linux__
+  if (perf_fd < 0) return;
+  ioctl(perf_fd, PERF_EVENT_IOC_RESET, 0);
+  ioctl(perf_fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+}
+
+static uint64_t perf_stop(void){
+  uint64_t count = 0;
+#ifdef __linux__
+  if (perf_fd < 0) return 0;
+  ioctl(perf_fd, PERF_EVENT_IOC_DISABLE, 0);
+  if (read(perf_fd, &count, sizeof(count)) != sizeof(count)) count = 0;
+#endif
+  return count;
+}
+
+/*******************************************************/
+/**                      Groups                       **/
+/*******************************************************/
+
+static uint32_t rng_state = 1;
+
+static uint32_t rng(void){
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state;
+}
+
+/* Place num_cus CUs with the given shape, returns false if the shape does not fit the mesh */
+static bool gen_group(const shape_t shape, const unsigned int n_cu_x, const unsigned int num_cus, fsync_cu_t *cus){
+  const unsigned int n_cu = n_cu_x*n_cu_x;
+  unsigned int       ids[__FSYNC_MAX_N_CU__];
+  unsigned int       n    = 0;
+
+  switch (shape){
+    case random_shape:
+      for (unsigned int i = 0; i < n_cu; i++) ids[i] = i;
+      for (unsigned int i = 0; i < num_cus; i++){
+        unsigned int j   = i + rng()%(n_cu-i);
+        unsigned int tmp = ids[i];
+        ids[i] = ids[j];
+        ids[j] = tmp;
+      }
+      n = num_cus;
+      break;
+    case row_shape:
+      for (n = 0; n < num_cus; n++) ids[n] = n;
+      break;
+    case column_shape:
+      for (n = 0; n < num_cus; n++) ids[n] = (n%n_cu_x)*n_cu_x + n/n_cu_x;
+      break;
+    case block_shape: {
+      unsigned int log = 0;
+      while ((1u << log) < num_cus) log++;
+      unsigned int w = 1u << ((log+1)/2);
+      unsigned int h = num_cus/w;
+      for (unsigned int y = 0; y < h; y++)
+        for (unsigned int x = 0; x < w; x++) ids[n++] = y*n_cu_x + x;
+      break;
+    }
+    case checkerboard_shape:
+      for (unsigned int i = 0; i < n_cu && n < num_cus; i++)
+        if (((i/n_cu_x) + (i%n_cu_x))%2 == 0) ids[n++] = i;
+      break;
+  }
+  if (n != num_cus) return false;
+
+  for (unsigned int i = 0; i < num_cus; i++){
+    cus[i].cu_id = ids[i];
+    cus[i].y_pos = ids[i]/n_cu_x;
+    cus[i].x_pos = ids[i]%n_cu_x;
+  }
+  fsync_init_reqs(cus, num_cus);
+  return true;
+}
+
+/*******************************************************/
+/**                     Benchmark                     **/
+/*******************************************************/
+
+typedef struct bench_ctx{
+  const fsync_topology_t *topo;
+  fsync_cu_t             *cus;
+  unsigned int            num_cus;
+  fsync_cus_soa_t         soa;
+  void                   *workspace;
+  size_t                  workspace_size;
+  fsync_req_cache_t       cache;
+} bench_ctx_t;
+
+static bool call(const impl_t impl, bench_ctx_t *ctx){
+  switch (impl){
+    case gen_impl:       return fsync_gen_reqs(ctx->topo, ctx->cus, ctx->num_cus, h_fs_dir);
+    case workspace_impl: return fsync_gen_reqs_workspace(ctx->topo, ctx->cus, ctx->num_cus, h_fs_dir, ctx->workspace, ctx->workspace_size);
+    case fast_impl:      return fsync_gen_reqs_fast(ctx->topo, ctx->cus, ctx->num_cus, h_fs_dir);
+    case soa_impl:       return fsync_gen_reqs_soa(ctx->topo, &ctx->soa, h_fs_dir);
+    case cache_impl:     return fsync_req_cache_gen_reqs(&ctx->cache, ctx->cus, ctx->num_cus, h_fs_dir);
+  }
+  return false;
+}
+
+static double now_ns(void){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec*1e9 + ts.tv_nsec;
+}
+
+int main(int argc, char *argv[]){
+  int        arg = 1;
+  const bool csv = (argc > arg) && !strcmp(argv[arg], "csv");
+  arg += csv;
+  const unsigned int n_cu_x      = (argc > arg) ? (unsigned int)atoi(argv[arg]) : 32;
+  const double       min_time_ns = ((argc > arg+1) ? atof(argv[arg+1]) : 20.0)*1e6;
+
+  fsync_topology_t topo;
+  if (!fsync_topology_init(&topo, n_cu_x, n_cu_x, NULL, NULL)){
+    printf("FractalSync topology not supported.\n");
+    return 1;
+  }
+  const unsigned int n_cu = topo.n_cu;
+
+  bench_ctx_t ctx;
+  ctx.topo           = &topo;
+  ctx.cus            = malloc(n_cu*sizeof(fsync_cu_t));
+  ctx.workspace_size = fsync_gen_reqs_workspace_size(n_cu);
+  ctx.workspace      = malloc(ctx.workspace_size ? ctx.workspace_size : 1);
+  ctx.soa.y_pos       = malloc(n_cu*sizeof(unsigned int));
+  ctx.soa.x_pos       = malloc(n_cu*sizeof(unsigned int));
+  ctx.soa.fs_req_aggr = malloc(n_cu*sizeof(unsigned int));
+  ctx.soa.fs_req_id   = malloc(n_cu*sizeof(unsigned int));
+  ctx.soa.req_node    = malloc(n_cu*sizeof(fsync_node));
+  size_t cache_size   = fsync_req_cache_size(&topo, 16, n_cu);
+  void  *cache_mem    = malloc(cache_size);
+  if (!ctx.cus || !ctx.workspace || !ctx.soa.y_pos || !ctx.soa.x_pos || !ctx.soa.fs_req_aggr || !ctx.soa.fs_req_id || !ctx.soa.req_node ||
+      !cache_mem || !fsync_req_cache_init(&ctx.cache, &topo, 16, n_cu, cache_mem, cache_size)){
+    printf("Benchmark memory allocation failed.\n");
+    return 1;
+  }
+
+  perf_open();
+
+  if (csv) printf("impl,shape,num_cus,calls,ns_per_call,allocs_per_call,instructions_per_call\n");
+  else     printf("%-10s %-13s %8s %10s %12s %12s %16s\n", "impl", "shape", "num_cus", "calls", "ns/call", "allocs/call", "instructions/call");
+
+  for (unsigned int impl = 0; impl < N_IMPLS; impl++){
+    for (unsigned int shape = 0; shape < N_SHAPES; shape++){
+      for (unsigned int num_cus = 2; num_cus <= n_cu; num_cus <<= 1){
+        if (!gen_group((shape_t)shape, n_cu_x, num_cus, ctx.cus)) continue;
+        ctx.num_cus     = num_cus;
+        ctx.soa.num_cus = num_cus;
+        for (unsigned int i = 0; i < num_cus; i++){
+          ctx.soa.y_pos[i] = ctx.cus[i].y_pos;
+          ctx.soa.x_pos[i] = ctx.cus[i].x_pos;
+        }
+        fsync_req_cache_flush(&ctx.cache);
+
+        /* Warm-up (fills the cache) and calibration: double the calls until the minimum time is reached */
+        bool          generated = call((impl_t)impl, &ctx);
+        unsigned long calls     = MIN_CALLS;
+        double        elapsed   = 0;
+        uint64_t      instrs    = 0;
+        while (true){
+#ifdef FSYNC_BENCH_WRAP_MALLOC
+          allocs = 0;
+#endif
+          perf_start();
+          double start = now_ns();
+          for (unsigned long c = 0; c < calls; c++) generated &= call((impl_t)impl, &ctx);
+          elapsed = now_ns() - start;
+          instrs  = perf_stop();
+          if (elapsed >= min_time_ns || calls >= (1ul << 30)) break;
+          calls <<= 1;
+        }
+
+        char alloc_str[32] = "n/a";
+        char instr_str[32] = "n/a";
+#ifdef FSYNC_BENCH_WRAP_MALLOC
+        snprintf(alloc_str, sizeof(alloc_str), "%.2f", (double)allocs/calls);
+#endif
+        if (perf_fd >= 0) snprintf(instr_str, sizeof(instr_str), "%.1f", (double)instrs/calls);
+
+        if (csv) printf("%s,%s,%u,%lu,%.1f,%s,%s\n", impl_names[impl], shape_names[shape], num_cus, calls, elapsed/calls, alloc_str, instr_str);
+        else     printf("%-10s %-13s %8u %10lu %12.1f %12s %16s%s\n", impl_names[impl], shape_names[shape], num_cus, calls, elapsed/calls, alloc_str, instr_str,
+                        generated ? "" : " (not generated)");
+      }
+    }
+  }
+
+#ifdef __linux__
+  if (perf_fd >= 0) close(perf_fd);
+#endif
+  free(cache_mem);
+  free(ctx.soa.req_node);
+  free(ctx.soa.fs_req_id);
+  free(ctx.soa.fs_req_aggr);
+  free(ctx.soa.x_pos);
+  free(ctx.soa.y_pos);
+  free(ctx.workspace);
+  free(ctx.cus);
+
+  return 0;
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization host barrier benchmark
+ *
+ * Usage: fractal_sync_host_bench [csv] [<n_cu_x>] [<iterations>] [tree|row|nopin]
+ *
+ * One thread per CU of a n_cu_x*n_cu_x mesh (default 8x8, i.e. 64 threads), pinned to the available CPUs in the tree
+ * order of fsync_host_map (default), row-major or not pinned, runs back-to-back global barriers, with the host
+ * FractalSync trees (requests of fsync_gen_reqs) and with pthread_barrier_wait, and row barriers (requests of
+ * fsync_alloc_teams, one team per row). Each row reports ns/barrier measured by CU 0 over the whole stream.
+ * The comparison is only meaningful with at least one CPU per thread: oversubscribed runs are futex bound and flagged.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "../fractal_sync_req_gen.h"
+#include "../fractal_sync_team_alloc.h"
+#include "../fractal_sync_host.h"
+#include "../fractal_sync_host_map.h"
+
+typedef enum {fsync_global, fsync_rows, pthread_global, n_impls} impl_e;
+
+static const char *impl_names[n_impls] = {"fsync_global", "fsync_rows", "pthread_global"};
+
+typedef struct bench{
+  fsync_topology_t  topo;
+  fsync_host_t      host;
+  fsync_host_map_t  map;
+  pthread_barrier_t pthread_barrier;
+  fsync_cu_t       *reqs[n_impls]; /* Request of each CU (indexed by cu_id) */
+  unsigned int      iterations;
+  bool              pin;
+  fsync_host_order  order;
+  unsigned int      pinned;
+  double            ns[n_impls];
+} bench_t;
+
+typedef struct cu_arg{
+  bench_t      *bench;
+  unsigned int  cu_id;
+} cu_arg_t;
+
+static double now_ns(void){
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec*1e9 + ts.tv_nsec;
+}
+
+static bool gen_reqs(bench_t *bench){
+  const unsigned int n_cu = bench->topo.n_cu;
+  for (unsigned int impl = 0; impl < n_impls; impl++){
+    bench->reqs[impl] = malloc(n_cu*sizeof(fsync_cu_t));
+    if (bench->reqs[impl] == NULL) return false;
+    for (unsigned int i = 0; i < n_cu; i++){
+      bench->reqs[impl][i].cu_id = i;
+      bench->reqs[impl][i].y_pos = i >> bench->topo.x_shift;
+      bench->reqs[impl][i].x_pos = i & (bench->topo.n_cu_x-1);
+    }
+  }
+  if (!fsync_gen_reqs(&bench->topo, bench->reqs[fsync_global], n_cu, h_fs_dir)) return false;
+
+  fsync_team_t *teams = malloc(bench->topo.n_cu_y*sizeof(fsync_team_t));
+  unsigned int  num_phases;
+  if (teams == NULL) return false;
+  for (unsigned int t = 0; t < bench->topo.n_cu_y; t++){
+    teams[t].cus     = &bench->reqs[fsync_rows][t*bench->topo.n_cu_x];
+    teams[t].num_cus = bench->topo.n_cu_x;
+  }
+  bool allocated = fsync_alloc_teams(&bench->topo, teams, bench->topo.n_cu_y, h_fs_dir, &num_phases) && num_phases == 1;
+  free(teams);
+  return allocated;
+}
+
+static void *cu_thread(void *arg){
+  bench_t           *bench = ((cu_arg_t *)arg)->bench;
+  const unsigned int cu_id = ((cu_arg_t *)arg)->cu_id;
+
+  if (bench->pin && fsync_host_map_pin(&bench->map, &bench->topo, &bench->reqs[fsync_global][cu_id])) __atomic_fetch_add(&bench->pinned, 1, __ATOMIC_RELAXED);
+
+  for (unsigned int impl = 0; impl < n_impls; impl++){
+    const fsync_cu_t *req = &bench->reqs[impl][cu_id];
+    /* Warm up and align the start of the measurement */
+    for (unsigned int i = 0; i < 16; i++) fsync_host_sync(&bench->host, &bench->reqs[fsync_global][cu_id]);
+
+    double start = now_ns();
+    for (unsigned int i = 0; i < bench->iterations; i++){
+      if (impl == pthread_global) pthread_barrier_wait(&bench->pthread_barrier);
+      else                        fsync_host_sync(&bench->host, req);
+    }
+    if (cu_id == 0) bench->ns[impl] = (now_ns() - start)/bench->iterations;
+  }
+  return NULL;
+}
+
+int main(int argc, char *argv[]){
+  unsigned int arg = 1;
+  const bool csv = (argc > arg) && !strcmp(argv[arg], "csv");
+  if (csv) arg++;
+  static bench_t bench;
+  const unsigned int n_cu_x = (argc > arg)   ? (unsigned int)atoi(argv[arg])   : 8;
+  bench.iterations          = (argc > arg+1) ? (unsigned int)atoi(argv[arg+1]) : 10000;
+  bench.pin                 = !((argc > arg+2) && !strcmp(argv[arg+2], "nopin"));
+  bench.order               = ((argc > arg+2) && !strcmp(argv[arg+2], "row")) ? row_fs_map : tree_fs_map;
+
+  if (!fsync_topology_init(&bench.topo, n_cu_x, n_cu_x, NULL, NULL)){
+    printf("FractalSync topology not supported.\n");
+    return 1;
+  }
+  if (bench.pin && !fsync_host_map_init(&bench.map, &bench.topo, bench.order, NULL, NULL)) bench.pin = false;
+  if (!gen_reqs(&bench) || !fsync_host_init(&bench.host, &bench.topo) ||
+      pthread_barrier_init(&bench.pthread_barrier, NULL, bench.topo.n_cu) != 0){
+    printf("Benchmark initialization failed.\n");
+    return 1;
+  }
+
+  const unsigned int n_cu    = bench.topo.n_cu;
+  pthread_t         *threads = malloc(n_cu*sizeof(pthread_t));
+  cu_arg_t          *args    = malloc(n_cu*sizeof(cu_arg_t));
+  if (threads == NULL || args == NULL){
+    printf("Benchmark memory allocation failed.\n");
+    return 1;
+  }
+  for (unsigned int i = 0; i < n_cu; i++){
+    args[i].bench = &bench;
+    args[i].cu_id = i;
+    pthread_create(&threads[i], NULL, cu_thread, &args[i]);
+  }
+  for (unsigned int i = 0; i < n_cu; i++) pthread_join(threads[i], NULL);
+
+  if (csv) printf("impl,n_cu_x,threads,pinned,iterations,ns_per_barrier\n");
+  else     printf("%-16s %8s %8s %8s %10s %16s\n", "impl", "n_cu_x", "threads", "pinned", "iterations", "ns/barrier");
+  for (unsigned int impl = 0; impl < n_impls; impl++){
+    if (csv) printf("%s,%u,%u,%u,%u,%.1f\n", impl_names[impl], n_cu_x, n_cu, bench.pinned, bench.iterations, bench.ns[impl]);
+    else     printf("%-16s %8u %8u %8u %10u %16.1f\n", impl_names[impl], n_cu_x, n_cu, bench.pinned, bench.iterations, bench.ns[impl]);
+  }
+  const long n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  if (!csv) printf("fsync_global speed-up over pthread_global: x%.2f\n", bench.ns[fsync_global] > 0 ? bench.ns[pthread_global]/bench.ns[fsync_global] : 0.0);
+  if (n_cpus > 0 && (unsigned long)n_cpus < n_cu)
+    fprintf(stderr, "[WARNING] %u threads oversubscribe %ld CPUs: barriers are futex bound, the comparison is not representative\n", n_cu, n_cpus);
+
+  pthread_barrier_destroy(&bench.pthread_barrier);
+  fsync_host_free(&bench.host);
+  for (unsigned int impl = 0; impl < n_impls; impl++) free(bench.reqs[impl]);
+  free(threads);
+  free(args);
+  return 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization host mapping report
+ *
+ * Usage: fractal_sync_host_map [csv] [<n_cu_x>] [<sysfs>]
+ *
+ * Maps the CUs of a n_cu_x*n_cu_x mesh (default 8x8) on the CPUs of the host (or of a copy of its sysfs, default
+ * /sys/devices/system) in row-major and in tree order, and reports for every level and direction of the trees the
+ * widest sharing domain crossed by a node and the mean expected cost of its nodes, plus the expected cost of a global
+ * barrier (fsync_gen_reqs). The CPU of each CU in tree order is printed as a grid.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "../fractal_sync_req_gen.h"
+#include "../fractal_sync_host_map.h"
+
+static fsync_host_map_t maps[2];
+
+int main(int argc, char *argv[]){
+  unsigned int arg = 1;
+  const bool csv = (argc > arg) && !strcmp(argv[arg], "csv");
+  if (csv) arg++;
+  const unsigned int n_cu_x = (argc > arg)   ? (unsigned int)atoi(argv[arg]) : 8;
+  const char        *sysfs  = (argc > arg+1) ? argv[arg+1]                   : NULL;
+  const char        *orders[2] = {"row", "tree"};
+
+  fsync_topology_t topo;
+  if (!fsync_topology_init(&topo, n_cu_x, n_cu_x, NULL, NULL)){
+    printf("FractalSync topology not supported.\n");
+    return 1;
+  }
+  fsync_cu_t *cus = malloc(topo.n_cu*sizeof(fsync_cu_t));
+  if (cus == NULL){
+    printf("Memory allocation failed.\n");
+    return 1;
+  }
+  for (unsigned int i = 0; i < topo.n_cu; i++){
+    cus[i].cu_id = i; cus[i].y_pos = i >> topo.x_shift; cus[i].x_pos = i & (n_cu_x-1);
+  }
+  if (!fsync_gen_reqs(&topo, cus, topo.n_cu, h_fs_dir)){
+    printf("FractalSync requests not generated.\n");
+    return 1;
+  }
+
+  for (unsigned int order = 0; order < 2; order++){
+    if (!fsync_host_map_init(&maps[order], &topo, order ? tree_fs_map : row_fs_map, sysfs, NULL)){
+      printf("CPU topology not readable.\n");
+      return 1;
+    }
+  }
+
+  if (csv) printf("order,level,dir,domain,cost_ns\n");
+  else     printf("%u CUs on %u CPUs\n%-6s %6s %4s %-8s %10s\n", topo.n_cu, maps[0].n_cpus, "order", "level", "dir", "domain", "cost [ns]");
+  for (unsigned int order = 0; order < 2; order++){
+    for (unsigned int l = 0; l < topo.n_lvl; l++){
+      for (unsigned int ch = 0; ch < 2; ch++){
+        const char *dom = fsync_host_dom_name(maps[order].lvl_dom[l][ch]);
+        if (csv) printf("%s,%u,%s,%s,%.1f\n", orders[order], l+1, ch ? "v" : "h", dom, maps[order].lvl_cost[l][ch]);
+        else     printf("%-6s %6u %4s %-8s %10.1f\n", orders[order], l+1, ch ? "v" : "h", dom, maps[order].lvl_cost[l][ch]);
+      }
+    }
+    if (csv) printf("%s,global,%s,,%.1f\n", orders[order], "h", fsync_host_map_req_cost(&maps[order], &topo, &cus[0]));
+    else     printf("%-6s %6s %4s %-8s %10.1f\n", orders[order], "global", "h", "", fsync_host_map_req_cost(&maps[order], &topo, &cus[0]));
+  }
+
+  if (!csv){
+    printf("CPU of each CU (tree order):\n");
+    for (unsigned int y = 0; y < n_cu_x; y++){
+      for (unsigned int x = 0; x < n_cu_x; x++) printf("%5u", maps[1].cpu[(y << topo.x_shift) + x]);
+      printf("\n");
+    }
+  }
+
+  free(cus);
+  return 0;
+}
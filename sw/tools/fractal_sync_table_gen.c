@@ -0,0 +1,348 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization barrier table compiler: emits a firmware header of per-CU requests for named barriers
+ *
+ * Usage: fractal_sync_table_gen <description> [<header>]
+ *
+ * Description format (one statement per line, '#' starts a comment):
+ *  mesh <n_cu_x> <n_cu_y>                  - Mesh size (mandatory, first statement)
+ *  local_regs <n_lvl_1> ... <n_lvl_N>      - Local RF size per level (optional, defaults to hw/trees)
+ *  links <n_lvl_1> ... <n_lvl_N>           - Number of input links per level (optional, defaults to hw/trees)
+ *  barrier <name> [h|v] <cu> [<cu> ...]    - Named barrier, default direction h
+ *  set <name> [h|v] ... end                - Barriers that may be active at the same time (disjoint CUs): they get
+ *                                            distinct registers of shared nodes, or serialized phases if they do not fit
+ *  A <cu> is <y>,<x> where <y> and <x> are a position, an inclusive range <first>:<last> or * (whole mesh)
+ *
+ * The header holds, for every barrier, a table indexed by CU position (y_pos*N_CU_X + x_pos) so that firmware issues
+ * a barrier with a single table load: fsync_barrier_<name>[cu].
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include "../fractal_sync_req_gen.h"
+#include "../fractal_sync_team_alloc.h"
+
+#define MAX_LINE     (4096)
+#define MAX_NAME     (64)
+#define MAX_BARRIERS (1024)
+
+typedef struct barrier{
+  char          name[MAX_NAME];
+  fsync_dir     dir;
+  int           set;      /* Concurrent set index, -1 if none */
+  unsigned int  line;
+  fsync_cu_t   *cus;
+  unsigned int  num_cus;
+  fsync_team_t  team;
+  bool          generated;
+} barrier_t;
+
+static fsync_topology_t topo;
+static bool             mesh_defined = false;
+static unsigned int     n_cu_x;
+static unsigned int     n_cu_y;
+static unsigned int     local_regs[__FSYNC_MAX_N_LVL__];
+static unsigned int     links[__FSYNC_MAX_N_LVL__];
+static bool             local_regs_defined = false;
+static bool             links_defined = false;
+static barrier_t        barriers[MAX_BARRIERS];
+static unsigned int     num_barriers = 0;
+static char             set_names[MAX_BARRIERS][MAX_NAME];
+static fsync_dir        set_dirs[MAX_BARRIERS];
+static unsigned int     num_sets = 0;
+
+static bool parse_range(const char *str, const unsigned int size, unsigned int *first, unsigned int *last){
+  char *end;
+  if (strcmp(str, "*") == 0){
+    *first = 0;
+    *last  = size-1;
+    return true;
+  }
+  *first = (unsigned int)strtoul(str, &end, 0);
+  if (end == str) return false;
+  if (*end == ':'){
+    const char *next = end+1;
+    *last = (unsigned int)strtoul(next, &end, 0);
+    if (end == next) return false;
+  }else *last = *first;
+  return (*end == '\0') && (*first <= *last) && (*last < size);
+}
+
+static bool parse_cus(char *token, barrier_t *barrier){
+  char *comma = strchr(token, ',');
+  if (comma == NULL) return false;
+  *comma = '\0';
+  unsigned int y_first, y_last, x_first, x_last;
+  if (!parse_range(token, n_cu_y, &y_first, &y_last) || !parse_range(comma+1, n_cu_x, &x_first, &x_last)) return false;
+  for (unsigned int y = y_first; y <= y_last; y++){
+    for (unsigned int x = x_first; x <= x_last; x++){
+      for (unsigned int i = 0; i < barrier->num_cus; i++)
+        if (barrier->cus[i].y_pos == y && barrier->cus[i].x_pos == x) return false;
+      barrier->cus[barrier->num_cus].cu_id = y*n_cu_x + x;
+      barrier->cus[barrier->num_cus].y_pos = y;
+      barrier->cus[barrier->num_cus].x_pos = x;
+      barrier->num_cus++;
+    }
+  }
+  return true;
+}
+
+static bool valid_name(const char *name){
+  if (strlen(name) == 0 || strlen(name) >= MAX_NAME || !(isalpha((unsigned char)name[0]) || name[0] == '_')) return false;
+  for (const char *c = name; *c; c++)
+    if (!(isalnum((unsigned char)*c) || *c == '_')) return false;
+  return true;
+}
+
+static bool parse_dir(char **token, fsync_dir *dir){
+  *dir = h_fs_dir;
+  if (*token != NULL && (strcmp(*token, "h") == 0 || strcmp(*token, "v") == 0)){
+    *dir   = (strcmp(*token, "h") == 0) ? h_fs_dir : v_fs_dir;
+    *token = strtok(NULL, " \t\r\n");
+  }
+  return true;
+}
+
+static bool parse_levels(unsigned int *values){
+  unsigned int n = 0;
+  for (char *token = strtok(NULL, " \t\r\n"); token != NULL; token = strtok(NULL, " \t\r\n")){
+    if (n == __FSYNC_MAX_N_LVL__) return false;
+    values[n++] = (unsigned int)strtoul(token, NULL, 0);
+  }
+  return n == topo.n_lvl;
+}
+
+static int parse_description(FILE *in, const char *in_name){
+  char         line[MAX_LINE];
+  unsigned int line_num = 0;
+  int          set      = -1;
+
+  while (fgets(line, sizeof(line), in) != NULL){
+    line_num++;
+    char *comment = strchr(line, '#');
+    if (comment != NULL) *comment = '\0';
+    char *token = strtok(line, " \t\r\n");
+    if (token == NULL) continue;
+
+    if (strcmp(token, "mesh") == 0){
+      char *x = strtok(NULL, " \t\r\n");
+      char *y = strtok(NULL, " \t\r\n");
+      if (mesh_defined || x == NULL || y == NULL) goto syntax_error;
+      n_cu_x = (unsigned int)strtoul(x, NULL, 0);
+      n_cu_y = (unsigned int)strtoul(y, NULL, 0);
+      if (!fsync_topology_init(&topo, n_cu_x, n_cu_y, NULL, NULL)){
+        fprintf(stderr, "%s:%u: unsupported %ux%u mesh\n", in_name, line_num, n_cu_x, n_cu_y);
+        return 1;
+      }
+      mesh_defined = true;
+    }else if (!mesh_defined){
+      fprintf(stderr, "%s:%u: mesh must be defined first\n", in_name, line_num);
+      return 1;
+    }else if (strcmp(token, "local_regs") == 0){
+      if (local_regs_defined || !parse_levels(local_regs)) goto syntax_error;
+      local_regs_defined = true;
+    }else if (strcmp(token, "links") == 0){
+      if (links_defined || !parse_levels(links)) goto syntax_error;
+      links_defined = true;
+    }else if (strcmp(token, "set") == 0){
+      char *name = strtok(NULL, " \t\r\n");
+      if (set >= 0 || name == NULL || !valid_name(name) || num_sets == MAX_BARRIERS) goto syntax_error;
+      token = strtok(NULL, " \t\r\n");
+      parse_dir(&token, &set_dirs[num_sets]);
+      if (token != NULL) goto syntax_error;
+      strcpy(set_names[num_sets], name);
+      set = (int)num_sets++;
+    }else if (strcmp(token, "end") == 0){
+      if (set < 0) goto syntax_error;
+      set = -1;
+    }else if (strcmp(token, "barrier") == 0){
+      char *name = strtok(NULL, " \t\r\n");
+      if (name == NULL || !valid_name(name) || num_barriers == MAX_BARRIERS) goto syntax_error;
+      for (unsigned int b = 0; b < num_barriers; b++){
+        if (strcmp(barriers[b].name, name) == 0){
+          fprintf(stderr, "%s:%u: barrier %s already defined at line %u\n", in_name, line_num, name, barriers[b].line);
+          return 1;
+        }
+      }
+      barrier_t *barrier = &barriers[num_barriers];
+      strcpy(barrier->name, name);
+      barrier->set     = set;
+      barrier->line    = line_num;
+      barrier->num_cus = 0;
+      barrier->cus     = malloc(topo.n_cu*sizeof(fsync_cu_t));
+      if (barrier->cus == NULL) return 1;
+      token = strtok(NULL, " \t\r\n");
+      parse_dir(&token, &barrier->dir);
+      if (set >= 0) barrier->dir = set_dirs[set];
+      for (; token != NULL; token = strtok(NULL, " \t\r\n")){
+        if (!parse_cus(token, barrier)){
+          fprintf(stderr, "%s:%u: invalid or repeated CU '%s'\n", in_name, line_num, token);
+          return 1;
+        }
+      }
+      if (barrier->num_cus < 2){
+        fprintf(stderr, "%s:%u: barrier %s needs at least two CUs\n", in_name, line_num, name);
+        return 1;
+      }
+      num_barriers++;
+    }else goto syntax_error;
+    continue;
+
+  syntax_error:
+    fprintf(stderr, "%s:%u: syntax error\n", in_name, line_num);
+    return 1;
+  }
+
+  if (!mesh_defined){
+    fprintf(stderr, "%s: no mesh defined\n", in_name);
+    return 1;
+  }
+  if (set >= 0){
+    fprintf(stderr, "%s: set %s not closed\n", in_name, set_names[set]);
+    return 1;
+  }
+  if (!fsync_topology_init(&topo, n_cu_x, n_cu_y, local_regs_defined ? local_regs : NULL, links_defined ? links : NULL)){
+    fprintf(stderr, "%s: invalid local_regs/links\n", in_name);
+    return 1;
+  }
+
+  return 0;
+}
+
+static int generate_barriers(const char *in_name){
+  /* Stand-alone barriers */
+  for (unsigned int b = 0; b < num_barriers; b++){
+    barrier_t *barrier = &barriers[b];
+    barrier->team.cus     = barrier->cus;
+    barrier->team.num_cus = barrier->num_cus;
+    if (barrier->set >= 0) continue;
+    unsigned int num_phases;
+    barrier->generated = fsync_alloc_teams(&topo, &barrier->team, 1, barrier->dir, &num_phases);
+  }
+
+  /* Concurrent sets */
+  fsync_team_t *teams = malloc(num_barriers*sizeof(fsync_team_t));
+  if (teams == NULL && num_barriers > 0) return 1;
+  for (unsigned int s = 0; s < num_sets; s++){
+    unsigned int num_teams = 0;
+    for (unsigned int b = 0; b < num_barriers; b++)
+      if (barriers[b].set == (int)s) teams[num_teams++] = barriers[b].team;
+    unsigned int num_phases;
+    if (!fsync_alloc_teams(&topo, teams, num_teams, set_dirs[s], &num_phases)){
+      fprintf(stderr, "%s: barriers of set %s are not disjoint or degenerate\n", in_name, set_names[s]);
+      free(teams);
+      return 1;
+    }
+    if (num_phases > 1)
+      fprintf(stderr, "%s: warning: barriers of set %s need %u serialized phases\n", in_name, set_names[s], num_phases);
+    for (unsigned int b = 0, t = 0; b < num_barriers; b++){
+      if (barriers[b].set != (int)s) continue;
+      barriers[b].team      = teams[t++];
+      barriers[b].generated = barriers[b].team.valid;
+    }
+  }
+  free(teams);
+
+  for (unsigned int b = 0; b < num_barriers; b++){
+    if (!barriers[b].generated){
+      fprintf(stderr, "%s:%u: barrier %s could not be generated\n", in_name, barriers[b].line, barriers[b].name);
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+static const char *node_name(const fsync_node node){
+  switch (node){
+    case h_fs_node:  return "h_fs_node";
+    case v_fs_node:  return "v_fs_node";
+    case hv_fs_node: return "hv_fs_node";
+    default:         return "null_fs_node";
+  }
+}
+
+static void upper(char *dst, const char *src){
+  for (; *src; src++) *dst++ = (char)toupper((unsigned char)*src);
+  *dst = '\0';
+}
+
+static void emit_header(FILE *out, const char *in_name){
+  fprintf(out, "/*\n * FractalSync barrier table generated by fractal_sync_table_gen from %s: do not edit\n */\n\n", in_name);
+  fprintf(out, "#ifndef FSYNC_BARRIER_TABLE_H\n#define FSYNC_BARRIER_TABLE_H\n\n");
+  fprintf(out, "#include \"fractal_sync_req_gen.h\"\n\n");
+  fprintf(out, "#define FSYNC_TABLE_N_CU_X (%u)\n",   topo.n_cu_x);
+  fprintf(out, "#define FSYNC_TABLE_N_CU_Y (%u)\n",   topo.n_cu_y);
+  fprintf(out, "#define FSYNC_TABLE_N_CU   (%u)\n",   topo.n_cu);
+  fprintf(out, "#define FSYNC_TABLE_N_LVL  (%u)\n\n", topo.n_lvl);
+  fprintf(out, "/* Tables are indexed by CU position (y_pos*FSYNC_TABLE_N_CU_X + x_pos), CUs outside of the barrier hold a null request */\n\n");
+
+  for (unsigned int b = 0; b < num_barriers; b++){
+    barrier_t *barrier = &barriers[b];
+    char       name[MAX_NAME];
+    upper(name, barrier->name);
+    fprintf(out, "/* %s: %u CUs, level %u, register %u", barrier->name, barrier->num_cus, barrier->team.lvl, barrier->team.reg);
+    if (barrier->team.nbr) fprintf(out, " (neighbor link)");
+    if (barrier->set >= 0) fprintf(out, ", set %s phase %u", set_names[barrier->set], barrier->team.phase);
+    fprintf(out, " */\n");
+    fprintf(out, "#define FSYNC_BARRIER_%s_LVL   (%u)\n", name, barrier->team.lvl);
+    fprintf(out, "#define FSYNC_BARRIER_%s_PHASE (%u)\n", name, barrier->team.phase);
+    fprintf(out, "static const fsync_req_t fsync_barrier_%s[FSYNC_TABLE_N_CU] = {\n", barrier->name);
+    for (unsigned int i = 0; i < barrier->num_cus; i++){
+      const fsync_cu_t *cu = &barrier->cus[i];
+      fprintf(out, "  [%4u] = {.fs_req_aggr = 0x%x, .fs_req_id = %u, .req_node = %s},\n", cu->y_pos*topo.n_cu_x + cu->x_pos,
+              cu->fsync_req.fs_req_aggr, cu->fsync_req.fs_req_id, node_name(cu->fsync_req.req_node));
+    }
+    fprintf(out, "};\n\n");
+  }
+
+  fprintf(out, "#endif /*FSYNC_BARRIER_TABLE_H*/\n");
+}
+
+int main(int argc, char **argv){
+  if (argc < 2 || argc > 3){
+    fprintf(stderr, "Usage: %s <description> [<header>]\n", argv[0]);
+    return 1;
+  }
+
+  FILE *in = fopen(argv[1], "r");
+  if (in == NULL){
+    perror(argv[1]);
+    return 1;
+  }
+  int ret = parse_description(in, argv[1]);
+  fclose(in);
+  if (ret) return ret;
+
+  ret = generate_barriers(argv[1]);
+  if (ret) return ret;
+
+  FILE *out = (argc == 3) ? fopen(argv[2], "w") : stdout;
+  if (out == NULL){
+    perror(argv[2]);
+    return 1;
+  }
+  emit_header(out, argv[1]);
+  if (out != stdout) fclose(out);
+
+  for (unsigned int b = 0; b < num_barriers; b++) free(barriers[b].cus);
+
+  return 0;
+}
@@ -0,0 +1,826 @@
+/*
+ * Copyright (C) 2023-2024 ETH Zurich and University of Bologna
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Authors: Victor Isachi <victor.isachi@unibo.it>
+ *
+ * Fractal synchronization tree generator: emits hw/trees/fractal_sync_<N>x<N>.sv for any power-of-two N >= 8
+ *
+ * Usage: fractal_sync_tree_gen <n_cu_x> [<output>]
+ *
+ * A NxN tree is built recursively, as the 8x8-32x32 trees: 4 (N/2)x(N/2) leaf cores below a 2x2 root core, with the
+ * leaf/root parameters sliced out of the NxN ones. The 2x2 (nodes) and 4x4 (2x2 leaves with scalar parameters) trees
+ * are the base cases and stay hand-written. The defaults of fractal_sync_<N>x<N>_pkg extend the hand-written presets
+ * (also used by sw/model preset()), with p the 1D/2D level pair (level 2p+1 and 2p+2):
+ *  RF_TYPE           - CAM at p = 0, DM above (SA from 64x64, where a DM RF holds a register per signature)
+ *  ARBITER_TYPE      - FA, DM_ALT at p >= 2 from 16x16
+ *  N_LOCAL_REGS      - 4^p (1D), 2*4^p (2D)
+ *  N_REMOTE_LINES    - 2*4^p (1D), 4*4^p (2D), at most MAX_SA_LINES in SA RFs
+ *  *_FIFO_COMB       - fall-through at p < 2 for 8x8, sequential from 16x16
+ *  N_LINKS_ITL       - 2^((i+1)/2) at intermediate level i+2
+ *  N_PIPELINE_STAGES - 2^(p-1)-1 at p >= 2
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_LOG2_N (15)
+#define PKG_INDENT (84) /* Column of the values of multi-line package lists */
+#define MAX_SA_LINES (256) /* Remote lines of the SA RFs of the generated trees */
+
+/* fractal_sync_8x8.sv with ${...} placeholders: ${PKG} is replaced by the per-level package defaults, ${P} pads the
+ * module parameters to the width of the package name */
+static const char *tree_template[] = {
+  "/*",
+  " * Copyright (C) 2023-2024 ETH Zurich and University of Bologna",
+  " *",
+  " * Licensed under the Solderpad Hardware License, Version 0.51 ",
+  " * (the \"License\"); you may not use this file except in compliance ",
+  " * with the License. You may obtain a copy of the License at",
+  " *",
+  " *     http://www.apache.org/licenses/LICENSE-2.0",
+  " *",
+  " * Unless required by applicable law or agreed to in writing, software",
+  " * distributed under the License is distributed on an \"AS IS\" BASIS,",
+  " * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.",
+  " * See the License for the specific language governing permissions and",
+  " * limitations under the License.",
+  " * SPDX-License-Identifier: SHL-0.51",
+  " *",
+  " * Authors: Victor Isachi <victor.isachi@unibo.it>",
+  " *",
+  " * Fractal synchronization ${N} network",
+  " * Asynchronous valid low reset",
+  " *",
+  " * Parameters:",
+  " *  TOP_NODE_TYPE       - Top node type (2D or root)",
+  " *  RF_TYPE_1D          - Remote RF type (DM, CAM or SA) of 1D nodes at various levels: index 0 refers to level 1, index 1 refers to level 3, ...",
+  " *  ARBITER_TYPE_1D     - Arbiter type (FA, DM_WA, DM_ALT or PP) of 1D nodes at various levels: index 0 refers to level 1, index 1 refers to level 3, ...",
+  " *  N_LOCAL_REGS_1D     - Local RF size of 1D nodes at various levels: index 0 refers to level 1, index 1 refers to level 3, ...",
+  " *  N_REMOTE_LINES_1D   - Remote RF size of CAM-based and SA 1D nodes at various levels: index 0 refers to level 1, index 1 refers to level 3, ...",
+  " *  RX_FIFO_COMB_1D     - Output RX FIFO fall-through/sequential of 1D nodes at various levels: index 0 refers to level 1, index 1 refers to level 3, ...",
+  " *  TX_FIFO_COMB_1D     - Output TX FIFO with fall-through/sequential of 1D nodes at various levels: index 0 refers to level 1, index 1 refers to level 3, ...",
+  " *  LOCAL_FIFO_COMB_1D  - Output local FIFO with fall-through/sequential of 1D nodes at various levels: index 0 refers to level 1, index 1 refers to level 3, ...",
+  " *  REMOTE_FIFO_COMB_1D - Output remote FIFO with fall-through/sequential of 1D nodes at various levels: index 0 refers to level 1, index 1 refers to level 3, ...",
+  " *  RF_TYPE_2D          - Remote RF type (DM, CAM or SA) of 2D nodes at various levels: index 0 refers to level 2, index 1 refers to level 4, ...",
+  " *  ARBITER_TYPE_2D     - Arbiter type (FA, DM_WA, DM_ALT or PP) of 2D nodes at various levels: index 0 refers to level 2, index 1 refers to level 4, ...",
+  " *  N_LOCAL_REGS_2D     - Local RF size of 2D nodes at various levels: index 0 refers to level 2, index 1 refers to level 4, ...",
+  " *  N_REMOTE_LINES_2D   - Remote RF size of CAM-based and SA 2D nodes (will be ignored for root node) at various levels: index 0 refers to level 2, index 1 refers to level 4, ...",
+  " *  RX_FIFO_COMB_2D     - Output RX FIFO with fall-through/sequential of 2D nodes at various levels: index 0 refers to level 2, index 1 refers to level 4, ...",
+  " *  TX_FIFO_COMB_2D     - Output TX FIFO with fall-through/sequential of 2D nodes at various levels: index 0 refers to level 2, index 1 refers to level 4, ...",
+  " *  LOCAL_FIFO_COMB_2D  - Output local FIFO with fall-through/sequential of 2D nodes at various levels: index 0 refers to level 2, index 1 refers to level 4, ...",
+  " *  REMOTE_FIFO_COMB_2D - Output remote FIFO with fall-through/sequential of 2D nodes at various levels: index 0 refers to level 2, index 1 refers to level 4, ...",
+  " *  N_LINKS_IN          - Number of input links of the 1D network links (CU-1D node)",
+  " *  N_LINKS_ITL         - Number of network links at the intermediate (internal) levels: index 0 refers to level 2, index 1 refers to level 3, ...",
+  " *  N_LINKS_OUT         - Number of output links of the 2D network links (2D node-Out)",
+  " *  N_PIPELINE_STAGES   - Number of pipeline stages at each level: index 0 refers to level 1, index 1 refers to level 2, ...",
+  " *  FLOW_CTRL           - Credit-based flow control on the node-to-node links (1) or none (0)",
+  " *  FIFO_DEPTH          - Depth of the node FIFOs: 0 sizes them on the worst-case ratio of the input and output links",
+  " *  AGGREGATE_WIDTH     - Width of the aggr field (CU-1D interface)",
+  " *  ID_WIDTH            - Width of the id field (CU-1D interface)",
+  " *  LVL_OFFSET          - Level offset of 1D nodes (CU-1D interface)",
+  " *  fsync_in_req_t      - CU-1D (horizontal/vertical) synchronization request type (see hw/include/typedef.svh for a template)",
+  " *  fsync_out_req_t     - Top node output synchronization request type  (see hw/include/typedef.svh for a template)",
+  " *  fsync_rsp_t         - 1D/top node synchronization response type (see hw/include/typedef.svh for a template)",
+  " *  fsync_nbr_req_t     - CU neighbor synchronization request type (see hw/include/typedef.svh for a template)",
+  " *  fsync_nbr_rsp_t     - CU neighbor synchronization response type (see hw/include/typedef.svh for a template)",
+  " *",
+  " * Interface signals:",
+  " *  > h_1d_fsync_req_i  - CU horizontal 1D synchronization request",
+  " *  > h_1d_fsync_rsp_o  - CU horizontal 1D synchronization response",
+  " *  > v_1d_fsync_req_i  - CU vertical 1D synchronization request",
+  " *  > v_1d_fsync_rsp_o  - CU vertical 1D synchronization response",
+  " *  > h_nbr_fsycn_req_i - CU horizontal neighbor synchronization request",
+  " *  > h_nbr_fsycn_rsp_o - CU horizontal neighbor synchronization response",
+  " *  > v_nbr_fsycn_req_i - CU vertical neighbor synchronization request",
+  " *  > v_nbr_fsycn_rsp_o - CU vertical neighbor synchronization response",
+  " *  > h_2d_fsync_req_o  - Top node horizontal synchronization request",
+  " *  > h_2d_fsync_rsp_i  - Top node horizontal synchronization response",
+  " *  > v_2d_fsync_req_o  - Top node vertical synchronization request",
+  " *  > v_2d_fsync_rsp_i  - Top node vertical synchronization response",
+  " */",
+  "",
+  "  `include \"../include/fractal_sync/typedef.svh\"",
+  "  `include \"../include/fractal_sync/assign.svh\"",
+  "",
+  "package fractal_sync_${N}_pkg;",
+  "",
+  "  import fractal_sync_pkg::*;",
+  "",
+  "${PKG}",
+  "  localparam int unsigned                  N_2D_H_PORTS                         = 1;",
+  "  localparam int unsigned                  N_2D_V_PORTS                         = 1;",
+  "",
+  "  localparam int unsigned                  OUT_AGGR_WIDTH                       = 1;",
+  "  localparam int unsigned                  IN_AGGR_WIDTH                        = OUT_AGGR_WIDTH+N_ITL_LEVELS+1;",
+  "  localparam int unsigned                  LVL_WIDTH                            = $clog2(IN_AGGR_WIDTH-1);",
+  "  localparam int unsigned                  ID_WIDTH                             = N_ITL_LEVELS;",
+  "  localparam int unsigned                  IN_LVL_OFFSET                        = 0;",
+  "",
+  "  localparam int unsigned                  NBR_AGGR_WIDTH                       = 1;",
+  "  localparam int unsigned                  NBR_LVL_WIDTH                        = 1;",
+  "  localparam int unsigned                  NBR_ID_WIDTH                         = 2;",
+  "",
+  "  `FSYNC_TYPEDEF_REQ_ALL(fsync_in,  logic[IN_AGGR_WIDTH-1:0],  logic[ID_WIDTH-1:0])",
+  "  `FSYNC_TYPEDEF_REQ_ALL(fsync_out, logic[OUT_AGGR_WIDTH-1:0], logic[ID_WIDTH-1:0])",
+  "  `FSYNC_TYPEDEF_RSP_ALL(fsync,     logic[LVL_WIDTH-1:0],      logic[ID_WIDTH-1:0])",
+  "  `FSYNC_TYPEDEF_ALL(    fsync_nbr, logic[NBR_AGGR_WIDTH-1:0], logic[NBR_LVL_WIDTH-1:0], logic[NBR_ID_WIDTH-1:0])",
+  "",
+  "endpackage: fractal_sync_${N}_pkg",
+  "",
+  "module fractal_sync_${N}_core",
+  "  import fractal_sync_${N}_pkg::*;",
+  "#(",
+  "  parameter fractal_sync_pkg::node_e      TOP_NODE_TYPE                                             ${P} = fractal_sync_${N}_pkg::TOP_NODE_TYPE,",
+  "  parameter fractal_sync_pkg::remote_rf_e RF_TYPE_1D[fractal_sync_${N}_pkg::N_1D_ITL_LEVELS]          = fractal_sync_${N}_pkg::RF_TYPE_1D,",
+  "  parameter fractal_sync_pkg::arb_e       ARBITER_TYPE_1D[fractal_sync_${N}_pkg::N_1D_ITL_LEVELS]     = fractal_sync_${N}_pkg::ARBITER_TYPE_1D,",
+  "  parameter int unsigned                  N_LOCAL_REGS_1D[fractal_sync_${N}_pkg::N_1D_ITL_LEVELS]     = fractal_sync_${N}_pkg::N_LOCAL_REGS_1D,",
+  "  parameter int unsigned                  N_REMOTE_LINES_1D[fractal_sync_${N}_pkg::N_1D_ITL_LEVELS]   = fractal_sync_${N}_pkg::N_REMOTE_LINES_1D,",
+  "  parameter bit                           RX_FIFO_COMB_1D[fractal_sync_${N}_pkg::N_1D_ITL_LEVELS]     = fractal_sync_${N}_pkg::RX_FIFO_COMB_1D,",
+  "  parameter bit                           TX_FIFO_COMB_1D[fractal_sync_${N}_pkg::N_1D_ITL_LEVELS]     = fractal_sync_${N}_pkg::TX_FIFO_COMB_1D,",
+  "  parameter bit                           LOCAL_FIFO_COMB_1D[fractal_sync_${N}_pkg::N_1D_ITL_LEVELS]  = fractal_sync_${N}_pkg::LOCAL_FIFO_COMB_1D,",
+  "  parameter bit                           REMOTE_FIFO_COMB_1D[fractal_sync_${N}_pkg::N_1D_ITL_LEVELS] = fractal_sync_${N}_pkg::REMOTE_FIFO_COMB_1D,",
+  "  parameter fractal_sync_pkg::remote_rf_e RF_TYPE_2D[fractal_sync_${N}_pkg::N_2D_ITL_LEVELS]          = fractal_sync_${N}_pkg::RF_TYPE_2D,",
+  "  parameter fractal_sync_pkg::arb_e       ARBITER_TYPE_2D[fractal_sync_${N}_pkg::N_2D_ITL_LEVELS]     = fractal_sync_${N}_pkg::ARBITER_TYPE_2D,",
+  "  parameter int unsigned                  N_LOCAL_REGS_2D[fractal_sync_${N}_pkg::N_2D_ITL_LEVELS]     = fractal_sync_${N}_pkg::N_LOCAL_REGS_2D,",
+  "  parameter int unsigned                  N_REMOTE_LINES_2D[fractal_sync_${N}_pkg::N_2D_ITL_LEVELS]   = fractal_sync_${N}_pkg::N_REMOTE_LINES_2D,",
+  "  parameter bit                           RX_FIFO_COMB_2D[fractal_sync_${N}_pkg::N_2D_ITL_LEVELS]     = fractal_sync_${N}_pkg::RX_FIFO_COMB_2D,",
+  "  parameter bit                           TX_FIFO_COMB_2D[fractal_sync_${N}_pkg::N_2D_ITL_LEVELS]     = fractal_sync_${N}_pkg::TX_FIFO_COMB_2D,",
+  "  parameter bit                           LOCAL_FIFO_COMB_2D[fractal_sync_${N}_pkg::N_2D_ITL_LEVELS]  = fractal_sync_${N}_pkg::LOCAL_FIFO_COMB_2D,",
+  "  parameter bit                           REMOTE_FIFO_COMB_2D[fractal_sync_${N}_pkg::N_2D_ITL_LEVELS] = fractal_sync_${N}_pkg::REMOTE_FIFO_COMB_2D,",
+  "  parameter int unsigned                  N_LINKS_IN                                                ${P} = fractal_sync_${N}_pkg::N_LINKS_IN,",
+  "  parameter int unsigned                  N_LINKS_ITL[fractal_sync_${N}_pkg::N_ITL_LEVELS]            = fractal_sync_${N}_pkg::N_LINKS_ITL,",
+  "  parameter int unsigned                  N_LINKS_OUT                                               ${P} = fractal_sync_${N}_pkg::N_LINKS_OUT,",
+  "  parameter int unsigned                  N_PIPELINE_STAGES[fractal_sync_${N}_pkg::N_LEVELS]          = fractal_sync_${N}_pkg::N_PIPELINE_STAGES,",
+  "  parameter bit                           FLOW_CTRL                                                  = fractal_sync_${N}_pkg::FLOW_CTRL,",
+  "  parameter int unsigned                  FIFO_DEPTH                                                 = fractal_sync_${N}_pkg::FIFO_DEPTH,",
+  "  parameter int unsigned                  AGGREGATE_WIDTH                                           ${P} = fractal_sync_${N}_pkg::IN_AGGR_WIDTH,",
+  "  parameter int unsigned                  ID_WIDTH                                                  ${P} = fractal_sync_${N}_pkg::ID_WIDTH,",
+  "  parameter int unsigned                  LVL_OFFSET                                                ${P} = fractal_sync_${N}_pkg::IN_LVL_OFFSET,",
+  "  parameter type                          fsync_in_req_t                                            ${P} = fractal_sync_${N}_pkg::fsync_in_req_t,",
+  "  parameter type                          fsync_out_req_t                                           ${P} = fractal_sync_${N}_pkg::fsync_out_req_t,",
+  "  parameter type                          fsync_rsp_t                                               ${P} = fractal_sync_${N}_pkg::fsync_rsp_t,",
+  "  localparam int unsigned                 N_1D_H_PORTS                                              ${P} = fractal_sync_${N}_pkg::N_1D_H_PORTS,",
+  "  localparam int unsigned                 N_1D_V_PORTS                                              ${P} = fractal_sync_${N}_pkg::N_1D_V_PORTS,",
+  "  localparam int unsigned                 N_2D_H_PORTS                                              ${P} = fractal_sync_${N}_pkg::N_2D_H_PORTS,",
+  "  localparam int unsigned                 N_2D_V_PORTS                                              ${P} = fractal_sync_${N}_pkg::N_2D_V_PORTS",
+  ")(",
+  "  input  logic           clk_i,",
+  "  input  logic           rst_ni,",
+  "",
+  "  input  fsync_in_req_t h_1d_fsync_req_i[N_1D_H_PORTS][N_LINKS_IN],",
+  "  output fsync_rsp_t    h_1d_fsync_rsp_o[N_1D_H_PORTS][N_LINKS_IN],",
+  "  input  fsync_in_req_t v_1d_fsync_req_i[N_1D_V_PORTS][N_LINKS_IN],",
+  "  output fsync_rsp_t    v_1d_fsync_rsp_o[N_1D_V_PORTS][N_LINKS_IN],",
+  "",
+  "  output fsync_out_req_t h_2d_fsync_req_o[N_2D_H_PORTS][N_LINKS_OUT],",
+  "  input  fsync_rsp_t     h_2d_fsync_rsp_i[N_2D_H_PORTS][N_LINKS_OUT],",
+  "  output fsync_out_req_t v_2d_fsync_req_o[N_2D_V_PORTS][N_LINKS_OUT],",
+  "  input  fsync_rsp_t     v_2d_fsync_rsp_i[N_2D_V_PORTS][N_LINKS_OUT]",
+  ");",
+  "",
+  "/*******************************************************/",
+  "/**        Parameters and Definitions Beginning       **/",
+  "/*******************************************************/",
+  "",
+  "  localparam int unsigned N_LEAF_FSYNC_NETWORKS  = 4;",
+  "  localparam int unsigned N_LEAF_FSYNC_ITL_LVL   = ${LEAF_ITL};",
+  "  localparam int unsigned N_LEAF_FSYNC_LEVELS    = N_ITL_LEVELS-1;",
+  "  localparam int unsigned N_ROOT_FSYNC_LEVELS    = 2;",
+  "  localparam int unsigned N_LEAF_FSYNC_1D_CFG_W  = (N_LEAF_FSYNC_ITL_LVL+1)/2;",
+  "  localparam int unsigned N_LEAF_FSYNC_2D_CFG_W  = (N_LEAF_FSYNC_ITL_LVL+1)/2;",
+  "  localparam int unsigned N_LEAF_FSYNC_ITL_CFG_W = N_LEAF_FSYNC_ITL_LVL;",
+  "",
+  "  localparam fractal_sync_pkg::remote_rf_e LEAF_RF_TYPE_1D[N_LEAF_FSYNC_1D_CFG_W]          = RF_TYPE_1D[0:${LEAF_CFG}];",
+  "  localparam fractal_sync_pkg::arb_e       LEAF_ARBITER_TYPE_1D[N_LEAF_FSYNC_1D_CFG_W]     = ARBITER_TYPE_1D[0:${LEAF_CFG}];",
+  "  localparam int unsigned                  LEAF_N_LOCAL_REGS_1D[N_LEAF_FSYNC_1D_CFG_W]     = N_LOCAL_REGS_1D[0:${LEAF_CFG}];",
+  "  localparam int unsigned                  LEAF_N_REMOTE_LINES_1D[N_LEAF_FSYNC_1D_CFG_W]   = N_REMOTE_LINES_1D[0:${LEAF_CFG}];",
+  "  localparam bit                           LEAF_RX_FIFO_COMB_1D[N_LEAF_FSYNC_1D_CFG_W]     = RX_FIFO_COMB_1D[0:${LEAF_CFG}];",
+  "  localparam bit                           LEAF_TX_FIFO_COMB_1D[N_LEAF_FSYNC_1D_CFG_W]     = TX_FIFO_COMB_1D[0:${LEAF_CFG}];",
+  "  localparam bit                           LEAF_LOCAL_FIFO_COMB_1D[N_LEAF_FSYNC_1D_CFG_W]  = LOCAL_FIFO_COMB_1D[0:${LEAF_CFG}];",
+  "  localparam bit                           LEAF_REMOTE_FIFO_COMB_1D[N_LEAF_FSYNC_1D_CFG_W] = REMOTE_FIFO_COMB_1D[0:${LEAF_CFG}];",
+  "  localparam fractal_sync_pkg::remote_rf_e LEAF_RF_TYPE_2D[N_LEAF_FSYNC_2D_CFG_W]          = RF_TYPE_2D[0:${LEAF_CFG}];",
+  "  localparam fractal_sync_pkg::arb_e       LEAF_ARBITER_TYPE_2D[N_LEAF_FSYNC_2D_CFG_W]     = ARBITER_TYPE_2D[0:${LEAF_CFG}];",
+  "  localparam int unsigned                  LEAF_N_LOCAL_REGS_2D[N_LEAF_FSYNC_2D_CFG_W]     = N_LOCAL_REGS_2D[0:${LEAF_CFG}];",
+  "  localparam int unsigned                  LEAF_N_REMOTE_LINES_2D[N_LEAF_FSYNC_2D_CFG_W]   = N_REMOTE_LINES_2D[0:${LEAF_CFG}];",
+  "  localparam bit                           LEAF_RX_FIFO_COMB_2D[N_LEAF_FSYNC_2D_CFG_W]     = RX_FIFO_COMB_2D[0:${LEAF_CFG}];",
+  "  localparam bit                           LEAF_TX_FIFO_COMB_2D[N_LEAF_FSYNC_2D_CFG_W]     = TX_FIFO_COMB_2D[0:${LEAF_CFG}];",
+  "  localparam bit                           LEAF_LOCAL_FIFO_COMB_2D[N_LEAF_FSYNC_2D_CFG_W]  = LOCAL_FIFO_COMB_2D[0:${LEAF_CFG}];",
+  "  localparam bit                           LEAF_REMOTE_FIFO_COMB_2D[N_LEAF_FSYNC_2D_CFG_W] = REMOTE_FIFO_COMB_2D[0:${LEAF_CFG}];",
+  "  localparam int unsigned                  LEAF_N_LINKS_IN                                 = N_LINKS_IN;",
+  "  localparam int unsigned                  LEAF_N_LINKS_ITL[N_LEAF_FSYNC_ITL_CFG_W]        = N_LINKS_ITL[0:${LEAF_ITL_M1}];",
+  "  localparam int unsigned                  LEAF_N_LINKS_OUT                                = N_LINKS_ITL[${LEAF_ITL}];",
+  "  localparam int unsigned                  LEAF_N_PIPELINE_STAGES[N_LEAF_FSYNC_LEVELS]     = N_PIPELINE_STAGES[0:${LEAF_ITL}];",
+  "  localparam int unsigned                  LEAF_AGGREGATE_WIDTH                            = AGGREGATE_WIDTH;",
+  "  localparam int unsigned                  LEAF_ID_WIDTH                                   = ID_WIDTH;",
+  "  localparam int unsigned                  LEAF_LVL_OFFSET                                 = LVL_OFFSET;",
+  "",
+  "  localparam fractal_sync_pkg::remote_rf_e ROOT_RF_TYPE_1D                             = RF_TYPE_1D[${ROOT_CFG}];",
+  "  localparam fractal_sync_pkg::arb_e       ROOT_ARBITER_TYPE_1D                        = ARBITER_TYPE_1D[${ROOT_CFG}];",
+  "  localparam int unsigned                  ROOT_N_LOCAL_REGS_1D                        = N_LOCAL_REGS_1D[${ROOT_CFG}];",
+  "  localparam int unsigned                  ROOT_N_REMOTE_LINES_1D                      = N_REMOTE_LINES_1D[${ROOT_CFG}];",
+  "  localparam bit                           ROOT_RX_FIFO_COMB_1D                        = RX_FIFO_COMB_1D[${ROOT_CFG}];",
+  "  localparam bit                           ROOT_TX_FIFO_COMB_1D                        = TX_FIFO_COMB_1D[${ROOT_CFG}];",
+  "  localparam bit                           ROOT_LOCAL_FIFO_COMB_1D                     = LOCAL_FIFO_COMB_1D[${ROOT_CFG}];",
+  "  localparam bit                           ROOT_REMOTE_FIFO_COMB_1D                    = REMOTE_FIFO_COMB_1D[${ROOT_CFG}];",
+  "  localparam fractal_sync_pkg::remote_rf_e ROOT_RF_TYPE_2D                             = RF_TYPE_2D[${ROOT_CFG}];",
+  "  localparam fractal_sync_pkg::arb_e       ROOT_ARBITER_TYPE_2D                        = ARBITER_TYPE_2D[${ROOT_CFG}];",
+  "  localparam int unsigned                  ROOT_N_LOCAL_REGS_2D                        = N_LOCAL_REGS_2D[${ROOT_CFG}];",
+  "  localparam int unsigned                  ROOT_N_REMOTE_LINES_2D                      = N_REMOTE_LINES_2D[${ROOT_CFG}];",
+  "  localparam bit                           ROOT_RX_FIFO_COMB_2D                        = RX_FIFO_COMB_2D[${ROOT_CFG}];",
+  "  localparam bit                           ROOT_TX_FIFO_COMB_2D                        = TX_FIFO_COMB_2D[${ROOT_CFG}];",
+  "  localparam bit                           ROOT_LOCAL_FIFO_COMB_2D                     = LOCAL_FIFO_COMB_2D[${ROOT_CFG}];",
+  "  localparam bit                           ROOT_REMOTE_FIFO_COMB_2D                    = REMOTE_FIFO_COMB_2D[${ROOT_CFG}];",
+  "  localparam int unsigned                  ROOT_N_LINKS_IN                             = N_LINKS_ITL[${LEAF_ITL}];",
+  "  localparam int unsigned                  ROOT_N_LINKS_ITL                            = N_LINKS_ITL[${ROOT_ITL}];",
+  "  localparam int unsigned                  ROOT_N_LINKS_OUT                            = N_LINKS_OUT;",
+  "  localparam int unsigned                  ROOT_N_PIPELINE_STAGES[N_ROOT_FSYNC_LEVELS] = N_PIPELINE_STAGES[${ROOT_ITL}:${ROOT_LVL}];",
+  "  localparam int unsigned                  ROOT_AGGREGATE_WIDTH                        = LEAF_AGGREGATE_WIDTH-${ROOT_ITL};",
+  "  localparam int unsigned                  ROOT_ID_WIDTH                               = LEAF_ID_WIDTH;",
+  "  localparam int unsigned                  ROOT_LVL_OFFSET                             = LEAF_LVL_OFFSET+${ROOT_ITL};",
+  "",
+  "  localparam int unsigned ITL_RSP_AGGR_WIDTH = ROOT_AGGREGATE_WIDTH;",
+  "  `FSYNC_TYPEDEF_REQ_ALL(fsync_itl, logic[ITL_RSP_AGGR_WIDTH-1:0], logic[ID_WIDTH-1:0])",
+  "",
+  "  localparam int unsigned N_1D_H_LEAF_PORTS = N_1D_H_PORTS/N_LEAF_FSYNC_NETWORKS;",
+  "  localparam int unsigned N_1D_V_LEAF_PORTS = N_1D_V_PORTS/N_LEAF_FSYNC_NETWORKS;",
+  "",
+  "  localparam int unsigned N_2D_H_LEAF_PORTS = N_2D_H_PORTS;",
+  "  localparam int unsigned N_2D_V_LEAF_PORTS = N_2D_V_PORTS;",
+  "",
+  "  localparam int unsigned N_1D_H_ROOT_PORTS = N_LEAF_FSYNC_NETWORKS;",
+  "  localparam int unsigned N_1D_V_ROOT_PORTS = N_LEAF_FSYNC_NETWORKS;",
+  "",
+  "/*******************************************************/",
+  "/**           Parameters and Definitions End          **/",
+  "/*******************************************************/",
+  "/**             Internal Signals Beginning            **/",
+  "/*******************************************************/",
+  "",
+  "  fsync_in_req_t h_1d_fsync_req[N_LEAF_FSYNC_NETWORKS][N_1D_H_LEAF_PORTS][LEAF_N_LINKS_IN];",
+  "  fsync_rsp_t    h_1d_fsync_rsp[N_LEAF_FSYNC_NETWORKS][N_1D_H_LEAF_PORTS][LEAF_N_LINKS_IN];",
+  "  fsync_in_req_t v_1d_fsync_req[N_LEAF_FSYNC_NETWORKS][N_1D_V_LEAF_PORTS][LEAF_N_LINKS_IN];",
+  "  fsync_rsp_t    v_1d_fsync_rsp[N_LEAF_FSYNC_NETWORKS][N_1D_V_LEAF_PORTS][LEAF_N_LINKS_IN];",
+  "",
+  "  fsync_itl_req_t leaf_h_2d_fsync_req[N_LEAF_FSYNC_NETWORKS][N_2D_H_LEAF_PORTS][LEAF_N_LINKS_OUT];",
+  "  fsync_rsp_t     leaf_h_2d_fsync_rsp[N_LEAF_FSYNC_NETWORKS][N_2D_H_LEAF_PORTS][LEAF_N_LINKS_OUT];",
+  "  fsync_itl_req_t leaf_v_2d_fsync_req[N_LEAF_FSYNC_NETWORKS][N_2D_V_LEAF_PORTS][LEAF_N_LINKS_OUT];",
+  "  fsync_rsp_t     leaf_v_2d_fsync_rsp[N_LEAF_FSYNC_NETWORKS][N_2D_V_LEAF_PORTS][LEAF_N_LINKS_OUT];",
+  "",
+  "  fsync_itl_req_t root_h_1d_fsync_req[N_1D_H_ROOT_PORTS][ROOT_N_LINKS_IN];",
+  "  fsync_rsp_t     root_h_1d_fsync_rsp[N_1D_H_ROOT_PORTS][ROOT_N_LINKS_IN];",
+  "  fsync_itl_req_t root_v_1d_fsync_req[N_1D_V_ROOT_PORTS][ROOT_N_LINKS_IN];",
+  "  fsync_rsp_t     root_v_1d_fsync_rsp[N_1D_V_ROOT_PORTS][ROOT_N_LINKS_IN];",
+  "",
+  "/*******************************************************/",
+  "/**                Internal Signals End               **/",
+  "/*******************************************************/",
+  "/**            Hardwired Signals Beginning            **/",
+  "/*******************************************************/",
+  "",
+  "  for (genvar i = 0; i < N_LEAF_FSYNC_NETWORKS; i++) begin: gen_h_1d_leaf_fsync_net_req_rsp",
+  "    for (genvar j = 0; j < N_1D_H_LEAF_PORTS; j++) begin",
+  "      for (genvar k = 0; k < N_LINKS_IN; k++) begin",
+  "        localparam int unsigned LEAF_NET_ROWS = $sqrt(N_1D_H_LEAF_PORTS);",
+  "        localparam int unsigned LEAF_NET_COLS = LEAF_NET_ROWS;",
+  "        localparam int unsigned ROOT_NET_ROWS = $sqrt(N_LEAF_FSYNC_NETWORKS);",
+  "        localparam int unsigned ROOT_NET_COLS = ROOT_NET_ROWS;",
+  "        localparam int unsigned NET_ROWS      = $sqrt(N_1D_H_PORTS);",
+  "        localparam int unsigned NET_COLS      = NET_ROWS;",
+  "",
+  "        localparam int unsigned leaf_net_row_idx = j/LEAF_NET_COLS;",
+  "        localparam int unsigned leaf_net_col_idx = j%LEAF_NET_COLS;",
+  "        localparam int unsigned root_net_row_idx = i/ROOT_NET_COLS;",
+  "        localparam int unsigned root_net_col_idx = i%ROOT_NET_COLS;",
+  "        localparam int unsigned row_offset       = (root_net_row_idx*LEAF_NET_ROWS+leaf_net_row_idx)*NET_COLS;",
+  "        localparam int unsigned col_offset       = root_net_col_idx*LEAF_NET_COLS+leaf_net_col_idx;",
+  "        localparam int unsigned offset           = row_offset+col_offset;",
+  "",
+  "        assign h_1d_fsync_req[i][j][k]     = h_1d_fsync_req_i[offset][k];",
+  "        assign h_1d_fsync_rsp_o[offset][k] = h_1d_fsync_rsp[i][j][k];",
+  "      end",
+  "    end",
+  "  end",
+  "",
+  "  for (genvar i = 0; i < N_LEAF_FSYNC_NETWORKS; i++) begin: gen_v_1d_leaf_fsync_net_req_rsp",
+  "    for (genvar j = 0; j < N_1D_V_LEAF_PORTS; j++) begin",
+  "      for (genvar k = 0; k < N_LINKS_IN; k++) begin",
+  "        localparam int unsigned LEAF_NET_ROWS = $sqrt(N_1D_V_LEAF_PORTS);",
+  "        localparam int unsigned LEAF_NET_COLS = LEAF_NET_ROWS;",
+  "        localparam int unsigned ROOT_NET_ROWS = $sqrt(N_LEAF_FSYNC_NETWORKS);",
+  "        localparam int unsigned ROOT_NET_COLS = ROOT_NET_ROWS;",
+  "        localparam int unsigned NET_ROWS      = $sqrt(N_1D_V_PORTS);",
+  "        localparam int unsigned NET_COLS      = NET_ROWS;",
+  "",
+  "        localparam int unsigned leaf_net_row_idx = j/LEAF_NET_COLS;",
+  "        localparam int unsigned leaf_net_col_idx = j%LEAF_NET_COLS;",
+  "        localparam int unsigned root_net_row_idx = i/ROOT_NET_COLS;",
+  "        localparam int unsigned root_net_col_idx = i%ROOT_NET_COLS;",
+  "        localparam int unsigned row_offset       = (root_net_row_idx*LEAF_NET_ROWS+leaf_net_row_idx)*NET_COLS;",
+  "        localparam int unsigned col_offset       = root_net_col_idx*LEAF_NET_COLS+leaf_net_col_idx;",
+  "        localparam int unsigned offset           = row_offset+col_offset;",
+  "",
+  "        assign v_1d_fsync_req[i][j][k]     = v_1d_fsync_req_i[offset][k];",
+  "        assign v_1d_fsync_rsp_o[offset][k] = v_1d_fsync_rsp[i][j][k];",
+  "      end",
+  "    end",
+  "  end",
+  "",
+  "  for (genvar i = 0; i < N_1D_H_ROOT_PORTS; i++) begin: gen_1d_h_root_fsync_net_req_rsp",
+  "    for (genvar j = 0; j < ROOT_N_LINKS_IN; j++) begin",
+  "      assign root_h_1d_fsync_req[i][j]    = leaf_h_2d_fsync_req[i][0][j];",
+  "      assign leaf_h_2d_fsync_rsp[i][0][j] = root_h_1d_fsync_rsp[i][j];",
+  "    end",
+  "  end",
+  "",
+  "  for (genvar i = 0; i < N_1D_V_ROOT_PORTS; i++) begin: gen_1d_v_root_fsync_net_req_rsp",
+  "    for (genvar j = 0; j < ROOT_N_LINKS_IN; j++) begin",
+  "      assign root_v_1d_fsync_req[i][j]    = leaf_v_2d_fsync_req[i][0][j];",
+  "      assign leaf_v_2d_fsync_rsp[i][0][j] = root_v_1d_fsync_rsp[i][j];",
+  "    end",
+  "  end",
+  "",
+  "/*******************************************************/",
+  "/**               Hardwired Signals End               **/",
+  "/*******************************************************/",
+  "/**      Leaf Synchronization Networks Beginning      **/",
+  "/*******************************************************/",
+  "",
+  "  for (genvar i = 0; i < N_LEAF_FSYNC_NETWORKS; i++) begin: gen_leaf_fsync_net",
+  "    fractal_sync_${LEAF}_core #(",
+  "      .TOP_NODE_TYPE       ( fractal_sync_pkg::HV_NODE ),",
+  "      .RF_TYPE_1D          ( LEAF_RF_TYPE_1D           ),",
+  "      .ARBITER_TYPE_1D     ( LEAF_ARBITER_TYPE_1D      ),",
+  "      .N_LOCAL_REGS_1D     ( LEAF_N_LOCAL_REGS_1D      ),",
+  "      .N_REMOTE_LINES_1D   ( LEAF_N_REMOTE_LINES_1D    ),",
+  "      .RX_FIFO_COMB_1D     ( LEAF_RX_FIFO_COMB_1D      ),",
+  "      .TX_FIFO_COMB_1D     ( LEAF_TX_FIFO_COMB_1D      ),",
+  "      .LOCAL_FIFO_COMB_1D  ( LEAF_LOCAL_FIFO_COMB_1D   ),",
+  "      .REMOTE_FIFO_COMB_1D ( LEAF_REMOTE_FIFO_COMB_1D  ),",
+  "      .RF_TYPE_2D          ( LEAF_RF_TYPE_2D           ),",
+  "      .ARBITER_TYPE_2D     ( LEAF_ARBITER_TYPE_2D      ),",
+  "      .N_LOCAL_REGS_2D     ( LEAF_N_LOCAL_REGS_2D      ),",
+  "      .N_REMOTE_LINES_2D   ( LEAF_N_REMOTE_LINES_2D    ),",
+  "      .RX_FIFO_COMB_2D     ( LEAF_RX_FIFO_COMB_2D      ),",
+  "      .TX_FIFO_COMB_2D     ( LEAF_TX_FIFO_COMB_2D      ),",
+  "      .LOCAL_FIFO_COMB_2D  ( LEAF_LOCAL_FIFO_COMB_2D   ),",
+  "      .REMOTE_FIFO_COMB_2D ( LEAF_REMOTE_FIFO_COMB_2D  ),",
+  "      .N_LINKS_IN          ( LEAF_N_LINKS_IN           ),",
+  "      .N_LINKS_ITL         ( LEAF_N_LINKS_ITL          ),",
+  "      .N_LINKS_OUT         ( LEAF_N_LINKS_OUT          ),",
+  "      .N_PIPELINE_STAGES   ( LEAF_N_PIPELINE_STAGES    ),",
+  "      .FLOW_CTRL           ( FLOW_CTRL                 ),",
+  "      .FIFO_DEPTH          ( FIFO_DEPTH                ),",
+  "      .AGGREGATE_WIDTH     ( LEAF_AGGREGATE_WIDTH      ),",
+  "      .ID_WIDTH            ( LEAF_ID_WIDTH             ),",
+  "      .LVL_OFFSET          ( LEAF_LVL_OFFSET           ),",
+  "      .fsync_in_req_t      ( fsync_in_req_t            ),",
+  "      .fsync_out_req_t     ( fsync_itl_req_t           ),",
+  "      .fsync_rsp_t         ( fsync_rsp_t               )",
+  "    ) i_leaf_fsync_net (",
+  "      .clk_i                                       ,",
+  "      .rst_ni                                      ,",
+  "      .h_1d_fsync_req_i  ( h_1d_fsync_req[i]      ),",
+  "      .h_1d_fsync_rsp_o  ( h_1d_fsync_rsp[i]      ),",
+  "      .v_1d_fsync_req_i  ( v_1d_fsync_req[i]      ),",
+  "      .v_1d_fsync_rsp_o  ( v_1d_fsync_rsp[i]      ),",
+  "      .h_2d_fsync_req_o  ( leaf_h_2d_fsync_req[i] ),",
+  "      .h_2d_fsync_rsp_i  ( leaf_h_2d_fsync_rsp[i] ),",
+  "      .v_2d_fsync_req_o  ( leaf_v_2d_fsync_req[i] ),",
+  "      .v_2d_fsync_rsp_i  ( leaf_v_2d_fsync_rsp[i] )",
+  "    );",
+  "  end",
+  "",
+  "/*******************************************************/",
+  "/**         Leaf Synchronization Networks End         **/",
+  "/*******************************************************/",
+  "/**       Root Synchronization Network Beginning      **/",
+  "/*******************************************************/",
+  "",
+  "  fractal_sync_2x2_core #(",
+  "    .TOP_NODE_TYPE       ( TOP_NODE_TYPE            ),",
+  "    .RF_TYPE_1D          ( ROOT_RF_TYPE_1D          ),",
+  "    .ARBITER_TYPE_1D     ( ROOT_ARBITER_TYPE_1D     ),",
+  "    .N_LOCAL_REGS_1D     ( ROOT_N_LOCAL_REGS_1D     ),",
+  "    .N_REMOTE_LINES_1D   ( ROOT_N_REMOTE_LINES_1D   ),",
+  "    .RX_FIFO_COMB_1D     ( ROOT_RX_FIFO_COMB_1D     ),",
+  "    .TX_FIFO_COMB_1D     ( ROOT_TX_FIFO_COMB_1D     ),",
+  "    .LOCAL_FIFO_COMB_1D  ( ROOT_LOCAL_FIFO_COMB_1D  ),",
+  "    .REMOTE_FIFO_COMB_1D ( ROOT_REMOTE_FIFO_COMB_1D ),",
+  "    .RF_TYPE_2D          ( ROOT_RF_TYPE_2D          ),",
+  "    .ARBITER_TYPE_2D     ( ROOT_ARBITER_TYPE_2D     ),",
+  "    .N_LOCAL_REGS_2D     ( ROOT_N_LOCAL_REGS_2D     ),",
+  "    .N_REMOTE_LINES_2D   ( ROOT_N_REMOTE_LINES_2D   ),",
+  "    .RX_FIFO_COMB_2D     ( ROOT_RX_FIFO_COMB_2D     ),",
+  "    .TX_FIFO_COMB_2D     ( ROOT_TX_FIFO_COMB_2D     ),",
+  "    .LOCAL_FIFO_COMB_2D  ( ROOT_LOCAL_FIFO_COMB_2D  ),",
+  "    .REMOTE_FIFO_COMB_2D ( ROOT_REMOTE_FIFO_COMB_2D ),",
+  "    .N_LINKS_IN          ( ROOT_N_LINKS_IN          ),",
+  "    .N_LINKS_ITL         ( ROOT_N_LINKS_ITL         ),",
+  "    .N_LINKS_OUT         ( ROOT_N_LINKS_OUT         ),",
+  "    .N_PIPELINE_STAGES   ( ROOT_N_PIPELINE_STAGES   ),",
+  "    .FLOW_CTRL           ( FLOW_CTRL                ),",
+  "    .FIFO_DEPTH          ( FIFO_DEPTH               ),",
+  "    .AGGREGATE_WIDTH     ( ROOT_AGGREGATE_WIDTH     ),",
+  "    .ID_WIDTH            ( ROOT_ID_WIDTH            ),",
+  "    .LVL_OFFSET          ( ROOT_LVL_OFFSET          ),",
+  "    .fsync_in_req_t      ( fsync_itl_req_t          ),",
+  "    .fsync_out_req_t     ( fsync_out_req_t          ),",
+  "    .fsync_rsp_t         ( fsync_rsp_t              )",
+  "  ) i_root_fsync_net (",
+  "    .clk_i                                    ,",
+  "    .rst_ni                                   ,",
+  "    .h_1d_fsync_req_i  ( root_h_1d_fsync_req ),",
+  "    .h_1d_fsync_rsp_o  ( root_h_1d_fsync_rsp ),",
+  "    .v_1d_fsync_req_i  ( root_v_1d_fsync_req ),",
+  "    .v_1d_fsync_rsp_o  ( root_v_1d_fsync_rsp ),",
+  "    .h_2d_fsync_req_o  ( h_2d_fsync_req_o    ),",
+  "    .h_2d_fsync_rsp_i  ( h_2d_fsync_rsp_i    ),",
+  "    .v_2d_fsync_req_o  ( v_2d_fsync_req_o    ),",
+  "    .v_2d_fsync_rsp_i  ( v_2d_fsync_rsp_i    )",
+  "  );",
+  "",
+  "/*******************************************************/",
+  "/**          Root Synchronization Network End         **/",
+  "/*******************************************************/",
+  "",
+  "endmodule: fractal_sync_${N}_core",
+  "",
+  "module fractal_sync_${N}",
+  "  import fractal_sync_${N}_pkg::*;",
+  "#(",
+  "  parameter fractal_sync_pkg::node_e      TOP_NODE_TYPE                                             ${P} = fractal_sync_${N}_pkg::TOP_NODE_TYPE,",
+  "  parameter fractal_sync_pkg::remote_rf_e RF_TYPE_1D[fractal_sync_${N}_pkg::N_1D_ITL_LEVELS]          = fractal_sync_${N}_pkg::RF_TYPE_1D,",
+  "  parameter fractal_sync_pkg::arb_e       ARBITER_TYPE_1D[fractal_sync_${N}_pkg::N_1D_ITL_LEVELS]     = fractal_sync_${N}_pkg::ARBITER_TYPE_1D,",
+  "  parameter int unsigned                  N_LOCAL_REGS_1D[fractal_sync_${N}_pkg::N_1D_ITL_LEVELS]     = fractal_sync_${N}_pkg::N_LOCAL_REGS_1D,",
+  "  parameter int unsigned                  N_REMOTE_LINES_1D[fractal_sync_${N}_pkg::N_1D_ITL_LEVELS]   = fractal_sync_${N}_pkg::N_REMOTE_LINES_1D,",
+  "  parameter bit                           RX_FIFO_COMB_1D[fractal_sync_${N}_pkg::N_1D_ITL_LEVELS]     = fractal_sync_${N}_pkg::RX_FIFO_COMB_1D,",
+  "  parameter bit                           TX_FIFO_COMB_1D[fractal_sync_${N}_pkg::N_1D_ITL_LEVELS]     = fractal_sync_${N}_pkg::TX_FIFO_COMB_1D,",
+  "  parameter bit                           LOCAL_FIFO_COMB_1D[fractal_sync_${N}_pkg::N_1D_ITL_LEVELS]  = fractal_sync_${N}_pkg::LOCAL_FIFO_COMB_1D,",
+  "  parameter bit                           REMOTE_FIFO_COMB_1D[fractal_sync_${N}_pkg::N_1D_ITL_LEVELS] = fractal_sync_${N}_pkg::REMOTE_FIFO_COMB_1D,",
+  "  parameter fractal_sync_pkg::remote_rf_e RF_TYPE_2D[fractal_sync_${N}_pkg::N_2D_ITL_LEVELS]          = fractal_sync_${N}_pkg::RF_TYPE_2D,",
+  "  parameter fractal_sync_pkg::arb_e       ARBITER_TYPE_2D[fractal_sync_${N}_pkg::N_2D_ITL_LEVELS]     = fractal_sync_${N}_pkg::ARBITER_TYPE_2D,",
+  "  parameter int unsigned                  N_LOCAL_REGS_2D[fractal_sync_${N}_pkg::N_2D_ITL_LEVELS]     = fractal_sync_${N}_pkg::N_LOCAL_REGS_2D,",
+  "  parameter int unsigned                  N_REMOTE_LINES_2D[fractal_sync_${N}_pkg::N_2D_ITL_LEVELS]   = fractal_sync_${N}_pkg::N_REMOTE_LINES_2D,",
+  "  parameter bit                           RX_FIFO_COMB_2D[fractal_sync_${N}_pkg::N_2D_ITL_LEVELS]     = fractal_sync_${N}_pkg::RX_FIFO_COMB_2D,",
+  "  parameter bit                           TX_FIFO_COMB_2D[fractal_sync_${N}_pkg::N_2D_ITL_LEVELS]     = fractal_sync_${N}_pkg::TX_FIFO_COMB_2D,",
+  "  parameter bit                           LOCAL_FIFO_COMB_2D[fractal_sync_${N}_pkg::N_2D_ITL_LEVELS]  = fractal_sync_${N}_pkg::LOCAL_FIFO_COMB_2D,",
+  "  parameter bit                           REMOTE_FIFO_COMB_2D[fractal_sync_${N}_pkg::N_2D_ITL_LEVELS] = fractal_sync_${N}_pkg::REMOTE_FIFO_COMB_2D,",
+  "  parameter int unsigned                  N_LINKS_IN                                                ${P} = fractal_sync_${N}_pkg::N_LINKS_IN,",
+  "  parameter int unsigned                  N_LINKS_ITL[fractal_sync_${N}_pkg::N_ITL_LEVELS]            = fractal_sync_${N}_pkg::N_LINKS_ITL,",
+  "  parameter int unsigned                  N_LINKS_OUT                                               ${P} = fractal_sync_${N}_pkg::N_LINKS_OUT,",
+  "  parameter int unsigned                  N_PIPELINE_STAGES[fractal_sync_${N}_pkg::N_LEVELS]          = fractal_sync_${N}_pkg::N_PIPELINE_STAGES,",
+  "  parameter bit                           FLOW_CTRL                                                  = fractal_sync_${N}_pkg::FLOW_CTRL,",
+  "  parameter int unsigned                  FIFO_DEPTH                                                 = fractal_sync_${N}_pkg::FIFO_DEPTH,",
+  "  parameter int unsigned                  AGGREGATE_WIDTH                                           ${P} = fractal_sync_${N}_pkg::IN_AGGR_WIDTH,",
+  "  parameter int unsigned                  ID_WIDTH                                                  ${P} = fractal_sync_${N}_pkg::ID_WIDTH,",
+  "  parameter int unsigned                  LVL_OFFSET                                                ${P} = fractal_sync_${N}_pkg::IN_LVL_OFFSET,",
+  "  parameter type                          fsync_in_req_t                                            ${P} = fractal_sync_${N}_pkg::fsync_in_req_t,",
+  "  parameter type                          fsync_out_req_t                                           ${P} = fractal_sync_${N}_pkg::fsync_out_req_t,",
+  "  parameter type                          fsync_rsp_t                                               ${P} = fractal_sync_${N}_pkg::fsync_rsp_t,",
+  "  parameter type                          fsync_nbr_req_t                                           ${P} = fractal_sync_${N}_pkg::fsync_nbr_req_t,",
+  "  parameter type                          fsync_nbr_rsp_t                                           ${P} = fractal_sync_${N}_pkg::fsync_nbr_rsp_t,",
+  "  localparam int unsigned                 N_1D_H_PORTS                                              ${P} = fractal_sync_${N}_pkg::N_1D_H_PORTS,",
+  "  localparam int unsigned                 N_1D_V_PORTS                                              ${P} = fractal_sync_${N}_pkg::N_1D_V_PORTS,",
+  "  localparam int unsigned                 N_NBR_H_PORTS                                             ${P} = fractal_sync_${N}_pkg::N_NBR_H_PORTS,",
+  "  localparam int unsigned                 N_NBR_V_PORTS                                             ${P} = fractal_sync_${N}_pkg::N_NBR_V_PORTS,",
+  "  localparam int unsigned                 N_2D_H_PORTS                                              ${P} = fractal_sync_${N}_pkg::N_2D_H_PORTS,",
+  "  localparam int unsigned                 N_2D_V_PORTS                                              ${P} = fractal_sync_${N}_pkg::N_2D_V_PORTS",
+  ")(",
+  "  input  logic           clk_i,",
+  "  input  logic           rst_ni,",
+  "",
+  "  input  fsync_in_req_t h_1d_fsync_req_i[N_1D_H_PORTS][N_LINKS_IN],",
+  "  output fsync_rsp_t    h_1d_fsync_rsp_o[N_1D_H_PORTS][N_LINKS_IN],",
+  "  input  fsync_in_req_t v_1d_fsync_req_i[N_1D_V_PORTS][N_LINKS_IN],",
+  "  output fsync_rsp_t    v_1d_fsync_rsp_o[N_1D_V_PORTS][N_LINKS_IN],",
+  "",
+  "  input  fsync_nbr_req_t h_nbr_fsycn_req_i[N_NBR_H_PORTS],",
+  "  output fsync_nbr_rsp_t h_nbr_fsycn_rsp_o[N_NBR_H_PORTS],",
+  "  input  fsync_nbr_req_t v_nbr_fsycn_req_i[N_NBR_V_PORTS],",
+  "  output fsync_nbr_rsp_t v_nbr_fsycn_rsp_o[N_NBR_V_PORTS],",
+  "",
+  "  output fsync_out_req_t h_2d_fsync_req_o[N_2D_H_PORTS][N_LINKS_OUT],",
+  "  input  fsync_rsp_t     h_2d_fsync_rsp_i[N_2D_H_PORTS][N_LINKS_OUT],",
+  "  output fsync_out_req_t v_2d_fsync_req_o[N_2D_V_PORTS][N_LINKS_OUT],",
+  "  input  fsync_rsp_t     v_2d_fsync_rsp_i[N_2D_V_PORTS][N_LINKS_OUT]",
+  ");",
+  "",
+  "/*******************************************************/",
+  "/**        Parameters and Definitions Beginning       **/",
+  "/*******************************************************/",
+  "",
+  "  localparam int unsigned N_H_NBR_NODES  = $sqrt(N_NBR_H_PORTS);",
+  "  localparam int unsigned N_V_NBR_NODES  = $sqrt(N_NBR_V_PORTS);",
+  "  localparam int unsigned LAST_H_NBR_IDX = N_H_NBR_NODES-1;",
+  "  localparam int unsigned LAST_V_NBR_IDX = N_V_NBR_NODES-1;",
+  "  localparam int unsigned N_NBR_PORTS    = 2;",
+  "",
+  "/*******************************************************/",
+  "/**           Parameters and Definitions End          **/",
+  "/*******************************************************/",
+  "/**     Neighbor Synchronization Network Beginning    **/",
+  "/*******************************************************/",
+  "",
+  "  for (genvar i = 0; i < N_NBR_H_PORTS; i ++) begin: gen_h_nbr_net",
+  "    localparam int unsigned h_nbr_col_idx = i%N_V_NBR_NODES;",
+  "    if ((h_nbr_col_idx == 0) || (h_nbr_col_idx == LAST_H_NBR_IDX)) begin: gen_hardwire_req_rsp",
+  "      assign h_nbr_fsycn_rsp_o[i].wake    = 1'b0;",
+  "      assign h_nbr_fsycn_rsp_o[i].sig.lvl = '0;",
+  "      assign h_nbr_fsycn_rsp_o[i].sig.id  = '0;",
+  "      assign h_nbr_fsycn_rsp_o[i].error   = 1'b0;",
+  "      assign h_nbr_fsycn_rsp_o[i].credit  = 1'b0;",
+  "    end else if (h_nbr_col_idx%2) begin: gen_nbr_node",
+  "      fsync_nbr_req_t h_nbr_req[N_NBR_PORTS];",
+  "      fsync_nbr_rsp_t h_nbr_rsp[N_NBR_PORTS];",
+  "      assign h_nbr_req[0]           = h_nbr_fsycn_req_i[i];",
+  "      assign h_nbr_req[1]           = h_nbr_fsycn_req_i[i+1];",
+  "      assign h_nbr_fsycn_rsp_o[i]   = h_nbr_rsp[0];",
+  "      assign h_nbr_fsycn_rsp_o[i+1] = h_nbr_rsp[1];",
+  "      fractal_sync_neighbor #(",
+  "        .fsync_req_t ( fsync_nbr_req_t      ),",
+  "        .fsync_rsp_t ( fsync_nbr_rsp_t      ),",
+  "        .COMB        ( /*DO NOT OVERWRITE*/ ) ",
+  "      ) i_h_nbr_node (",
+  "        .clk_i               ,",
+  "        .rst_ni              ,",
+  "        .req_i  ( h_nbr_req ),",
+  "        .rsp_o  ( h_nbr_rsp )",
+  "      );",
+  "    end",
+  "  end",
+  "",
+  "  for (genvar i = 0; i < N_NBR_V_PORTS; i ++) begin: gen_v_nbr_net",
+  "    localparam int unsigned v_nbr_row_idx = i/N_V_NBR_NODES;",
+  "    if ((v_nbr_row_idx == 0) || (v_nbr_row_idx == LAST_V_NBR_IDX)) begin: gen_hardwire_req_rsp",
+  "      assign v_nbr_fsycn_rsp_o[i].wake    = 1'b0;",
+  "      assign v_nbr_fsycn_rsp_o[i].sig.lvl = '0;",
+  "      assign v_nbr_fsycn_rsp_o[i].sig.id  = '0;",
+  "      assign v_nbr_fsycn_rsp_o[i].error   = 1'b0;",
+  "      assign v_nbr_fsycn_rsp_o[i].credit  = 1'b0;",
+  "    end else if (v_nbr_row_idx%2) begin: gen_nbr_node",
+  "      fsync_nbr_req_t v_nbr_req[N_NBR_PORTS];",
+  "      fsync_nbr_rsp_t v_nbr_rsp[N_NBR_PORTS];",
+  "      assign v_nbr_req[0]                       = v_nbr_fsycn_req_i[i];",
+  "      assign v_nbr_req[1]                       = v_nbr_fsycn_req_i[i+N_V_NBR_NODES];",
+  "      assign v_nbr_fsycn_rsp_o[i]               = v_nbr_rsp[0];",
+  "      assign v_nbr_fsycn_rsp_o[i+N_V_NBR_NODES] = v_nbr_rsp[1];",
+  "      fractal_sync_neighbor #(",
+  "        .fsync_req_t ( fsync_nbr_req_t      ),",
+  "        .fsync_rsp_t ( fsync_nbr_rsp_t      ),",
+  "        .COMB        ( /*DO NOT OVERWRITE*/ ) ",
+  "      ) i_v_nbr_node (",
+  "        .clk_i               ,",
+  "        .rst_ni              ,",
+  "        .req_i  ( v_nbr_req ),",
+  "        .rsp_o  ( v_nbr_rsp )",
+  "      );",
+  "    end",
+  "  end",
+  "",
+  "/*******************************************************/",
+  "/**        Neighbor Synchronization Network End       **/",
+  "/*******************************************************/",
+  "/**      H-Tree Synchronization Network Beginning     **/",
+  "/*******************************************************/",
+  "",
+  "  fractal_sync_${N}_core #(",
+  "    .TOP_NODE_TYPE       ( TOP_NODE_TYPE       ),",
+  "    .RF_TYPE_1D          ( RF_TYPE_1D          ),",
+  "    .ARBITER_TYPE_1D     ( ARBITER_TYPE_1D     ),",
+  "    .N_LOCAL_REGS_1D     ( N_LOCAL_REGS_1D     ),",
+  "    .N_REMOTE_LINES_1D   ( N_REMOTE_LINES_1D   ),",
+  "    .RX_FIFO_COMB_1D     ( RX_FIFO_COMB_1D     ),",
+  "    .TX_FIFO_COMB_1D     ( TX_FIFO_COMB_1D     ),",
+  "    .LOCAL_FIFO_COMB_1D  ( LOCAL_FIFO_COMB_1D  ),",
+  "    .REMOTE_FIFO_COMB_1D ( REMOTE_FIFO_COMB_1D ),",
+  "    .RF_TYPE_2D          ( RF_TYPE_2D          ),",
+  "    .ARBITER_TYPE_2D     ( ARBITER_TYPE_2D     ),",
+  "    .N_LOCAL_REGS_2D     ( N_LOCAL_REGS_2D     ),",
+  "    .N_REMOTE_LINES_2D   ( N_REMOTE_LINES_2D   ),",
+  "    .RX_FIFO_COMB_2D     ( RX_FIFO_COMB_2D     ),",
+  "    .TX_FIFO_COMB_2D     ( TX_FIFO_COMB_2D     ),",
+  "    .LOCAL_FIFO_COMB_2D  ( LOCAL_FIFO_COMB_2D  ),",
+  "    .REMOTE_FIFO_COMB_2D ( REMOTE_FIFO_COMB_2D ),",
+  "    .N_LINKS_IN          ( N_LINKS_IN          ),",
+  "    .N_LINKS_ITL         ( N_LINKS_ITL         ),",
+  "    .N_LINKS_OUT         ( N_LINKS_OUT         ),",
+  "    .N_PIPELINE_STAGES   ( N_PIPELINE_STAGES   ),",
+  "    .FLOW_CTRL           ( FLOW_CTRL           ),",
+  "    .FIFO_DEPTH          ( FIFO_DEPTH          ),",
+  "    .AGGREGATE_WIDTH     ( AGGREGATE_WIDTH     ),",
+  "    .ID_WIDTH            ( ID_WIDTH            ),",
+  "    .LVL_OFFSET          ( LVL_OFFSET          ),",
+  "    .fsync_in_req_t      ( fsync_in_req_t      ),",
+  "    .fsync_out_req_t     ( fsync_out_req_t     ),",
+  "    .fsync_rsp_t         ( fsync_rsp_t         )",
+  "  ) i_fractal_sync_${N}_core (.*);",
+  "",
+  "/*******************************************************/",
+  "/**         H-Tree Synchronization Network End        **/",
+  "/*******************************************************/",
+  "",
+  "endmodule: fractal_sync_${N}"
+};
+
+static unsigned int log2_n;
+static unsigned int n_cu_x;
+
+static unsigned int pkg_regs_1d(unsigned int p)  { return 1u << 2*p; }
+static unsigned int pkg_sa(unsigned int p)       { return (log2_n >= 6) && (p > 0); }
+static unsigned int pkg_lines_1d(unsigned int p) { return (pkg_sa(p) && (2u << 2*p) > MAX_SA_LINES) ? MAX_SA_LINES : 2u << 2*p; }
+static unsigned int pkg_regs_2d(unsigned int p)  { return 2u << 2*p; }
+static unsigned int pkg_lines_2d(unsigned int p) { return (pkg_sa(p) && (4u << 2*p) > MAX_SA_LINES) ? MAX_SA_LINES : 4u << 2*p; }
+static unsigned int pkg_comb(unsigned int p)     { return (log2_n <= 3) && (p < 2); }
+static unsigned int pkg_links(unsigned int i)    { return 1u << (i+1)/2; }
+static unsigned int pkg_stages(unsigned int l)   { return (l/2 < 2) ? 0 : (1u << (l/2-1))-1; }
+
+static void emit_decl(FILE *out, const char *type, const char *name){
+  fprintf(out, "  localparam %-30s%-37s= ", type, name);
+}
+
+/* Values are aligned with the ones of the matching list (local regs/remote lines) */
+static void emit_list(FILE *out, unsigned int n, unsigned int (*value)(unsigned int), unsigned int (*align)(unsigned int)){
+  char buf[16];
+  fputs("'{", out);
+  for (unsigned int i = 0; i < n-1; i++){
+    int width = snprintf(buf, sizeof(buf), "%u", (align != NULL && align(i) > value(i)) ? align(i) : value(i));
+    snprintf(buf, sizeof(buf), "%u,", value(i));
+    fprintf(out, "%-*s ", width+1, buf);
+  }
+  fprintf(out, "%u};\n", value(n-1));
+}
+
+static void emit_enum_list(FILE *out, unsigned int n, const char *first, const char *second, unsigned int n_first){
+  fputs("'{", out);
+  for (unsigned int i = 0; i < n; i++){
+    if (i > 0) fprintf(out, "%*s", PKG_INDENT, "");
+    fprintf(out, "fractal_sync_pkg::%s%s\n", (i < n_first) ? first : second, (i == n-1) ? "};" : ",");
+  }
+}
+
+static void emit_pkg(FILE *out){
+  const unsigned int n_itl   = 2*log2_n-1;
+  const unsigned int n_cfg   = log2_n;
+  const unsigned int n_fa    = (log2_n <= 3) ? n_cfg : 2;
+  const unsigned int n_ports = n_cu_x*n_cu_x;
+  const char        *dims[2] = {"1D", "2D"};
+  const char        *combs[4] = {"RX", "TX", "LOCAL", "REMOTE"};
+  char               name[64];
+
+  emit_decl(out, "int unsigned", "N_ITL_LEVELS");
+  fprintf(out, "%u;\n", n_itl);
+  emit_decl(out, "int unsigned", "N_LEVELS");
+  fputs("N_ITL_LEVELS+1;\n", out);
+  emit_decl(out, "int unsigned", "N_1D_ITL_LEVELS");
+  fputs("(N_ITL_LEVELS+1)/2;\n", out);
+  emit_decl(out, "int unsigned", "N_2D_ITL_LEVELS");
+  fputs("(N_ITL_LEVELS+1)/2;\n\n", out);
+
+  emit_decl(out, "fractal_sync_pkg::node_e", "TOP_NODE_TYPE");
+  fputs("fractal_sync_pkg::HV_NODE;\n", out);
+  for (unsigned int d = 0; d < 2; d++){
+    snprintf(name, sizeof(name), "RF_TYPE_%s[N_%s_ITL_LEVELS]", dims[d], dims[d]);
+    emit_decl(out, "fractal_sync_pkg::remote_rf_e", name);
+    emit_enum_list(out, n_cfg, "CAM_RF", (log2_n >= 6) ? "SA_RF" : "DM_RF", 1);
+    snprintf(name, sizeof(name), "ARBITER_TYPE_%s[N_%s_ITL_LEVELS]", dims[d], dims[d]);
+    emit_decl(out, "fractal_sync_pkg::arb_e", name);
+    emit_enum_list(out, n_cfg, "FA_ARB", "DM_ALT_ARB", n_fa);
+    snprintf(name, sizeof(name), "N_LOCAL_REGS_%s[N_%s_ITL_LEVELS]", dims[d], dims[d]);
+    emit_decl(out, "int unsigned", name);
+    emit_list(out, n_cfg, d ? pkg_regs_2d : pkg_regs_1d, d ? pkg_lines_2d : pkg_lines_1d);
+    snprintf(name, sizeof(name), "N_REMOTE_LINES_%s[N_%s_ITL_LEVELS]", dims[d], dims[d]);
+    emit_decl(out, "int unsigned", name);
+    emit_list(out, n_cfg, d ? pkg_lines_2d : pkg_lines_1d, d ? pkg_regs_2d : pkg_regs_1d);
+    for (unsigned int c = 0; c < 4; c++){
+      snprintf(name, sizeof(name), "%s_FIFO_COMB_%s[N_%s_ITL_LEVELS]", combs[c], dims[d], dims[d]);
+      emit_decl(out, "bit", name);
+      emit_list(out, n_cfg, pkg_comb, NULL);
+    }
+  }
+  fputc('\n', out);
+
+  emit_decl(out, "int unsigned", "N_LINKS_IN");
+  fputs("1;\n", out);
+  emit_decl(out, "int unsigned", "N_LINKS_ITL[N_ITL_LEVELS]");
+  emit_list(out, n_itl, pkg_links, NULL);
+  emit_decl(out, "int unsigned", "N_LINKS_OUT");
+  fputs("1;\n\n", out);
+
+  emit_decl(out, "int unsigned", "N_PIPELINE_STAGES[N_LEVELS]");
+  emit_list(out, n_itl+1, pkg_stages, NULL);
+  fputc('\n', out);
+
+  emit_decl(out, "bit", "FLOW_CTRL");
+  fputs("0;\n", out);
+  emit_decl(out, "int unsigned", "FIFO_DEPTH");
+  fputs("0;\n\n", out);
+
+  emit_decl(out, "int unsigned", "N_1D_H_PORTS");
+  fprintf(out, "%u;\n", n_ports);
+  emit_decl(out, "int unsigned", "N_1D_V_PORTS");
+  fprintf(out, "%u;\n", n_ports);
+  emit_decl(out, "int unsigned", "N_NBR_H_PORTS");
+  fprintf(out, "%u;\n", n_ports);
+  emit_decl(out, "int unsigned", "N_NBR_V_PORTS");
+  fprintf(out, "%u;\n", n_ports);
+}
+
+/* Value of a ${...} placeholder, NULL if unknown */
+static const char *placeholder(const char *key, size_t len, char *buf, size_t size){
+  const unsigned int root_itl = 2*log2_n-2;
+  if      (len == 1 && !strncmp(key, "N", len))            snprintf(buf, size, "%ux%u", n_cu_x, n_cu_x);
+  else if (len == 4 && !strncmp(key, "LEAF", len))         snprintf(buf, size, "%ux%u", n_cu_x/2, n_cu_x/2);
+  else if (len == 8 && !strncmp(key, "LEAF_ITL", len))     snprintf(buf, size, "%u", root_itl-1);
+  else if (len == 11 && !strncmp(key, "LEAF_ITL_M1", len)) snprintf(buf, size, "%u", root_itl-2);
+  else if (len == 8 && !strncmp(key, "ROOT_CFG", len))     snprintf(buf, size, "%u", log2_n-1);
+  else if (len == 8 && !strncmp(key, "LEAF_CFG", len))  snprintf(buf, size, "%u", log2_n-2);
+  else if (len == 8 && !strncmp(key, "ROOT_ITL", len))     snprintf(buf, size, "%u", root_itl);
+  else if (len == 8 && !strncmp(key, "ROOT_LVL", len))     snprintf(buf, size, "%u", root_itl+1);
+  else return NULL;
+  return buf;
+}
+
+static int emit_tree(FILE *out){
+  const unsigned int n_lines = sizeof(tree_template)/sizeof(tree_template[0]);
+  char               buf[64];
+
+  /* ${P} pads by the extra width of the package name with respect to fractal_sync_8x8_pkg */
+  const int pad = snprintf(buf, sizeof(buf), "%ux%u", n_cu_x, n_cu_x)-3;
+
+  for (unsigned int l = 0; l < n_lines; l++){
+    const char *line = tree_template[l];
+    if (!strcmp(line, "${PKG}")){
+      emit_pkg(out);
+      continue;
+    }
+    while (*line){
+      const char *start = strstr(line, "${");
+      if (start == NULL){
+        fputs(line, out);
+        break;
+      }
+      fwrite(line, 1, start-line, out);
+      const char *end = strchr(start, '}');
+      if (end == NULL){
+        fprintf(stderr, "Unterminated placeholder at template line %u\n", l+1);
+        return 1;
+      }
+      if (end-start == 3 && start[2] == 'P'){
+        fprintf(out, "%*s", pad, "");
+      } else {
+        const char *value = placeholder(start+2, end-start-2, buf, sizeof(buf));
+        if (value == NULL){
+          fprintf(stderr, "Unknown placeholder at template line %u\n", l+1);
+          return 1;
+        }
+        fputs(value, out);
+      }
+      line = end+1;
+    }
+    if (l < n_lines-1) fputc('\n', out);
+  }
+  return 0;
+}
+
+int main(int argc, char **argv){
+  if (argc < 2 || argc > 3){
+    fprintf(stderr, "Usage: %s <n_cu_x> [<output>]\n", argv[0]);
+    return 1;
+  }
+
+  char *end;
+  n_cu_x = strtoul(argv[1], &end, 0);
+  for (log2_n = 0; (1u << log2_n) < n_cu_x && log2_n < MAX_LOG2_N; log2_n++);
+  if (*end != '\0' || n_cu_x < 8 || (1u << log2_n) != n_cu_x){
+    fprintf(stderr, "Unsupported %s mesh: N must be a power of two between 8 and %u (2x2 and 4x4 are hand-written)\n",
+            argv[1], 1u << MAX_LOG2_N);
+    return 1;
+  }
+
+  FILE *out = (argc == 3) ? fopen(argv[2], "w") : stdout;
+  if (out == NULL){
+    perror(argv[2]);
+    return 1;
+  }
+  int ret = emit_tree(out);
+  if (out != stdout){
+    fclose(out);
+    if (ret) remove(argv[2]);
+  }
+
+  return ret;
+}